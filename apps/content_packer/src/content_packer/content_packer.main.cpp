@@ -0,0 +1,121 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#include "model/content_image.hpp"
+#include "util/log_output.hpp"
+#include "util/logger.hpp"
+#include "util/string.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+    /// Writes the log messages to the standard output.
+    class StdoutLogOutput final : public Util::LogOutput {
+      public:
+        void write_log(const std::string_view message) override
+        {
+            std::fwrite(message.data(), 1, message.size(), stdout);
+        }
+    };
+
+    /// The parsed command line of the packer.
+    struct PackerOptions {
+        std::uint32_t alignment{Model::ContentImageBuilder::DEFAULT_ALIGNMENT};
+        std::string output{};
+        std::vector<std::string> directories{};
+    };
+
+    void print_usage()
+    {
+        Util::log_info("Usage: content_packer [-align <bytes>] <output> <directory> [<directory>...]\n");
+        Util::log_info("Bakes the directory trees into a content image, mounted with -contentimage.\n");
+        Util::log_info("Files of the directories listed first take precedence, like the search paths.\n");
+    }
+
+    [[nodiscard]] bool parse_options(const int argc, const char** const argv, PackerOptions& options)
+    {
+        std::vector<std::string> positional{};
+
+        for (int i = 1; i < argc; ++i) {
+            const std::string_view arg = argv[i];
+
+            if (("-align" == arg) && (i + 1 < argc)) {
+                const auto alignment = Util::str::convert_to_type<std::uint32_t>(argv[++i]);
+
+                if (!alignment) {
+                    return false;
+                }
+
+                options.alignment = *alignment;
+            }
+            else {
+                positional.emplace_back(arg);
+            }
+        }
+
+        if (positional.size() < 2) {
+            return false;
+        }
+
+        options.output = positional.front();
+        options.directories.assign(positional.cbegin() + 1, positional.cend());
+
+        return true;
+    }
+}
+
+int main(const int argc, const char** const argv)
+{
+    Util::LogSettings log_settings{};
+    log_settings.log_output = std::make_shared<StdoutLogOutput>();
+    Util::log_init(log_settings);
+
+    PackerOptions options{};
+
+    if (!parse_options(argc, argv, options)) {
+        print_usage();
+        return EXIT_FAILURE;
+    }
+
+    Model::ContentImageBuilder builder{};
+
+    for (const auto& directory : options.directories) {
+        const auto file_count = builder.get_file_count();
+
+        if (!builder.add_directory(directory)) {
+            return EXIT_FAILURE;
+        }
+
+        Util::log_info("Added {} files from '{}'.\n", builder.get_file_count() - file_count, directory);
+    }
+
+    if (!builder.write(options.output, options.alignment)) {
+        return EXIT_FAILURE;
+    }
+
+    Util::log_info("Content image '{}' written with {} files.\n", options.output, builder.get_file_count());
+
+    return EXIT_SUCCESS;
+}
@@ -42,6 +42,8 @@ namespace {
         Core::init_server_loop(cmdline_args, server_loop);
 
         const auto console_commands = std::make_shared<Model::ConsoleCommands>(system_interface);
+        Core::init_control_socket(cmdline_args, server_loop, console_commands);
+
         const auto input_history = std::make_shared<Model::UserInputHistory>("input_history.txt");
 
         const auto input_presenter =
@@ -62,7 +64,11 @@ int main(const int argc, const char** const argv)
     auto cmdline_args = Core::CmdLineArgs::from_command_line(argc, argv);
     const auto console_view = std::make_shared<View::ConsoleView>();
 
+    Core::init_reactor(cmdline_args);
     Core::init_logger(cmdline_args, console_view);
+    Core::init_output_capture(cmdline_args);
+    Core::init_status_line(cmdline_args, console_view);
+    Core::init_game_events(cmdline_args);
     const Core::CmdLineProcessor cmdline_processor{};
     cmdline_processor.process(cmdline_args);
 
@@ -0,0 +1,226 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+
+#include "util/binary_log.hpp"
+#include "util/log_output.hpp"
+#include "util/logger.hpp"
+#include <fmt/chrono.h>
+#include <fmt/format.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+
+namespace {
+    /// Writes the log messages to the standard error, the decoded log goes to the standard output.
+    class StderrLogOutput final : public Util::LogOutput {
+      public:
+        void write_log(const std::string_view message) override
+        {
+            std::fwrite(message.data(), 1, message.size(), stderr);
+        }
+    };
+
+    /// The parsed command line of the decoder.
+    struct DecoderOptions {
+        bool json{};
+        std::string input{};
+    };
+
+    void print_usage()
+    {
+        Util::log_info("Usage: log_decoder [-json] <file>\n");
+        Util::log_info("Renders a binary log written with -binlog as text, or as one JSON object per line.\n");
+    }
+
+    [[nodiscard]] bool parse_options(const int argc, const char** const argv, DecoderOptions& options)
+    {
+        for (int i = 1; i < argc; ++i) {
+            const std::string_view arg = argv[i];
+
+            if ("-json" == arg) {
+                options.json = true;
+            }
+            else if (options.input.empty()) {
+                options.input = arg;
+            }
+            else {
+                return false;
+            }
+        }
+
+        return !options.input.empty();
+    }
+
+    [[nodiscard]] std::string_view get_level_name(const int level)
+    {
+        switch (static_cast<Util::LogLevel>(level)) {
+            case Util::LogLevel::trace: return "trace";
+            case Util::LogLevel::debug: return "debug";
+            case Util::LogLevel::info: return "info";
+            case Util::LogLevel::warn: return "warning";
+            case Util::LogLevel::error: return "error";
+            case Util::LogLevel::critical: return "critical";
+            default: return "unknown";
+        }
+    }
+
+    /// Gets the prefix of a message in the text log, the same as in \c qconsole.log.
+    [[nodiscard]] std::string_view get_level_prefix(const int level)
+    {
+        switch (static_cast<Util::LogLevel>(level)) {
+            case Util::LogLevel::debug: return "[DEBUG] ";
+            case Util::LogLevel::warn: return "[WARNING] ";
+            case Util::LogLevel::error: return "[ERROR] ";
+            case Util::LogLevel::critical: return "[FATAL ERROR] ";
+            default: return "";
+        }
+    }
+
+    /// Removes the line breaks the messages end with.
+    [[nodiscard]] std::string_view trim_newlines(std::string_view text)
+    {
+        while (!text.empty() && ('\n' == text.back() || '\r' == text.back())) {
+            text.remove_suffix(1);
+        }
+
+        return text;
+    }
+
+    /// Escapes a string for a JSON string literal.
+    [[nodiscard]] std::string escape_json(const std::string_view text)
+    {
+        std::string escaped{};
+        escaped.reserve(text.size());
+
+        for (const auto character : text) {
+            switch (character) {
+                case '"': escaped += "\\\""; break;
+                case '\\': escaped += "\\\\"; break;
+                case '\n': escaped += "\\n"; break;
+                case '\r': escaped += "\\r"; break;
+                case '\t': escaped += "\\t"; break;
+                default: {
+                    if (static_cast<unsigned char>(character) < 0x20) {
+                        escaped += fmt::format("\\u{:04x}", static_cast<unsigned>(character));
+                    }
+                    else {
+                        escaped += character;
+                    }
+                }
+            }
+        }
+
+        return escaped;
+    }
+
+    /// Formats an argument as a JSON value.
+    [[nodiscard]] std::string to_json(const Util::BinaryLogArg& arg)
+    {
+        return std::visit(
+          [](const auto& value) -> std::string {
+              using Type = std::decay_t<decltype(value)>;
+
+              if constexpr (std::is_same_v<Type, std::string_view>) {
+                  return fmt::format("\"{}\"", escape_json(value));
+              }
+              else if constexpr (std::is_same_v<Type, char>) {
+                  return fmt::format("\"{}\"", escape_json({&value, 1}));
+              }
+              else {
+                  return fmt::format("{}", value);
+              }
+          },
+          arg);
+    }
+
+    void print_text(const Util::BinaryLogMessage& message)
+    {
+        constexpr std::int64_t nanoseconds_per_second = 1'000'000'000;
+        constexpr std::int64_t nanoseconds_per_millisecond = 1'000'000;
+
+        const auto seconds = static_cast<std::time_t>(message.time / nanoseconds_per_second);
+        const auto milliseconds = (message.time % nanoseconds_per_second) / nanoseconds_per_millisecond;
+
+        fmt::print("[{:%Y-%m-%d %H:%M:%S}.{:03}] {}{}\n", fmt::localtime(seconds), milliseconds,
+                   get_level_prefix(message.level), trim_newlines(message.format_message()));
+    }
+
+    void print_json(const Util::BinaryLogMessage& message)
+    {
+        std::string line = fmt::format(R"({{"time_ns":{},"level":"{}","message":"{}")", message.time,
+                                       get_level_name(message.level),
+                                       escape_json(trim_newlines(message.format_message())));
+
+        if (!message.is_text) {
+            line += fmt::format(R"(,"format":"{}","args":[)", escape_json(message.format));
+
+            for (std::size_t i = 0; i < message.args.size(); ++i) {
+                line += (0 == i ? "" : ",") + to_json(message.args[i]);
+            }
+
+            line += "]";
+        }
+
+        fmt::print("{}}}\n", line);
+    }
+}
+
+int main(const int argc, const char** const argv)
+{
+    Util::LogSettings log_settings{};
+    log_settings.log_output = std::make_shared<StderrLogOutput>();
+    Util::log_init(log_settings);
+
+    DecoderOptions options{};
+
+    if (!parse_options(argc, argv, options)) {
+        print_usage();
+        return EXIT_FAILURE;
+    }
+
+    Util::BinaryLogReader reader{};
+
+    if (!reader.open(options.input)) {
+        Util::log_error("'{}' is not a binary log file.", options.input);
+        return EXIT_FAILURE;
+    }
+
+    for (Util::BinaryLogMessage message{}; reader.next(message);) {
+        if (options.json) {
+            print_json(message);
+        }
+        else {
+            print_text(message);
+        }
+    }
+
+    if (reader.is_damaged()) {
+        Util::log_warn("The log contains damaged or truncated records, they were skipped.");
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -16,16 +16,18 @@ function(is_path_inside_directory path dir result_var)
 endfunction()
 
 # Retrieves the build targets located in the specified directories,
-# excluding certain targets and optionally excluding unit test targets.
+# excluding certain targets and optionally excluding unit test and benchmark targets.
 #
 # @param result_list The variable to store the list of targets.
 # @param DIRECTORIES The directories to search for targets.
 # @param EXCLUDE_TARGETS A list of targets to exclude from the result.
 # @param EXCLUDE_TESTS If set, excludes targets ending with "_tests".
+# @param EXCLUDE_BENCHMARKS If set, excludes targets ending with "_benchmarks".
 # @param EXCLUDE_IFACE_LIBS If set, excludes interface libraries.
 function(get_targets_in_directories result_list)
   # Parse the arguments passed to the function.
-  cmake_parse_arguments(ARG "" "EXCLUDE_TESTS;EXCLUDE_IFACE_LIBS" "DIRECTORIES;EXCLUDE_TARGETS" ${ARGN})
+  cmake_parse_arguments(
+    ARG "" "EXCLUDE_TESTS;EXCLUDE_BENCHMARKS;EXCLUDE_IFACE_LIBS" "DIRECTORIES;EXCLUDE_TARGETS" ${ARGN})
 
   if(NOT ARG_DIRECTORIES)
     message(FATAL_ERROR "DIRECTORIES argument is required.")
@@ -74,6 +76,11 @@ function(get_targets_in_directories result_list)
     list(FILTER targets EXCLUDE REGEX "_tests$")
   endif()
 
+  # Exclude benchmark targets from the list.
+  if(ARG_EXCLUDE_BENCHMARKS)
+    list(FILTER targets EXCLUDE REGEX "_benchmarks$")
+  endif()
+
   # Exclude interface libraries from the list.
   if(ARG_EXCLUDE_IFACE_LIBS)
     foreach(target ${targets})
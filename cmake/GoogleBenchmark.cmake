@@ -0,0 +1,26 @@
+# Google Benchmark - A microbenchmark support library.
+FetchContent_Declare(
+  GoogleBenchmark
+  GIT_REPOSITORY https://github.com/google/benchmark.git
+  GIT_TAG        v1.8.3
+)
+
+set(BENCHMARK_ENABLE_TESTING OFF CACHE INTERNAL
+  "Enable testing of the benchmark library." FORCE
+)
+
+set(BENCHMARK_ENABLE_GTEST_TESTS OFF CACHE INTERNAL
+  "Enable building the unit tests which depend on gtest." FORCE
+)
+
+set(BENCHMARK_ENABLE_INSTALL OFF CACHE INTERNAL
+  "Enable installation of benchmark." FORCE
+)
+
+set(BENCHMARK_INSTALL_DOCS OFF CACHE INTERNAL
+  "Enable installation of documentation." FORCE
+)
+
+set(BENCHMARK_ENABLE_WERROR OFF CACHE INTERNAL
+  "Build Release candidates with -Werror." FORCE
+)
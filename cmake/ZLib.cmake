@@ -0,0 +1,14 @@
+# A massively spiffy yet delicately unobtrusive compression library.
+FetchContent_Declare(
+  ZLib
+  GIT_REPOSITORY https://github.com/madler/zlib.git
+  GIT_TAG        v1.3.1
+)
+
+set(ZLIB_BUILD_EXAMPLES OFF CACHE INTERNAL
+  "Enable Zlib Examples." FORCE
+)
+
+set(SKIP_INSTALL_ALL ON CACHE INTERNAL
+  "Skip the installation of all zlib files." FORCE
+)
@@ -0,0 +1,218 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#include "common/object_container.hpp"
+#include "common/object_list.hpp"
+#include "common/platform.hpp"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace {
+    /**
+     * @brief The previous object list, a deque scanned on every lookup, as the reference.
+     */
+    class DequeObjectList final : public Common::ObjectContainer {
+      public:
+        FORCE_STACK_ALIGN void init() override
+        {
+            clear(false);
+        }
+
+        FORCE_STACK_ALIGN bool add(void* const object) override
+        {
+            container_.push_back(object);
+            return true;
+        }
+
+        FORCE_STACK_ALIGN bool remove(void* const object) override
+        {
+            const auto it = std::find(container_.begin(), container_.end(), object);
+
+            if (it == container_.end()) {
+                return false;
+            }
+
+            if ((current_ > 0) && (static_cast<std::size_t>(std::distance(container_.begin(), it)) < current_)) {
+                --current_;
+            }
+
+            container_.erase(it);
+
+            return true;
+        }
+
+        FORCE_STACK_ALIGN void clear(bool) override
+        {
+            current_ = 0;
+            container_.clear();
+        }
+
+        FORCE_STACK_ALIGN void* first() override
+        {
+            current_ = container_.empty() ? 0 : 1;
+            return container_.empty() ? nullptr : container_.front();
+        }
+
+        FORCE_STACK_ALIGN void* next() override
+        {
+            return (current_ < container_.size()) ? container_[current_++] : nullptr;
+        }
+
+        [[nodiscard]] FORCE_STACK_ALIGN std::size_t size() const override
+        {
+            return container_.size();
+        }
+
+        FORCE_STACK_ALIGN bool contains(void* const object) override
+        {
+            const auto it = std::find(container_.cbegin(), container_.cend(), object);
+
+            if (it == container_.cend()) {
+                return false;
+            }
+
+            current_ = static_cast<std::size_t>(std::distance(container_.cbegin(), it));
+
+            return true;
+        }
+
+        [[nodiscard]] FORCE_STACK_ALIGN bool empty() const override
+        {
+            return container_.empty();
+        }
+
+      private:
+        std::size_t current_{};
+        std::deque<void*> container_{};
+    };
+
+    /// Objects to store, in the order a lookup visits them.
+    class Objects final {
+      public:
+        explicit Objects(const std::int64_t count) :
+          objects_(static_cast<std::size_t>(count))
+        {
+            for (std::size_t i = 0; i < objects_.size(); ++i) {
+                lookups_.push_back(&objects_[(i * 7919) % objects_.size()]);
+            }
+        }
+
+        void fill(Common::ObjectContainer& list)
+        {
+            for (auto& object : objects_) {
+                list.add(&object);
+            }
+        }
+
+        /// Gets the next object to look up, spread over the whole list.
+        [[nodiscard]] void* get_lookup() noexcept
+        {
+            auto* const object = lookups_[next_lookup_];
+            next_lookup_ = (next_lookup_ + 1) % lookups_.size();
+
+            return object;
+        }
+
+      private:
+        std::vector<char> objects_{};
+        std::vector<void*> lookups_{};
+        std::size_t next_lookup_{};
+    };
+
+    /// Adds the objects one by one, like the engine builds its lists.
+    template <typename List>
+    void BM_Add(benchmark::State& state)
+    {
+        Objects objects{state.range(0)};
+
+        for ([[maybe_unused]] auto _ : state) {
+            List storage{};
+            Common::ObjectContainer& list = storage;
+            objects.fill(list);
+            benchmark::DoNotOptimize(list.first());
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    /// Looks up objects stored anywhere in the list.
+    template <typename List>
+    void BM_Contains(benchmark::State& state)
+    {
+        Objects objects{state.range(0)};
+        List storage{};
+        Common::ObjectContainer& list = storage;
+        objects.fill(list);
+
+        for ([[maybe_unused]] auto _ : state) {
+            benchmark::DoNotOptimize(list.contains(objects.get_lookup()));
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    /// Removes objects stored anywhere in the list and adds them back.
+    template <typename List>
+    void BM_RemoveAdd(benchmark::State& state)
+    {
+        Objects objects{state.range(0)};
+        List storage{};
+        Common::ObjectContainer& list = storage;
+        objects.fill(list);
+
+        for ([[maybe_unused]] auto _ : state) {
+            auto* const object = objects.get_lookup();
+            benchmark::DoNotOptimize(list.remove(object));
+            list.add(object);
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    /// Walks the list with the first/next cursor.
+    template <typename List>
+    void BM_Iterate(benchmark::State& state)
+    {
+        Objects objects{state.range(0)};
+        List storage{};
+        Common::ObjectContainer& list = storage;
+        objects.fill(list);
+
+        for ([[maybe_unused]] auto _ : state) {
+            for (auto* object = list.first(); object != nullptr; object = list.next()) {
+                benchmark::DoNotOptimize(object);
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_Add, DequeObjectList)->Arg(10)->Arg(1000)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_Add, Common::ObjectList)->Arg(10)->Arg(1000)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_Contains, DequeObjectList)->Arg(10)->Arg(1000)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_Contains, Common::ObjectList)->Arg(10)->Arg(1000)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_RemoveAdd, DequeObjectList)->Arg(10)->Arg(1000)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_RemoveAdd, Common::ObjectList)->Arg(10)->Arg(1000)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_Iterate, DequeObjectList)->Arg(10)->Arg(1000)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_Iterate, Common::ObjectList)->Arg(10)->Arg(1000)->Arg(100000);
@@ -0,0 +1,147 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#pragma once
+
+#include "common/filesystem/interface/filesystem_interface.hpp"
+#include "common/platform.hpp"
+
+namespace Common {
+    /**
+     * @brief A filesystem interface that forwards every call to another filesystem interface.
+     *
+     * Serves as the base class for decorators that are placed between the engine
+     * and the filesystem module. Derived classes override only the calls they are interested in.
+     */
+    class FileSystemProxy : public FileSystemInterface {
+      public:
+        /**
+         * @brief Constructs a new FileSystemProxy object.
+         *
+         * @param inner The filesystem interface to forward calls to.
+         */
+        explicit FileSystemProxy(FileSystemInterface* inner) noexcept;
+
+        /// Move constructor.
+        FileSystemProxy(FileSystemProxy&&) = delete;
+
+        /// Copy constructor.
+        FileSystemProxy(const FileSystemProxy&) = delete;
+
+        /// Move assignment operator.
+        FileSystemProxy& operator=(FileSystemProxy&&) = delete;
+
+        /// Copy assignment operator.
+        FileSystemProxy& operator=(const FileSystemProxy&) = delete;
+
+        /**
+         * @brief Gets the filesystem interface the calls are forwarded to.
+         *
+         * @return A pointer to the wrapped filesystem interface.
+         */
+        [[nodiscard]] FileSystemInterface* get_inner() const noexcept;
+
+        FORCE_STACK_ALIGN void mount() override;
+        FORCE_STACK_ALIGN void unmount() override;
+        FORCE_STACK_ALIGN void remove_all_search_paths() override;
+        FORCE_STACK_ALIGN void add_search_path(const char* path, const char* path_id) override;
+        FORCE_STACK_ALIGN bool remove_search_path(const char* path) override;
+        FORCE_STACK_ALIGN void remove_file(const char* relative_path, const char* path_id) override;
+        FORCE_STACK_ALIGN void create_dir_hierarchy(const char* path, const char* path_id) override;
+        FORCE_STACK_ALIGN bool file_exists(const char* filename) override;
+        FORCE_STACK_ALIGN bool is_directory(const char* filename) override;
+        FORCE_STACK_ALIGN FileHandle open(const char* filename, const char* options, const char* path_id) override;
+        FORCE_STACK_ALIGN void close(FileHandle file) override;
+        FORCE_STACK_ALIGN void seek(FileHandle file, int position, FileSystemSeek type) override;
+        FORCE_STACK_ALIGN unsigned int tell(FileHandle file) override;
+        FORCE_STACK_ALIGN unsigned int size(FileHandle file) override;
+        FORCE_STACK_ALIGN unsigned int size(const char* filename) override;
+        FORCE_STACK_ALIGN long get_filetime(const char* filename) override;
+        FORCE_STACK_ALIGN void filetime_to_string(char* strip, int max_chars_including_terminator,
+                                                  long filetime) override;
+        FORCE_STACK_ALIGN bool is_ok(FileHandle file) override;
+        FORCE_STACK_ALIGN void flush(FileHandle file) override;
+        FORCE_STACK_ALIGN bool end_of_file(FileHandle file) override;
+        FORCE_STACK_ALIGN int read(void* output, int size, FileHandle file) override;
+        FORCE_STACK_ALIGN int write(const void* input, int size, FileHandle file) override;
+        FORCE_STACK_ALIGN char* read_line(char* output, int max_chars, FileHandle file) override;
+        FORCE_STACK_ALIGN int print(FileHandle file, char* format, ...) override;
+        FORCE_STACK_ALIGN void* get_read_buffer(FileHandle file, int* out_buffer_size,
+                                                bool fail_if_not_in_cache) override;
+        FORCE_STACK_ALIGN void release_read_buffer(FileHandle file, void* read_buffer) override;
+        FORCE_STACK_ALIGN const char* find_first(const char* wild_card, FileFindHandle* handle,
+                                                 const char* path_id) override;
+        FORCE_STACK_ALIGN const char* find_next(FileFindHandle handle) override;
+        FORCE_STACK_ALIGN bool find_is_directory(FileFindHandle handle) override;
+        FORCE_STACK_ALIGN void find_close(FileFindHandle handle) override;
+        FORCE_STACK_ALIGN void get_local_copy(const char* filename) override;
+        FORCE_STACK_ALIGN const char* get_local_path(const char* filename, char* local_path,
+                                                     int local_path_buffer_size) override;
+        FORCE_STACK_ALIGN char* parse_file(char* file_bytes, char* token, bool* was_quoted) override;
+        FORCE_STACK_ALIGN bool full_path_to_relative_path(const char* full_path, char* relative) override;
+        FORCE_STACK_ALIGN bool get_current_directory(char* directory, int max_length) override;
+        FORCE_STACK_ALIGN void print_opened_files() override;
+        FORCE_STACK_ALIGN void set_warning_func(WarningFn warning_func) override;
+        FORCE_STACK_ALIGN void set_warning_level(FileWarningLevel level) override;
+        FORCE_STACK_ALIGN void log_level_load_started(const char* name) override;
+        FORCE_STACK_ALIGN void log_level_load_finished(const char* name) override;
+        FORCE_STACK_ALIGN int hint_resource_need(const char* hint_list, int forget_everything) override;
+        FORCE_STACK_ALIGN int pause_resource_preloading() override;
+        FORCE_STACK_ALIGN int resume_resource_preloading() override;
+        FORCE_STACK_ALIGN int set_buffer(FileHandle stream, char* buffer, int mode, long size) override;
+        FORCE_STACK_ALIGN void get_interface_version(char* buffer, int max_length) override;
+        FORCE_STACK_ALIGN bool is_file_immediately_available(const char* filename) override;
+        FORCE_STACK_ALIGN WaitForResourcesHandle wait_for_resources(const char* resource_list) override;
+        FORCE_STACK_ALIGN bool get_wait_for_resources_progress(WaitForResourcesHandle handle, float* progress,
+                                                               bool* complete) override;
+        FORCE_STACK_ALIGN void cancel_wait_for_resources(WaitForResourcesHandle handle) override;
+        FORCE_STACK_ALIGN bool is_app_ready_for_offline_play(int app_id) override;
+        FORCE_STACK_ALIGN bool add_pack_file(const char* full_path, const char* path_id) override;
+        FORCE_STACK_ALIGN FileHandle open_from_cache_for_read(const char* filename, const char* options,
+                                                              const char* path_id) override;
+        FORCE_STACK_ALIGN void add_search_path_no_write(const char* path, const char* path_id) override;
+
+      protected:
+        /**
+         * @brief Writes formatted text to a file, called by \c print() once the text is formatted.
+         *
+         * Derived classes override this function instead of the variadic \c print().
+         *
+         * @param file The file to write the text to.
+         * @param text The formatted text.
+         *
+         * @return The number of characters written, or a negative value on error.
+         */
+        virtual int print_text(FileHandle file, const char* text);
+
+      private:
+        /// The filesystem interface to forward calls to.
+        FileSystemInterface* inner_;
+    };
+
+    inline FileSystemProxy::FileSystemProxy(FileSystemInterface* const inner) noexcept : inner_(inner)
+    {
+    }
+
+    inline FileSystemInterface* FileSystemProxy::get_inner() const noexcept
+    {
+        return inner_;
+    }
+}
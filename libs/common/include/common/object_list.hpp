@@ -23,29 +23,69 @@
 #include "common/object_container.hpp"
 #include "common/platform.hpp"
 #include <algorithm>
-#include <deque>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <unordered_map>
 #include <utility>
 
 namespace Common {
     /**
      * @brief A container for storing objects.
+     *
+     * The objects are stored contiguously, in the object itself while there are only a few of them. Removing
+     * an object from the middle only marks its slot, the slots are compacted once the removed ones outnumber
+     * the objects or before the objects are accessed by index or iterator. Larger lists build an index of the
+     * positions of the objects on first lookup, so \c contains and \c remove do not scan the list.
      */
     class ObjectList final : public ObjectContainer {
       public:
         /**
          * @brief Type alias for the size type of the container.
          */
-        using SizeType = std::deque<void*>::size_type;
+        using SizeType = std::size_t;
 
         /**
          * @brief Type alias for the iterator of the container.
          */
-        using Iterator = std::deque<void*>::iterator;
+        using Iterator = void**;
 
         /**
          * @brief Type alias for the constant iterator of the container.
          */
-        using ConstIterator = std::deque<void*>::const_iterator;
+        using ConstIterator = void* const*;
+
+        /**
+         * @brief The number of objects stored in the object itself before the storage moves to the heap.
+         */
+        static constexpr SizeType INLINE_CAPACITY = 8;
+
+        /**
+         * @brief The number of slots at which lookups use the index of the positions of the objects.
+         */
+        static constexpr SizeType INDEX_THRESHOLD = 32;
+
+        /**
+         * @brief Default constructor.
+         */
+        ObjectList() = default;
+
+        /// Move constructor.
+        ObjectList(ObjectList&&) = delete;
+
+        /// Copy constructor.
+        ObjectList(const ObjectList&) = delete;
+
+        /// Move assignment operator.
+        ObjectList& operator=(ObjectList&&) = delete;
+
+        /// Copy assignment operator.
+        ObjectList& operator=(const ObjectList&) = delete;
+
+        /**
+         * @brief Default destructor.
+         */
+        ~ObjectList() override = default;
 
         /**
          * @brief Initializes the object container.
@@ -268,90 +308,158 @@ namespace Common {
         void sort(Comparator&& comp);
 
       private:
-        /// Current size of the container.
-        SizeType current_{};
+        /// Gets the storage of the slots.
+        [[nodiscard]] void** get_storage() const noexcept;
+
+        /// Gets the first slot.
+        [[nodiscard]] void** get_slots() const noexcept;
+
+        /// Gets the slots for access by index or iterator: compacted, and the objects may be replaced.
+        [[nodiscard]] void** get_dense_slots() noexcept;
+
+        /// Makes room for a slot at the front or at the back.
+        void make_room(bool at_head);
+
+        /// Moves the objects over the removed slots.
+        void compact() const noexcept;
+
+        /// Drops the slots removed at the front and at the back.
+        void trim() noexcept;
+
+        /// Finds the slot of an object, returns the number of slots if it is not in the container.
+        [[nodiscard]] SizeType find_slot(void* object);
+
+        /// Records the position of an added object in the index.
+        void index_object(void* object, SizeType slot);
+
+        /// Drops the index, it is rebuilt on the next lookup.
+        void invalidate_index() const noexcept;
+
+        /// The slot of the next object returned by \c next
+        mutable SizeType current_{};
+
+        /// The storage while it fits in the object.
+        mutable void* inline_storage_[INLINE_CAPACITY]{};
+
+        /// The storage once it does not fit in the object anymore.
+        std::unique_ptr<void*[]> heap_storage_{};
+
+        /// The number of slots of the storage.
+        SizeType capacity_{INLINE_CAPACITY};
+
+        /// The offset of the first slot in the storage.
+        mutable SizeType head_{};
 
-        /// Internal container storing the objects.
-        std::deque<void*> container_{};
+        /// The number of slots, including the removed ones.
+        mutable SizeType num_slots_{};
+
+        /// The number of objects.
+        SizeType size_{};
+
+        /// The position of the first slot, the index keeps positions so adding at the front does not move them.
+        mutable SizeType origin_{};
+
+        /// The positions of the objects, valid when \c indexed_ is set.
+        mutable std::unordered_map<void*, SizeType> index_{};
+
+        /// Indicates whether the index holds every object.
+        mutable bool indexed_{};
+
+        /// Indicates whether an object was found twice while indexing, lookups scan the slots until cleared.
+        mutable bool has_duplicates_{};
     };
 
+    inline void** ObjectList::get_storage() const noexcept
+    {
+        return heap_storage_ ? heap_storage_.get() : inline_storage_;
+    }
+
+    inline void** ObjectList::get_slots() const noexcept
+    {
+        return get_storage() + head_;
+    }
+
+    inline void** ObjectList::get_dense_slots() noexcept
+    {
+        compact();
+        invalidate_index();
+
+        return get_slots();
+    }
+
     inline void*& ObjectList::operator[](const SizeType index)
     {
-        return container_[index];
+        return get_dense_slots()[index];
     }
 
     inline void*& ObjectList::operator[](const int index)
     {
-        return container_[static_cast<SizeType>(index)];
+        return get_dense_slots()[static_cast<SizeType>(index)];
     }
 
     inline void* ObjectList::operator[](const SizeType index) const
     {
-        return container_[index];
+        compact();
+        return get_slots()[index];
     }
 
     inline void* ObjectList::operator[](const int index) const
     {
-        return container_[static_cast<SizeType>(index)];
+        compact();
+        return get_slots()[static_cast<SizeType>(index)];
     }
 
     inline auto ObjectList::begin() noexcept
     {
-        return container_.begin();
+        return get_dense_slots();
     }
 
     inline auto ObjectList::cbegin() const noexcept
     {
-        return container_.cbegin();
+        compact();
+        return static_cast<ConstIterator>(get_slots());
     }
 
-    inline auto ObjectList::rbegin() noexcept
+    inline auto ObjectList::end() noexcept
     {
-        return container_.rbegin();
+        return get_dense_slots() + size_;
     }
 
-    inline auto ObjectList::crbegin() const noexcept
+    inline auto ObjectList::cend() const noexcept
     {
-        return container_.crbegin();
+        compact();
+        return static_cast<ConstIterator>(get_slots() + size_);
     }
 
-    inline auto ObjectList::end() noexcept
+    inline auto ObjectList::rbegin() noexcept
     {
-        return container_.end();
+        return std::make_reverse_iterator(end());
     }
 
-    inline auto ObjectList::cend() const noexcept
+    inline auto ObjectList::crbegin() const noexcept
     {
-        return container_.cend();
+        return std::make_reverse_iterator(cend());
     }
 
     inline auto ObjectList::rend() noexcept
     {
-        return container_.rend();
+        return std::make_reverse_iterator(begin());
     }
 
     inline auto ObjectList::crend() const noexcept
     {
-        return container_.crend();
+        return std::make_reverse_iterator(cbegin());
     }
 
     inline ObjectList::Iterator ObjectList::erase(const ObjectList::ConstIterator& pos)
     {
-        current_ = 0;
-        return container_.erase(pos);
-    }
-
-    inline ObjectList::Iterator
-      ObjectList::erase(const ObjectList::ConstIterator& first, const ObjectList::ConstIterator& last)
-    {
-        current_ = 0;
-        return container_.erase(first, last);
+        return erase(pos, pos + 1);
     }
 
     template <typename Comparator>
     void ObjectList::sort(Comparator&& comp)
     {
         current_ = 0;
-        std::sort(container_.begin(), container_.end(), std::forward<Comparator>(comp));
+        std::sort(begin(), end(), std::forward<Comparator>(comp));
     }
 }
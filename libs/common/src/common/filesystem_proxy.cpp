@@ -0,0 +1,329 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#include "common/filesystem/filesystem_proxy.hpp"
+#include <array>
+#include <cstdarg>
+#include <cstdio>
+#include <string>
+
+namespace Common {
+    void FileSystemProxy::mount()
+    {
+        inner_->mount();
+    }
+
+    void FileSystemProxy::unmount()
+    {
+        inner_->unmount();
+    }
+
+    void FileSystemProxy::remove_all_search_paths()
+    {
+        inner_->remove_all_search_paths();
+    }
+
+    void FileSystemProxy::add_search_path(const char* const path, const char* const path_id)
+    {
+        inner_->add_search_path(path, path_id);
+    }
+
+    bool FileSystemProxy::remove_search_path(const char* const path)
+    {
+        return inner_->remove_search_path(path);
+    }
+
+    void FileSystemProxy::remove_file(const char* const relative_path, const char* const path_id)
+    {
+        inner_->remove_file(relative_path, path_id);
+    }
+
+    void FileSystemProxy::create_dir_hierarchy(const char* const path, const char* const path_id)
+    {
+        inner_->create_dir_hierarchy(path, path_id);
+    }
+
+    bool FileSystemProxy::file_exists(const char* const filename)
+    {
+        return inner_->file_exists(filename);
+    }
+
+    bool FileSystemProxy::is_directory(const char* const filename)
+    {
+        return inner_->is_directory(filename);
+    }
+
+    FileHandle FileSystemProxy::open(const char* const filename, const char* const options, const char* const path_id)
+    {
+        return inner_->open(filename, options, path_id);
+    }
+
+    void FileSystemProxy::close(const FileHandle file)
+    {
+        inner_->close(file);
+    }
+
+    void FileSystemProxy::seek(const FileHandle file, const int position, const FileSystemSeek type)
+    {
+        inner_->seek(file, position, type);
+    }
+
+    unsigned int FileSystemProxy::tell(const FileHandle file)
+    {
+        return inner_->tell(file);
+    }
+
+    unsigned int FileSystemProxy::size(const FileHandle file)
+    {
+        return inner_->size(file);
+    }
+
+    unsigned int FileSystemProxy::size(const char* const filename)
+    {
+        return inner_->size(filename);
+    }
+
+    long FileSystemProxy::get_filetime(const char* const filename)
+    {
+        return inner_->get_filetime(filename);
+    }
+
+    void FileSystemProxy::filetime_to_string(char* const strip, const int max_chars_including_terminator,
+                                             const long filetime)
+    {
+        inner_->filetime_to_string(strip, max_chars_including_terminator, filetime);
+    }
+
+    bool FileSystemProxy::is_ok(const FileHandle file)
+    {
+        return inner_->is_ok(file);
+    }
+
+    void FileSystemProxy::flush(const FileHandle file)
+    {
+        inner_->flush(file);
+    }
+
+    bool FileSystemProxy::end_of_file(const FileHandle file)
+    {
+        return inner_->end_of_file(file);
+    }
+
+    int FileSystemProxy::read(void* const output, const int size, const FileHandle file)
+    {
+        return inner_->read(output, size, file);
+    }
+
+    int FileSystemProxy::write(const void* const input, const int size, const FileHandle file)
+    {
+        return inner_->write(input, size, file);
+    }
+
+    char* FileSystemProxy::read_line(char* const output, const int max_chars, const FileHandle file)
+    {
+        return inner_->read_line(output, max_chars, file);
+    }
+
+    int FileSystemProxy::print(const FileHandle file, char* const format, ...)
+    {
+        // The variadic arguments cannot be forwarded as is, so the text is formatted here
+        std::array<char, 1024> buffer{};
+
+        std::va_list args;
+        va_start(args, format);
+        std::va_list args_copy;
+        va_copy(args_copy, args);
+        const auto length = std::vsnprintf(buffer.data(), buffer.size(), format, args);
+        va_end(args);
+
+        if (length < 0) {
+            va_end(args_copy);
+            return length;
+        }
+
+        if (static_cast<std::size_t>(length) < buffer.size()) {
+            va_end(args_copy);
+            return print_text(file, buffer.data());
+        }
+
+        std::string text(static_cast<std::size_t>(length) + 1, '\0');
+        std::vsnprintf(text.data(), text.size(), format, args_copy);
+        va_end(args_copy);
+
+        return print_text(file, text.c_str());
+    }
+
+    int FileSystemProxy::print_text(const FileHandle file, const char* const text)
+    {
+        // Passed to the wrapped interface through a plain "%s" format
+        static char text_format[] = "%s";
+        return inner_->print(file, text_format, text);
+    }
+
+    void* FileSystemProxy::get_read_buffer(const FileHandle file, int* const out_buffer_size,
+                                           const bool fail_if_not_in_cache)
+    {
+        return inner_->get_read_buffer(file, out_buffer_size, fail_if_not_in_cache);
+    }
+
+    void FileSystemProxy::release_read_buffer(const FileHandle file, void* const read_buffer)
+    {
+        inner_->release_read_buffer(file, read_buffer);
+    }
+
+    const char* FileSystemProxy::find_first(const char* const wild_card, FileFindHandle* const handle,
+                                            const char* const path_id)
+    {
+        return inner_->find_first(wild_card, handle, path_id);
+    }
+
+    const char* FileSystemProxy::find_next(const FileFindHandle handle)
+    {
+        return inner_->find_next(handle);
+    }
+
+    bool FileSystemProxy::find_is_directory(const FileFindHandle handle)
+    {
+        return inner_->find_is_directory(handle);
+    }
+
+    void FileSystemProxy::find_close(const FileFindHandle handle)
+    {
+        inner_->find_close(handle);
+    }
+
+    void FileSystemProxy::get_local_copy(const char* const filename)
+    {
+        inner_->get_local_copy(filename);
+    }
+
+    const char* FileSystemProxy::get_local_path(const char* const filename, char* const local_path,
+                                                const int local_path_buffer_size)
+    {
+        return inner_->get_local_path(filename, local_path, local_path_buffer_size);
+    }
+
+    char* FileSystemProxy::parse_file(char* const file_bytes, char* const token, bool* const was_quoted)
+    {
+        return inner_->parse_file(file_bytes, token, was_quoted);
+    }
+
+    bool FileSystemProxy::full_path_to_relative_path(const char* const full_path, char* const relative)
+    {
+        return inner_->full_path_to_relative_path(full_path, relative);
+    }
+
+    bool FileSystemProxy::get_current_directory(char* const directory, const int max_length)
+    {
+        return inner_->get_current_directory(directory, max_length);
+    }
+
+    void FileSystemProxy::print_opened_files()
+    {
+        inner_->print_opened_files();
+    }
+
+    void FileSystemProxy::set_warning_func(const WarningFn warning_func)
+    {
+        inner_->set_warning_func(warning_func);
+    }
+
+    void FileSystemProxy::set_warning_level(const FileWarningLevel level)
+    {
+        inner_->set_warning_level(level);
+    }
+
+    void FileSystemProxy::log_level_load_started(const char* const name)
+    {
+        inner_->log_level_load_started(name);
+    }
+
+    void FileSystemProxy::log_level_load_finished(const char* const name)
+    {
+        inner_->log_level_load_finished(name);
+    }
+
+    int FileSystemProxy::hint_resource_need(const char* const hint_list, const int forget_everything)
+    {
+        return inner_->hint_resource_need(hint_list, forget_everything);
+    }
+
+    int FileSystemProxy::pause_resource_preloading()
+    {
+        return inner_->pause_resource_preloading();
+    }
+
+    int FileSystemProxy::resume_resource_preloading()
+    {
+        return inner_->resume_resource_preloading();
+    }
+
+    int FileSystemProxy::set_buffer(const FileHandle stream, char* const buffer, const int mode, const long size)
+    {
+        return inner_->set_buffer(stream, buffer, mode, size);
+    }
+
+    void FileSystemProxy::get_interface_version(char* const buffer, const int max_length)
+    {
+        inner_->get_interface_version(buffer, max_length);
+    }
+
+    bool FileSystemProxy::is_file_immediately_available(const char* const filename)
+    {
+        return inner_->is_file_immediately_available(filename);
+    }
+
+    WaitForResourcesHandle FileSystemProxy::wait_for_resources(const char* const resource_list)
+    {
+        return inner_->wait_for_resources(resource_list);
+    }
+
+    bool FileSystemProxy::get_wait_for_resources_progress(const WaitForResourcesHandle handle, float* const progress,
+                                                          bool* const complete)
+    {
+        return inner_->get_wait_for_resources_progress(handle, progress, complete);
+    }
+
+    void FileSystemProxy::cancel_wait_for_resources(const WaitForResourcesHandle handle)
+    {
+        inner_->cancel_wait_for_resources(handle);
+    }
+
+    bool FileSystemProxy::is_app_ready_for_offline_play(const int app_id)
+    {
+        return inner_->is_app_ready_for_offline_play(app_id);
+    }
+
+    bool FileSystemProxy::add_pack_file(const char* const full_path, const char* const path_id)
+    {
+        return inner_->add_pack_file(full_path, path_id);
+    }
+
+    FileHandle FileSystemProxy::open_from_cache_for_read(const char* const filename, const char* const options,
+                                                         const char* const path_id)
+    {
+        return inner_->open_from_cache_for_read(filename, options, path_id);
+    }
+
+    void FileSystemProxy::add_search_path_no_write(const char* const path, const char* const path_id)
+    {
+        inner_->add_search_path_no_write(path, path_id);
+    }
+}
@@ -21,6 +21,15 @@
 #include "common/object_list.hpp"
 #include <algorithm>
 #include <cstdlib>
+#include <cstring>
+
+namespace {
+    /// The object of the marker of the removed slots.
+    char removed_slot_object{};
+
+    /// Marks a slot whose object was removed, until the slots are compacted.
+    void* const REMOVED_SLOT = &removed_slot_object;
+}
 
 namespace Common {
     void ObjectList::init()
@@ -36,17 +45,24 @@ namespace Common {
 
     bool ObjectList::remove(void* const object)
     {
-        const auto& it = std::find(container_.begin(), container_.end(), object);
+        const auto slot = find_slot(object);
 
-        if (it == container_.end()) {
+        if (slot == num_slots_) {
             return false;
         }
 
-        if ((current_ > 0) && (static_cast<SizeType>(std::distance(container_.begin(), it)) < current_)) {
-            --current_;
+        get_slots()[slot] = REMOVED_SLOT;
+        --size_;
+
+        if (indexed_) {
+            index_.erase(object);
         }
 
-        container_.erase(it);
+        trim();
+
+        if ((num_slots_ - size_) > size_) {
+            compact();
+        }
 
         return true;
     }
@@ -54,25 +70,37 @@ namespace Common {
     void ObjectList::clear(const bool free_elements_memory)
     {
         if (free_elements_memory) {
-            for (auto* const object : container_) {
-                std::free(object); // NOLINT
+            auto* const slots = get_slots();
+
+            for (SizeType slot = 0; slot < num_slots_; ++slot) {
+                if (slots[slot] != REMOVED_SLOT) {
+                    std::free(slots[slot]); // NOLINT
+                }
             }
         }
 
         current_ = 0;
-        container_.clear();
+        heap_storage_.reset();
+        capacity_ = INLINE_CAPACITY;
+        head_ = 0;
+        num_slots_ = 0;
+        size_ = 0;
+        origin_ = 0;
+        index_.clear();
+        indexed_ = false;
+        has_duplicates_ = false;
     }
 
     void* ObjectList::first()
     {
         void* object = nullptr;
 
-        if (container_.empty()) {
+        if (size_ == 0) {
             current_ = 0;
         }
         else {
             current_ = 1;
-            object = container_.front();
+            object = get_slots()[0];
         }
 
         return object;
@@ -80,11 +108,17 @@ namespace Common {
 
     void* ObjectList::next()
     {
-        if (current_ >= container_.size()) {
+        auto* const slots = get_slots();
+
+        while ((current_ < num_slots_) && (slots[current_] == REMOVED_SLOT)) {
+            ++current_;
+        }
+
+        if (current_ >= num_slots_) {
             return nullptr;
         }
 
-        auto* const object = container_[current_];
+        auto* const object = slots[current_];
         ++current_;
 
         return object;
@@ -92,13 +126,13 @@ namespace Common {
 
     ObjectList::SizeType ObjectList::size() const
     {
-        return container_.size();
+        return size_;
     }
 
     bool ObjectList::contains(void* const object)
     {
-        if (const auto& it = std::find(container_.cbegin(), container_.cend(), object); it != container_.cend()) {
-            current_ = static_cast<SizeType>(std::distance(container_.cbegin(), it));
+        if (const auto slot = find_slot(object); slot != num_slots_) {
+            current_ = slot;
             return true;
         }
 
@@ -107,55 +141,223 @@ namespace Common {
 
     bool ObjectList::empty() const
     {
-        return container_.empty();
+        return size_ == 0;
     }
 
     bool ObjectList::add_head(void* const object)
     {
-        container_.push_front(object);
+        if (head_ == 0) {
+            make_room(true);
+        }
+
+        --head_;
+        --origin_;
+        ++num_slots_;
+        ++size_;
+        get_slots()[0] = object;
 
         if (current_ != 0) {
             ++current_;
         }
 
+        if (indexed_) {
+            index_object(object, 0);
+        }
+
         return true;
     }
 
     bool ObjectList::add_tail(void* const object)
     {
-        container_.push_back(object);
+        if ((head_ + num_slots_) == capacity_) {
+            make_room(false);
+        }
+
+        get_slots()[num_slots_] = object;
+        ++num_slots_;
+        ++size_;
+
+        if (indexed_) {
+            index_object(object, num_slots_ - 1);
+        }
+
         return true;
     }
 
     void* ObjectList::remove_head()
     {
-        if (container_.empty()) {
+        if (size_ == 0) {
             return nullptr;
         }
 
-        if (current_ > 0) {
-            --current_;
+        auto* const object = get_slots()[0];
+        get_slots()[0] = REMOVED_SLOT;
+        --size_;
+
+        if (indexed_) {
+            index_.erase(object);
         }
 
-        auto* const object = container_.front();
-        container_.pop_front();
+        trim();
 
         return object;
     }
 
     void* ObjectList::remove_tail()
     {
-        if (container_.empty()) {
+        if (size_ == 0) {
             return nullptr;
         }
 
-        if ((current_ > 0) && ((container_.size() - 1) == current_)) {
+        // The cursor steps back when it is at the last object, removed slots in between would hide that
+        compact();
+
+        if ((current_ > 0) && ((num_slots_ - 1) == current_)) {
             --current_;
         }
 
-        auto* const object = container_.back();
-        container_.pop_back();
+        auto* const object = get_slots()[num_slots_ - 1];
+        --num_slots_;
+        --size_;
+
+        if (indexed_) {
+            index_.erase(object);
+        }
 
         return object;
     }
+
+    ObjectList::Iterator ObjectList::erase(const ConstIterator& first, const ConstIterator& last)
+    {
+        auto* const slots = get_dense_slots();
+        const auto from = static_cast<SizeType>(first - slots);
+        const auto count = static_cast<SizeType>(last - first);
+
+        std::memmove(slots + from, slots + from + count, (num_slots_ - from - count) * sizeof(void*));
+        num_slots_ -= count;
+        size_ -= count;
+        current_ = 0;
+
+        return slots + from;
+    }
+
+    void ObjectList::make_room(const bool at_head)
+    {
+        compact();
+
+        // Keeps the slots in place if there is enough room left, otherwise grows the storage twice,
+        // the room made for adding at the front is split between both ends
+        const auto capacity = ((num_slots_ + 1) > (capacity_ / 2)) ? (capacity_ * 2) : capacity_;
+        const auto head = at_head ? ((capacity - num_slots_) / 2) : 0;
+
+        if (capacity == capacity_) {
+            std::memmove(get_storage() + head, get_slots(), num_slots_ * sizeof(void*));
+        }
+        else {
+            std::unique_ptr<void*[]> storage{new void*[capacity]};
+            std::memcpy(storage.get() + head, get_slots(), num_slots_ * sizeof(void*));
+            heap_storage_ = std::move(storage);
+            capacity_ = capacity;
+        }
+
+        head_ = head;
+    }
+
+    void ObjectList::compact() const noexcept
+    {
+        if (num_slots_ == size_) {
+            return;
+        }
+
+        auto* const slots = get_slots();
+        auto current = current_;
+        SizeType kept = 0;
+
+        // The cursor keeps its place among the objects, and stays past the end if it is
+        for (SizeType slot = 0; slot < num_slots_; ++slot) {
+            if (slots[slot] != REMOVED_SLOT) {
+                slots[kept++] = slots[slot];
+            }
+            else if (slot < current_) {
+                --current;
+            }
+        }
+
+        current_ = current;
+        num_slots_ = kept;
+        invalidate_index();
+    }
+
+    void ObjectList::trim() noexcept
+    {
+        auto* const slots = get_slots();
+        SizeType leading = 0;
+
+        while ((leading < num_slots_) && (slots[leading] == REMOVED_SLOT)) {
+            ++leading;
+        }
+
+        head_ += leading;
+        origin_ += leading;
+        num_slots_ -= leading;
+        current_ = (current_ > leading) ? (current_ - leading) : 0;
+
+        const auto num_slots = num_slots_;
+
+        while ((num_slots_ > 0) && (slots[leading + num_slots_ - 1] == REMOVED_SLOT)) {
+            --num_slots_;
+        }
+
+        // Removing an object before the cursor moves it back, even when the cursor is past the end
+        if (current_ > num_slots_) {
+            current_ -= std::min(current_, num_slots) - num_slots_;
+        }
+    }
+
+    ObjectList::SizeType ObjectList::find_slot(void* const object)
+    {
+        auto* const slots = get_slots();
+
+        if ((num_slots_ < INDEX_THRESHOLD) || has_duplicates_) {
+            return static_cast<SizeType>(std::find(slots, slots + num_slots_, object) - slots);
+        }
+
+        if (!indexed_) {
+            index_.clear();
+            index_.reserve(size_);
+
+            for (SizeType slot = 0; slot < num_slots_; ++slot) {
+                if ((slots[slot] != REMOVED_SLOT) && !index_.emplace(slots[slot], origin_ + slot).second) {
+                    index_.clear();
+                    has_duplicates_ = true;
+
+                    return find_slot(object);
+                }
+            }
+
+            indexed_ = true;
+        }
+
+        const auto it = index_.find(object);
+
+        return (it == index_.end()) ? num_slots_ : (it->second - origin_);
+    }
+
+    void ObjectList::index_object(void* const object, const SizeType slot)
+    {
+        if (!index_.emplace(object, origin_ + slot).second) {
+            index_.clear();
+            indexed_ = false;
+            has_duplicates_ = true;
+        }
+    }
+
+    void ObjectList::invalidate_index() const noexcept
+    {
+        if (indexed_ || has_duplicates_) {
+            index_.clear();
+            indexed_ = false;
+            has_duplicates_ = false;
+        }
+    }
 }
@@ -20,6 +20,9 @@
 
 #include "common/object_list.hpp"
 #include <gtest/gtest.h>
+#include <array>
+#include <iterator>
+#include <vector>
 
 namespace {
     class ObjectListTest : public ::testing::Test {
@@ -398,4 +401,88 @@ namespace {
         ++it;
         EXPECT_EQ(*it, &x);
     }
+
+    TEST_F(ObjectListTest, RemoveMiddleKeepsCursor)
+    {
+        auto objects = std::array<int, 5>{};
+
+        for (auto& object : objects) {
+            list.add(&object);
+        }
+
+        EXPECT_EQ(list.first(), &objects[0]);
+        EXPECT_EQ(list.next(), &objects[1]);
+
+        EXPECT_TRUE(list.remove(&objects[0]));
+        EXPECT_TRUE(list.remove(&objects[3]));
+        EXPECT_EQ(list.size(), 3);
+
+        EXPECT_EQ(list.next(), &objects[2]);
+        EXPECT_EQ(list.next(), &objects[4]);
+        EXPECT_EQ(list.next(), nullptr);
+    }
+
+    TEST_F(ObjectListTest, RemovedSlotsAreCompacted)
+    {
+        auto objects = std::array<int, 6>{};
+
+        for (auto& object : objects) {
+            list.add(&object);
+        }
+
+        EXPECT_TRUE(list.remove(&objects[1]));
+        EXPECT_TRUE(list.remove(&objects[3]));
+
+        const auto& const_list = list;
+        EXPECT_EQ(const_list[1], &objects[2]);
+        EXPECT_EQ(std::distance(const_list.cbegin(), const_list.cend()), 4);
+        EXPECT_EQ(list[3], &objects[5]);
+    }
+
+    TEST_F(ObjectListTest, LargeListLookups)
+    {
+        auto objects = std::vector<int>(Common::ObjectList::INDEX_THRESHOLD * 8);
+
+        for (auto& object : objects) {
+            list.add(&object);
+        }
+
+        auto x = 5;
+        list.add_head(&x);
+
+        EXPECT_TRUE(list.contains(&objects[100]));
+        EXPECT_EQ(list.next(), &objects[100]);
+        EXPECT_FALSE(list.contains(&objects[0] - 1));
+
+        for (std::size_t i = 0; i < objects.size(); i += 2) {
+            EXPECT_TRUE(list.remove(&objects[i]));
+        }
+
+        EXPECT_FALSE(list.remove(&objects[0]));
+        EXPECT_EQ(list.size(), (objects.size() / 2) + 1);
+        EXPECT_TRUE(list.contains(&objects[1]));
+        EXPECT_TRUE(list.contains(&x));
+        EXPECT_EQ(list.remove_head(), &x);
+
+        list[0] = &x;
+        EXPECT_TRUE(list.contains(&x));
+        EXPECT_FALSE(list.contains(&objects[1]));
+    }
+
+    TEST_F(ObjectListTest, LargeListDuplicates)
+    {
+        auto objects = std::vector<int>(Common::ObjectList::INDEX_THRESHOLD * 2);
+
+        for (auto& object : objects) {
+            list.add(&object);
+        }
+
+        EXPECT_TRUE(list.contains(&objects[10]));
+
+        list.add(&objects[10]);
+        EXPECT_TRUE(list.remove(&objects[10]));
+        EXPECT_TRUE(list.contains(&objects[10]));
+        EXPECT_EQ(list.next(), &objects[10]);
+        EXPECT_EQ(list.next(), nullptr);
+    }
 }
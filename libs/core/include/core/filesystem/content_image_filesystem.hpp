@@ -0,0 +1,55 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#pragma once
+
+#include "core/filesystem/memory_filesystem.hpp"
+#include "model/content_image.hpp"
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace Core {
+    /**
+     * @brief A filesystem proxy that mounts content images as read-only search paths ahead of the loose files.
+     *
+     * Images are searched in the order they were specified, regardless of the search path ID of the request.
+     * Directory queries and file searches are answered by the wrapped interface only.
+     */
+    class ContentImageFileSystem final : public MemoryFileSystem {
+      public:
+        /**
+         * @brief Constructs a new ContentImageFileSystem object and mounts the content images.
+         *
+         * @param inner The filesystem interface to forward calls to.
+         * @param image_files The paths to the content images, in priority order.
+         */
+        ContentImageFileSystem(Common::FileSystemInterface* inner, const std::vector<std::string>& image_files);
+
+      protected:
+        [[nodiscard]] std::optional<MemoryFileInfo> find_memory_file(const char* filename,
+                                                                     const char* path_id) override;
+
+      private:
+        /// The mounted content images, never changed after construction.
+        std::vector<std::shared_ptr<Model::ContentImage>> images_{};
+    };
+}
@@ -0,0 +1,83 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#pragma once
+
+#include "common/filesystem/filesystem_proxy.hpp"
+#include "common/filesystem/interface/filesystem_interface.hpp"
+#include "common/interface.hpp"
+#include "common/platform.hpp"
+#include <memory>
+#include <utility>
+
+namespace Core {
+    /**
+     * @brief Gets the filesystem interface that is handed to the engine.
+     *
+     * This is the outermost installed proxy, or the interface of the filesystem module if no proxy is installed.
+     *
+     * @return A pointer to the filesystem interface. If the interface retrieval fails, the program will abort.
+     */
+    [[nodiscard]] Common::FileSystemInterface* get_filesystem_interface();
+
+    /**
+     * @brief Installs a filesystem proxy on top of the current filesystem interface.
+     *
+     * The proxy must wrap the interface returned by \c get_filesystem_interface().
+     * Proxies have to be installed before the engine is initialized and live until the program exits.
+     *
+     * @param proxy The proxy to install.
+     */
+    void push_filesystem_proxy(std::unique_ptr<Common::FileSystemProxy> proxy);
+
+    /**
+     * @brief Constructs and installs a filesystem proxy on top of the current filesystem interface.
+     *
+     * @tparam Proxy The proxy type, its constructor takes the wrapped interface as the first argument.
+     * @tparam Args The types of the remaining constructor arguments.
+     *
+     * @param args The remaining constructor arguments.
+     *
+     * @return A reference to the installed proxy.
+     */
+    template <typename Proxy, typename... Args>
+    Proxy& install_filesystem_proxy(Args&&... args)
+    {
+        auto proxy = std::make_unique<Proxy>(get_filesystem_interface(), std::forward<Args>(args)...);
+        auto& proxy_ref = *proxy;
+        push_filesystem_proxy(std::move(proxy));
+
+        return proxy_ref;
+    }
+
+    /**
+     * @brief The filesystem interface factory handed to the engine.
+     *
+     * Returns the outermost proxy for the filesystem interface and forwards
+     * any other request to the factory of the filesystem module.
+     *
+     * @param name The name of the interface to create.
+     * @param status Pointer to a CreateInterfaceStatus variable to store the creation status.
+     *
+     * @return A pointer to the created interface. If the creation fails, nullptr is returned.
+     */
+    FORCE_STACK_ALIGN Common::CommonInterface*
+      create_filesystem_interface(const char* name, Common::CreateInterfaceStatus* status);
+}
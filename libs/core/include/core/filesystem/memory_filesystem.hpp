@@ -0,0 +1,115 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#pragma once
+
+#include "common/filesystem/filesystem_proxy.hpp"
+#include "common/platform.hpp"
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+
+namespace Core {
+    /**
+     * @brief A base class for filesystem proxies that serve some files from memory.
+     *
+     * Derived classes implement \c find_memory_file() to provide the data of the files they serve.
+     * Files that are not found, and files opened for writing, are passed to the wrapped interface.
+     * The handles of the files served from memory are managed by this class.
+     */
+    class MemoryFileSystem : public Common::FileSystemProxy {
+      public:
+        using FileSystemProxy::FileSystemProxy;
+
+        FORCE_STACK_ALIGN bool file_exists(const char* filename) override;
+        FORCE_STACK_ALIGN Common::FileHandle open(const char* filename, const char* options,
+                                                  const char* path_id) override;
+        FORCE_STACK_ALIGN void close(Common::FileHandle file) override;
+        FORCE_STACK_ALIGN void seek(Common::FileHandle file, int position, Common::FileSystemSeek type) override;
+        FORCE_STACK_ALIGN unsigned int tell(Common::FileHandle file) override;
+        FORCE_STACK_ALIGN unsigned int size(Common::FileHandle file) override;
+        FORCE_STACK_ALIGN unsigned int size(const char* filename) override;
+        FORCE_STACK_ALIGN long get_filetime(const char* filename) override;
+        FORCE_STACK_ALIGN bool is_ok(Common::FileHandle file) override;
+        FORCE_STACK_ALIGN void flush(Common::FileHandle file) override;
+        FORCE_STACK_ALIGN bool end_of_file(Common::FileHandle file) override;
+        FORCE_STACK_ALIGN int read(void* output, int size, Common::FileHandle file) override;
+        FORCE_STACK_ALIGN int write(const void* input, int size, Common::FileHandle file) override;
+        FORCE_STACK_ALIGN char* read_line(char* output, int max_chars, Common::FileHandle file) override;
+        FORCE_STACK_ALIGN void* get_read_buffer(Common::FileHandle file, int* out_buffer_size,
+                                                bool fail_if_not_in_cache) override;
+        FORCE_STACK_ALIGN void release_read_buffer(Common::FileHandle file, void* read_buffer) override;
+        FORCE_STACK_ALIGN int set_buffer(Common::FileHandle stream, char* buffer, int mode, long size) override;
+        FORCE_STACK_ALIGN bool is_file_immediately_available(const char* filename) override;
+        FORCE_STACK_ALIGN Common::FileHandle open_from_cache_for_read(const char* filename, const char* options,
+                                                                      const char* path_id) override;
+
+      protected:
+        /**
+         * @brief Describes a file served from memory.
+         */
+        struct MemoryFileInfo {
+            /// The content of the file.
+            std::string_view data{};
+
+            /// The modification time of the file as a Unix timestamp.
+            long filetime{};
+
+            /// Keeps the memory holding the content alive while the file is open.
+            std::shared_ptr<const void> owner{};
+        };
+
+        /**
+         * @brief Looks up a file served from memory.
+         *
+         * @param filename The path of the file.
+         * @param path_id The search path ID, \c nullptr or empty to search all paths.
+         *
+         * @return The description of the file, or an empty optional if the file is not served from memory.
+         */
+        [[nodiscard]] virtual std::optional<MemoryFileInfo> find_memory_file(const char* filename,
+                                                                             const char* path_id) = 0;
+
+        int print_text(Common::FileHandle file, const char* text) override;
+
+      private:
+        /// An open file served from memory.
+        struct MemoryFile {
+            MemoryFileInfo info{};
+            std::size_t position{};
+        };
+
+        /// Opens a file from memory, returns \c nullptr if the file is not served from memory.
+        [[nodiscard]] Common::FileHandle open_memory_file(const char* filename, const char* options,
+                                                          const char* path_id);
+
+        /// Gets an open file served from memory by its handle, returns \c nullptr for other handles.
+        [[nodiscard]] MemoryFile* get_memory_file(Common::FileHandle file);
+
+        /// Guards the open files.
+        std::mutex mutex_{};
+
+        /// The open files served from memory, keyed by their handles.
+        std::unordered_map<Common::FileHandle, std::unique_ptr<MemoryFile>> memory_files_{};
+    };
+}
@@ -0,0 +1,166 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#pragma once
+
+#include "common/filesystem/filesystem_proxy.hpp"
+#include "common/platform.hpp"
+#include "model/metadata_index.hpp"
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace Core {
+    /**
+     * @brief A filesystem proxy that remembers the results of metadata queries across server restarts.
+     *
+     * The results of \c file_exists(), \c is_directory(), \c size() and \c get_filetime() are collected
+     * while the server runs and saved to a metadata index when it exits. On the next start the index
+     * is validated against the modification times of the directories it covers and, once the engine
+     * has set up the same search paths, answers the queries without touching the disk.
+     *
+     * Files written through the filesystem are never served from the index. Files edited in place by
+     * other programs are not detected by the index, as their directories keep the same modification time;
+     * the metadata collected at runtime expires after \c metadata_lifetime, so such changes are picked up
+     * with that delay.
+     */
+    class MetadataCacheFileSystem final : public Common::FileSystemProxy {
+      public:
+        /**
+         * @brief Constructs a new MetadataCacheFileSystem object and loads the metadata index.
+         *
+         * @param inner The filesystem interface to forward calls to.
+         * @param cache_file The path to the metadata index file.
+         */
+        MetadataCacheFileSystem(Common::FileSystemInterface* inner, std::string cache_file);
+
+        /// How long the metadata collected at runtime answers queries before it is queried again.
+        static constexpr std::chrono::seconds metadata_lifetime{5};
+
+        using FileSystemProxy::size;
+
+        FORCE_STACK_ALIGN void remove_all_search_paths() override;
+        FORCE_STACK_ALIGN void add_search_path(const char* path, const char* path_id) override;
+        FORCE_STACK_ALIGN bool remove_search_path(const char* path) override;
+        FORCE_STACK_ALIGN void remove_file(const char* relative_path, const char* path_id) override;
+        FORCE_STACK_ALIGN void create_dir_hierarchy(const char* path, const char* path_id) override;
+        FORCE_STACK_ALIGN bool file_exists(const char* filename) override;
+        FORCE_STACK_ALIGN bool is_directory(const char* filename) override;
+        FORCE_STACK_ALIGN Common::FileHandle open(const char* filename, const char* options,
+                                                  const char* path_id) override;
+        FORCE_STACK_ALIGN unsigned int size(const char* filename) override;
+        FORCE_STACK_ALIGN long get_filetime(const char* filename) override;
+        FORCE_STACK_ALIGN bool add_pack_file(const char* full_path, const char* path_id) override;
+        FORCE_STACK_ALIGN void add_search_path_no_write(const char* path, const char* path_id) override;
+
+        /**
+         * @brief Saves the collected metadata to the index file.
+         *
+         * @return \c true if the index file was written successfully, \c false otherwise.
+         */
+        bool save();
+
+      private:
+        /// A search path registered by the engine.
+        struct SearchRoot {
+            /// The path of the directory or pack file.
+            std::string path{};
+
+            /// Identifies the search path in the index, includes the kind of the search path and its ID.
+            std::string key{};
+        };
+
+        /// The metadata of a file collected at runtime.
+        struct Entry {
+            Model::FileMetadata metadata{};
+
+            /// When the metadata was collected, it expires \c metadata_lifetime later.
+            std::chrono::steady_clock::time_point collected_at{};
+        };
+
+        /// The metadata collected for a set of search paths.
+        struct Snapshot {
+            std::vector<SearchRoot> roots{};
+            std::unordered_map<std::string, Entry> entries{};
+        };
+
+        /// Converts a filename to the key of the metadata, returns \c false if the file cannot be cached.
+        [[nodiscard]] static bool make_key(const char* filename, std::string& key);
+
+        /**
+         * @brief Answers a metadata query from the collected metadata, or from the wrapped interface
+         * remembering the result.
+         */
+        template <typename Value, typename Query>
+        std::invoke_result_t<Query&, const char*> query_metadata(const char* filename,
+                                                                 bool Model::FileMetadata::*known,
+                                                                 Value Model::FileMetadata::*value, Query&& query);
+
+        /// Finds the unexpired metadata of a file, copying it from the index on the first access.
+        [[nodiscard]] const Model::FileMetadata* find_metadata(const std::string& key);
+
+        /// Forgets the metadata of a file that is about to change, along with its parent directories.
+        void invalidate(const char* filename);
+
+        /// Registers a search path and resets the collected metadata.
+        void add_root(const char* kind, const char* path, const char* path_id);
+
+        /// Called before the search paths change, keeps the largest set of collected metadata for saving.
+        void on_search_paths_changing();
+
+        /// Enables the index if it was built for the current search paths.
+        void update_index_state();
+
+        /// Guards the state below.
+        std::mutex mutex_{};
+
+        /// The path to the metadata index file.
+        std::string cache_file_;
+
+        /// The metadata index loaded at startup.
+        Model::MetadataIndex index_{};
+
+        /// The search roots the index was built for.
+        std::vector<std::string> index_roots_{};
+
+        /// Whether the index was found up to date at startup.
+        bool index_valid_{};
+
+        /// Whether the index matches the current search paths and answers queries.
+        bool index_active_{};
+
+        /// The current search paths.
+        std::vector<SearchRoot> roots_{};
+
+        /// The metadata collected for the current search paths.
+        std::unordered_map<std::string, Entry> entries_{};
+
+        /// The largest set of metadata collected for previous search paths.
+        std::optional<Snapshot> snapshot_{};
+
+        /// The files written during this run, never served from the index nor saved.
+        std::unordered_set<std::string> dirty_{};
+    };
+}
@@ -0,0 +1,85 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#pragma once
+
+#include "core/filesystem/memory_filesystem.hpp"
+#include "common/platform.hpp"
+#include "model/pack_file.hpp"
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Core {
+    /**
+     * @brief A filesystem proxy that serves the entries of the pack files registered via \c add_pack_file()
+     * from memory-mapped, hash-indexed packs.
+     *
+     * Packs are searched at the position they were registered at among the search paths, as the filesystem
+     * module does: a loose file in an earlier search path overrides a packed entry, in which case the file
+     * is passed to the wrapped interface.
+     */
+    class PackFileSystem final : public MemoryFileSystem {
+      public:
+        using MemoryFileSystem::MemoryFileSystem;
+
+        FORCE_STACK_ALIGN void remove_all_search_paths() override;
+        FORCE_STACK_ALIGN void add_search_path(const char* path, const char* path_id) override;
+        FORCE_STACK_ALIGN bool remove_search_path(const char* path) override;
+        FORCE_STACK_ALIGN bool add_pack_file(const char* full_path, const char* path_id) override;
+        FORCE_STACK_ALIGN void add_search_path_no_write(const char* path, const char* path_id) override;
+
+      protected:
+        [[nodiscard]] std::optional<MemoryFileInfo> find_memory_file(const char* filename,
+                                                                     const char* path_id) override;
+
+      private:
+        /// A search path, either a directory or a pack file.
+        struct SearchPath {
+            /// The directory path, empty for pack files.
+            std::string directory{};
+
+            /// The lowercase search path ID.
+            std::string path_id{};
+
+            /// The mounted pack, \c nullptr for directories and for packs that could not be memory-mapped.
+            std::shared_ptr<Model::PackFile> pack{};
+
+            /// Whether this search path is a pack file.
+            bool is_pack{};
+        };
+
+        /// Adds a directory to the end of the search paths.
+        void push_search_path(const char* path, const char* path_id);
+
+        /// Checks whether an earlier search path than \c end may provide the file instead of a mounted pack.
+        [[nodiscard]] bool is_overridden(const char* filename, std::size_t end, std::string_view path_id) const;
+
+        /// Guards the search paths.
+        std::mutex mutex_{};
+
+        /// The search paths, in the order they were registered.
+        std::vector<SearchPath> search_paths_{};
+    };
+}
@@ -0,0 +1,48 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#pragma once
+
+#include "common/filesystem/filesystem_proxy.hpp"
+#include "common/platform.hpp"
+#include "model/map_prefetcher.hpp"
+#include <memory>
+
+namespace Core {
+    /**
+     * @brief A filesystem proxy that notifies the map prefetcher when the engine starts loading a map.
+     */
+    class PrefetchFileSystem final : public Common::FileSystemProxy {
+      public:
+        /**
+         * @brief Constructs a new PrefetchFileSystem object.
+         *
+         * @param inner The filesystem interface to forward calls to.
+         * @param prefetcher The map prefetcher to notify.
+         */
+        PrefetchFileSystem(Common::FileSystemInterface* inner, std::shared_ptr<Model::MapPrefetcher> prefetcher);
+
+        FORCE_STACK_ALIGN void log_level_load_started(const char* name) override;
+
+      private:
+        /// The map prefetcher to notify.
+        std::shared_ptr<Model::MapPrefetcher> prefetcher_;
+    };
+}
@@ -0,0 +1,90 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#pragma once
+
+#include "common/filesystem/filesystem_proxy.hpp"
+#include "common/platform.hpp"
+#include "model/filesystem_profile.hpp"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace Core {
+    /**
+     * @brief A filesystem proxy that measures the calls made by the engine and records them in a profile.
+     */
+    class ProfilingFileSystem final : public Common::FileSystemProxy {
+      public:
+        /**
+         * @brief Constructs a new ProfilingFileSystem object.
+         *
+         * @param inner The filesystem interface to forward calls to.
+         * @param profile The profile to record the calls in.
+         */
+        ProfilingFileSystem(Common::FileSystemInterface* inner, std::shared_ptr<Model::FileSystemProfile> profile);
+
+        using FileSystemProxy::size;
+
+        FORCE_STACK_ALIGN bool file_exists(const char* filename) override;
+        FORCE_STACK_ALIGN bool is_directory(const char* filename) override;
+        FORCE_STACK_ALIGN Common::FileHandle open(const char* filename, const char* options,
+                                                  const char* path_id) override;
+        FORCE_STACK_ALIGN void close(Common::FileHandle file) override;
+        FORCE_STACK_ALIGN void seek(Common::FileHandle file, int position, Common::FileSystemSeek type) override;
+        FORCE_STACK_ALIGN unsigned int size(const char* filename) override;
+        FORCE_STACK_ALIGN long get_filetime(const char* filename) override;
+        FORCE_STACK_ALIGN int read(void* output, int size, Common::FileHandle file) override;
+        FORCE_STACK_ALIGN int write(const void* input, int size, Common::FileHandle file) override;
+        FORCE_STACK_ALIGN char* read_line(char* output, int max_chars, Common::FileHandle file) override;
+        FORCE_STACK_ALIGN void* get_read_buffer(Common::FileHandle file, int* out_buffer_size,
+                                                bool fail_if_not_in_cache) override;
+        FORCE_STACK_ALIGN void log_level_load_started(const char* name) override;
+        FORCE_STACK_ALIGN Common::FileHandle open_from_cache_for_read(const char* filename, const char* options,
+                                                                      const char* path_id) override;
+
+      private:
+        /// The path and the search path ID a file was opened with.
+        struct OpenFile {
+            std::string path{};
+            std::string path_id{};
+        };
+
+        /// Records a call made with a file name.
+        void record(const char* filename, const char* path_id, Model::FileOperation operation, std::uint64_t bytes,
+                    std::chrono::nanoseconds time, bool success);
+
+        /// Records a call made with a file handle.
+        void record(Common::FileHandle file, Model::FileOperation operation, std::uint64_t bytes,
+                    std::chrono::nanoseconds time, bool success);
+
+        /// The profile to record the calls in.
+        std::shared_ptr<Model::FileSystemProfile> profile_;
+
+        /// Guards the open files.
+        std::mutex mutex_{};
+
+        /// The files opened through this proxy, keyed by their handles.
+        std::unordered_map<Common::FileHandle, OpenFile> open_files_{};
+    };
+}
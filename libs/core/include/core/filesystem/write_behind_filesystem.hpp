@@ -0,0 +1,189 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#pragma once
+
+#include "common/filesystem/filesystem_proxy.hpp"
+#include "common/platform.hpp"
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace Core {
+    /**
+     * @brief A filesystem proxy that moves the writes of the files opened for writing to a background thread.
+     *
+     * The data passed to \c write() and \c print() is copied into a per-handle buffer and written through
+     * the wrapped interface by the writer thread, \c flush() is queued behind the buffered data.
+     * Opening and closing files stays on the calling thread, as the filesystem module tracks its open files
+     * without locking; a closed file is released once its data has been written.
+     *
+     * The calling thread only waits when it accesses a file with pending writes in any other way
+     * (reading, seeking, opening it again), or when too much data is pending.
+     */
+    class WriteBehindFileSystem final : public Common::FileSystemProxy {
+      public:
+        /**
+         * @brief Constructs a new WriteBehindFileSystem object and starts the writer thread.
+         *
+         * @param inner The filesystem interface to forward calls to.
+         */
+        explicit WriteBehindFileSystem(Common::FileSystemInterface* inner);
+
+        /**
+         * @brief Writes the pending data, releases the closed files and stops the writer thread.
+         */
+        ~WriteBehindFileSystem() override;
+
+        /// Move constructor.
+        WriteBehindFileSystem(WriteBehindFileSystem&&) = delete;
+
+        /// Copy constructor.
+        WriteBehindFileSystem(const WriteBehindFileSystem&) = delete;
+
+        /// Move assignment operator.
+        WriteBehindFileSystem& operator=(WriteBehindFileSystem&&) = delete;
+
+        /// Copy assignment operator.
+        WriteBehindFileSystem& operator=(const WriteBehindFileSystem&) = delete;
+
+        FORCE_STACK_ALIGN void unmount() override;
+        FORCE_STACK_ALIGN void remove_all_search_paths() override;
+        FORCE_STACK_ALIGN void remove_file(const char* relative_path, const char* path_id) override;
+        FORCE_STACK_ALIGN Common::FileHandle open(const char* filename, const char* options,
+                                                  const char* path_id) override;
+        FORCE_STACK_ALIGN void close(Common::FileHandle file) override;
+        FORCE_STACK_ALIGN void seek(Common::FileHandle file, int position, Common::FileSystemSeek type) override;
+        FORCE_STACK_ALIGN unsigned int tell(Common::FileHandle file) override;
+        FORCE_STACK_ALIGN unsigned int size(Common::FileHandle file) override;
+        FORCE_STACK_ALIGN unsigned int size(const char* filename) override;
+        FORCE_STACK_ALIGN long get_filetime(const char* filename) override;
+        FORCE_STACK_ALIGN bool is_ok(Common::FileHandle file) override;
+        FORCE_STACK_ALIGN void flush(Common::FileHandle file) override;
+        FORCE_STACK_ALIGN bool end_of_file(Common::FileHandle file) override;
+        FORCE_STACK_ALIGN int read(void* output, int size, Common::FileHandle file) override;
+        FORCE_STACK_ALIGN int write(const void* input, int size, Common::FileHandle file) override;
+        FORCE_STACK_ALIGN char* read_line(char* output, int max_chars, Common::FileHandle file) override;
+        FORCE_STACK_ALIGN int set_buffer(Common::FileHandle stream, char* buffer, int mode, long size) override;
+        FORCE_STACK_ALIGN Common::FileHandle open_from_cache_for_read(const char* filename, const char* options,
+                                                                      const char* path_id) override;
+
+        /**
+         * @brief Writes the pending data, releases the closed files and stops the writer thread.
+         *
+         * Files opened for writing afterwards are written synchronously.
+         */
+        void stop();
+
+      protected:
+        int print_text(Common::FileHandle file, const char* text) override;
+
+      private:
+        /// A file opened for writing.
+        struct PendingFile {
+            /// The normalized path the file was opened with.
+            std::string path{};
+
+            /// The data not yet taken by the writer thread.
+            std::string buffer{};
+
+            /// Whether a flush is requested after the buffered data.
+            bool flush_requested{};
+
+            /// Whether the engine closed the file.
+            bool closed{};
+
+            /// Whether the file is queued for the writer thread.
+            bool queued{};
+
+            /// Whether the writer thread is writing the file.
+            bool busy{};
+
+            /// Whether a write failed, reported by \c is_ok().
+            bool failed{};
+
+            /// Checks if the file has no pending work.
+            [[nodiscard]] bool is_idle() const noexcept
+            {
+                return buffer.empty() && !flush_requested && !queued && !busy;
+            }
+        };
+
+        /// The body of the writer thread.
+        void run();
+
+        /// Appends data to the buffer of a file, returns \c false if the file is not written in the background.
+        bool append(Common::FileHandle file, const char* data, std::size_t size);
+
+        /// Queues a file for the writer thread, the caller holds the lock.
+        void schedule(Common::FileHandle file, PendingFile& pending);
+
+        /// Waits until a file has no pending work or is released, the caller holds the lock.
+        void wait_idle(std::unique_lock<std::mutex>& lock, Common::FileHandle file);
+
+        /// Waits until a file has no pending work.
+        void drain(Common::FileHandle file);
+
+        /// Waits until the files opened with the specified path have no pending work.
+        void drain_path(const std::string& path);
+
+        /// Waits until the writer thread has written all queued data, then closes the released files.
+        void drain_all();
+
+        /// Closes the files released by the writer thread, on the calling thread.
+        void close_released_files();
+
+        /// Guards the state below.
+        std::mutex mutex_{};
+
+        /// Signals the writer thread about new work.
+        std::condition_variable work_condition_{};
+
+        /// Signals the waiting threads about completed work.
+        std::condition_variable done_condition_{};
+
+        /// The files opened for writing, keyed by their handles.
+        std::unordered_map<Common::FileHandle, std::unique_ptr<PendingFile>> files_{};
+
+        /// The files queued for the writer thread, in submission order.
+        std::deque<Common::FileHandle> queue_{};
+
+        /// The closed files whose data has been written, to be closed on the calling thread.
+        std::vector<Common::FileHandle> released_{};
+
+        /// The amount of buffered data over all files.
+        std::size_t pending_bytes_{};
+
+        /// Whether the writer thread is writing a file.
+        bool writing_{};
+
+        /// Whether the writer thread is stopped.
+        bool stopped_{};
+
+        /// The writer thread.
+        std::thread thread_{};
+    };
+}
@@ -21,16 +21,25 @@
 #pragma once
 
 #include "core/cmdline_args.hpp"
+#include "model/console_commands.hpp"
 #include "model/server_loop.hpp"
 #include "util/log_output.hpp"
 #include "view/console_view.hpp"
 #include <memory>
+#include <string_view>
 
 namespace Core {
+    void init_reactor(const CmdLineArgs& args);
     void init_logger(const CmdLineArgs& args, const std::shared_ptr<Util::LogOutput>& log_output);
+    void init_output_capture(const CmdLineArgs& args);
+    void init_status_line(const CmdLineArgs& args, const std::shared_ptr<View::ConsoleView>& console_view);
+    void init_game_events(const CmdLineArgs& args);
+    void extract_game_events(std::string_view text);
     void init_locale();
     void init_socket();
     void init_filesystem();
     void init_engine(const CmdLineArgs& args);
     void init_server_loop(const CmdLineArgs& args, const std::shared_ptr<Model::ServerLoop>& server_loop);
+    void init_control_socket(const CmdLineArgs& args, const std::shared_ptr<Model::ServerLoop>& server_loop,
+                             const std::shared_ptr<Model::ConsoleCommands>& console_commands);
 }
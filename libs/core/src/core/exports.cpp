@@ -21,6 +21,8 @@
 #include "common/hlds/interface/hlds_exports.hpp"
 #include "common/interface.hpp"
 #include "common/platform.hpp"
+#include "core/init.hpp"
+#include "model/console_commands.hpp"
 #include "util/logger.hpp"
 
 namespace {
@@ -32,6 +34,8 @@ namespace {
     void Exports::print(const char* const text)
     {
         if ((text != nullptr) && (*text != '\0')) {
+            Core::extract_game_events(text);
+            Model::ConsoleCommands::capture_print(text);
             Util::log_info(text);
         }
     }
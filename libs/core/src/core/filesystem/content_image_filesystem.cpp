@@ -0,0 +1,59 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#include "core/filesystem/content_image_filesystem.hpp"
+#include "util/logger.hpp"
+#include <utility>
+
+namespace Core {
+    ContentImageFileSystem::ContentImageFileSystem(Common::FileSystemInterface* const inner,
+                                                   const std::vector<std::string>& image_files)
+      : MemoryFileSystem(inner)
+    {
+        for (const auto& image_file : image_files) {
+            auto image = std::make_shared<Model::ContentImage>();
+
+            if (!image->open(image_file)) {
+                Util::log_error("Failed to mount content image '{}'.", image_file);
+                continue;
+            }
+
+            Util::log_info("Content image '{}' mounted with {} files.\n", image_file, image->get_entry_count());
+            images_.push_back(std::move(image));
+        }
+    }
+
+    std::optional<MemoryFileSystem::MemoryFileInfo> ContentImageFileSystem::find_memory_file(
+      const char* const filename, [[maybe_unused]] const char* const path_id)
+    {
+        if ((nullptr == filename) || ('\0' == *filename)) {
+            return std::nullopt;
+        }
+
+        // The images are immutable, the lookups need no locking
+        for (const auto& image : images_) {
+            if (const auto entry = image->find(filename); entry) {
+                return MemoryFileInfo{entry->data, entry->filetime, image};
+            }
+        }
+
+        return std::nullopt;
+    }
+}
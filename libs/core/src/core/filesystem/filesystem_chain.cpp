@@ -0,0 +1,77 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#include "core/filesystem/filesystem_chain.hpp"
+#include "common/filesystem/filesystem_wrapper.hpp"
+#include "util/string.hpp"
+#include <cassert>
+#include <vector>
+
+namespace {
+    // Implementation of the "Construct On First Use" idiom
+    [[nodiscard]] auto& get_proxies()
+    {
+        static const auto proxies = std::make_unique<std::vector<std::unique_ptr<Common::FileSystemProxy>>>();
+        return *proxies;
+    }
+}
+
+namespace Core {
+    Common::FileSystemInterface* get_filesystem_interface()
+    {
+        if (const auto& proxies = get_proxies(); !proxies.empty()) {
+            return proxies.back().get();
+        }
+
+        return Common::FileSystemWrapper::get_instance()
+          .get_interface_or_abort<Common::FileSystemModuleInterface::filesystem>();
+    }
+
+    void push_filesystem_proxy(std::unique_ptr<Common::FileSystemProxy> proxy)
+    {
+        assert(proxy != nullptr);
+        assert(proxy->get_inner() == get_filesystem_interface());
+
+        get_proxies().emplace_back(std::move(proxy));
+    }
+
+    Common::CommonInterface* create_filesystem_interface(const char* const name,
+                                                         Common::CreateInterfaceStatus* const status)
+    {
+        if ((name != nullptr) && Util::str::equal(name, Common::FileSystemInterface::INTERFACE_NAME)) {
+            if (status != nullptr) {
+                *status = Common::CreateInterfaceStatus::succeeded;
+            }
+
+            return get_filesystem_interface();
+        }
+
+        if (auto* const factory = Common::FileSystemWrapper::get_instance().get_interface_factory();
+            factory != nullptr) {
+            return factory(name, status);
+        }
+
+        if (status != nullptr) {
+            *status = Common::CreateInterfaceStatus::failed;
+        }
+
+        return nullptr;
+    }
+}
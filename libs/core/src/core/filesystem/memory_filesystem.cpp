@@ -0,0 +1,304 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#include "core/filesystem/memory_filesystem.hpp"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <string_view>
+
+namespace {
+    /// Checks if the options passed to open() allow to modify the file.
+    [[nodiscard]] bool is_write_mode(const char* const options) noexcept
+    {
+        return (options != nullptr) && (std::strpbrk(options, "wa+") != nullptr);
+    }
+
+    [[nodiscard]] unsigned int to_unsigned_size(const std::size_t size) noexcept
+    {
+        return static_cast<unsigned int>(std::min<std::size_t>(size, UINT_MAX));
+    }
+}
+
+namespace Core {
+    bool MemoryFileSystem::file_exists(const char* const filename)
+    {
+        return find_memory_file(filename, nullptr).has_value() || FileSystemProxy::file_exists(filename);
+    }
+
+    Common::FileHandle MemoryFileSystem::open(const char* const filename, const char* const options,
+                                              const char* const path_id)
+    {
+        if (auto* const file = open_memory_file(filename, options, path_id); file != nullptr) {
+            return file;
+        }
+
+        return FileSystemProxy::open(filename, options, path_id);
+    }
+
+    void MemoryFileSystem::close(const Common::FileHandle file)
+    {
+        {
+            const std::scoped_lock lock{mutex_};
+
+            if (memory_files_.erase(file) > 0) {
+                return;
+            }
+        }
+
+        FileSystemProxy::close(file);
+    }
+
+    void MemoryFileSystem::seek(const Common::FileHandle file, const int position, const Common::FileSystemSeek type)
+    {
+        auto* const memory_file = get_memory_file(file);
+
+        if (nullptr == memory_file) {
+            FileSystemProxy::seek(file, position, type);
+            return;
+        }
+
+        const auto size = static_cast<long long>(memory_file->info.data.size());
+        auto new_position = static_cast<long long>(position);
+
+        switch (type) {
+            case Common::FileSystemSeek::current: {
+                new_position += static_cast<long long>(memory_file->position);
+                break;
+            }
+            case Common::FileSystemSeek::tail: {
+                new_position += size;
+                break;
+            }
+            default: {
+                break;
+            }
+        }
+
+        memory_file->position = static_cast<std::size_t>(std::clamp(new_position, 0LL, size));
+    }
+
+    unsigned int MemoryFileSystem::tell(const Common::FileHandle file)
+    {
+        if (const auto* const memory_file = get_memory_file(file); memory_file != nullptr) {
+            return to_unsigned_size(memory_file->position);
+        }
+
+        return FileSystemProxy::tell(file);
+    }
+
+    unsigned int MemoryFileSystem::size(const Common::FileHandle file)
+    {
+        if (const auto* const memory_file = get_memory_file(file); memory_file != nullptr) {
+            return to_unsigned_size(memory_file->info.data.size());
+        }
+
+        return FileSystemProxy::size(file);
+    }
+
+    unsigned int MemoryFileSystem::size(const char* const filename)
+    {
+        if (const auto memory_file = find_memory_file(filename, nullptr); memory_file) {
+            return to_unsigned_size(memory_file->data.size());
+        }
+
+        return FileSystemProxy::size(filename);
+    }
+
+    long MemoryFileSystem::get_filetime(const char* const filename)
+    {
+        if (const auto memory_file = find_memory_file(filename, nullptr); memory_file) {
+            return memory_file->filetime;
+        }
+
+        return FileSystemProxy::get_filetime(filename);
+    }
+
+    bool MemoryFileSystem::is_ok(const Common::FileHandle file)
+    {
+        return (get_memory_file(file) != nullptr) || FileSystemProxy::is_ok(file);
+    }
+
+    void MemoryFileSystem::flush(const Common::FileHandle file)
+    {
+        if (nullptr == get_memory_file(file)) {
+            FileSystemProxy::flush(file);
+        }
+    }
+
+    bool MemoryFileSystem::end_of_file(const Common::FileHandle file)
+    {
+        if (const auto* const memory_file = get_memory_file(file); memory_file != nullptr) {
+            return memory_file->position >= memory_file->info.data.size();
+        }
+
+        return FileSystemProxy::end_of_file(file);
+    }
+
+    int MemoryFileSystem::read(void* const output, const int size, const Common::FileHandle file)
+    {
+        auto* const memory_file = get_memory_file(file);
+
+        if (nullptr == memory_file) {
+            return FileSystemProxy::read(output, size, file);
+        }
+
+        if ((nullptr == output) || (size <= 0)) {
+            return 0;
+        }
+
+        const auto& data = memory_file->info.data;
+        const auto count = std::min(static_cast<std::size_t>(size), data.size() - memory_file->position);
+
+        std::memcpy(output, data.data() + memory_file->position, count);
+        memory_file->position += count;
+
+        return static_cast<int>(count);
+    }
+
+    int MemoryFileSystem::write(const void* const input, const int size, const Common::FileHandle file)
+    {
+        // Files served from memory are read-only
+        if (get_memory_file(file) != nullptr) {
+            return 0;
+        }
+
+        return FileSystemProxy::write(input, size, file);
+    }
+
+    char* MemoryFileSystem::read_line(char* const output, const int max_chars, const Common::FileHandle file)
+    {
+        auto* const memory_file = get_memory_file(file);
+
+        if (nullptr == memory_file) {
+            return FileSystemProxy::read_line(output, max_chars, file);
+        }
+
+        const auto& data = memory_file->info.data;
+
+        // Same behavior as fgets: stops after a newline or when the output buffer is full
+        if ((nullptr == output) || (max_chars <= 0) || (memory_file->position >= data.size())) {
+            return nullptr;
+        }
+
+        const auto line = data.substr(memory_file->position, static_cast<std::size_t>(max_chars - 1));
+        const auto newline_pos = line.find('\n');
+        const auto count = std::string_view::npos == newline_pos ? line.size() : newline_pos + 1;
+
+        std::memcpy(output, line.data(), count);
+        output[count] = '\0';
+        memory_file->position += count;
+
+        return output;
+    }
+
+    void* MemoryFileSystem::get_read_buffer(const Common::FileHandle file, int* const out_buffer_size,
+                                            const bool fail_if_not_in_cache)
+    {
+        // The data is mapped read-only and cannot be handed out as a writable buffer,
+        // the caller falls back to regular reads, which are plain memory copies here
+        if (get_memory_file(file) != nullptr) {
+            if (out_buffer_size != nullptr) {
+                *out_buffer_size = 0;
+            }
+
+            return nullptr;
+        }
+
+        return FileSystemProxy::get_read_buffer(file, out_buffer_size, fail_if_not_in_cache);
+    }
+
+    void MemoryFileSystem::release_read_buffer(const Common::FileHandle file, void* const read_buffer)
+    {
+        if (nullptr == get_memory_file(file)) {
+            FileSystemProxy::release_read_buffer(file, read_buffer);
+        }
+    }
+
+    int MemoryFileSystem::set_buffer(const Common::FileHandle stream, char* const buffer, const int mode,
+                                     const long size)
+    {
+        if (get_memory_file(stream) != nullptr) {
+            return 0;
+        }
+
+        return FileSystemProxy::set_buffer(stream, buffer, mode, size);
+    }
+
+    bool MemoryFileSystem::is_file_immediately_available(const char* const filename)
+    {
+        return find_memory_file(filename, nullptr).has_value() ||
+               FileSystemProxy::is_file_immediately_available(filename);
+    }
+
+    Common::FileHandle MemoryFileSystem::open_from_cache_for_read(const char* const filename,
+                                                                  const char* const options,
+                                                                  const char* const path_id)
+    {
+        if (auto* const file = open_memory_file(filename, options, path_id); file != nullptr) {
+            return file;
+        }
+
+        return FileSystemProxy::open_from_cache_for_read(filename, options, path_id);
+    }
+
+    int MemoryFileSystem::print_text(const Common::FileHandle file, const char* const text)
+    {
+        if (get_memory_file(file) != nullptr) {
+            return -1;
+        }
+
+        return FileSystemProxy::print_text(file, text);
+    }
+
+    Common::FileHandle MemoryFileSystem::open_memory_file(const char* const filename, const char* const options,
+                                                          const char* const path_id)
+    {
+        if ((nullptr == filename) || ('\0' == *filename) || is_write_mode(options)) {
+            return nullptr;
+        }
+
+        auto info = find_memory_file(filename, path_id);
+
+        if (!info) {
+            return nullptr;
+        }
+
+        auto memory_file = std::make_unique<MemoryFile>();
+        memory_file->info = std::move(*info);
+        auto* const handle = static_cast<Common::FileHandle>(memory_file.get());
+
+        const std::scoped_lock lock{mutex_};
+        memory_files_.emplace(handle, std::move(memory_file));
+
+        return handle;
+    }
+
+    MemoryFileSystem::MemoryFile* MemoryFileSystem::get_memory_file(const Common::FileHandle file)
+    {
+        const std::scoped_lock lock{mutex_};
+
+        if (const auto it = memory_files_.find(file); it != memory_files_.end()) {
+            return it->second.get();
+        }
+
+        return nullptr;
+    }
+}
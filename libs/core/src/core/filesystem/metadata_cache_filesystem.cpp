@@ -0,0 +1,358 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#include "core/filesystem/metadata_cache_filesystem.hpp"
+#include "util/logger.hpp"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <set>
+#include <string_view>
+#include <utility>
+
+namespace {
+    /// Checks if an open mode allows writing.
+    [[nodiscard]] bool is_write_mode(const char* const options) noexcept
+    {
+        return (nullptr != options) && (nullptr != std::strpbrk(options, "wa+"));
+    }
+
+    /// Gets the directory part of a key, or an empty string for files in the root of a search path.
+    [[nodiscard]] std::string_view get_parent(const std::string_view key) noexcept
+    {
+        const auto pos = key.rfind('/');
+        return std::string_view::npos == pos ? std::string_view{} : key.substr(0, pos);
+    }
+}
+
+namespace Core {
+    MetadataCacheFileSystem::MetadataCacheFileSystem(Common::FileSystemInterface* const inner, std::string cache_file)
+      : FileSystemProxy(inner), cache_file_(std::move(cache_file))
+    {
+        // Created before any directory is stamped, creating it on save would change
+        // the modification time of its parent and invalidate the index right away
+        if (const auto parent = std::filesystem::path{cache_file_}.parent_path(); !parent.empty()) {
+            std::error_code error_code{};
+            std::filesystem::create_directories(parent, error_code);
+        }
+
+        if (!index_.load(cache_file_)) {
+            return;
+        }
+
+        if (!index_.is_up_to_date()) {
+            Util::log_debug("Metadata cache '{}' is out of date, it will be rebuilt.", cache_file_);
+            index_.unload();
+            return;
+        }
+
+        index_roots_ = index_.get_search_roots();
+        index_valid_ = true;
+
+        Util::log_debug("Metadata cache '{}' loaded with {} entries.", cache_file_, index_.get_entry_count());
+    }
+
+    template <typename Value, typename Query>
+    std::invoke_result_t<Query&, const char*> MetadataCacheFileSystem::query_metadata(
+      const char* const filename, bool Model::FileMetadata::*const known, Value Model::FileMetadata::*const value,
+      Query&& query)
+    {
+        using Result = std::invoke_result_t<Query&, const char*>;
+        std::string key{};
+
+        if (!make_key(filename, key)) {
+            return query(filename);
+        }
+
+        {
+            const std::scoped_lock lock{mutex_};
+
+            if (const auto* const metadata = find_metadata(key); (nullptr != metadata) && (metadata->*known)) {
+                return static_cast<Result>(metadata->*value);
+            }
+        }
+
+        const auto result = query(filename);
+        const std::scoped_lock lock{mutex_};
+
+        if (0 == dirty_.count(key)) {
+            const auto [it, inserted] = entries_.try_emplace(key);
+
+            if (inserted) {
+                it->second.collected_at = std::chrono::steady_clock::now();
+            }
+
+            auto& metadata = it->second.metadata;
+            metadata.*known = true;
+            metadata.*value = static_cast<Value>(result);
+        }
+
+        return result;
+    }
+
+    void MetadataCacheFileSystem::remove_all_search_paths()
+    {
+        {
+            const std::scoped_lock lock{mutex_};
+            on_search_paths_changing();
+            roots_.clear();
+            update_index_state();
+        }
+
+        FileSystemProxy::remove_all_search_paths();
+    }
+
+    void MetadataCacheFileSystem::add_search_path(const char* const path, const char* const path_id)
+    {
+        add_root("dir", path, path_id);
+        FileSystemProxy::add_search_path(path, path_id);
+    }
+
+    bool MetadataCacheFileSystem::remove_search_path(const char* const path)
+    {
+        {
+            const std::scoped_lock lock{mutex_};
+            on_search_paths_changing();
+
+            roots_.erase(std::remove_if(roots_.begin(), roots_.end(),
+                                        [path](const SearchRoot& root) {
+                                            return (nullptr != path) && (root.path == path);
+                                        }),
+                         roots_.end());
+
+            update_index_state();
+        }
+
+        return FileSystemProxy::remove_search_path(path);
+    }
+
+    void MetadataCacheFileSystem::remove_file(const char* const relative_path, const char* const path_id)
+    {
+        invalidate(relative_path);
+        FileSystemProxy::remove_file(relative_path, path_id);
+    }
+
+    void MetadataCacheFileSystem::create_dir_hierarchy(const char* const path, const char* const path_id)
+    {
+        invalidate(path);
+        FileSystemProxy::create_dir_hierarchy(path, path_id);
+    }
+
+    bool MetadataCacheFileSystem::file_exists(const char* const filename)
+    {
+        return query_metadata(filename, &Model::FileMetadata::exists_known, &Model::FileMetadata::exists,
+                              [this](const char* const name) {
+                                  return FileSystemProxy::file_exists(name);
+                              });
+    }
+
+    bool MetadataCacheFileSystem::is_directory(const char* const filename)
+    {
+        return query_metadata(filename, &Model::FileMetadata::is_directory_known, &Model::FileMetadata::is_directory,
+                              [this](const char* const name) {
+                                  return FileSystemProxy::is_directory(name);
+                              });
+    }
+
+    Common::FileHandle MetadataCacheFileSystem::open(const char* const filename, const char* const options,
+                                                     const char* const path_id)
+    {
+        if (is_write_mode(options)) {
+            invalidate(filename);
+        }
+
+        return FileSystemProxy::open(filename, options, path_id);
+    }
+
+    unsigned int MetadataCacheFileSystem::size(const char* const filename)
+    {
+        return query_metadata(filename, &Model::FileMetadata::size_known, &Model::FileMetadata::size,
+                              [this](const char* const name) {
+                                  return FileSystemProxy::size(name);
+                              });
+    }
+
+    long MetadataCacheFileSystem::get_filetime(const char* const filename)
+    {
+        return query_metadata(filename, &Model::FileMetadata::filetime_known, &Model::FileMetadata::filetime,
+                              [this](const char* const name) {
+                                  return FileSystemProxy::get_filetime(name);
+                              });
+    }
+
+    bool MetadataCacheFileSystem::add_pack_file(const char* const full_path, const char* const path_id)
+    {
+        add_root("pack", full_path, path_id);
+        return FileSystemProxy::add_pack_file(full_path, path_id);
+    }
+
+    void MetadataCacheFileSystem::add_search_path_no_write(const char* const path, const char* const path_id)
+    {
+        add_root("nowrite", path, path_id);
+        FileSystemProxy::add_search_path_no_write(path, path_id);
+    }
+
+    bool MetadataCacheFileSystem::save()
+    {
+        const std::scoped_lock lock{mutex_};
+        on_search_paths_changing();
+
+        if (!snapshot_) {
+            return false;
+        }
+
+        for (const auto& key : dirty_) {
+            snapshot_->entries.erase(key);
+        }
+
+        if (snapshot_->entries.empty()) {
+            return false;
+        }
+
+        std::vector<std::string> roots{};
+        std::set<std::string> directories{};
+        std::set<std::string_view> parents{};
+        std::unordered_map<std::string, Model::FileMetadata> entries{};
+
+        for (const auto& [key, entry] : snapshot_->entries) {
+            parents.insert(get_parent(key));
+            entries.emplace(key, entry.metadata);
+        }
+
+        // The search paths themselves are stamped too, this covers the pack files
+        for (const auto& root : snapshot_->roots) {
+            roots.push_back(root.key);
+            directories.insert(root.path);
+
+            for (const auto parent : parents) {
+                if (!parent.empty()) {
+                    directories.insert(root.path + '/' + std::string{parent});
+                }
+            }
+        }
+
+        // The index file is replaced by renaming, which fails on Windows while it is still mapped
+        index_.unload();
+        index_valid_ = false;
+        index_active_ = false;
+
+        const auto result = Model::MetadataIndex::save(cache_file_, roots, {directories.cbegin(), directories.cend()},
+                                                       entries);
+
+        if (result) {
+            Util::log_debug("Metadata cache '{}' saved with {} entries.", cache_file_, snapshot_->entries.size());
+        }
+
+        return result;
+    }
+
+    bool MetadataCacheFileSystem::make_key(const char* const filename, std::string& key)
+    {
+        if ((nullptr == filename) || ('\0' == *filename)) {
+            return false;
+        }
+
+        key.assign(filename);
+        std::replace(key.begin(), key.end(), '\\', '/');
+
+        // Absolute paths and paths leaving the search paths are not resolved against the search paths
+        const auto is_absolute = ('/' == key.front()) || (key.find(':') != std::string::npos);
+
+        return !is_absolute && (key.find("..") == std::string::npos);
+    }
+
+    const Model::FileMetadata* MetadataCacheFileSystem::find_metadata(const std::string& key)
+    {
+        if (dirty_.count(key) != 0) {
+            return nullptr;
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+
+        if (const auto it = entries_.find(key); it != entries_.end()) {
+            if (now - it->second.collected_at < metadata_lifetime) {
+                return &it->second.metadata;
+            }
+
+            // The expired entry is kept with nothing known, so that the index is not consulted for the file again
+            it->second = Entry{{}, now};
+            return nullptr;
+        }
+
+        if (!index_active_) {
+            return nullptr;
+        }
+
+        // Only the entries used during this run make it into the next index
+        if (auto metadata = index_.find(key); metadata) {
+            return &entries_.emplace(key, Entry{*metadata, now}).first->second.metadata;
+        }
+
+        return nullptr;
+    }
+
+    void MetadataCacheFileSystem::invalidate(const char* const filename)
+    {
+        std::string key{};
+
+        if (!make_key(filename, key)) {
+            return;
+        }
+
+        const std::scoped_lock lock{mutex_};
+
+        for (std::string_view path = key; !path.empty(); path = get_parent(path)) {
+            std::string parent{path};
+            entries_.erase(parent);
+            dirty_.insert(std::move(parent));
+        }
+    }
+
+    void MetadataCacheFileSystem::add_root(const char* const kind, const char* const path, const char* const path_id)
+    {
+        const std::scoped_lock lock{mutex_};
+        on_search_paths_changing();
+
+        const std::string root_path = nullptr == path ? "" : path;
+        const std::string root_path_id = nullptr == path_id ? "" : path_id;
+        roots_.push_back({root_path, std::string{kind} + ':' + root_path_id + ':' + root_path});
+
+        update_index_state();
+    }
+
+    void MetadataCacheFileSystem::on_search_paths_changing()
+    {
+        if (!snapshot_ || (entries_.size() >= snapshot_->entries.size())) {
+            snapshot_ = Snapshot{roots_, entries_};
+        }
+
+        entries_.clear();
+    }
+
+    void MetadataCacheFileSystem::update_index_state()
+    {
+        const auto matches = std::equal(roots_.cbegin(), roots_.cend(), index_roots_.cbegin(), index_roots_.cend(),
+                                        [](const SearchRoot& root, const std::string& index_root) {
+                                            return root.key == index_root;
+                                        });
+
+        index_active_ = index_valid_ && matches;
+    }
+}
@@ -0,0 +1,187 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#include "core/filesystem/pack_filesystem.hpp"
+#include "util/logger.hpp"
+#include "util/string.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+namespace {
+    /// Converts a search path to the form the search paths are compared in.
+    std::string normalize_directory(const char* const path)
+    {
+        std::string directory{nullptr == path ? "" : path};
+        std::replace(directory.begin(), directory.end(), '\\', '/');
+
+        while ((directory.size() > 1) && ('/' == directory.back())) {
+            directory.pop_back();
+        }
+
+        return directory;
+    }
+}
+
+namespace Core {
+    void PackFileSystem::remove_all_search_paths()
+    {
+        {
+            // Files that are still open keep their pack mapped
+            const std::scoped_lock lock{mutex_};
+            search_paths_.clear();
+        }
+
+        MemoryFileSystem::remove_all_search_paths();
+    }
+
+    void PackFileSystem::add_search_path(const char* const path, const char* const path_id)
+    {
+        push_search_path(path, path_id);
+        MemoryFileSystem::add_search_path(path, path_id);
+    }
+
+    bool PackFileSystem::remove_search_path(const char* const path)
+    {
+        {
+            const auto directory = normalize_directory(path);
+            const std::scoped_lock lock{mutex_};
+
+            search_paths_.erase(std::remove_if(search_paths_.begin(), search_paths_.end(),
+                                               [&directory](const SearchPath& search_path) {
+                                                   return !search_path.is_pack && (search_path.directory == directory);
+                                               }),
+                                search_paths_.end());
+        }
+
+        return MemoryFileSystem::remove_search_path(path);
+    }
+
+    bool PackFileSystem::add_pack_file(const char* const full_path, const char* const path_id)
+    {
+        // The wrapped interface still registers the pack, so that the calls that are not
+        // served from memory (e.g. find_first) see its entries as well
+        const auto result = MemoryFileSystem::add_pack_file(full_path, path_id);
+
+        if (!result || (nullptr == full_path) || ('\0' == *full_path)) {
+            return result;
+        }
+
+        // The filesystem module appends the pack to the search paths, so it is searched at this position
+        auto pack = std::make_shared<Model::PackFile>();
+
+        if (pack->open(full_path)) {
+            Util::log_debug("Pack file '{}' mapped with {} entries.", full_path, pack->get_entry_count());
+        }
+        else {
+            Util::log_debug("Pack file '{}' cannot be memory-mapped, it is served by the filesystem module.",
+                            full_path);
+            pack.reset();
+        }
+
+        const std::scoped_lock lock{mutex_};
+        search_paths_.push_back({{}, Util::str::to_lower(nullptr == path_id ? "" : path_id), std::move(pack), true});
+
+        return result;
+    }
+
+    void PackFileSystem::add_search_path_no_write(const char* const path, const char* const path_id)
+    {
+        push_search_path(path, path_id);
+        MemoryFileSystem::add_search_path_no_write(path, path_id);
+    }
+
+    std::optional<MemoryFileSystem::MemoryFileInfo> PackFileSystem::find_memory_file(const char* const filename,
+                                                                                      const char* const path_id)
+    {
+        if ((nullptr == filename) || ('\0' == *filename)) {
+            return std::nullopt;
+        }
+
+        // Path IDs are short enough to fit into the small string buffer
+        const auto& search_path_id = nullptr == path_id ? std::string{} : Util::str::to_lower(path_id);
+        const std::scoped_lock lock{mutex_};
+
+        for (std::size_t i = 0; i < search_paths_.size(); ++i) {
+            const auto& pack = search_paths_[i].pack;
+
+            if (!pack || (!search_path_id.empty() && !Util::str::equal(search_paths_[i].path_id, search_path_id))) {
+                continue;
+            }
+
+            if (const auto data = pack->find(filename); data) {
+                // The earlier search paths are only checked on a hit, so that the files
+                // that are not packed cost no extra lookups
+                if (is_overridden(filename, i, search_path_id)) {
+                    return std::nullopt;
+                }
+
+                return MemoryFileInfo{*data, pack->get_filetime(), pack};
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    void PackFileSystem::push_search_path(const char* const path, const char* const path_id)
+    {
+        if ((nullptr == path) || ('\0' == *path)) {
+            return;
+        }
+
+        const std::scoped_lock lock{mutex_};
+        search_paths_.push_back({normalize_directory(path), Util::str::to_lower(nullptr == path_id ? "" : path_id)});
+    }
+
+    bool PackFileSystem::is_overridden(const char* const filename, const std::size_t end,
+                                       const std::string_view path_id) const
+    {
+        std::string relative_path{filename};
+        std::replace(relative_path.begin(), relative_path.end(), '\\', '/');
+        std::error_code error_code{};
+
+        for (std::size_t i = 0; i < end; ++i) {
+            const auto& search_path = search_paths_[i];
+
+            if (!path_id.empty() && !Util::str::equal(search_path.path_id, path_id)) {
+                continue;
+            }
+
+            // A pack that is not memory-mapped may hold the file as well, only the filesystem module can tell
+            if (search_path.is_pack) {
+                if (!search_path.pack) {
+                    return true;
+                }
+
+                continue;
+            }
+
+            const auto loose_path = std::filesystem::path{search_path.directory} / relative_path;
+
+            if (std::filesystem::is_regular_file(loose_path, error_code)) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+}
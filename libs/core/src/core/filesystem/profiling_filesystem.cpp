@@ -0,0 +1,203 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#include "core/filesystem/profiling_filesystem.hpp"
+#include <string_view>
+#include <utility>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    /// The path recorded for calls made with a handle that was not opened through the proxy.
+    constexpr auto* UNKNOWN_FILE = "(unknown)";
+
+    [[nodiscard]] std::string_view to_string_view(const char* const str) noexcept
+    {
+        return nullptr == str ? std::string_view{} : std::string_view{str};
+    }
+
+    [[nodiscard]] std::chrono::nanoseconds elapsed_since(const Clock::time_point start_time) noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start_time);
+    }
+}
+
+namespace Core {
+    ProfilingFileSystem::ProfilingFileSystem(Common::FileSystemInterface* const inner,
+                                             std::shared_ptr<Model::FileSystemProfile> profile) :
+      FileSystemProxy(inner), profile_(std::move(profile))
+    {
+    }
+
+    bool ProfilingFileSystem::file_exists(const char* const filename)
+    {
+        const auto start_time = Clock::now();
+        const auto result = FileSystemProxy::file_exists(filename);
+        record(filename, nullptr, Model::FileOperation::query, 0, elapsed_since(start_time), result);
+
+        return result;
+    }
+
+    bool ProfilingFileSystem::is_directory(const char* const filename)
+    {
+        const auto start_time = Clock::now();
+        const auto result = FileSystemProxy::is_directory(filename);
+        record(filename, nullptr, Model::FileOperation::query, 0, elapsed_since(start_time), true);
+
+        return result;
+    }
+
+    Common::FileHandle ProfilingFileSystem::open(const char* const filename, const char* const options,
+                                                 const char* const path_id)
+    {
+        const auto start_time = Clock::now();
+        auto* const file = FileSystemProxy::open(filename, options, path_id);
+        record(filename, path_id, Model::FileOperation::open, 0, elapsed_since(start_time), file != nullptr);
+
+        if (file != nullptr) {
+            const std::scoped_lock lock{mutex_};
+            open_files_.insert_or_assign(file, OpenFile{std::string{to_string_view(filename)},
+                                                        std::string{to_string_view(path_id)}});
+        }
+
+        return file;
+    }
+
+    void ProfilingFileSystem::close(const Common::FileHandle file)
+    {
+        FileSystemProxy::close(file);
+
+        const std::scoped_lock lock{mutex_};
+        open_files_.erase(file);
+    }
+
+    void ProfilingFileSystem::seek(const Common::FileHandle file, const int position,
+                                   const Common::FileSystemSeek type)
+    {
+        const auto start_time = Clock::now();
+        FileSystemProxy::seek(file, position, type);
+        record(file, Model::FileOperation::seek, 0, elapsed_since(start_time), true);
+    }
+
+    unsigned int ProfilingFileSystem::size(const char* const filename)
+    {
+        const auto start_time = Clock::now();
+        const auto result = FileSystemProxy::size(filename);
+        record(filename, nullptr, Model::FileOperation::query, 0, elapsed_since(start_time), true);
+
+        return result;
+    }
+
+    long ProfilingFileSystem::get_filetime(const char* const filename)
+    {
+        const auto start_time = Clock::now();
+        const auto result = FileSystemProxy::get_filetime(filename);
+        record(filename, nullptr, Model::FileOperation::query, 0, elapsed_since(start_time), true);
+
+        return result;
+    }
+
+    int ProfilingFileSystem::read(void* const output, const int size, const Common::FileHandle file)
+    {
+        const auto start_time = Clock::now();
+        const auto result = FileSystemProxy::read(output, size, file);
+        const auto bytes = result > 0 ? static_cast<std::uint64_t>(result) : 0U;
+        record(file, Model::FileOperation::read, bytes, elapsed_since(start_time), result >= 0);
+
+        return result;
+    }
+
+    int ProfilingFileSystem::write(const void* const input, const int size, const Common::FileHandle file)
+    {
+        const auto start_time = Clock::now();
+        const auto result = FileSystemProxy::write(input, size, file);
+        const auto bytes = result > 0 ? static_cast<std::uint64_t>(result) : 0U;
+        record(file, Model::FileOperation::write, bytes, elapsed_since(start_time), result >= 0);
+
+        return result;
+    }
+
+    char* ProfilingFileSystem::read_line(char* const output, const int max_chars, const Common::FileHandle file)
+    {
+        const auto start_time = Clock::now();
+        auto* const result = FileSystemProxy::read_line(output, max_chars, file);
+        const auto bytes = nullptr == result ? 0U : static_cast<std::uint64_t>(std::char_traits<char>::length(result));
+        record(file, Model::FileOperation::read, bytes, elapsed_since(start_time), result != nullptr);
+
+        return result;
+    }
+
+    void* ProfilingFileSystem::get_read_buffer(const Common::FileHandle file, int* const out_buffer_size,
+                                               const bool fail_if_not_in_cache)
+    {
+        const auto start_time = Clock::now();
+        auto* const result = FileSystemProxy::get_read_buffer(file, out_buffer_size, fail_if_not_in_cache);
+        const auto bytes = (nullptr == result) || (nullptr == out_buffer_size) || (*out_buffer_size < 0)
+                             ? 0U
+                             : static_cast<std::uint64_t>(*out_buffer_size);
+        record(file, Model::FileOperation::read, bytes, elapsed_since(start_time), result != nullptr);
+
+        return result;
+    }
+
+    void ProfilingFileSystem::log_level_load_started(const char* const name)
+    {
+        profile_->begin_map(to_string_view(name));
+        FileSystemProxy::log_level_load_started(name);
+    }
+
+    Common::FileHandle ProfilingFileSystem::open_from_cache_for_read(const char* const filename,
+                                                                     const char* const options,
+                                                                     const char* const path_id)
+    {
+        const auto start_time = Clock::now();
+        auto* const file = FileSystemProxy::open_from_cache_for_read(filename, options, path_id);
+        record(filename, path_id, Model::FileOperation::open, 0, elapsed_since(start_time), file != nullptr);
+
+        if (file != nullptr) {
+            const std::scoped_lock lock{mutex_};
+            open_files_.insert_or_assign(file, OpenFile{std::string{to_string_view(filename)},
+                                                        std::string{to_string_view(path_id)}});
+        }
+
+        return file;
+    }
+
+    void ProfilingFileSystem::record(const char* const filename, const char* const path_id,
+                                     const Model::FileOperation operation, const std::uint64_t bytes,
+                                     const std::chrono::nanoseconds time, const bool success)
+    {
+        profile_->record(to_string_view(filename), to_string_view(path_id), operation, bytes, time, success);
+    }
+
+    void ProfilingFileSystem::record(const Common::FileHandle file, const Model::FileOperation operation,
+                                     const std::uint64_t bytes, const std::chrono::nanoseconds time,
+                                     const bool success)
+    {
+        const std::scoped_lock lock{mutex_};
+
+        if (const auto it = open_files_.find(file); it != open_files_.end()) {
+            profile_->record(it->second.path, it->second.path_id, operation, bytes, time, success);
+        }
+        else {
+            profile_->record(UNKNOWN_FILE, {}, operation, bytes, time, success);
+        }
+    }
+}
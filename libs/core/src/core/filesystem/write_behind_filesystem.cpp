@@ -0,0 +1,419 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#include "core/filesystem/write_behind_filesystem.hpp"
+#include "util/logger.hpp"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <utility>
+
+namespace {
+    /// The amount of buffered data over all files above which writing waits for the writer thread.
+    constexpr std::size_t MAX_PENDING_BYTES = 16 * 1024 * 1024;
+
+    /// Checks if an open mode only allows writing, files that are also read are left alone.
+    [[nodiscard]] bool is_write_only_mode(const char* const options) noexcept
+    {
+        return (nullptr != options) && (nullptr != std::strpbrk(options, "wa")) &&
+               (nullptr == std::strpbrk(options, "r+"));
+    }
+
+    /// Converts a file name to the key used to find the files with pending writes.
+    [[nodiscard]] std::string make_path_key(const char* const filename)
+    {
+        std::string key = nullptr == filename ? "" : filename;
+        std::replace(key.begin(), key.end(), '\\', '/');
+
+        return key;
+    }
+}
+
+namespace Core {
+    WriteBehindFileSystem::WriteBehindFileSystem(Common::FileSystemInterface* const inner)
+      : FileSystemProxy(inner), thread_(&WriteBehindFileSystem::run, this)
+    {
+    }
+
+    WriteBehindFileSystem::~WriteBehindFileSystem()
+    {
+        stop();
+    }
+
+    void WriteBehindFileSystem::unmount()
+    {
+        stop();
+        FileSystemProxy::unmount();
+    }
+
+    void WriteBehindFileSystem::remove_all_search_paths()
+    {
+        // The writer thread keeps running, the files opened afterwards are still written in the background
+        drain_all();
+        FileSystemProxy::remove_all_search_paths();
+    }
+
+    void WriteBehindFileSystem::remove_file(const char* const relative_path, const char* const path_id)
+    {
+        drain_path(make_path_key(relative_path));
+        close_released_files();
+        FileSystemProxy::remove_file(relative_path, path_id);
+    }
+
+    Common::FileHandle WriteBehindFileSystem::open(const char* const filename, const char* const options,
+                                                   const char* const path_id)
+    {
+        // A file with pending writes is completed before it is opened again, in any mode
+        auto path = make_path_key(filename);
+        drain_path(path);
+        close_released_files();
+
+        auto* const file = FileSystemProxy::open(filename, options, path_id);
+
+        if ((nullptr != file) && is_write_only_mode(options)) {
+            const std::scoped_lock lock{mutex_};
+
+            if (!stopped_) {
+                auto pending = std::make_unique<PendingFile>();
+                pending->path = std::move(path);
+                files_.insert_or_assign(file, std::move(pending));
+            }
+        }
+
+        return file;
+    }
+
+    void WriteBehindFileSystem::close(const Common::FileHandle file)
+    {
+        close_released_files();
+
+        {
+            const std::scoped_lock lock{mutex_};
+
+            if (const auto it = files_.find(file); it != files_.end()) {
+                // The writer thread releases the file once its data has been written
+                if (!it->second->is_idle()) {
+                    it->second->closed = true;
+                    return;
+                }
+
+                files_.erase(it);
+            }
+        }
+
+        FileSystemProxy::close(file);
+    }
+
+    void WriteBehindFileSystem::seek(const Common::FileHandle file, const int position,
+                                     const Common::FileSystemSeek type)
+    {
+        drain(file);
+        FileSystemProxy::seek(file, position, type);
+    }
+
+    unsigned int WriteBehindFileSystem::tell(const Common::FileHandle file)
+    {
+        drain(file);
+        return FileSystemProxy::tell(file);
+    }
+
+    unsigned int WriteBehindFileSystem::size(const Common::FileHandle file)
+    {
+        drain(file);
+        return FileSystemProxy::size(file);
+    }
+
+    unsigned int WriteBehindFileSystem::size(const char* const filename)
+    {
+        drain_path(make_path_key(filename));
+        return FileSystemProxy::size(filename);
+    }
+
+    long WriteBehindFileSystem::get_filetime(const char* const filename)
+    {
+        drain_path(make_path_key(filename));
+        return FileSystemProxy::get_filetime(filename);
+    }
+
+    bool WriteBehindFileSystem::is_ok(const Common::FileHandle file)
+    {
+        {
+            const std::scoped_lock lock{mutex_};
+
+            if (const auto it = files_.find(file); it != files_.end()) {
+                return !it->second->failed;
+            }
+        }
+
+        return FileSystemProxy::is_ok(file);
+    }
+
+    void WriteBehindFileSystem::flush(const Common::FileHandle file)
+    {
+        {
+            const std::scoped_lock lock{mutex_};
+
+            if (const auto it = files_.find(file); (it != files_.end()) && !stopped_) {
+                it->second->flush_requested = true;
+                schedule(file, *it->second);
+                return;
+            }
+        }
+
+        FileSystemProxy::flush(file);
+    }
+
+    bool WriteBehindFileSystem::end_of_file(const Common::FileHandle file)
+    {
+        drain(file);
+        return FileSystemProxy::end_of_file(file);
+    }
+
+    int WriteBehindFileSystem::read(void* const output, const int size, const Common::FileHandle file)
+    {
+        drain(file);
+        return FileSystemProxy::read(output, size, file);
+    }
+
+    int WriteBehindFileSystem::write(const void* const input, const int size, const Common::FileHandle file)
+    {
+        if ((nullptr != input) && (size > 0) &&
+            append(file, static_cast<const char*>(input), static_cast<std::size_t>(size))) {
+            return size;
+        }
+
+        return FileSystemProxy::write(input, size, file);
+    }
+
+    char* WriteBehindFileSystem::read_line(char* const output, const int max_chars, const Common::FileHandle file)
+    {
+        drain(file);
+        return FileSystemProxy::read_line(output, max_chars, file);
+    }
+
+    int WriteBehindFileSystem::set_buffer(const Common::FileHandle stream, char* const buffer, const int mode,
+                                          const long size)
+    {
+        drain(stream);
+        return FileSystemProxy::set_buffer(stream, buffer, mode, size);
+    }
+
+    Common::FileHandle WriteBehindFileSystem::open_from_cache_for_read(const char* const filename,
+                                                                       const char* const options,
+                                                                       const char* const path_id)
+    {
+        drain_path(make_path_key(filename));
+        close_released_files();
+
+        return FileSystemProxy::open_from_cache_for_read(filename, options, path_id);
+    }
+
+    void WriteBehindFileSystem::stop()
+    {
+        {
+            std::unique_lock lock{mutex_};
+
+            if (stopped_) {
+                return;
+            }
+
+            done_condition_.wait(lock, [this] {
+                return queue_.empty() && !writing_;
+            });
+
+            stopped_ = true;
+        }
+
+        work_condition_.notify_one();
+
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+
+        close_released_files();
+    }
+
+    int WriteBehindFileSystem::print_text(const Common::FileHandle file, const char* const text)
+    {
+        const auto length = std::strlen(text);
+
+        if ((length > 0) && (length <= INT_MAX) && append(file, text, length)) {
+            return static_cast<int>(length);
+        }
+
+        return FileSystemProxy::print_text(file, text);
+    }
+
+    void WriteBehindFileSystem::run()
+    {
+        std::unique_lock lock{mutex_};
+
+        while (true) {
+            work_condition_.wait(lock, [this] {
+                return stopped_ || !queue_.empty();
+            });
+
+            if (queue_.empty()) {
+                break;
+            }
+
+            const auto file = queue_.front();
+            queue_.pop_front();
+
+            auto& pending = *files_.at(file);
+            const auto data = std::exchange(pending.buffer, std::string{});
+            const auto flush_requested = std::exchange(pending.flush_requested, false);
+            pending.queued = false;
+            pending.busy = true;
+            pending_bytes_ -= data.size();
+            writing_ = true;
+            lock.unlock();
+
+            auto success = true;
+
+            for (std::size_t offset = 0; offset < data.size();) {
+                const auto chunk = static_cast<int>(std::min<std::size_t>(data.size() - offset, INT_MAX));
+                const auto written = FileSystemProxy::write(data.data() + offset, chunk, file);
+
+                if (written <= 0) {
+                    success = false;
+                    break;
+                }
+
+                offset += static_cast<std::size_t>(written);
+            }
+
+            if (flush_requested) {
+                FileSystemProxy::flush(file);
+            }
+
+            lock.lock();
+            writing_ = false;
+            pending.busy = false;
+
+            if (!success && !pending.failed) {
+                pending.failed = true;
+                Util::log_error("Failed to write file '{}'.", pending.path);
+            }
+
+            if (!pending.buffer.empty() || pending.flush_requested) {
+                schedule(file, pending);
+            }
+            else if (pending.closed) {
+                released_.push_back(file);
+                files_.erase(file);
+            }
+
+            done_condition_.notify_all();
+        }
+    }
+
+    bool WriteBehindFileSystem::append(const Common::FileHandle file, const char* const data, const std::size_t size)
+    {
+        std::unique_lock lock{mutex_};
+
+        if (stopped_ || (files_.count(file) == 0)) {
+            return false;
+        }
+
+        // Bounds the memory held by the buffers when the disk cannot keep up
+        if ((pending_bytes_ > 0) && (pending_bytes_ + size > MAX_PENDING_BYTES)) {
+            done_condition_.wait(lock, [this, size] {
+                return (0 == pending_bytes_) || (pending_bytes_ + size <= MAX_PENDING_BYTES);
+            });
+        }
+
+        auto& pending = *files_.at(file);
+        pending.buffer.append(data, size);
+        pending_bytes_ += size;
+        schedule(file, pending);
+
+        return true;
+    }
+
+    void WriteBehindFileSystem::schedule(const Common::FileHandle file, PendingFile& pending)
+    {
+        // A busy file is scheduled again by the writer thread when it is done
+        if (pending.queued || pending.busy) {
+            return;
+        }
+
+        pending.queued = true;
+        queue_.push_back(file);
+        work_condition_.notify_one();
+    }
+
+    void WriteBehindFileSystem::wait_idle(std::unique_lock<std::mutex>& lock, const Common::FileHandle file)
+    {
+        done_condition_.wait(lock, [this, file] {
+            const auto it = files_.find(file);
+            return (it == files_.end()) || it->second->is_idle();
+        });
+    }
+
+    void WriteBehindFileSystem::drain(const Common::FileHandle file)
+    {
+        std::unique_lock lock{mutex_};
+        wait_idle(lock, file);
+    }
+
+    void WriteBehindFileSystem::drain_path(const std::string& path)
+    {
+        std::unique_lock lock{mutex_};
+        std::vector<Common::FileHandle> files{};
+
+        for (const auto& [file, pending] : files_) {
+            if (pending->path == path) {
+                files.push_back(file);
+            }
+        }
+
+        for (const auto file : files) {
+            wait_idle(lock, file);
+        }
+    }
+
+    void WriteBehindFileSystem::drain_all()
+    {
+        {
+            std::unique_lock lock{mutex_};
+
+            done_condition_.wait(lock, [this] {
+                return queue_.empty() && !writing_;
+            });
+        }
+
+        close_released_files();
+    }
+
+    void WriteBehindFileSystem::close_released_files()
+    {
+        std::vector<Common::FileHandle> released{};
+
+        {
+            const std::scoped_lock lock{mutex_};
+            released.swap(released_);
+        }
+
+        for (const auto file : released) {
+            FileSystemProxy::close(file);
+        }
+    }
+}
@@ -21,31 +21,384 @@
 #include "core/init.hpp"
 #include "common/engine/engine_wrapper.hpp"
 #include "common/filesystem/filesystem_wrapper.hpp"
+#include "core/filesystem/content_image_filesystem.hpp"
+#include "core/filesystem/filesystem_chain.hpp"
+#include "core/filesystem/metadata_cache_filesystem.hpp"
+#include "core/filesystem/pack_filesystem.hpp"
+#include "core/filesystem/prefetch_filesystem.hpp"
+#include "core/filesystem/profiling_filesystem.hpp"
+#include "core/filesystem/write_behind_filesystem.hpp"
+#include "model/filesystem_profile.hpp"
+#include "model/game_events.hpp"
+#include "model/map_prefetcher.hpp"
+#include "util/file.hpp"
 #include "util/lifecycle.hpp"
 #include "util/logger.hpp"
+#include "util/string.hpp"
 #include <algorithm>
+#include <chrono>
 #include <clocale>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 #ifdef _WIN32
   #define WIN32_LEAN_AND_MEAN
   #include <Windows.h>
   #include <WinSock2.h>
+#else
+  #include "model/linux/control_socket.hpp"
+  #include "util/linux/log_tail.hpp"
+  #include "util/linux/output_capture.hpp"
+  #include "util/linux/reactor.hpp"
+#endif
+
+namespace {
+    /// The map prefetcher, shared by the filesystem proxy and the server loop listener.
+    std::shared_ptr<Model::MapPrefetcher> map_prefetcher{};
+
+    /// The filesystem profile, recorded by the profiling proxy and reported by the console command.
+    std::shared_ptr<Model::FileSystemProfile> filesystem_profile{};
+
+    /// The game event extractor fed with the engine output, set once at startup.
+    std::unique_ptr<Model::GameEventExtractor> game_events{};
+
+#ifndef _WIN32
+    /// The control socket serving console commands, set once the server loop is created.
+    std::unique_ptr<Model::ControlSocket> control_socket{};
 #endif
 
+    [[nodiscard]] std::string get_game_dir(const Core::CmdLineArgs& args)
+    {
+        const auto game_dir = args.get_argument_option("-game").value_or(std::string{});
+        return game_dir.empty() ? "valve" : game_dir;
+    }
+
+    /**
+     * @brief Finds the map cycle file: the \c +mapcyclefile argument,
+     * then the \c mapcyclefile cvar set in \c server.cfg and finally the engine default.
+     */
+    [[nodiscard]] std::string get_mapcycle_file(const Core::CmdLineArgs& args, const std::string& game_dir)
+    {
+        if (auto mapcycle_file = args.get_argument_option("+mapcyclefile"); mapcycle_file && !mapcycle_file->empty()) {
+            return Util::str::trim(*mapcycle_file, "\"");
+        }
+
+        const auto server_cfg = game_dir + "/server.cfg";
+
+        if (std::string content{}; Util::file_read(server_cfg, content) == Util::FileReadErrorCode::success) {
+            for (const auto& line : Util::str::split_lines(content)) {
+                const auto tokens = Util::str::split(line);
+
+                if ((tokens.size() >= 2) && Util::str::equal(Util::str::to_lower(tokens[0]), "mapcyclefile")) {
+                    return Util::str::trim(tokens[1], "\"");
+                }
+            }
+        }
+
+        return "mapcycle.txt";
+    }
+
+    /// Gets the content images listed by the \c -contentimage argument, separated by commas, in priority order.
+    [[nodiscard]] std::vector<std::string> get_content_images(const Core::CmdLineArgs& args)
+    {
+        const auto option = args.get_argument_option("-contentimage").value_or(std::string{});
+        std::vector<std::string> image_files{};
+
+        for (std::string_view images = option; !images.empty();) {
+            const auto pos = images.find(',');
+            const auto image_file = Util::str::trim(images.substr(0, pos), "\" ");
+
+            if (!image_file.empty()) {
+                image_files.push_back(image_file);
+            }
+
+            images = std::string_view::npos == pos ? std::string_view{} : images.substr(pos + 1);
+        }
+
+        return image_files;
+    }
+
+    /**
+     * @brief Gets the settings for asynchronous logging from the command line.
+     */
+    Util::LogAsyncSettings get_log_async_settings(const Core::CmdLineArgs& args)
+    {
+        Util::LogAsyncSettings settings{};
+        settings.enabled = args.contains("-asynclog");
+
+        if (const auto queue_size = args.get_argument_option_as<int>("-logqueuesize").value_or(0); queue_size > 0) {
+            settings.queue_size = static_cast<std::size_t>(queue_size);
+        }
+
+        if (const auto policy = Util::str::to_lower(args.get_argument_option("-logoverflow").value_or(""));
+            Util::str::equal(policy, "drop")) {
+            settings.overflow_policy = Util::LogOverflowPolicy::drop;
+        }
+        else if (Util::str::equal(policy, "drop_oldest")) {
+            settings.overflow_policy = Util::LogOverflowPolicy::drop_oldest;
+        }
+
+        return settings;
+    }
+
+    /**
+     * @brief Gets the settings for the rotation of the log file from the command line.
+     */
+    Util::LogRotationSettings get_log_rotation_settings(const Core::CmdLineArgs& args)
+    {
+        constexpr std::uint64_t bytes_per_megabyte = 1024 * 1024;
+        Util::LogRotationSettings settings{};
+
+        if (const auto max_size = args.get_argument_option_as<int>("-logmaxsize").value_or(0); max_size > 0) {
+            settings.max_size = static_cast<std::uint64_t>(max_size) * bytes_per_megabyte;
+        }
+
+        if (const auto max_age = args.get_argument_option_as<int>("-logmaxage").value_or(0); max_age > 0) {
+            settings.interval = std::chrono::hours{max_age};
+        }
+
+        if (const auto max_files = args.get_argument_option_as<int>("-logkeep"); max_files.has_value()) {
+            settings.max_files = static_cast<std::size_t>(std::max(*max_files, 0));
+        }
+
+        settings.compress = !args.contains("-nologcompress");
+
+        return settings;
+    }
+
+    /**
+     * @brief Gets the settings for the rate limiting of repetitive log messages from the command line.
+     */
+    Util::LogRateLimitSettings get_log_rate_limit_settings(const Core::CmdLineArgs& args)
+    {
+        Util::LogRateLimitSettings settings{};
+        settings.enabled = args.contains("-logratelimit") || args.contains("-logburst");
+
+        if (const auto rate = args.get_argument_option_as<int>("-logratelimit").value_or(0); rate > 0) {
+            settings.rate = static_cast<double>(rate);
+        }
+
+        if (const auto burst = args.get_argument_option_as<int>("-logburst").value_or(0); burst > 0) {
+            settings.burst = static_cast<std::size_t>(burst);
+        }
+
+        return settings;
+    }
+
+    void install_filesystem_proxies(const Core::CmdLineArgs& args)
+    {
+        // Installed first, the other proxies pass their writes down to it
+        if (args.contains("-fswritebehind")) {
+            auto& write_behind = Core::install_filesystem_proxy<Core::WriteBehindFileSystem>();
+
+            Util::at_exit([&write_behind] {
+                write_behind.stop();
+            });
+        }
+
+        if (args.contains("-mapprefetch")) {
+            const auto game_dir = get_game_dir(args);
+            map_prefetcher = std::make_shared<Model::MapPrefetcher>(game_dir, get_mapcycle_file(args, game_dir));
+            Core::install_filesystem_proxy<Core::PrefetchFileSystem>(map_prefetcher);
+
+            Util::at_exit([] {
+                map_prefetcher->stop();
+            });
+        }
+
+        if (args.contains("-packmmap")) {
+            Core::install_filesystem_proxy<Core::PackFileSystem>();
+        }
+
+        // Kept outside of the game directories, saving the cache must not invalidate it
+        if (args.contains("-fsmetacache")) {
+            auto& metadata_cache = Core::install_filesystem_proxy<Core::MetadataCacheFileSystem>(
+              "fscache/" + get_game_dir(args) + ".bin");
+
+            Util::at_exit([&metadata_cache] {
+                metadata_cache.save();
+            });
+        }
+
+        // Mounted above the metadata cache, the images answer their queries before the loose files are checked
+        if (const auto image_files = get_content_images(args); !image_files.empty()) {
+            Core::install_filesystem_proxy<Core::ContentImageFileSystem>(image_files);
+        }
+
+        // Installed last to measure the engine calls through all other proxies
+        if (args.contains("-fsprofile")) {
+            filesystem_profile = std::make_shared<Model::FileSystemProfile>();
+            Core::install_filesystem_proxy<Core::ProfilingFileSystem>(filesystem_profile);
+        }
+    }
+
+    /**
+     * @brief Handles the \c fs_profile console command.
+     *
+     * Usage: <tt>fs_profile [top [count] | dump [filename] [count] | reset]</tt>
+     */
+    void fs_profile_command(const std::vector<std::string>& args)
+    {
+        constexpr std::size_t default_top_count = 20;
+        constexpr auto* default_dump_filename = "fs_profile.txt";
+
+        const auto& action = args.size() > 1 ? Util::str::to_lower(args[1]) : std::string{"top"};
+        const auto get_count = [&args](const std::size_t index) {
+            return args.size() > index ? Util::str::convert_to_type<std::size_t>(args[index]).value_or(0) : 0;
+        };
+
+        if (Util::str::equal(action, "top")) {
+            const auto count = get_count(2);
+
+            for (const auto& line : filesystem_profile->report(count > 0 ? count : default_top_count)) {
+                Util::log_info("{}\n", line);
+            }
+        }
+        else if (Util::str::equal(action, "dump")) {
+            const auto& filename = args.size() > 2 ? args[2] : std::string{default_dump_filename};
+            const auto count = get_count(3);
+
+            if (filesystem_profile->dump(filename, count > 0 ? count : default_top_count)) {
+                Util::log_info("File system profile written to '{}'.\n", filename);
+            }
+        }
+        else if (Util::str::equal(action, "reset")) {
+            filesystem_profile->reset();
+            Util::log_info("File system profile reset.\n");
+        }
+        else {
+            Util::log_info("Usage: fs_profile [top [count] | dump [filename] [count] | reset]\n");
+        }
+    }
+}
+
 namespace Core {
+    void init_reactor([[maybe_unused]] const CmdLineArgs& args)
+    {
+#ifndef _WIN32
+        const auto cpu = args.get_argument_option_as<int>("-helpercpu").value_or(-1);
+
+        // Registered first to run last, the helpers started afterwards are hosted on the reactor
+        if (Util::get_reactor().start(cpu)) {
+            Util::at_exit([] {
+                Util::get_reactor().stop();
+            });
+        }
+#endif
+    }
+
     void init_logger(const CmdLineArgs& args, const std::shared_ptr<Util::LogOutput>& log_output)
     {
         constexpr auto* logfile = "qconsole.log";
-        const auto enable_condebug = args.contains("-condebug");
+        constexpr auto* binary_logfile = "qconsole.hlbl";
+
+        Util::LogSettings settings{};
+        settings.log_output = log_output;
+        settings.async = get_log_async_settings(args);
+        settings.rotation = get_log_rotation_settings(args);
+        settings.rate_limit = get_log_rate_limit_settings(args);
 
+#ifndef _WIN32
+        const auto tail_socket = args.get_argument_option("-logtail");
+
+        if (tail_socket) {
+            constexpr std::size_t default_ring_size = 4096;
+            const auto ring_size = args.get_argument_option_as<int>("-logringsize").value_or(0);
+            settings.ring_size = ring_size > 0 ? static_cast<std::size_t>(ring_size) : default_ring_size;
+        }
+#endif
+
+        if (args.contains("-condebug")) {
 #ifdef _WIN32
-        Util::log_init(enable_condebug, logfile, log_output);
+            settings.logfile = logfile;
 #else
-        const auto game_name = args.get_argument_option("-game").value_or(std::string{});
-        Util::log_init(enable_condebug, game_name.empty() ? logfile : (game_name + "/" + logfile), log_output);
+            const auto game_name = args.get_argument_option("-game").value_or(std::string{});
+            settings.logfile = game_name.empty() ? logfile : (game_name + "/" + logfile);
+#endif
+            settings.output = Util::LogDestination::view_and_file;
+
+            if (args.contains("-binlog")) {
+                const auto& directory = std::filesystem::path{settings.logfile}.parent_path();
+                settings.binary_logfile = (directory / binary_logfile).string();
+            }
+        }
+
+        Util::log_init(settings);
+
+        // Registered first to run last, the other exit callbacks may still log
+        if (settings.async.enabled || settings.rate_limit.enabled || !settings.binary_logfile.empty()) {
+            Util::at_exit(&Util::log_shutdown);
+        }
+
+#ifndef _WIN32
+        if (tail_socket && Util::start_log_tail(*tail_socket)) {
+            Util::at_exit(&Util::stop_log_tail);
+        }
+#endif
+    }
+
+    void init_output_capture([[maybe_unused]] const CmdLineArgs& args)
+    {
+#ifndef _WIN32
+        if (args.contains("-nooutputcapture")) {
+            return;
+        }
+
+        // The captured output is kept out of the binary log, its records are written by the logger only
+        const auto& settings = Util::log_settings();
+        const auto to_file = (settings.output & Util::LogDestination::file) == Util::LogDestination::file &&
+                             settings.binary_logfile.empty();
+
+        if (Util::start_output_capture(to_file ? settings.logfile : std::string{})) {
+            Util::at_exit(&Util::stop_output_capture);
+        }
+#endif
+    }
+
+    void init_status_line([[maybe_unused]] const CmdLineArgs& args,
+                          [[maybe_unused]] const std::shared_ptr<View::ConsoleView>& console_view)
+    {
+#ifndef _WIN32
+        if (args.contains("-nostatusline") || !console_view->start_status_line()) {
+            return;
+        }
+
+        // Gives the top row back before the output capture is stopped
+        Util::at_exit([console_view] {
+            console_view->stop_status_line();
+        });
 #endif
     }
 
+    void init_game_events(const CmdLineArgs& args)
+    {
+        const auto destination = args.get_argument_option("-gameevents");
+
+        if (!destination) {
+            return;
+        }
+
+        const auto types = args.get_argument_option("-gameeventtypes");
+        auto extractor = std::make_unique<Model::GameEventExtractor>(
+          types ? Model::parse_game_event_types(*types) : static_cast<unsigned>(Model::GameEventType::all));
+
+        if (extractor->open(*destination)) {
+            game_events = std::move(extractor);
+        }
+    }
+
+    void extract_game_events(const std::string_view text)
+    {
+        if (game_events) {
+            game_events->feed(text);
+        }
+    }
+
     void init_locale()
     {
 #ifdef _WIN32
@@ -99,10 +452,12 @@ namespace Core {
         engine.load_or_abort();
 
         auto& serverapi_interface = *engine.get_interface_or_abort<Common::EngineInterface::server_api>();
-        auto* const fs_interface_factory = Common::FileSystemWrapper::get_instance().get_interface_factory();
         const auto* const cmdline_args_string = args.get_current();
 
-        if (!serverapi_interface.init(".", cmdline_args_string, ::CreateInterface, fs_interface_factory)) {
+        // The engine receives the filesystem through the proxy chain
+        install_filesystem_proxies(args);
+
+        if (!serverapi_interface.init(".", cmdline_args_string, ::CreateInterface, create_filesystem_interface)) {
             Util::log_critical("Failed to initialize HLDS engine.");
             std::abort();
         }
@@ -123,5 +478,40 @@ namespace Core {
 
             server_loop->set_pingboost_level(static_cast<Model::PingBoostLevel>(pingboost_value));
         }
+
+        if (map_prefetcher != nullptr) {
+            server_loop->append_listener([server_loop = server_loop.get()](const Model::ServerLoopEvent event) {
+                if (Model::ServerLoopEvent::status_updated == event) {
+                    map_prefetcher->on_map_changed(server_loop->get_status().current_map);
+                }
+            });
+        }
+
+        if (filesystem_profile != nullptr) {
+            server_loop->register_command("fs_profile", &fs_profile_command);
+        }
+    }
+
+    void init_control_socket([[maybe_unused]] const CmdLineArgs& args,
+                             [[maybe_unused]] const std::shared_ptr<Model::ServerLoop>& server_loop,
+                             [[maybe_unused]] const std::shared_ptr<Model::ConsoleCommands>& console_commands)
+    {
+#ifndef _WIN32
+        const auto socket_path = args.get_argument_option("-controlsocket");
+
+        if (!socket_path) {
+            return;
+        }
+
+        auto socket = std::make_unique<Model::ControlSocket>(server_loop, console_commands);
+
+        if (socket->start(*socket_path)) {
+            control_socket = std::move(socket);
+
+            Util::at_exit([] {
+                control_socket.reset();
+            });
+        }
+#endif
     }
 }
@@ -0,0 +1,290 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#include "core/filesystem/write_behind_filesystem.hpp"
+#include "common/filesystem/filesystem_proxy.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    /// An in-memory filesystem whose writes can be held back to keep data pending in the proxy.
+    class FakeFileSystem final : public Common::FileSystemProxy {
+      public:
+        FakeFileSystem() : FileSystemProxy(nullptr)
+        {
+        }
+
+        using FileSystemProxy::size;
+
+        Common::FileHandle open(const char* const filename, const char* const options, const char*) override
+        {
+            const std::scoped_lock lock{mutex_};
+            auto& file = files_.emplace_back(std::make_unique<OpenFile>());
+            file->path = filename;
+            std::replace(file->path.begin(), file->path.end(), '\\', '/');
+
+            if (nullptr != std::strchr(options, 'w')) {
+                contents_[file->path].clear();
+            }
+
+            return file.get();
+        }
+
+        void close(const Common::FileHandle) override
+        {
+            const std::scoped_lock lock{mutex_};
+            ++close_count_;
+        }
+
+        void seek(const Common::FileHandle file, const int position, const Common::FileSystemSeek type) override
+        {
+            const std::scoped_lock lock{mutex_};
+            auto& open_file = *static_cast<OpenFile*>(file);
+            const auto offset = static_cast<std::ptrdiff_t>(position);
+
+            switch (type) {
+                case Common::FileSystemSeek::head:
+                    open_file.position = static_cast<std::size_t>(offset);
+                    break;
+                case Common::FileSystemSeek::current:
+                    open_file.position = static_cast<std::size_t>(static_cast<std::ptrdiff_t>(open_file.position) +
+                                                                  offset);
+                    break;
+                case Common::FileSystemSeek::tail:
+                    open_file.position = static_cast<std::size_t>(
+                      static_cast<std::ptrdiff_t>(contents_[open_file.path].size()) + offset);
+                    break;
+            }
+        }
+
+        unsigned int tell(const Common::FileHandle file) override
+        {
+            const std::scoped_lock lock{mutex_};
+            return static_cast<unsigned int>(static_cast<OpenFile*>(file)->position);
+        }
+
+        unsigned int size(const char* const filename) override
+        {
+            const std::scoped_lock lock{mutex_};
+            return static_cast<unsigned int>(contents_[filename].size());
+        }
+
+        void flush(const Common::FileHandle) override
+        {
+        }
+
+        int read(void* const output, const int size, const Common::FileHandle file) override
+        {
+            const std::scoped_lock lock{mutex_};
+            auto& open_file = *static_cast<OpenFile*>(file);
+            const auto& content = contents_[open_file.path];
+            const auto count = std::min(static_cast<std::size_t>(size),
+                                        content.size() - std::min(open_file.position, content.size()));
+
+            content.copy(static_cast<char*>(output), count, open_file.position);
+            open_file.position += count;
+
+            return static_cast<int>(count);
+        }
+
+        int write(const void* const input, const int size, const Common::FileHandle file) override
+        {
+            std::unique_lock lock{mutex_};
+
+            writes_condition_.wait(lock, [this] {
+                return !writes_held_;
+            });
+
+            auto& open_file = *static_cast<OpenFile*>(file);
+            auto& content = contents_[open_file.path];
+            const auto count = static_cast<std::size_t>(size);
+
+            content.resize(std::max(content.size(), open_file.position + count));
+            content.replace(open_file.position, count, static_cast<const char*>(input), count);
+            open_file.position += count;
+
+            return size;
+        }
+
+        void unmount() override
+        {
+        }
+
+        /// Makes the writes wait until they are released.
+        void hold_writes()
+        {
+            const std::scoped_lock lock{mutex_};
+            writes_held_ = true;
+        }
+
+        /// Lets the held writes complete.
+        void release_writes()
+        {
+            {
+                const std::scoped_lock lock{mutex_};
+                writes_held_ = false;
+            }
+
+            writes_condition_.notify_all();
+        }
+
+        /// Releases the held writes after a delay, on another thread.
+        [[nodiscard]] std::future<void> release_writes_later()
+        {
+            return std::async(std::launch::async, [this] {
+                std::this_thread::sleep_for(std::chrono::milliseconds{50});
+                release_writes();
+            });
+        }
+
+        [[nodiscard]] std::string get_content(const std::string& path)
+        {
+            const std::scoped_lock lock{mutex_};
+            return contents_[path];
+        }
+
+        [[nodiscard]] int get_close_count()
+        {
+            const std::scoped_lock lock{mutex_};
+            return close_count_;
+        }
+
+      private:
+        struct OpenFile {
+            std::string path{};
+            std::size_t position{};
+        };
+
+        std::mutex mutex_{};
+        std::condition_variable writes_condition_{};
+        std::vector<std::unique_ptr<OpenFile>> files_{};
+        std::map<std::string, std::string> contents_{};
+        int close_count_{};
+        bool writes_held_{};
+    };
+
+    class WriteBehindFileSystemTest : public ::testing::Test {
+      protected:
+        void TearDown() override
+        {
+            inner.release_writes();
+        }
+
+        FakeFileSystem inner{};
+        Core::WriteBehindFileSystem file_system{&inner};
+    };
+
+    TEST_F(WriteBehindFileSystemTest, ReopenReadsWrittenData)
+    {
+        inner.hold_writes();
+        auto* const writer = file_system.open("logs/L0101.log", "wb", "GAME");
+        ASSERT_EQ(file_system.write("hello", 5, writer), 5);
+        file_system.close(writer);
+
+        // The file is opened again with another spelling of its path while the data is still pending
+        auto release = inner.release_writes_later();
+        auto* const reader = file_system.open("logs\\L0101.log", "rb", "GAME");
+        std::array<char, 16> buffer{};
+        const auto bytes_read = file_system.read(buffer.data(), static_cast<int>(buffer.size()), reader);
+
+        ASSERT_EQ(std::string(buffer.data(), static_cast<std::size_t>(bytes_read)), "hello");
+        ASSERT_EQ(file_system.size("logs/L0101.log"), 5U);
+        release.get();
+    }
+
+    TEST_F(WriteBehindFileSystemTest, SeekAfterWriteKeepsOrder)
+    {
+        inner.hold_writes();
+        auto* const file = file_system.open("scores.txt", "w", "GAME");
+        ASSERT_EQ(file_system.write("abc", 3, file), 3);
+
+        auto release = inner.release_writes_later();
+        ASSERT_EQ(file_system.tell(file), 3U);
+        release.get();
+
+        file_system.seek(file, 0, Common::FileSystemSeek::head);
+        ASSERT_EQ(file_system.write("X", 1, file), 1);
+        ASSERT_EQ(file_system.tell(file), 1U);
+        file_system.close(file);
+        file_system.unmount();
+
+        ASSERT_EQ(inner.get_content("scores.txt"), "Xbc");
+    }
+
+    TEST_F(WriteBehindFileSystemTest, UnmountCompletesPendingWrites)
+    {
+        inner.hold_writes();
+        auto* const file = file_system.open("banned.cfg", "w", "GAME");
+        file_system.print(file, const_cast<char*>("banid %d %s\n"), 0, "STEAM_0:1:1");
+        file_system.close(file);
+        ASSERT_EQ(inner.get_close_count(), 0);
+
+        auto release = inner.release_writes_later();
+        file_system.unmount();
+        release.get();
+
+        ASSERT_EQ(inner.get_content("banned.cfg"), "banid 0 STEAM_0:1:1\n");
+        ASSERT_EQ(inner.get_close_count(), 1);
+
+        // Files opened after unmounting are written synchronously
+        auto* const synchronous = file_system.open("listip.cfg", "w", "GAME");
+        ASSERT_EQ(file_system.write("x", 1, synchronous), 1);
+        ASSERT_EQ(inner.get_content("listip.cfg"), "x");
+    }
+
+    TEST_F(WriteBehindFileSystemTest, WriteWaitsWhenTooMuchIsPending)
+    {
+        constexpr std::size_t pending_limit = 16 * 1024 * 1024;
+        const std::string data(pending_limit, 'a');
+
+        // The first buffer is taken by the writer thread, which blocks in the inner write
+        inner.hold_writes();
+        auto* const file = file_system.open("large.dat", "wb", "GAME");
+        ASSERT_EQ(file_system.write(data.data(), static_cast<int>(data.size()), file), static_cast<int>(data.size()));
+        ASSERT_EQ(file_system.write(data.data(), static_cast<int>(data.size()), file), static_cast<int>(data.size()));
+
+        auto blocked_write = std::async(std::launch::async, [this, file] {
+            return file_system.write("b", 1, file);
+        });
+
+        ASSERT_EQ(blocked_write.wait_for(std::chrono::milliseconds{100}), std::future_status::timeout);
+        inner.release_writes();
+        ASSERT_EQ(blocked_write.get(), 1);
+
+        file_system.close(file);
+        file_system.unmount();
+
+        const auto content = inner.get_content("large.dat");
+        ASSERT_EQ(content.size(), (2 * pending_limit) + 1);
+        ASSERT_EQ(content.back(), 'b');
+    }
+}
@@ -0,0 +1,190 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#include "model/metadata_index.hpp"
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    /// The number of directories of the synthetic game tree.
+    constexpr int DIRECTORY_COUNT = 32;
+
+    /// The number of files in each directory of the synthetic game tree.
+    constexpr int FILES_PER_DIRECTORY = 64;
+
+    /**
+     * @brief A synthetic game tree with a mod directory on top of the base game directory.
+     *
+     * Half of the looked up paths exist in the base directory only, a quarter are found in the mod directory
+     * and the rest do not exist at all, which roughly matches what a server start looks like.
+     */
+    class GameTree final {
+      public:
+        GameTree()
+        {
+            for (const auto& root : roots_) {
+                for (int dir = 0; dir < DIRECTORY_COUNT; ++dir) {
+                    std::filesystem::create_directories(base_dir_ / root / get_directory(dir));
+                    directories_.push_back((base_dir_ / root / get_directory(dir)).string());
+                }
+
+                directories_.push_back((base_dir_ / root).string());
+            }
+
+            for (int dir = 0; dir < DIRECTORY_COUNT; ++dir) {
+                for (int file = 0; file < FILES_PER_DIRECTORY; ++file) {
+                    const auto path = get_directory(dir) + "/file" + std::to_string(file) + ".dat";
+                    const auto root = (file % 4 == 0) ? roots_[0] : roots_[1];
+
+                    if (file % 4 != 3) {
+                        std::ofstream{base_dir_ / root / path} << path;
+                    }
+
+                    paths_.push_back(path);
+                }
+            }
+        }
+
+        ~GameTree()
+        {
+            std::error_code error_code{};
+            std::filesystem::remove_all(base_dir_, error_code);
+        }
+
+        /// Move constructor.
+        GameTree(GameTree&&) = delete;
+
+        /// Copy constructor.
+        GameTree(const GameTree&) = delete;
+
+        /// Move assignment operator.
+        GameTree& operator=(GameTree&&) = delete;
+
+        /// Copy assignment operator.
+        GameTree& operator=(const GameTree&) = delete;
+
+        /// Resolves the metadata of a path by probing every search root, like the filesystem module does.
+        [[nodiscard]] Model::FileMetadata resolve(const std::string& path) const
+        {
+            Model::FileMetadata metadata{};
+            metadata.exists_known = true;
+            metadata.size_known = true;
+            metadata.filetime_known = true;
+
+            for (const auto& root : roots_) {
+                std::error_code error_code{};
+                const auto full_path = base_dir_ / root / path;
+                const auto size = std::filesystem::file_size(full_path, error_code);
+
+                if (!error_code) {
+                    const auto filetime = std::filesystem::last_write_time(full_path, error_code);
+                    metadata.exists = true;
+                    metadata.size = static_cast<std::uint32_t>(size);
+                    metadata.filetime = static_cast<std::int64_t>(filetime.time_since_epoch().count());
+                    break;
+                }
+            }
+
+            return metadata;
+        }
+
+        [[nodiscard]] const std::vector<std::string>& get_paths() const noexcept
+        {
+            return paths_;
+        }
+
+        [[nodiscard]] const std::vector<std::string>& get_directories() const noexcept
+        {
+            return directories_;
+        }
+
+        [[nodiscard]] std::vector<std::string> get_roots() const
+        {
+            return {roots_.cbegin(), roots_.cend()};
+        }
+
+        [[nodiscard]] std::string get_index_file() const
+        {
+            return (base_dir_ / "metadata.bin").string();
+        }
+
+      private:
+        [[nodiscard]] static std::string get_directory(const int dir)
+        {
+            return "dir" + std::to_string(dir);
+        }
+
+        std::filesystem::path base_dir_{std::filesystem::temp_directory_path() / "benchmark_metadata_index"};
+        std::vector<std::string> roots_{"cstrike", "valve"};
+        std::vector<std::string> paths_{};
+        std::vector<std::string> directories_{};
+    };
+
+    /// Resolves every path of the game tree directly against the filesystem.
+    void BM_StartupWithoutCache(benchmark::State& state)
+    {
+        const GameTree tree{};
+
+        for ([[maybe_unused]] auto _ : state) {
+            for (const auto& path : tree.get_paths()) {
+                benchmark::DoNotOptimize(tree.resolve(path));
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(tree.get_paths().size()));
+    }
+
+    /// Loads and validates the cache, then resolves every path of the game tree from it.
+    void BM_StartupWithCache(benchmark::State& state)
+    {
+        const GameTree tree{};
+        std::unordered_map<std::string, Model::FileMetadata> entries{};
+
+        for (const auto& path : tree.get_paths()) {
+            entries.emplace(path, tree.resolve(path));
+        }
+
+        Model::MetadataIndex::save(tree.get_index_file(), tree.get_roots(), tree.get_directories(), entries);
+
+        for ([[maybe_unused]] auto _ : state) {
+            Model::MetadataIndex index{};
+
+            if (!index.load(tree.get_index_file()) || !index.is_up_to_date()) {
+                state.SkipWithError("The metadata cache is not valid");
+                break;
+            }
+
+            for (const auto& path : tree.get_paths()) {
+                benchmark::DoNotOptimize(index.find(path));
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(tree.get_paths().size()));
+    }
+}
+
+BENCHMARK(BM_StartupWithoutCache)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StartupWithCache)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,106 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Model {
+    /**
+     * @brief A sorted index of the command and cvar names for tab completion.
+     *
+     * The names are kept in a sorted array that is replaced as a whole, so lookups take no locks and
+     * run in logarithmic time. The index is updated one prefix at a time, and it tracks for each first
+     * character when its names were last refreshed, so the owner can refresh only the part in use.
+     */
+    class CommandIndex final {
+      public:
+        /**
+         * @brief The clock used to track the refreshes.
+         */
+        using Clock = std::chrono::steady_clock;
+
+        /**
+         * @brief Constructs a new CommandIndex object.
+         *
+         * @param refresh_interval The age after which the names starting with a character are refreshed.
+         */
+        explicit CommandIndex(std::chrono::milliseconds refresh_interval = std::chrono::seconds{5}) noexcept;
+
+        /**
+         * @brief Replaces the names that start with the prefix.
+         *
+         * @param prefix The prefix of the replaced names, an empty prefix replaces all the names.
+         * @param names The new names starting with the prefix, in lowercase.
+         */
+        void update(std::string_view prefix, std::vector<std::string> names);
+
+        /**
+         * @brief Finds the names that start with the prefix.
+         *
+         * @param prefix The prefix, compared case-insensitively.
+         *
+         * @return The sorted matching names.
+         */
+        [[nodiscard]] std::vector<std::string> find_matches(std::string_view prefix) const;
+
+        /**
+         * @brief Checks if the index has been built.
+         *
+         * @return \c true if the names have been set at least once, \c false otherwise.
+         */
+        [[nodiscard]] bool is_built() const noexcept;
+
+        /**
+         * @brief Checks if the names starting with the first character of the prefix should be refreshed,
+         * and marks them as being refreshed if so.
+         *
+         * @param prefix The prefix being completed.
+         * @param now The current time.
+         *
+         * @return \c true if the caller should refresh the names, \c false if they are recent enough.
+         */
+        [[nodiscard]] bool take_refresh(std::string_view prefix, Clock::time_point now = Clock::now());
+
+      private:
+        /// The sorted names.
+        using Names = std::vector<std::string>;
+
+        /// The age after which the names starting with a character are refreshed.
+        const std::chrono::milliseconds refresh_interval_;
+
+        /// The current names, replaced as a whole.
+        std::shared_ptr<const Names> names_{};
+
+        /// Serializes the updates and guards the refresh times.
+        std::mutex mutex_{};
+
+        /// The time of the last refresh of the names, by their first character.
+        std::array<Clock::time_point, 256> refresh_times_{};
+    };
+}
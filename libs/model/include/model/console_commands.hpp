@@ -20,7 +20,10 @@
 
 #pragma once
 
+#include "model/command_index.hpp"
+#include <cstddef>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace Common {
@@ -37,6 +40,23 @@ namespace Model {
          */
         explicit ConsoleCommands(Common::SystemInterface* system_interface);
 
+        /// Move constructor.
+        ConsoleCommands(ConsoleCommands&&) = delete;
+
+        /// Copy constructor.
+        ConsoleCommands(const ConsoleCommands&) = delete;
+
+        /// Move assignment operator.
+        ConsoleCommands& operator=(ConsoleCommands&&) = delete;
+
+        /// Copy assignment operator.
+        ConsoleCommands& operator=(const ConsoleCommands&) = delete;
+
+        /**
+         * @brief Default destructor.
+         */
+        ~ConsoleCommands() = default;
+
         /**
          * @brief Searches for command matches for the given command.
          *
@@ -48,8 +68,64 @@ namespace Model {
          */
         [[nodiscard]] std::vector<std::string> find_command_matches(const std::string& command) const noexcept;
 
+        /**
+         * @brief Queries the engine for the names starting with the prefix and updates the index with them.
+         *
+         * Must be called on the server thread.
+         *
+         * @param prefix The prefix of the names to refresh, an empty prefix refreshes all of them.
+         */
+        void refresh_index(std::string_view prefix);
+
+        /**
+         * @brief Gets the index of the command and cvar names, safe to use from any thread.
+         *
+         * @return The index.
+         */
+        [[nodiscard]] CommandIndex& get_index() noexcept
+        {
+            return index_;
+        }
+
+        /**
+         * @brief Executes a command and returns the console output it produced.
+         *
+         * The output printed through the system interface is collected with its redirect buffer, the text
+         * the engine prints to the console is collected through \c capture_print while the command runs.
+         * Both are appended to the same output in the order they were printed.
+         * Must be called on the server thread.
+         *
+         * @param command The command to execute.
+         *
+         * @return The console output of the command, truncated to \c MAX_OUTPUT_SIZE bytes.
+         */
+        [[nodiscard]] std::string execute(std::string_view command);
+
+        /**
+         * @brief Adds engine console text to the output of the command being executed, if any.
+         *
+         * Called for all the text the engine prints, does nothing outside of \c execute
+         *
+         * @param text The printed text.
+         */
+        static void capture_print(std::string_view text);
+
+        /**
+         * @brief The maximum size of the output of a command in bytes.
+         */
+        static constexpr std::size_t MAX_OUTPUT_SIZE = 64 * 1024;
+
       private:
+        /// Queries the engine for the names starting with the prefix.
+        [[nodiscard]] std::vector<std::string> query_matches(const std::string& prefix) const noexcept;
+
         /// The system interface.
         Common::SystemInterface* system_interface_;
+
+        /// The index of the command and cvar names.
+        CommandIndex index_{};
+
+        /// The buffer the system interface redirects its output to while a command runs.
+        std::vector<char> redirect_buffer_{};
     };
 }
@@ -0,0 +1,155 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#pragma once
+
+#include "util/mapped_file.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace Model {
+    /**
+     * @brief A file stored in a content image.
+     */
+    struct ContentImageEntry {
+        /// The content of the file.
+        std::string_view data{};
+
+        /// The modification time of the source file as a Unix timestamp.
+        long filetime{};
+    };
+
+    /**
+     * @brief A memory-mapped content image: a read-only tree of game files baked into a single file.
+     *
+     * The image starts with a directory of the files and an open-addressing hash table over their paths,
+     * followed by the aligned file contents. Mounting an image takes one open and one mapping,
+     * looking up and reading files does not involve any system calls.
+     */
+    class ContentImage final {
+      public:
+        /**
+         * @brief Maps a content image into memory and checks its header.
+         *
+         * @param path The path to the image file.
+         *
+         * @return \c true if the image was opened successfully, \c false otherwise.
+         */
+        bool open(const std::string& path);
+
+        /**
+         * @brief Finds a file by its path.
+         *
+         * The lookup is case-insensitive and treats back slashes as forward slashes.
+         *
+         * @param path The game relative path of the file.
+         *
+         * @return The file, or an empty optional if the image does not contain the file.
+         */
+        [[nodiscard]] std::optional<ContentImageEntry> find(std::string_view path) const;
+
+        /**
+         * @brief Gets the number of files in the image.
+         *
+         * @return The number of files in the image.
+         */
+        [[nodiscard]] std::size_t get_entry_count() const noexcept;
+
+      private:
+        /// The mapped image file.
+        Util::MappedFile file_{};
+
+        /// The number of files.
+        std::uint32_t entry_count_{};
+
+        /// The number of hash table slots, a power of two.
+        std::uint32_t slot_count_{};
+
+        /// The offsets of the sections within the mapped file.
+        std::size_t slots_offset_{};
+        std::size_t strings_offset_{};
+
+        /// The size of the string table.
+        std::size_t strings_size_{};
+    };
+
+    /**
+     * @brief Builds content images from directory trees.
+     */
+    class ContentImageBuilder final {
+      public:
+        /// The default alignment of the file contents within the image.
+        static constexpr std::uint32_t DEFAULT_ALIGNMENT = 64;
+
+        /**
+         * @brief Adds the files of a directory tree.
+         *
+         * When several trees contain the same path, the file of the tree added first is kept,
+         * like with the search paths of the filesystem.
+         *
+         * @param root The root directory of the tree.
+         *
+         * @return \c true if the tree was scanned successfully, \c false otherwise.
+         */
+        bool add_directory(const std::string& root);
+
+        /**
+         * @brief Gets the number of files added so far.
+         *
+         * @return The number of files added so far.
+         */
+        [[nodiscard]] std::size_t get_file_count() const noexcept;
+
+        /**
+         * @brief Writes the content image.
+         *
+         * @param path The path to the image file.
+         * @param alignment The alignment of the file contents, a power of two.
+         *
+         * @return \c true if the image was written successfully, \c false otherwise.
+         */
+        [[nodiscard]] bool write(const std::string& path, std::uint32_t alignment = DEFAULT_ALIGNMENT) const;
+
+      private:
+        /// A file to store in the image.
+        struct SourceFile {
+            std::string path{};
+            std::uint64_t size{};
+            long filetime{};
+        };
+
+        /// The files to store, keyed by their normalized paths so that the image layout is reproducible.
+        std::map<std::string, SourceFile> files_{};
+    };
+
+    inline std::size_t ContentImage::get_entry_count() const noexcept
+    {
+        return entry_count_;
+    }
+
+    inline std::size_t ContentImageBuilder::get_file_count() const noexcept
+    {
+        return files_.size();
+    }
+}
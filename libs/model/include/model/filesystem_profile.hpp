@@ -0,0 +1,180 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Model {
+    /**
+     * @brief The kind of filesystem operation being recorded.
+     */
+    enum class FileOperation {
+        open,  ///< A file was opened.
+        read,  ///< Data was read from a file.
+        write, ///< Data was written to a file.
+        seek,  ///< The position in a file was changed.
+        query  ///< A file was looked up without being opened (existence, size, time).
+    };
+
+    /**
+     * @brief Counters and latencies accumulated for a file or a search path ID.
+     */
+    struct FileIoStats {
+        /// The total number of calls.
+        std::uint64_t calls{};
+
+        /// The number of successful opens.
+        std::uint64_t opens{};
+
+        /// The number of failed opens and lookups.
+        std::uint64_t misses{};
+
+        /// The number of reads.
+        std::uint64_t reads{};
+
+        /// The number of writes.
+        std::uint64_t writes{};
+
+        /// The number of seeks.
+        std::uint64_t seeks{};
+
+        /// The number of bytes read.
+        std::uint64_t bytes_read{};
+
+        /// The number of bytes written.
+        std::uint64_t bytes_written{};
+
+        /// The total time spent in the calls.
+        std::chrono::nanoseconds total_time{};
+
+        /// The longest single call.
+        std::chrono::nanoseconds max_time{};
+
+        /**
+         * @brief Accounts a single call.
+         *
+         * @param operation The kind of operation.
+         * @param bytes The number of bytes transferred.
+         * @param time The time the call took.
+         * @param success Whether the call succeeded.
+         */
+        void add(FileOperation operation, std::uint64_t bytes, std::chrono::nanoseconds time, bool success) noexcept;
+    };
+
+    /**
+     * @brief The filesystem activity recorded during a single map.
+     */
+    struct MapIoProfile {
+        /// The name of the map, or \c "(startup)" for the activity before the first map.
+        std::string map_name{};
+
+        /// The statistics of each file, keyed by the lowercase path with forward slashes.
+        std::unordered_map<std::string, FileIoStats> paths{};
+
+        /// The statistics of each search path ID.
+        std::unordered_map<std::string, FileIoStats> path_ids{};
+
+        /// The statistics of all files.
+        FileIoStats total{};
+    };
+
+    /**
+     * @brief Aggregates filesystem statistics per map load.
+     *
+     * The class is thread-safe, calls can be recorded from any thread.
+     */
+    class FileSystemProfile final {
+      public:
+        /// The maximum number of maps kept in the profile, the oldest map is discarded first.
+        static constexpr std::size_t MAX_MAPS = 16;
+
+        /**
+         * @brief Constructs a new FileSystemProfile object.
+         */
+        FileSystemProfile();
+
+        /**
+         * @brief Starts a new section of the profile for the map being loaded.
+         *
+         * @param map_name The name of the map.
+         */
+        void begin_map(std::string_view map_name);
+
+        /**
+         * @brief Records a single filesystem call in the current map section.
+         *
+         * @param path The path of the file, as passed to the filesystem.
+         * @param path_id The search path ID, empty if all paths were searched.
+         * @param operation The kind of operation.
+         * @param bytes The number of bytes transferred.
+         * @param time The time the call took.
+         * @param success Whether the call succeeded.
+         */
+        void record(std::string_view path, std::string_view path_id, FileOperation operation, std::uint64_t bytes,
+                    std::chrono::nanoseconds time, bool success);
+
+        /**
+         * @brief Discards all recorded statistics and starts over with the current map.
+         */
+        void reset();
+
+        /**
+         * @brief Gets a copy of the recorded map sections, oldest first.
+         *
+         * @return The recorded map sections.
+         */
+        [[nodiscard]] std::vector<MapIoProfile> get_maps() const;
+
+        /**
+         * @brief Formats the top offenders of the current map.
+         *
+         * @param top_count The maximum number of files to list.
+         *
+         * @return The report lines.
+         */
+        [[nodiscard]] std::vector<std::string> report(std::size_t top_count) const;
+
+        /**
+         * @brief Writes the top offenders of every recorded map to a file.
+         *
+         * @param filename The name of the file to write the report to.
+         * @param top_count The maximum number of files to list per map.
+         *
+         * @return \c true if the report was written successfully, \c false otherwise.
+         */
+        bool dump(const std::string& filename, std::size_t top_count) const;
+
+      private:
+        /// Guards the map sections.
+        mutable std::mutex mutex_{};
+
+        /// The recorded map sections, the current map is the last one.
+        std::deque<MapIoProfile> maps_{};
+    };
+}
@@ -0,0 +1,112 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace Model {
+    /**
+     * @brief The frame rate and frame time percentiles of an interval.
+     */
+    struct FrameTimeStats {
+        /**
+         * @brief The number of frames per second that were achieved.
+         */
+        float fps{};
+
+        /**
+         * @brief The median frame time, in milliseconds.
+         */
+        float median_ms{};
+
+        /**
+         * @brief The 99th percentile of the frame times, in milliseconds.
+         */
+        float p99_ms{};
+
+        /**
+         * @brief The longest frame time, in milliseconds.
+         */
+        float max_ms{};
+    };
+
+    /**
+     * @brief Records the frame times of the server loop and computes their percentiles per interval.
+     *
+     * Recording a frame only stores its duration in a preallocated buffer, the percentiles are computed
+     * when the statistics are taken. The frames beyond the capacity of the buffer still count towards the
+     * frame rate.
+     */
+    class FrameTimes final {
+      public:
+        /**
+         * @brief The default number of frame times kept per interval.
+         */
+        static constexpr std::size_t DEFAULT_MAX_SAMPLES = 8192;
+
+        /**
+         * @brief Constructs a new FrameTimes object.
+         *
+         * @param max_samples The number of frame times kept per interval.
+         */
+        explicit FrameTimes(std::size_t max_samples = DEFAULT_MAX_SAMPLES);
+
+        /**
+         * @brief Marks the start of a frame, the time since the previous mark is recorded as a frame time.
+         */
+        void mark_frame() noexcept;
+
+        /**
+         * @brief Records the duration of a frame.
+         *
+         * @param frame_time The duration of the frame.
+         */
+        void record(std::chrono::nanoseconds frame_time) noexcept;
+
+        /**
+         * @brief Computes the statistics of the frames recorded since the previous call and starts a new interval.
+         *
+         * @return The statistics, all zero if no frame was recorded.
+         */
+        [[nodiscard]] FrameTimeStats take_stats();
+
+      private:
+        /// The frame times of the interval, in microseconds.
+        std::vector<std::uint32_t> samples_{};
+
+        /// The number of frame times kept per interval.
+        std::size_t max_samples_;
+
+        /// The number of frames recorded in the interval.
+        std::uint64_t num_frames_{};
+
+        /// The total duration of the frames recorded in the interval.
+        std::chrono::nanoseconds total_time_{};
+
+        /// The start of the current frame.
+        std::optional<std::chrono::steady_clock::time_point> frame_start_{};
+    };
+}
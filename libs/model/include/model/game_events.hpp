@@ -0,0 +1,224 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+
+#pragma once
+
+#include "util/threadsafe_queue.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace Model {
+    /**
+     * @brief The kinds of game events extracted from the log, as bit flags.
+     */
+    enum class GameEventType : unsigned {
+        kill = 1U << 0U,       ///< A player killed a player.
+        connect = 1U << 1U,    ///< A player connected.
+        enter = 1U << 2U,      ///< A player entered the game.
+        disconnect = 1U << 3U, ///< A player disconnected.
+        map_change = 1U << 4U, ///< A map was started.
+        all = kill | connect | enter | disconnect | map_change
+    };
+
+    /**
+     * @brief Parses a comma-separated list of game event names.
+     *
+     * The names are \c kill, \c connect, \c enter, \c disconnect and \c map, unknown names are ignored.
+     *
+     * @param names The list of names.
+     *
+     * @return The bit flags of the listed event types.
+     */
+    [[nodiscard]] unsigned parse_game_event_types(std::string_view names);
+
+    /**
+     * @brief Checks if a line starts with the standard log prefix \c "L MM/DD/YYYY - hh:mm:ss: ".
+     *
+     * The first 16 bytes are checked with a few SIMD operations, so the lines that are not game log lines
+     * are rejected without a byte-by-byte scan.
+     *
+     * @param line The line to check.
+     *
+     * @return \c true if the line has the log prefix, \c false otherwise.
+     */
+    [[nodiscard]] bool has_game_log_prefix(std::string_view line) noexcept;
+
+    /**
+     * @brief Extracts game events from the engine log lines and writes them as compact records.
+     *
+     * The engine output is fed as it is printed and reassembled into lines. Each event is written as a single
+     * tab-separated line: the Unix time in milliseconds, the event name and its fields, for example
+     * \c "1700000000000\tkill\tName\tSTEAM_0:1:1\tCT\tOther\tSTEAM_0:0:2\tTERRORIST\tak47". The output is a file,
+     * a named pipe or, on Linux, a Unix datagram socket given as \c "unix:<path>". The class is thread-safe.
+     *
+     * The records are handed to a bounded queue and written by a helper thread, so the thread feeding the output
+     * never waits for the reader. The records that do not fit into the queue, or that the reader of a pipe or
+     * a socket does not take, are dropped and counted. A named pipe without a reader is opened once one appears.
+     */
+    class GameEventExtractor final {
+      public:
+        /**
+         * @brief Constructs a new GameEventExtractor object.
+         *
+         * @param types The bit flags of the event types to extract.
+         */
+        explicit GameEventExtractor(unsigned types = static_cast<unsigned>(GameEventType::all)) noexcept;
+
+        /**
+         * @brief Writes the queued records, stops the helper thread and closes the output.
+         */
+        ~GameEventExtractor();
+
+        /// Move constructor.
+        GameEventExtractor(GameEventExtractor&&) = delete;
+
+        /// Copy constructor.
+        GameEventExtractor(const GameEventExtractor&) = delete;
+
+        /// Move assignment operator.
+        GameEventExtractor& operator=(GameEventExtractor&&) = delete;
+
+        /// Copy assignment operator.
+        GameEventExtractor& operator=(const GameEventExtractor&) = delete;
+
+        /**
+         * @brief Opens the output for the records.
+         *
+         * @param destination The path to a file or a named pipe, or \c "unix:<path>" for a datagram socket.
+         *
+         * @return \c true if the output is open, \c false otherwise.
+         */
+        bool open(const std::string& destination);
+
+        /**
+         * @brief Feeds a piece of the engine output.
+         *
+         * @param text The output, which may contain several lines or a part of a line.
+         */
+        void feed(std::string_view text);
+
+        /**
+         * @brief Extracts an event from a complete line and writes its record.
+         *
+         * @param line The line without the line break.
+         *
+         * @return \c true if the line was an event of the extracted types, \c false otherwise.
+         */
+        bool process_line(std::string_view line);
+
+        /**
+         * @brief Gets the number of events extracted, including the dropped ones.
+         *
+         * @return The number of events.
+         */
+        [[nodiscard]] std::uint64_t get_event_count() const noexcept
+        {
+            return event_count_;
+        }
+
+        /**
+         * @brief Gets the number of events dropped because the output did not keep up or was not available.
+         *
+         * @return The number of dropped events.
+         */
+        [[nodiscard]] std::uint64_t get_dropped_count() const noexcept
+        {
+            return dropped_count_.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Gets the record of the last event, for diagnostics and tests.
+         *
+         * @return The last record without the line break.
+         */
+        [[nodiscard]] const std::string& get_last_record() const noexcept
+        {
+            return record_;
+        }
+
+      private:
+        /// Formats the record of an event from the body of a log line, returns \c false if it is not an event.
+        bool format_record(std::string_view body);
+
+        /// Queues the formatted record for the helper thread.
+        void write_record();
+
+        /// The body of the helper thread.
+        void run();
+
+        /// Writes a record to the output, on the helper thread.
+        void write_output(const std::string& record);
+
+        /// Opens the output file or named pipe without blocking, on the helper thread once it runs.
+        bool open_file();
+
+        /// The bit flags of the event types to extract.
+        const unsigned types_;
+
+        /// Guards the state.
+        std::mutex mutex_{};
+
+        /// The beginning of a line whose end has not been fed yet.
+        std::string partial_line_{};
+
+        /// The record being written.
+        std::string record_{};
+
+        /// The path to the output file or named pipe.
+        std::string path_{};
+
+        /// The output file.
+        std::FILE* file_{};
+
+        /// The output file or named pipe.
+        int fd_{-1};
+
+        /// The output socket.
+        int socket_{-1};
+
+        /// The time of the last attempt to open the output, used by the helper thread only.
+        std::chrono::steady_clock::time_point open_time_{};
+
+        /// The records waiting for the helper thread.
+        Util::ThreadSafeQueue<std::string> queue_{};
+
+        /// Whether the helper thread should exit once the queue is empty.
+        std::atomic<bool> stopping_{};
+
+        /// The number of events extracted.
+        std::uint64_t event_count_{};
+
+        /// The number of events dropped.
+        std::atomic<std::uint64_t> dropped_count_{};
+
+        /// The number of dropped events already reported in the log, used by the helper thread only.
+        std::uint64_t dropped_reported_{};
+
+        /// Writes the records to the output.
+        std::thread thread_{};
+    };
+}
@@ -0,0 +1,192 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+
+#pragma once
+
+#include "model/console_commands.hpp"
+#include "model/server_loop.hpp"
+#include "util/line_splitter.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Model {
+    /**
+     * @brief Serves console commands on a local Unix socket and returns the output of each command.
+     *
+     * A client sends one request per line, a request ID of its choice followed by the command:
+     * <tt>\<id\> \<command\></tt>. For every request, in the order they were sent, the reply is the line
+     * <tt>\<id\> \<size\></tt> followed by exactly \<size\> bytes of the console output of the command.
+     * Requests can be pipelined without waiting for the replies. The requests received together are
+     * executed as a batch by one server loop task, so a burst of commands costs a single frame. The socket
+     * is served by the launcher reactor, which has to be running.
+     */
+    class ControlSocket final {
+      public:
+        /**
+         * @brief Type alias for a shared pointer to a ServerLoop object.
+         */
+        using ServerLoopPtr = std::shared_ptr<ServerLoop>;
+
+        /**
+         * @brief Type alias for a shared pointer to a ConsoleCommands object.
+         */
+        using ConsoleCommandsPtr = std::shared_ptr<ConsoleCommands>;
+
+        /**
+         * @brief Constructs a new ControlSocket object.
+         *
+         * @param server_loop The server loop that executes the commands.
+         * @param console_commands The console commands used to execute the commands and capture their output.
+         */
+        ControlSocket(ServerLoopPtr server_loop, ConsoleCommandsPtr console_commands);
+
+        /// Move constructor.
+        ControlSocket(ControlSocket&&) = delete;
+
+        /// Copy constructor.
+        ControlSocket(const ControlSocket&) = delete;
+
+        /// Move assignment operator.
+        ControlSocket& operator=(ControlSocket&&) = delete;
+
+        /// Copy assignment operator.
+        ControlSocket& operator=(const ControlSocket&) = delete;
+
+        /**
+         * @brief Destructor, stops serving the socket.
+         */
+        ~ControlSocket();
+
+        /**
+         * @brief Starts listening on the socket.
+         *
+         * @param socket_path The path to the socket, an existing socket at this path is replaced.
+         *
+         * @return \c true if the socket is listening, \c false if it could not be created.
+         */
+        bool start(const std::string& socket_path);
+
+        /**
+         * @brief Disconnects the clients and removes the socket.
+         *
+         * The requests already queued to the server loop are discarded.
+         */
+        void stop();
+
+      private:
+        /// A connected client.
+        struct Client {
+            /// The socket of the client.
+            int fd;
+
+            /// The unique number of the client, the replies are matched to the clients by it.
+            std::uint64_t serial;
+
+            /// The \c epoll events the socket is watched for.
+            std::uint32_t events;
+
+            /// Splits the received data into requests.
+            Util::LineSplitter splitter{};
+
+            /// The replies not sent yet.
+            std::string pending{};
+
+            /// The number of requests of the client that have not been replied to.
+            std::size_t in_flight{};
+
+            /// Indicates whether the client has finished sending, it is disconnected once it has its replies.
+            bool input_closed{};
+        };
+
+        /// A request that is queued to the server loop.
+        struct Request {
+            /// The serial of the client that sent the request.
+            std::uint64_t client;
+
+            /// The request ID chosen by the client.
+            std::string id;
+
+            /// The command to execute.
+            std::string command;
+
+            /// The console output of the command, filled in on the server thread.
+            std::string output{};
+        };
+
+        /// The executed requests, shared with the server loop tasks that may outlive the socket.
+        struct Completions;
+
+        /// Accepts the pending connections.
+        void accept_clients();
+
+        /// Handles a readiness change of a client socket.
+        void on_client_event(std::uint64_t serial, std::uint32_t events);
+
+        /// Reads the requests of a client into the batch, returns \c false if the client is gone.
+        bool receive_requests(Client& client, std::vector<Request>& batch);
+
+        /// Queues a batch of requests to the server loop.
+        void enqueue_batch(std::vector<Request> batch);
+
+        /// Adds the replies of the executed requests to the pending data of their clients.
+        void collect_replies();
+
+        /// Sends the pending replies, disconnects the finished clients and updates the events of the others.
+        void serve_clients();
+
+        /// Sends the pending replies of a client, returns \c false if the client is gone.
+        static bool send_replies(Client& client);
+
+        /// Stops watching a client and closes its socket.
+        static void close_client(const Client& client);
+
+        /// The server loop that executes the commands.
+        ServerLoopPtr server_loop_;
+
+        /// The console commands used to execute the commands.
+        ConsoleCommandsPtr console_commands_;
+
+        /// Guards starting and stopping.
+        std::mutex mutex_{};
+
+        /// The path to the socket.
+        std::string socket_path_{};
+
+        /// The listening socket.
+        int listen_fd_{-1};
+
+        /// The executed requests of the current run.
+        std::shared_ptr<Completions> completions_{};
+
+        /// The connected clients, only used on the reactor thread.
+        std::vector<Client> clients_{};
+
+        /// The serial of the next client.
+        std::uint64_t next_serial_{};
+
+        /// The number of requests queued to the server loop and not replied to.
+        std::size_t in_flight_{};
+    };
+}
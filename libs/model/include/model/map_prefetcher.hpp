@@ -0,0 +1,156 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace Model {
+    /**
+     * @brief Parses the map names from the content of a map cycle file.
+     *
+     * Comments are ignored and per-map settings enclosed in braces are skipped.
+     *
+     * @param content The content of the map cycle file.
+     *
+     * @return The names of the maps, without \c "maps/" prefix and \c ".bsp" extension.
+     */
+    [[nodiscard]] std::vector<std::string> parse_mapcycle(const std::string& content);
+
+    /**
+     * @brief Parses the file paths listed in the content of a \c .res file.
+     *
+     * @param content The content of the \c .res file.
+     *
+     * @return The paths, with forward slashes.
+     */
+    [[nodiscard]] std::vector<std::string> parse_res(const std::string& content);
+
+    /**
+     * @brief Parses the files referenced by the entities lump of a BSP file.
+     *
+     * The WAD files, the sky box images, and the models, sprites and sounds are collected.
+     *
+     * @param entities The content of the entities lump.
+     *
+     * @return The game relative paths of the referenced files.
+     */
+    [[nodiscard]] std::vector<std::string> parse_entities(std::string_view entities);
+
+    /**
+     * @brief Warms the page cache with the files of the map that follows the current one in the map cycle.
+     *
+     * On every map change the prefetcher looks up the next map in the map cycle file, collects the files
+     * it will need (the BSP itself, the entries of its \c .res file, the WAD files and the models, sprites
+     * and sounds referenced by its entities) and asks the operating system to read them ahead.
+     * The work is done by a background thread with idle I/O priority, so it never competes with the server.
+     */
+    class MapPrefetcher final {
+      public:
+        /**
+         * @brief Constructs a new MapPrefetcher object and starts the background thread.
+         *
+         * @param game_dir The game directory (e.g. \c "cstrike").
+         * @param mapcycle_file The map cycle file, relative to the game directory.
+         */
+        MapPrefetcher(std::string game_dir, std::string mapcycle_file);
+
+        /**
+         * @brief Stops the background thread and destroys the MapPrefetcher object.
+         */
+        ~MapPrefetcher();
+
+        /// Move constructor.
+        MapPrefetcher(MapPrefetcher&&) = delete;
+
+        /// Copy constructor.
+        MapPrefetcher(const MapPrefetcher&) = delete;
+
+        /// Move assignment operator.
+        MapPrefetcher& operator=(MapPrefetcher&&) = delete;
+
+        /// Copy assignment operator.
+        MapPrefetcher& operator=(const MapPrefetcher&) = delete;
+
+        /**
+         * @brief Notifies the prefetcher that the server has switched to a map.
+         *
+         * Cheap to call repeatedly with the same map, only actual changes wake up the background thread.
+         *
+         * @param map_name The name of the current map, with or without \c "maps/" prefix and \c ".bsp" extension.
+         */
+        void on_map_changed(std::string_view map_name);
+
+        /**
+         * @brief Stops the background thread.
+         *
+         * Pending prefetch requests are discarded, a file that is being read ahead is finished first.
+         */
+        void stop();
+
+      private:
+        /// The background thread entry point.
+        void run();
+
+        /// Prefetches the files of the map that follows \p current_map in the map cycle.
+        void prefetch_next_map(const std::string& current_map);
+
+        /// Finds the map that follows \p current_map in the map cycle.
+        [[nodiscard]] std::string find_next_map(const std::string& current_map) const;
+
+        /// Collects the paths of the files the specified map depends on.
+        [[nodiscard]] std::vector<std::string> collect_map_files(const std::string& map_name) const;
+
+        /// Resolves a game relative path against the search directories.
+        [[nodiscard]] std::string resolve_path(std::string_view relative_path) const;
+
+        /// The map cycle file, relative to the game directory.
+        std::string mapcycle_file_{};
+
+        /// The directories the game relative paths are looked up in, in priority order.
+        std::vector<std::string> search_dirs_{};
+
+        /// The last map the server switched to.
+        std::string current_map_{};
+
+        /// The map whose successor is waiting to be prefetched.
+        std::string pending_map_{};
+
+        /// The last map that was prefetched.
+        std::string prefetched_map_{};
+
+        /// Whether the background thread has been requested to stop.
+        bool stopped_{};
+
+        /// Guards the state shared with the background thread.
+        std::mutex mutex_{};
+
+        /// Wakes up the background thread.
+        std::condition_variable condition_{};
+
+        /// The background thread.
+        std::thread thread_{};
+    };
+}
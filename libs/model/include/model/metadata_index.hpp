@@ -0,0 +1,214 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#pragma once
+
+#include "util/mapped_file.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Model {
+    /**
+     * @brief The results of the metadata queries made for a single path.
+     *
+     * Each query result is only valid if the corresponding \c *_known flag is set.
+     */
+    struct FileMetadata {
+        /// Whether \c exists holds the result of an existence query.
+        bool exists_known{};
+
+        /// Whether the path exists.
+        bool exists{};
+
+        /// Whether \c is_directory holds the result of a directory query.
+        bool is_directory_known{};
+
+        /// Whether the path is a directory.
+        bool is_directory{};
+
+        /// Whether \c size holds the result of a size query.
+        bool size_known{};
+
+        /// The size of the file.
+        std::uint32_t size{};
+
+        /// Whether \c filetime holds the result of a modification time query.
+        bool filetime_known{};
+
+        /// The modification time of the file.
+        std::int64_t filetime{};
+
+        /**
+         * @brief Checks if any query result is known.
+         *
+         * @return \c true if at least one query result is known, \c false otherwise.
+         */
+        [[nodiscard]] bool is_known() const noexcept
+        {
+            return exists_known || is_directory_known || size_known || filetime_known;
+        }
+    };
+
+    /**
+     * @brief A persistent, memory-mapped index of filesystem metadata.
+     *
+     * The index file stores the metadata of game relative paths resolved against a list of search roots,
+     * together with the modification times of the directories the paths live in. The index is considered
+     * up to date as long as none of those directories were changed, which is checked without touching
+     * the individual files. Content edits that keep the directory entries intact are not detected.
+     *
+     * Lookups are served directly from the mapped file through an open-addressing hash table.
+     */
+    class MetadataIndex final {
+      public:
+        /**
+         * @brief Maps an index file into memory and checks its structure.
+         *
+         * @param path The path to the index file.
+         *
+         * @return \c true if the index file was loaded successfully, \c false otherwise.
+         */
+        bool load(const std::string& path);
+
+        /**
+         * @brief Unloads the index file.
+         */
+        void unload() noexcept;
+
+        /**
+         * @brief Checks if an index file is loaded.
+         *
+         * @return \c true if an index file is loaded, \c false otherwise.
+         */
+        [[nodiscard]] bool is_loaded() const noexcept;
+
+        /**
+         * @brief Checks that none of the directories recorded in the index were changed since it was saved.
+         *
+         * @return \c true if the index is up to date, \c false otherwise.
+         */
+        [[nodiscard]] bool is_up_to_date() const;
+
+        /**
+         * @brief Gets the search roots the paths of the index were resolved against.
+         *
+         * @return The search roots, in priority order.
+         */
+        [[nodiscard]] std::vector<std::string> get_search_roots() const;
+
+        /**
+         * @brief Gets the number of paths in the index.
+         *
+         * @return The number of paths in the index.
+         */
+        [[nodiscard]] std::size_t get_entry_count() const noexcept;
+
+        /**
+         * @brief Finds the metadata of a path.
+         *
+         * @param path The game relative path, as passed to the filesystem.
+         *
+         * @return The metadata of the path, or an empty optional if the index does not contain the path.
+         */
+        [[nodiscard]] std::optional<FileMetadata> find(std::string_view path) const;
+
+        /**
+         * @brief Calls a function for every path of the index.
+         *
+         * @tparam Func The type of the function, called with \c (std::string_view, const FileMetadata&).
+         *
+         * @param func The function to call.
+         */
+        template <typename Func>
+        void for_each(Func&& func) const;
+
+        /**
+         * @brief Writes an index file.
+         *
+         * @param path The path to the index file.
+         * @param search_roots The search roots the paths were resolved against, in priority order.
+         * @param directories The directories whose modification times validate the index.
+         * @param entries The metadata of the paths.
+         *
+         * @return \c true if the index file was written successfully, \c false otherwise.
+         */
+        static bool save(const std::string& path, const std::vector<std::string>& search_roots,
+                         const std::vector<std::string>& directories,
+                         const std::unordered_map<std::string, FileMetadata>& entries);
+
+      private:
+        /// Gets the metadata of the entry at the specified index.
+        [[nodiscard]] FileMetadata get_metadata(std::size_t entry_index) const;
+
+        /// Gets the path of the entry at the specified index.
+        [[nodiscard]] std::string_view get_entry_path(std::size_t entry_index) const;
+
+        /// Gets a string from the string table.
+        [[nodiscard]] std::string_view get_string(std::uint32_t offset, std::uint32_t length) const;
+
+        /// The mapped index file.
+        Util::MappedFile file_{};
+
+        /// The number of search roots.
+        std::uint32_t root_count_{};
+
+        /// The number of directory stamps.
+        std::uint32_t stamp_count_{};
+
+        /// The number of entries.
+        std::uint32_t entry_count_{};
+
+        /// The number of hash table slots, a power of two.
+        std::uint32_t slot_count_{};
+
+        /// The offsets of the sections within the mapped file.
+        std::size_t roots_offset_{};
+        std::size_t stamps_offset_{};
+        std::size_t entries_offset_{};
+        std::size_t slots_offset_{};
+        std::size_t strings_offset_{};
+
+        /// The size of the string table.
+        std::size_t strings_size_{};
+    };
+
+    inline bool MetadataIndex::is_loaded() const noexcept
+    {
+        return file_.is_open();
+    }
+
+    inline std::size_t MetadataIndex::get_entry_count() const noexcept
+    {
+        return entry_count_;
+    }
+
+    template <typename Func>
+    void MetadataIndex::for_each(Func&& func) const
+    {
+        for (std::size_t i = 0; i < entry_count_; ++i) {
+            func(get_entry_path(i), get_metadata(i));
+        }
+    }
+}
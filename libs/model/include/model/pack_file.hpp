@@ -0,0 +1,104 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#pragma once
+
+#include "util/mapped_file.hpp"
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace Model {
+    /**
+     * @brief A memory-mapped pack file (\c "PACK" and 64-bit \c "PK64" formats) with a hash index over its directory.
+     *
+     * Once the pack is opened, looking up and reading entries does not involve any system calls.
+     */
+    class PackFile final {
+      public:
+        /**
+         * @brief Maps a pack file into memory and indexes its directory.
+         *
+         * @param path The path to the pack file.
+         *
+         * @return \c true if the pack file was opened successfully, \c false otherwise.
+         */
+        bool open(const std::string& path);
+
+        /**
+         * @brief Finds an entry by its path.
+         *
+         * The lookup is case-insensitive and treats back slashes as forward slashes.
+         *
+         * @param path The path of the entry.
+         *
+         * @return The data of the entry, or an empty optional if the pack does not contain the entry.
+         */
+        [[nodiscard]] std::optional<std::string_view> find(std::string_view path) const;
+
+        /**
+         * @brief Gets the number of entries in the pack.
+         *
+         * @return The number of entries in the pack.
+         */
+        [[nodiscard]] std::size_t get_entry_count() const noexcept;
+
+        /**
+         * @brief Gets the modification time of the pack file, reported for all its entries.
+         *
+         * @return The modification time of the pack file as a Unix timestamp.
+         */
+        [[nodiscard]] long get_filetime() const noexcept;
+
+        /**
+         * @brief Converts a path to the key used by the index: lowercase, with forward slashes.
+         *
+         * @param path The path to convert.
+         * @param key The string to store the key in.
+         */
+        static void make_key(std::string_view path, std::string& key);
+
+      private:
+        /// Indexes the directory of a pack with the specified entry layout.
+        template <typename Header, typename Entry>
+        bool build_index();
+
+        /// The mapped pack file.
+        Util::MappedFile file_{};
+
+        /// The entries of the pack, keyed by their normalized paths.
+        std::unordered_map<std::string, std::string_view> index_{};
+
+        /// The modification time of the pack file.
+        long filetime_{};
+    };
+
+    inline std::size_t PackFile::get_entry_count() const noexcept
+    {
+        return index_.size();
+    }
+
+    inline long PackFile::get_filetime() const noexcept
+    {
+        return filetime_;
+    }
+}
@@ -21,15 +21,18 @@
 #pragma once
 
 #include "common/platform.hpp"
+#include "model/frame_times.hpp"
 #include "model/server_status.hpp"
-#include "util/observable.hpp"
+#include "util/atomic_observable.hpp"
 #include "util/threadsafe_queue.hpp"
 #include <functional>
 #include <future>
 #include <memory>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace Common {
     class DedicatedServerApiInterface;
@@ -42,7 +45,7 @@ namespace Model {
     /**
      * @brief Runs the main loop of a server application.
      */
-    class ServerLoop final : public Util::Observable<ServerLoopEvent> {
+    class ServerLoop final : public Util::AtomicObservable<ServerLoopEvent> {
       public:
         /**
          * @brief A type alias for a thread-safe queue of \c std::function<void()>
@@ -54,6 +57,11 @@ namespace Model {
          */
         using InputQueue = Util::ThreadSafeQueue<std::string>;
 
+        /**
+         * @brief A type alias for a handler of a launcher console command, receives the words of the input line.
+         */
+        using CommandHandler = std::function<void(const std::vector<std::string>& args)>;
+
         [[nodiscard]] PingBoostLevel get_pingboost_level() const noexcept;
 
         void set_pingboost_level(PingBoostLevel level) noexcept;
@@ -114,14 +122,28 @@ namespace Model {
         template <typename Result = void>
         std::future<Result> enqueue_task(std::function<Result()> task);
 
+        /**
+         * @brief Registers a console command that is handled by the launcher instead of the engine.
+         *
+         * Input whose first word matches the command name (case-insensitively) is passed to the handler
+         * and is not sent to the engine. Commands must be registered before the server loop is started.
+         *
+         * @param name The name of the command.
+         * @param handler The handler to call when the command is entered.
+         */
+        void register_command(std::string_view name, CommandHandler handler);
+
       private:
+        /// Executes the input as a launcher command, returns \c false if it is not one.
+        bool execute_command(const std::string& input);
+
         /// Processes task from the task queue.
         ATTR_HOT void process_tasks();
 
         /// Processes input from the input queue.
         ATTR_HOT void process_input(Common::DedicatedServerApiInterface& serverapi_interface);
 
-        /// Updates the server status.
+        /// Records the frame time and updates the server status, called once per frame.
         ATTR_HOT void update_status(Common::DedicatedServerApiInterface& serverapi_interface);
 
         PingBoostLevel pingboost_level_{};
@@ -131,11 +153,17 @@ namespace Model {
         /// The current status of the server.
         ServerStatus status_{};
 
+        /// The frame times since the previous status update.
+        FrameTimes frame_times_{};
+
         /// The task queue for tasks to be executed by the server loop.
         TaskQueue task_queue_{};
 
         /// The input queue for input to be processed by the server loop.
         InputQueue input_queue_{};
+
+        /// The launcher console commands, keyed by the lowercase command name.
+        std::unordered_map<std::string, CommandHandler> commands_{};
     };
 
     inline PingBoostLevel ServerLoop::get_pingboost_level() const noexcept
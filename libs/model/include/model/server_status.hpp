@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include "model/frame_times.hpp"
 #include <string>
 
 namespace Model {
@@ -48,5 +49,10 @@ namespace Model {
          * @brief The name of the current map on the server.
          */
         std::string current_map{};
+
+        /**
+         * @brief The frame rate and frame times of the server loop since the previous status update.
+         */
+        FrameTimeStats frame_times{};
     };
 }
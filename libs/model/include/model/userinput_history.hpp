@@ -21,9 +21,14 @@
 #pragma once
 
 #include "util/circular_buffer.hpp"
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <vector>
 
 namespace Model {
     /** @brief The maximum capacity of the history buffer. */
@@ -31,6 +36,10 @@ namespace Model {
 
     /**
      * @brief A class for storing and managing user input history.
+     *
+     * The history file is an append-only journal: saving appends the inputs added since the previous save,
+     * and the journal is rewritten down to the last \c HISTORY_CAPACITY entries only once it has grown to
+     * twice that size. The file is written by a background thread, saving never waits for the disk.
      */
     class UserInputHistory {
       public:
@@ -46,6 +55,23 @@ namespace Model {
          */
         explicit UserInputHistory(std::string_view filename = "");
 
+        /// Move constructor.
+        UserInputHistory(UserInputHistory&&) = delete;
+
+        /// Copy constructor.
+        UserInputHistory(const UserInputHistory&) = delete;
+
+        /// Move assignment operator.
+        UserInputHistory& operator=(UserInputHistory&&) = delete;
+
+        /// Copy assignment operator.
+        UserInputHistory& operator=(const UserInputHistory&) = delete;
+
+        /**
+         * @brief Destructor, writes the saved inputs that are still pending and stops the writer thread.
+         */
+        ~UserInputHistory();
+
         /**
          * @brief Append a new input to the history.
          *
@@ -78,10 +104,15 @@ namespace Model {
         void load();
 
         /**
-         * @brief Save the history to file.
+         * @brief Save the inputs appended since the previous save to file, in the background.
          */
         void save();
 
+        /**
+         * @brief Wait until the saved inputs have been written to file.
+         */
+        void flush();
+
       private:
         /// The circular buffer to store the history.
         Util::CircularBuffer<std::string, HISTORY_CAPACITY> history_{};
@@ -91,5 +122,35 @@ namespace Model {
 
         /// The name of the file to load and save history from/to.
         std::string filename_{};
+
+        /// The inputs appended since the previous save.
+        std::vector<std::string> unsaved_{};
+
+        /// Guards the state shared with the writer thread.
+        std::mutex mutex_{};
+
+        /// Signals the writer thread about pending inputs and the waiters about their completion.
+        std::condition_variable condition_{};
+
+        /// The saved inputs waiting to be appended to the journal.
+        std::vector<std::string> pending_{};
+
+        /// The last entries of the journal, the content of the file after compaction.
+        Util::CircularBuffer<std::string, HISTORY_CAPACITY> journal_tail_{};
+
+        /// The number of lines in the journal file.
+        std::size_t journal_lines_{};
+
+        /// Indicates whether the writer thread is writing to the file.
+        bool writing_{};
+
+        /// Indicates whether the writer thread should exit.
+        bool stopping_{};
+
+        /// The writer thread, started by the first save.
+        std::thread writer_{};
+
+        /// Writes the pending inputs to the journal (runs in a separate thread).
+        void write_journal();
     };
 }
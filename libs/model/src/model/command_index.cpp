@@ -0,0 +1,103 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+
+#include "model/command_index.hpp"
+#include "util/string.hpp"
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <utility>
+
+namespace {
+    /// Checks if the text starts with a prefix.
+    [[nodiscard]] bool starts_with(const std::string_view text, const std::string_view prefix) noexcept
+    {
+        return text.substr(0, prefix.size()) == prefix;
+    }
+}
+
+namespace Model {
+    CommandIndex::CommandIndex(const std::chrono::milliseconds refresh_interval) noexcept :
+      refresh_interval_(refresh_interval)
+    {
+    }
+
+    void CommandIndex::update(const std::string_view prefix, std::vector<std::string> names)
+    {
+        const auto lower_prefix = Util::str::to_lower(prefix);
+        const std::lock_guard lock{mutex_};
+        const auto current = std::atomic_load(&names_);
+
+        // The names outside of the prefix are kept
+        if (current && !lower_prefix.empty()) {
+            std::copy_if(current->cbegin(), current->cend(), std::back_inserter(names), [&](const auto& name) {
+                return !starts_with(name, lower_prefix);
+            });
+        }
+
+        std::sort(names.begin(), names.end());
+        names.erase(std::unique(names.begin(), names.end()), names.end());
+        std::atomic_store(&names_, std::shared_ptr<const Names>{std::make_shared<Names>(std::move(names))});
+    }
+
+    std::vector<std::string> CommandIndex::find_matches(const std::string_view prefix) const
+    {
+        std::vector<std::string> matches{};
+        const auto names = std::atomic_load(&names_);
+
+        if (!names || prefix.empty()) {
+            return matches;
+        }
+
+        const auto lower_prefix = Util::str::to_lower(prefix);
+
+        for (auto it = std::lower_bound(names->cbegin(), names->cend(), lower_prefix);
+             it != names->cend() && starts_with(*it, lower_prefix); ++it) {
+            matches.push_back(*it);
+        }
+
+        return matches;
+    }
+
+    bool CommandIndex::is_built() const noexcept
+    {
+        return std::atomic_load(&names_) != nullptr;
+    }
+
+    bool CommandIndex::take_refresh(const std::string_view prefix, const Clock::time_point now)
+    {
+        if (prefix.empty()) {
+            return false;
+        }
+
+        const auto first_char = static_cast<unsigned char>(Util::str::to_lower(prefix.substr(0, 1)).front());
+        const std::lock_guard lock{mutex_};
+        auto& refresh_time = refresh_times_[first_char];
+
+        if (refresh_time != Clock::time_point{} && now - refresh_time < refresh_interval_) {
+            return false;
+        }
+
+        refresh_time = now;
+
+        return true;
+    }
+}
@@ -23,6 +23,48 @@
 #include "common/object_list.hpp"
 #include "util/string.hpp"
 #include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+    /// The output of a command being executed.
+    struct CommandOutput {
+        /// The collected console text.
+        std::string text{};
+
+        /// The buffer the system interface redirects its output to.
+        const std::vector<char>* redirect_buffer{};
+
+        /// The size of the redirected text already added to the collected text.
+        std::size_t redirect_offset{};
+    };
+
+    /// The output of the command being executed on this thread, null when no command is executed.
+    thread_local CommandOutput* command_output = nullptr;
+
+    /// Appends text to the output, truncated to the maximum output size.
+    void append_output(CommandOutput& output, const std::string_view text)
+    {
+        output.text.append(text.substr(0, Model::ConsoleCommands::MAX_OUTPUT_SIZE - output.text.size()));
+    }
+
+    /// Appends the text redirected since the last call, so the output keeps the order the text was printed in.
+    void collect_redirected(CommandOutput& output)
+    {
+        const auto& buffer = *output.redirect_buffer;
+        const auto end = std::find(buffer.cbegin(), buffer.cend(), '\0');
+        const auto size = static_cast<std::size_t>(end - buffer.cbegin());
+
+        // The buffer was flushed and refilled from the start
+        if (size < output.redirect_offset) {
+            output.redirect_offset = 0;
+        }
+
+        append_output(output, {buffer.data() + output.redirect_offset, size - output.redirect_offset});
+        output.redirect_offset = size;
+    }
+}
 
 namespace Model {
     ConsoleCommands::ConsoleCommands(Common::SystemInterface* const system_interface) :
@@ -31,15 +73,37 @@ namespace Model {
     }
 
     std::vector<std::string> ConsoleCommands::find_command_matches(const std::string& command) const noexcept
+    {
+        if (command.empty()) {
+            return {};
+        }
+
+        return query_matches(command);
+    }
+
+    void ConsoleCommands::refresh_index(const std::string_view prefix)
+    {
+        auto matches = query_matches(std::string{prefix});
+
+        // The engine matches every name against an empty prefix, if it does not, the index is left unbuilt
+        // and the completions keep querying the engine
+        if (prefix.empty() && matches.empty()) {
+            return;
+        }
+
+        index_.update(prefix, std::move(matches));
+    }
+
+    std::vector<std::string> ConsoleCommands::query_matches(const std::string& prefix) const noexcept
     {
         std::vector<std::string> matches{};
 
-        if ((nullptr == system_interface_) || command.empty()) {
+        if (nullptr == system_interface_) {
             return matches;
         }
 
         Common::ObjectList object_list{};
-        system_interface_->get_command_matches(command.c_str(), &object_list);
+        system_interface_->get_command_matches(prefix.c_str(), &object_list);
 
         for (const auto* const object : object_list) {
             const auto* const command_match = static_cast<const char*>(object);
@@ -58,4 +122,35 @@ namespace Model {
 
         return matches;
     }
+
+    std::string ConsoleCommands::execute(const std::string_view command)
+    {
+        CommandOutput output{};
+
+        if (nullptr == system_interface_) {
+            return output.text;
+        }
+
+        redirect_buffer_.assign(MAX_OUTPUT_SIZE, '\0');
+        output.redirect_buffer = &redirect_buffer_;
+        command_output = &output;
+
+        // The engine runs the command buffer before returning, so the output is complete afterwards
+        system_interface_->redirect_output(redirect_buffer_.data(), static_cast<int>(redirect_buffer_.size() - 1));
+        system_interface_->execute_string(std::string{command}.append("\n").c_str());
+        system_interface_->redirect_output(nullptr, 0);
+
+        command_output = nullptr;
+        collect_redirected(output);
+
+        return std::move(output.text);
+    }
+
+    void ConsoleCommands::capture_print(const std::string_view text)
+    {
+        if (command_output != nullptr) {
+            collect_redirected(*command_output);
+            append_output(*command_output, text);
+        }
+    }
 }
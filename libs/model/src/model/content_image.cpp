@@ -0,0 +1,347 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#include "model/content_image.hpp"
+#include "model/pack_file.hpp"
+#include "util/file.hpp"
+#include "util/logger.hpp"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <vector>
+
+namespace {
+    /// The identifier of a content image.
+    constexpr std::array<char, 4> IMAGE_ID{'H', 'L', 'C', 'I'};
+
+    /// The version of the content image format.
+    constexpr std::uint32_t IMAGE_VERSION = 1;
+
+    /// The alignment of the data section, keeps the file contents page aligned relative to the mapping.
+    constexpr std::uint64_t DATA_SECTION_ALIGNMENT = 4096;
+
+    /// The value of an empty hash table slot.
+    constexpr std::uint32_t EMPTY_SLOT = 0;
+
+    // All the records are naturally aligned and little-endian on the supported platforms
+    struct ImageHeader {
+        std::array<char, 4> id;
+        std::uint32_t version;
+        std::uint32_t entry_count;
+        std::uint32_t slot_count;
+        std::uint32_t strings_size;
+        std::uint32_t alignment;
+        std::uint64_t data_offset;
+    };
+
+    struct ImageEntry {
+        std::uint32_t hash;
+        std::uint32_t name_offset;
+        std::uint32_t name_length;
+        std::uint32_t reserved;
+        std::uint64_t offset;
+        std::uint64_t size;
+        std::int64_t filetime;
+    };
+
+    static_assert(sizeof(ImageHeader) == 32);
+    static_assert(sizeof(ImageEntry) == 40);
+
+    /// Computes the 32-bit FNV-1a hash of a string.
+    [[nodiscard]] std::uint32_t hash_string(const std::string_view str) noexcept
+    {
+        std::uint32_t hash = 2166136261U;
+
+        for (const auto ch : str) {
+            hash ^= static_cast<unsigned char>(ch);
+            hash *= 16777619U;
+        }
+
+        return hash;
+    }
+
+    /// Rounds a value up to a multiple of a power of two.
+    [[nodiscard]] constexpr std::uint64_t align_up(const std::uint64_t value, const std::uint64_t alignment) noexcept
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    /// Copies a record out of the mapped data.
+    template <typename T>
+    [[nodiscard]] T read_record(const char* const data, const std::size_t offset) noexcept
+    {
+        T record{};
+        std::memcpy(&record, data + offset, sizeof(T));
+
+        return record;
+    }
+
+    /// Writes zero bytes to a stream until it reaches the specified position.
+    void pad_to(std::ofstream& stream, std::uint64_t& position, const std::uint64_t target)
+    {
+        static constexpr std::array<char, DATA_SECTION_ALIGNMENT> zeros{};
+
+        while (position < target) {
+            const auto count = std::min<std::uint64_t>(target - position, zeros.size());
+            stream.write(zeros.data(), static_cast<std::streamsize>(count));
+            position += count;
+        }
+    }
+
+    /// Copies the content of a file to a stream, fails if the file does not have the expected size.
+    [[nodiscard]] bool copy_file(std::ofstream& stream, const std::string& path, const std::uint64_t size)
+    {
+        std::ifstream input{path, std::ios::binary};
+        std::vector<char> buffer(64 * 1024);
+        std::uint64_t copied = 0;
+
+        while (input && (copied < size)) {
+            const auto count = std::min<std::uint64_t>(size - copied, buffer.size());
+            input.read(buffer.data(), static_cast<std::streamsize>(count));
+
+            const auto read = static_cast<std::uint64_t>(input.gcount());
+            stream.write(buffer.data(), static_cast<std::streamsize>(read));
+            copied += read;
+        }
+
+        return (copied == size) && (input.peek() == std::ifstream::traits_type::eof());
+    }
+}
+
+namespace Model {
+    bool ContentImage::open(const std::string& path)
+    {
+        entry_count_ = 0;
+        slot_count_ = 0;
+
+        if (!file_.open(path)) {
+            return false;
+        }
+
+        const auto size = file_.size();
+        const auto header = size >= sizeof(ImageHeader) ? read_record<ImageHeader>(file_.data(), 0) : ImageHeader{};
+
+        if ((header.id != IMAGE_ID) || (header.version != IMAGE_VERSION)) {
+            Util::log_error("Content image \"{}\": unsupported file format.", path);
+            file_.close();
+            return false;
+        }
+
+        const auto entries_size = std::uint64_t{header.entry_count} * sizeof(ImageEntry);
+        const auto slots_size = std::uint64_t{header.slot_count} * sizeof(std::uint32_t);
+        const auto directory_size = sizeof(ImageHeader) + entries_size + slots_size + header.strings_size;
+        const auto is_power_of_two = (0 != header.slot_count) && (0 == (header.slot_count & (header.slot_count - 1)));
+
+        if ((directory_size > size) || !is_power_of_two || (header.entry_count >= header.slot_count)) {
+            Util::log_error("Content image \"{}\": the file is corrupted.", path);
+            file_.close();
+            return false;
+        }
+
+        entry_count_ = header.entry_count;
+        slot_count_ = header.slot_count;
+        slots_offset_ = sizeof(ImageHeader) + static_cast<std::size_t>(entries_size);
+        strings_offset_ = slots_offset_ + static_cast<std::size_t>(slots_size);
+        strings_size_ = header.strings_size;
+
+        return true;
+    }
+
+    std::optional<ContentImageEntry> ContentImage::find(const std::string_view path) const
+    {
+        if (0 == entry_count_) {
+            return std::nullopt;
+        }
+
+        // Reused to avoid an allocation for every lookup
+        thread_local std::string key{};
+        PackFile::make_key(path, key);
+
+        const auto hash = hash_string(key);
+        const auto mask = slot_count_ - 1;
+        const auto* const data = file_.data();
+        const auto size = static_cast<std::uint64_t>(file_.size());
+
+        // The table always has empty slots, the probing terminates
+        for (auto slot = hash & mask;; slot = (slot + 1) & mask) {
+            const auto value = read_record<std::uint32_t>(data, slots_offset_ + (slot * sizeof(std::uint32_t)));
+
+            if ((EMPTY_SLOT == value) || (value > entry_count_)) {
+                return std::nullopt;
+            }
+
+            const auto entry = read_record<ImageEntry>(data, sizeof(ImageHeader) + ((value - 1) * sizeof(ImageEntry)));
+
+            if ((entry.hash != hash) || (entry.name_offset > strings_size_) ||
+                (entry.name_length > strings_size_ - entry.name_offset) ||
+                (std::string_view{data + strings_offset_ + entry.name_offset, entry.name_length} != key)) {
+                continue;
+            }
+
+            // Ranges are checked on access, mounting an image does not touch its directory
+            if ((entry.offset > size) || (entry.size > size - entry.offset)) {
+                return std::nullopt;
+            }
+
+            return ContentImageEntry{{data + entry.offset, static_cast<std::size_t>(entry.size)},
+                                     static_cast<long>(entry.filetime)};
+        }
+    }
+
+    bool ContentImageBuilder::add_directory(const std::string& root)
+    {
+        std::error_code error_code{};
+        std::filesystem::recursive_directory_iterator it{root, error_code};
+
+        if (error_code) {
+            Util::log_error("Failed to open directory '{}': {}", root, error_code.message());
+            return false;
+        }
+
+        for (const std::filesystem::recursive_directory_iterator end{}; it != end; it.increment(error_code)) {
+            if (error_code) {
+                Util::log_error("Failed to scan directory '{}': {}", root, error_code.message());
+                return false;
+            }
+
+            if (!it->is_regular_file(error_code)) {
+                continue;
+            }
+
+            const auto file_path = it->path().string();
+            const auto relative_path = it->path().lexically_relative(root).generic_string();
+            const auto file_size = it->file_size(error_code);
+
+            if (error_code) {
+                Util::log_error("Failed to get the size of file '{}': {}", file_path, error_code.message());
+                return false;
+            }
+
+            std::string key{};
+            PackFile::make_key(relative_path, key);
+            files_.try_emplace(std::move(key), SourceFile{file_path, file_size, Util::file_mtime(file_path)});
+        }
+
+        return true;
+    }
+
+    bool ContentImageBuilder::write(const std::string& path, const std::uint32_t alignment) const
+    {
+        if ((0 == alignment) || (0 != (alignment & (alignment - 1))) || (alignment > DATA_SECTION_ALIGNMENT)) {
+            Util::log_error("Content image alignment must be a power of two up to {}.", DATA_SECTION_ALIGNMENT);
+            return false;
+        }
+
+        std::uint32_t slot_count = 16;
+
+        while (slot_count < files_.size() * 2) {
+            slot_count *= 2;
+        }
+
+        std::vector<ImageEntry> entries{};
+        std::vector<std::uint32_t> slots(slot_count, EMPTY_SLOT);
+        std::string strings{};
+        entries.reserve(files_.size());
+
+        for (const auto& [key, file] : files_) {
+            ImageEntry entry{};
+            entry.hash = hash_string(key);
+            entry.name_offset = static_cast<std::uint32_t>(strings.size());
+            entry.name_length = static_cast<std::uint32_t>(key.size());
+            entry.size = file.size;
+            entry.filetime = file.filetime;
+
+            auto slot = entry.hash & (slot_count - 1);
+
+            while (EMPTY_SLOT != slots[slot]) {
+                slot = (slot + 1) & (slot_count - 1);
+            }
+
+            strings += key;
+            entries.push_back(entry);
+            slots[slot] = static_cast<std::uint32_t>(entries.size());
+        }
+
+        if (strings.size() > std::numeric_limits<std::uint32_t>::max()) {
+            Util::log_error("Content image \"{}\": too many files.", path);
+            return false;
+        }
+
+        const auto directory_size = sizeof(ImageHeader) + (entries.size() * sizeof(ImageEntry)) +
+                                    (slots.size() * sizeof(std::uint32_t)) + strings.size();
+
+        ImageHeader header{};
+        header.id = IMAGE_ID;
+        header.version = IMAGE_VERSION;
+        header.entry_count = static_cast<std::uint32_t>(entries.size());
+        header.slot_count = slot_count;
+        header.strings_size = static_cast<std::uint32_t>(strings.size());
+        header.alignment = alignment;
+        header.data_offset = align_up(directory_size, DATA_SECTION_ALIGNMENT);
+
+        auto offset = header.data_offset;
+
+        for (auto& entry : entries) {
+            entry.offset = offset;
+            offset = align_up(offset + entry.size, alignment);
+        }
+
+        std::ofstream stream{path, std::ios::binary | std::ios::trunc};
+
+        if (!stream) {
+            Util::log_error("Content image \"{}\": failed to open the file for writing.", path);
+            return false;
+        }
+
+        stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        stream.write(reinterpret_cast<const char*>(entries.data()),
+                     static_cast<std::streamsize>(entries.size() * sizeof(ImageEntry)));
+        stream.write(reinterpret_cast<const char*>(slots.data()),
+                     static_cast<std::streamsize>(slots.size() * sizeof(std::uint32_t)));
+        stream.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+
+        std::uint64_t position = directory_size;
+        auto entry = entries.cbegin();
+
+        for (const auto& [key, file] : files_) {
+            pad_to(stream, position, entry->offset);
+
+            if (!copy_file(stream, file.path, file.size)) {
+                Util::log_error("Content image \"{}\": file '{}' changed while packing.", path, file.path);
+                return false;
+            }
+
+            position += file.size;
+            ++entry;
+        }
+
+        stream.close();
+
+        if (!stream) {
+            Util::log_error("Content image \"{}\": failed to write the file.", path);
+            return false;
+        }
+
+        return true;
+    }
+}
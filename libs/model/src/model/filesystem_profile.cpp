@@ -0,0 +1,225 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#include "model/filesystem_profile.hpp"
+#include "util/file.hpp"
+#include "util/string.hpp"
+#include <algorithm>
+#include <cctype>
+#include <utility>
+
+namespace {
+    /// The name of the section that collects the activity before the first map is loaded.
+    constexpr auto* STARTUP_SECTION = "(startup)";
+
+    /// The name displayed for calls that searched all paths.
+    constexpr auto* ALL_PATH_IDS = "(all)";
+
+    /// Converts a path to the key used in the statistics: lowercase, with forward slashes.
+    void make_path_key(const std::string_view path, std::string& key)
+    {
+        key.assign(path);
+
+        std::transform(key.begin(), key.end(), key.begin(), [](const unsigned char ch) {
+            return '\\' == ch ? '/' : static_cast<char>(std::tolower(ch));
+        });
+    }
+
+    Model::FileIoStats& get_stats(std::unordered_map<std::string, Model::FileIoStats>& stats, const std::string& key)
+    {
+        if (const auto it = stats.find(key); it != stats.end()) {
+            return it->second;
+        }
+
+        return stats.emplace(key, Model::FileIoStats{}).first->second;
+    }
+
+    [[nodiscard]] double to_milliseconds(const std::chrono::nanoseconds time) noexcept
+    {
+        return std::chrono::duration<double, std::milli>(time).count();
+    }
+
+    [[nodiscard]] std::string format_stats(const std::string_view name, const Model::FileIoStats& stats)
+    {
+        return Util::str::format("  {:<48} {:>7} {:>6} {:>7} {:>11} {:>6} {:>10.3f} {:>9.3f}", name, stats.opens,
+                                 stats.misses, stats.reads, stats.bytes_read, stats.seeks,
+                                 to_milliseconds(stats.total_time), to_milliseconds(stats.max_time));
+    }
+
+    /// Sorts the statistics by the total time, the slowest first.
+    [[nodiscard]] std::vector<std::pair<std::string, Model::FileIoStats>>
+      sort_by_time(const std::unordered_map<std::string, Model::FileIoStats>& stats, const std::size_t top_count)
+    {
+        std::vector<std::pair<std::string, Model::FileIoStats>> sorted{stats.cbegin(), stats.cend()};
+        const auto count = std::min(top_count, sorted.size());
+
+        std::partial_sort(sorted.begin(), sorted.begin() + static_cast<std::ptrdiff_t>(count), sorted.end(),
+                          [](const auto& lhs, const auto& rhs) {
+                              return lhs.second.total_time > rhs.second.total_time;
+                          });
+
+        sorted.resize(count);
+
+        return sorted;
+    }
+
+    void append_report(const Model::MapIoProfile& map, const std::size_t top_count, std::vector<std::string>& lines)
+    {
+        const auto& total = map.total;
+
+        lines.emplace_back(Util::str::format(
+          "File system profile of map '{}': {} calls, {} files, {} opens, {} misses, {} bytes read, {:.3f} ms",
+          map.map_name, total.calls, map.paths.size(), total.opens, total.misses, total.bytes_read,
+          to_milliseconds(total.total_time)));
+
+        lines.emplace_back(Util::str::format("  {:<48} {:>7} {:>6} {:>7} {:>11} {:>6} {:>10} {:>9}", "path", "opens",
+                                             "misses", "reads", "bytes", "seeks", "time(ms)", "max(ms)"));
+
+        for (const auto& [path, stats] : sort_by_time(map.paths, top_count)) {
+            lines.emplace_back(format_stats(path, stats));
+        }
+
+        lines.emplace_back(Util::str::format("  {:<48}", "path id"));
+
+        for (const auto& [path_id, stats] : sort_by_time(map.path_ids, map.path_ids.size())) {
+            lines.emplace_back(format_stats(path_id.empty() ? ALL_PATH_IDS : path_id, stats));
+        }
+    }
+}
+
+namespace Model {
+    void FileIoStats::add(const FileOperation operation, const std::uint64_t bytes, const std::chrono::nanoseconds time,
+                          const bool success) noexcept
+    {
+        ++calls;
+        total_time += time;
+        max_time = std::max(max_time, time);
+
+        switch (operation) {
+            case FileOperation::open: {
+                if (success) {
+                    ++opens;
+                }
+                else {
+                    ++misses;
+                }
+
+                break;
+            }
+            case FileOperation::read: {
+                ++reads;
+                bytes_read += bytes;
+                break;
+            }
+            case FileOperation::write: {
+                ++writes;
+                bytes_written += bytes;
+                break;
+            }
+            case FileOperation::seek: {
+                ++seeks;
+                break;
+            }
+            case FileOperation::query: {
+                if (!success) {
+                    ++misses;
+                }
+
+                break;
+            }
+        }
+    }
+
+    FileSystemProfile::FileSystemProfile()
+    {
+        begin_map(STARTUP_SECTION);
+    }
+
+    void FileSystemProfile::begin_map(const std::string_view map_name)
+    {
+        const std::scoped_lock lock{mutex_};
+
+        if (maps_.size() >= MAX_MAPS) {
+            maps_.pop_front();
+        }
+
+        maps_.emplace_back().map_name = map_name;
+    }
+
+    void FileSystemProfile::record(const std::string_view path, const std::string_view path_id,
+                                   const FileOperation operation, const std::uint64_t bytes,
+                                   const std::chrono::nanoseconds time, const bool success)
+    {
+        // Reused to avoid an allocation for every recorded call
+        thread_local std::string key{};
+
+        const std::scoped_lock lock{mutex_};
+        auto& map = maps_.back();
+
+        make_path_key(path, key);
+        get_stats(map.paths, key).add(operation, bytes, time, success);
+
+        make_path_key(path_id, key);
+        get_stats(map.path_ids, key).add(operation, bytes, time, success);
+
+        map.total.add(operation, bytes, time, success);
+    }
+
+    void FileSystemProfile::reset()
+    {
+        const std::scoped_lock lock{mutex_};
+        auto map_name = std::move(maps_.back().map_name);
+
+        maps_.clear();
+        maps_.emplace_back().map_name = std::move(map_name);
+    }
+
+    std::vector<MapIoProfile> FileSystemProfile::get_maps() const
+    {
+        const std::scoped_lock lock{mutex_};
+        return {maps_.cbegin(), maps_.cend()};
+    }
+
+    std::vector<std::string> FileSystemProfile::report(const std::size_t top_count) const
+    {
+        std::vector<std::string> lines{};
+        const std::scoped_lock lock{mutex_};
+
+        append_report(maps_.back(), top_count, lines);
+
+        return lines;
+    }
+
+    bool FileSystemProfile::dump(const std::string& filename, const std::size_t top_count) const
+    {
+        std::vector<std::string> lines{};
+
+        {
+            const std::scoped_lock lock{mutex_};
+
+            for (const auto& map : maps_) {
+                append_report(map, top_count, lines);
+                lines.emplace_back();
+            }
+        }
+
+        return Util::try_file_write_lines(filename, lines);
+    }
+}
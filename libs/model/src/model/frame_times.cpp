@@ -0,0 +1,87 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+
+#include "model/frame_times.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+    /// Gets a percentile of the samples by the nearest-rank method, reorders the samples.
+    float get_percentile(std::vector<std::uint32_t>& samples, const double percentile)
+    {
+        const auto rank = static_cast<std::size_t>(std::ceil(percentile * static_cast<double>(samples.size())));
+        const auto nth = samples.begin() + static_cast<std::ptrdiff_t>(std::max<std::size_t>(rank, 1) - 1);
+        std::nth_element(samples.begin(), nth, samples.end());
+
+        return static_cast<float>(*nth) / 1000.0F;
+    }
+}
+
+namespace Model {
+    FrameTimes::FrameTimes(const std::size_t max_samples) :
+      max_samples_(std::max<std::size_t>(max_samples, 1))
+    {
+        samples_.reserve(max_samples_);
+    }
+
+    void FrameTimes::mark_frame() noexcept
+    {
+        const auto now = std::chrono::steady_clock::now();
+
+        if (frame_start_) {
+            record(now - *frame_start_);
+        }
+
+        frame_start_ = now;
+    }
+
+    void FrameTimes::record(const std::chrono::nanoseconds frame_time) noexcept
+    {
+        ++num_frames_;
+        total_time_ += frame_time;
+
+        if (samples_.size() < max_samples_) {
+            const auto microseconds = std::chrono::duration_cast<std::chrono::microseconds>(frame_time).count();
+            samples_.push_back(static_cast<std::uint32_t>(
+              std::clamp<decltype(microseconds)>(microseconds, 0, std::numeric_limits<std::uint32_t>::max())));
+        }
+    }
+
+    FrameTimeStats FrameTimes::take_stats()
+    {
+        FrameTimeStats stats{};
+
+        if (!samples_.empty() && total_time_.count() > 0) {
+            const auto seconds = std::chrono::duration<double>{total_time_}.count();
+            stats.fps = static_cast<float>(static_cast<double>(num_frames_) / seconds);
+            stats.max_ms = static_cast<float>(*std::max_element(samples_.cbegin(), samples_.cend())) / 1000.0F;
+            stats.median_ms = get_percentile(samples_, 0.5);
+            stats.p99_ms = get_percentile(samples_, 0.99);
+        }
+
+        samples_.clear();
+        num_frames_ = 0;
+        total_time_ = std::chrono::nanoseconds{0};
+
+        return stats;
+    }
+}
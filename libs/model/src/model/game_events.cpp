@@ -0,0 +1,577 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+
+#include "model/game_events.hpp"
+#include "util/logger.hpp"
+#include "util/string.hpp"
+#include <fmt/format.h>
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iterator>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #define GAME_EVENTS_SSE2
+  #include <emmintrin.h>
+#endif
+
+#ifndef _WIN32
+  #include <fcntl.h>
+  #include <sys/socket.h>
+  #include <sys/un.h>
+  #include <csignal>
+  #include <ctime>
+  #include <unistd.h>
+#endif
+
+namespace {
+    /// The maximum number of records waiting for the helper thread.
+    constexpr std::size_t MAX_QUEUED_RECORDS = 4096;
+
+    /// The interval at which the helper thread retries opening a named pipe without a reader.
+    constexpr std::chrono::seconds REOPEN_INTERVAL{1};
+
+    /// The size of the prefix "L MM/DD/YYYY - hh:mm:ss: " of the game log lines.
+    constexpr std::size_t LOG_PREFIX_SIZE = 25;
+
+    /// The prefix pattern, the digits are masked out.
+    constexpr std::string_view LOG_PREFIX_PATTERN = "L 00/00/0000 - 00:00:00: ";
+
+    /// Whether a character of the prefix is fixed rather than a digit.
+    [[nodiscard]] constexpr bool is_fixed_prefix_char(const std::size_t index) noexcept
+    {
+        return LOG_PREFIX_PATTERN[index] != '0';
+    }
+
+    /// The first 16 characters of the prefix, the digit positions are masked out.
+    constexpr auto prefix_chars = [] {
+        std::array<char, 16> chars{};
+
+        for (std::size_t i = 0; i < chars.size(); ++i) {
+            chars[i] = is_fixed_prefix_char(i) ? LOG_PREFIX_PATTERN[i] : '\0';
+        }
+
+        return chars;
+    }();
+
+    /// The mask of the fixed characters among the first 16 characters of the prefix.
+    constexpr auto prefix_mask = [] {
+        std::array<char, 16> mask{};
+
+        for (std::size_t i = 0; i < mask.size(); ++i) {
+            mask[i] = is_fixed_prefix_char(i) ? static_cast<char>(0xFF) : '\0';
+        }
+
+        return mask;
+    }();
+
+    /// A player as written in the log, \c "Name<uid><steamid><team>".
+    struct Player {
+        std::string_view name{};
+        std::string_view steam_id{};
+        std::string_view team{};
+    };
+
+    /// Takes the text between the angle brackets at the end of a player token.
+    [[nodiscard]] bool take_bracketed(std::string_view& token, std::string_view& value) noexcept
+    {
+        if (token.empty() || token.back() != '>') {
+            return false;
+        }
+
+        const auto start = token.rfind('<');
+
+        if (std::string_view::npos == start) {
+            return false;
+        }
+
+        value = token.substr(start + 1, token.size() - start - 2);
+        token.remove_suffix(token.size() - start);
+
+        return true;
+    }
+
+    /// Parses a player token without the quotes.
+    [[nodiscard]] bool parse_player(std::string_view token, Player& player) noexcept
+    {
+        std::string_view user_id{};
+
+        if (!take_bracketed(token, player.team) || !take_bracketed(token, player.steam_id) ||
+            !take_bracketed(token, user_id)) {
+            return false;
+        }
+
+        player.name = token;
+
+        return true;
+    }
+
+    /// Takes a quoted player from the beginning of the text, the player ends at the first \c >" sequence.
+    [[nodiscard]] bool take_player(std::string_view& text, Player& player) noexcept
+    {
+        if (text.empty() || text.front() != '"') {
+            return false;
+        }
+
+        const auto end = text.find(">\"", 1);
+
+        if (std::string_view::npos == end || !parse_player(text.substr(1, end), player)) {
+            return false;
+        }
+
+        text.remove_prefix(end + 2);
+
+        return true;
+    }
+
+    /// Takes a quoted string from the beginning of the text.
+    [[nodiscard]] bool take_quoted(std::string_view& text, std::string_view& value) noexcept
+    {
+        if (text.empty() || text.front() != '"') {
+            return false;
+        }
+
+        const auto end = text.find('"', 1);
+
+        if (std::string_view::npos == end) {
+            return false;
+        }
+
+        value = text.substr(1, end - 1);
+        text.remove_prefix(end + 1);
+
+        return true;
+    }
+
+    /// Checks if the text starts with a prefix.
+    [[nodiscard]] bool starts_with(const std::string_view text, const std::string_view prefix) noexcept
+    {
+        return text.substr(0, prefix.size()) == prefix;
+    }
+
+    /// Removes a prefix from the text if it is there.
+    [[nodiscard]] bool consume(std::string_view& text, const std::string_view prefix) noexcept
+    {
+        if (!starts_with(text, prefix)) {
+            return false;
+        }
+
+        text.remove_prefix(prefix.size());
+
+        return true;
+    }
+
+    /// Appends a field to a record, the separators in the value are replaced with spaces.
+    void append_field(std::string& record, const std::string_view value)
+    {
+        record.push_back('\t');
+
+        for (const auto c : value) {
+            record.push_back('\t' == c || '\n' == c || '\r' == c ? ' ' : c);
+        }
+    }
+
+    /// Appends the fields of a player to a record.
+    void append_player(std::string& record, const Player& player)
+    {
+        append_field(record, player.name);
+        append_field(record, player.steam_id);
+        append_field(record, player.team);
+    }
+}
+
+namespace Model {
+    unsigned parse_game_event_types(const std::string_view names)
+    {
+        unsigned types = 0;
+
+        for (std::size_t start = 0; start <= names.size();) {
+            const auto end = std::min(names.find(',', start), names.size());
+            const auto type = Util::str::to_lower(Util::str::trim(names.substr(start, end - start)));
+            start = end + 1;
+
+            if ("kill" == type) {
+                types |= static_cast<unsigned>(GameEventType::kill);
+            }
+            else if ("connect" == type) {
+                types |= static_cast<unsigned>(GameEventType::connect);
+            }
+            else if ("enter" == type) {
+                types |= static_cast<unsigned>(GameEventType::enter);
+            }
+            else if ("disconnect" == type) {
+                types |= static_cast<unsigned>(GameEventType::disconnect);
+            }
+            else if ("map" == type) {
+                types |= static_cast<unsigned>(GameEventType::map_change);
+            }
+        }
+
+        return types;
+    }
+
+    bool has_game_log_prefix(const std::string_view line) noexcept
+    {
+        if (line.size() < LOG_PREFIX_SIZE) {
+            return false;
+        }
+
+#ifdef GAME_EVENTS_SSE2
+        const auto data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(line.data()));
+        const auto mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(prefix_mask.data()));
+        const auto chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(prefix_chars.data()));
+
+        // The fixed characters must match and the rest must be digits
+        const auto fixed = _mm_and_si128(_mm_cmpeq_epi8(data, chars), mask);
+        const auto digits = _mm_andnot_si128(mask, _mm_and_si128(_mm_cmpgt_epi8(data, _mm_set1_epi8('0' - 1)),
+                                                                 _mm_cmplt_epi8(data, _mm_set1_epi8('9' + 1))));
+
+        if (_mm_movemask_epi8(_mm_or_si128(fixed, digits)) != 0xFFFF) {
+            return false;
+        }
+
+        constexpr std::size_t checked_size = 16;
+#else
+        constexpr std::size_t checked_size = 0;
+#endif
+
+        for (auto i = checked_size; i < LOG_PREFIX_SIZE; ++i) {
+            if (is_fixed_prefix_char(i) ? line[i] != LOG_PREFIX_PATTERN[i] : (line[i] < '0' || line[i] > '9')) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    GameEventExtractor::GameEventExtractor(const unsigned types) noexcept : types_(types)
+    {
+        queue_.set_capacity(MAX_QUEUED_RECORDS);
+    }
+
+    GameEventExtractor::~GameEventExtractor()
+    {
+        if (thread_.joinable()) {
+            stopping_.store(true, std::memory_order_release);
+
+            // Wakes up the helper thread, which checks the flag after each record anyway
+            [[maybe_unused]] const auto woken = queue_.try_push(std::string{});
+            thread_.join();
+        }
+
+        if (file_ != nullptr) {
+            std::fclose(file_);
+        }
+
+#ifndef _WIN32
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+
+        if (socket_ >= 0) {
+            ::close(socket_);
+        }
+#endif
+    }
+
+    bool GameEventExtractor::open(const std::string& destination)
+    {
+        const std::lock_guard lock{mutex_};
+
+        if (thread_.joinable()) {
+            return true;
+        }
+
+#ifndef _WIN32
+        if (constexpr std::string_view unix_prefix = "unix:"; starts_with(destination, unix_prefix)) {
+            const auto path = std::string_view{destination}.substr(unix_prefix.size());
+            ::sockaddr_un address{};
+            address.sun_family = AF_UNIX;
+
+            if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+                Util::log_error("Invalid game event socket path '{}'", path);
+                return false;
+            }
+
+            std::memcpy(address.sun_path, path.data(), path.size());
+            socket_ = ::socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+
+            if (socket_ < 0 || ::connect(socket_, reinterpret_cast<const ::sockaddr*>(&address), sizeof(address)) < 0) {
+                Util::log_error("Failed to connect to the game event socket '{}': {}", path, std::strerror(errno));
+                return false;
+            }
+
+            thread_ = std::thread{&GameEventExtractor::run, this};
+
+            return true;
+        }
+#endif
+
+        path_ = destination;
+
+        if (!open_file()) {
+#ifndef _WIN32
+            // A named pipe without a reader, the helper thread opens it once a reader appears
+            if (ENXIO == errno) {
+                Util::log_info("Game events are written to '{}' once it is opened for reading.", path_);
+                thread_ = std::thread{&GameEventExtractor::run, this};
+
+                return true;
+            }
+#endif
+            Util::log_error("Failed to open the game event file '{}': {}", path_, std::strerror(errno));
+            return false;
+        }
+
+        thread_ = std::thread{&GameEventExtractor::run, this};
+
+        return true;
+    }
+
+    void GameEventExtractor::feed(std::string_view text)
+    {
+        const std::lock_guard lock{mutex_};
+
+        while (!text.empty()) {
+            const auto end = text.find('\n');
+
+            if (std::string_view::npos == end) {
+                partial_line_.append(text);
+                return;
+            }
+
+            if (partial_line_.empty()) {
+                process_line(text.substr(0, end));
+            }
+            else {
+                partial_line_.append(text.substr(0, end));
+                process_line(partial_line_);
+                partial_line_.clear();
+            }
+
+            text.remove_prefix(end + 1);
+        }
+    }
+
+    bool GameEventExtractor::process_line(std::string_view line)
+    {
+        if (!line.empty() && '\r' == line.back()) {
+            line.remove_suffix(1);
+        }
+
+        if (!has_game_log_prefix(line) || !format_record(line.substr(LOG_PREFIX_SIZE))) {
+            return false;
+        }
+
+        ++event_count_;
+        write_record();
+
+        return true;
+    }
+
+    bool GameEventExtractor::format_record(std::string_view body)
+    {
+        const auto is_enabled = [this](const GameEventType type) {
+            return (types_ & static_cast<unsigned>(type)) != 0;
+        };
+
+        const auto time = std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::system_clock::now().time_since_epoch());
+
+        record_.clear();
+        fmt::format_to(std::back_inserter(record_), "{}", time.count());
+
+        if (consume(body, "Started map ")) {
+            std::string_view map_name{};
+
+            if (!is_enabled(GameEventType::map_change) || !take_quoted(body, map_name)) {
+                return false;
+            }
+
+            record_.append("\tmap");
+            append_field(record_, map_name);
+
+            return true;
+        }
+
+        Player player{};
+
+        if (!take_player(body, player)) {
+            return false;
+        }
+
+        if (consume(body, " killed ")) {
+            Player victim{};
+            std::string_view weapon{};
+
+            if (!is_enabled(GameEventType::kill) || !take_player(body, victim) || !consume(body, " with ") ||
+                !take_quoted(body, weapon)) {
+                return false;
+            }
+
+            record_.append("\tkill");
+            append_player(record_, player);
+            append_player(record_, victim);
+            append_field(record_, weapon);
+        }
+        else if (consume(body, " connected, address ")) {
+            std::string_view address{};
+
+            if (!is_enabled(GameEventType::connect) || !take_quoted(body, address)) {
+                return false;
+            }
+
+            record_.append("\tconnect");
+            append_player(record_, player);
+            append_field(record_, address);
+        }
+        else if (starts_with(body, " entered the game")) {
+            if (!is_enabled(GameEventType::enter)) {
+                return false;
+            }
+
+            record_.append("\tenter");
+            append_player(record_, player);
+        }
+        else if (starts_with(body, " disconnected")) {
+            if (!is_enabled(GameEventType::disconnect)) {
+                return false;
+            }
+
+            record_.append("\tdisconnect");
+            append_player(record_, player);
+        }
+        else {
+            return false;
+        }
+
+        return true;
+    }
+
+    void GameEventExtractor::write_record()
+    {
+        // Formatted on the calling thread, the output is only accessed by the helper thread
+        if (!thread_.joinable()) {
+            return;
+        }
+
+        std::string record{};
+        record.reserve(record_.size() + 1);
+        record.append(record_).push_back('\n');
+
+        if (!queue_.try_push(std::move(record))) {
+            dropped_count_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void GameEventExtractor::run()
+    {
+#ifndef _WIN32
+        // A reader that exits makes the writes to a named pipe fail with EPIPE, the signal is kept pending
+        // on this thread instead of terminating the process
+        ::sigset_t sigpipe{};
+        ::sigemptyset(&sigpipe);
+        ::sigaddset(&sigpipe, SIGPIPE);
+        ::pthread_sigmask(SIG_BLOCK, &sigpipe, nullptr);
+#endif
+
+        for (std::string record{};;) {
+            if (!queue_.pop_for(record, REOPEN_INTERVAL)) {
+                if (stopping_.load(std::memory_order_acquire)) {
+                    break;
+                }
+
+                continue;
+            }
+
+            if (!record.empty()) {
+                write_output(record);
+            }
+            else if (stopping_.load(std::memory_order_acquire) && queue_.empty()) {
+                break;
+            }
+        }
+    }
+
+    void GameEventExtractor::write_output(const std::string& record)
+    {
+        auto written = false;
+
+#ifdef _WIN32
+        // Stats collectors read the records as they come, a record is never left in a buffer
+        if (file_ != nullptr) {
+            written = std::fwrite(record.data(), 1, record.size(), file_) == record.size();
+            std::fflush(file_);
+        }
+#else
+        if (socket_ >= 0) {
+            // A datagram is dropped rather than waited for when the reader does not keep up
+            written = ::send(socket_, record.data(), record.size(), MSG_DONTWAIT | MSG_NOSIGNAL) >= 0;
+        }
+        else if ((fd_ >= 0) || ((std::chrono::steady_clock::now() - open_time_ >= REOPEN_INTERVAL) && open_file())) {
+            // The records are shorter than PIPE_BUF, so a write to a pipe is either complete or fails with EAGAIN
+            const auto result = ::write(fd_, record.data(), record.size());
+            written = result >= 0;
+
+            if ((result < 0) && (EPIPE == errno)) {
+                const ::timespec no_wait{};
+                ::sigset_t sigpipe{};
+                ::sigemptyset(&sigpipe);
+                ::sigaddset(&sigpipe, SIGPIPE);
+                ::sigtimedwait(&sigpipe, nullptr, &no_wait);
+
+                Util::log_warn("The reader of the game events '{}' has exited.", path_);
+                ::close(fd_);
+                fd_ = -1;
+            }
+        }
+#endif
+
+        if (!written) {
+            dropped_count_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        if (const auto dropped = dropped_count_.load(std::memory_order_relaxed); dropped != dropped_reported_) {
+            Util::log_warn("{} game events were dropped because the output did not keep up.",
+                           dropped - dropped_reported_);
+            dropped_reported_ = dropped;
+        }
+    }
+
+    bool GameEventExtractor::open_file()
+    {
+        open_time_ = std::chrono::steady_clock::now();
+
+#ifdef _WIN32
+        file_ = std::fopen(path_.c_str(), "ab");
+
+        return file_ != nullptr;
+#else
+        // Without O_NONBLOCK opening a named pipe waits for a reader, and writing to it waits for the reader
+        fd_ = ::open(path_.c_str(), O_WRONLY | O_APPEND | O_CREAT | O_NONBLOCK | O_CLOEXEC, 0644);
+
+        return fd_ >= 0;
+#endif
+    }
+}
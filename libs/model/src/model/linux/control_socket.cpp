@@ -0,0 +1,440 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+
+#include "model/linux/control_socket.hpp"
+#include "util/linux/reactor.hpp"
+#include "util/linux/system/error.hpp"
+#include "util/logger.hpp"
+#include "util/string.hpp"
+#include <fmt/format.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <unistd.h>
+#include <utility>
+
+namespace {
+    /// The maximum number of connected clients.
+    constexpr std::size_t MAX_CLIENTS = 16;
+
+    /// The maximum number of requests executed by one server loop task.
+    constexpr std::size_t MAX_BATCH_SIZE = 256;
+
+    /// The number of queued requests at which the clients stop being read until replies are sent.
+    constexpr std::size_t MAX_IN_FLIGHT = 4096;
+
+    /// The number of reply bytes buffered for a client at which it stops being read.
+    constexpr std::size_t MAX_CLIENT_PENDING_SIZE = 4 * 1024 * 1024;
+
+    /// The size of the buffer the requests are received into.
+    constexpr std::size_t RECEIVE_BUFFER_SIZE = 16 * 1024;
+
+    /// Binds a socket to a path only the owner can connect to.
+    bool bind_private(const int fd, const std::string& socket_path)
+    {
+        // The socket is bound in a new directory only the owner can enter, restricted and then moved to its
+        // path, so there is no window where other users can connect. Changing the umask would also affect
+        // the files created by the other threads in the meantime.
+        const auto separator = socket_path.rfind('/');
+        auto directory = std::string::npos == separator ? std::string{} : socket_path.substr(0, separator + 1);
+        directory.append(".controlsocket.XXXXXX");
+
+        if (nullptr == ::mkdtemp(directory.data())) {
+            return false;
+        }
+
+        const auto private_path = directory + "/socket";
+        ::sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        auto bound = false;
+
+        if (private_path.size() >= sizeof(address.sun_path)) {
+            errno = ENAMETOOLONG;
+        }
+        else {
+            std::memcpy(address.sun_path, private_path.c_str(), private_path.size() + 1);
+            bound = ::bind(fd, reinterpret_cast<const ::sockaddr*>(&address), sizeof(address)) >= 0 &&
+                    ::chmod(private_path.c_str(), S_IRUSR | S_IWUSR) >= 0 &&
+                    ::rename(private_path.c_str(), socket_path.c_str()) >= 0;
+        }
+
+        const auto error = errno;
+
+        if (!bound) {
+            ::unlink(private_path.c_str());
+        }
+
+        ::rmdir(directory.c_str());
+        errno = error;
+
+        return bound;
+    }
+}
+
+namespace Model {
+    struct ControlSocket::Completions {
+        Completions() : event_fd(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+        {
+        }
+
+        ~Completions()
+        {
+            if (event_fd >= 0) {
+                ::close(event_fd);
+            }
+        }
+
+        /// Move constructor.
+        Completions(Completions&&) = delete;
+
+        /// Copy constructor.
+        Completions(const Completions&) = delete;
+
+        /// Move assignment operator.
+        Completions& operator=(Completions&&) = delete;
+
+        /// Copy assignment operator.
+        Completions& operator=(const Completions&) = delete;
+
+        /// Guards the executed requests.
+        std::mutex mutex{};
+
+        /// The executed requests not collected by the reactor yet.
+        std::vector<Request> requests{};
+
+        /// Indicates whether the socket has stopped and the queued requests are to be discarded.
+        std::atomic<bool> closed{};
+
+        /// Signals the reactor that requests have been executed.
+        int event_fd;
+    };
+
+    ControlSocket::ControlSocket(ServerLoopPtr server_loop, ConsoleCommandsPtr console_commands) :
+      server_loop_(std::move(server_loop)),
+      console_commands_(std::move(console_commands))
+    {
+        assert(server_loop_ != nullptr);
+        assert(console_commands_ != nullptr);
+    }
+
+    ControlSocket::~ControlSocket()
+    {
+        stop();
+    }
+
+    bool ControlSocket::start(const std::string& socket_path)
+    {
+        const std::lock_guard lock{mutex_};
+
+        if (listen_fd_ >= 0) {
+            return true;
+        }
+
+        if (socket_path.empty() || socket_path.size() >= sizeof(::sockaddr_un::sun_path)) {
+            Util::log_error("Invalid control socket path '{}'", socket_path);
+            return false;
+        }
+
+        auto completions = std::make_shared<Completions>();
+
+        if (completions->event_fd < 0) {
+            Util::log_error("Failed to create the control socket event: {}", Util::get_last_error_string());
+            return false;
+        }
+
+        listen_fd_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+        if (listen_fd_ < 0) {
+            Util::log_error("Failed to create the control socket: {}", Util::get_last_error_string());
+            return false;
+        }
+
+        // Only the owner can connect, the commands run with the full rights of the server console.
+        // A socket left behind by a previous run is replaced.
+        if (!bind_private(listen_fd_, socket_path) || ::listen(listen_fd_, SOMAXCONN) < 0) {
+            Util::log_error("Failed to listen on '{}': {}", socket_path, Util::get_last_error_string());
+            ::close(listen_fd_);
+            listen_fd_ = -1;
+            return false;
+        }
+
+        socket_path_ = socket_path;
+        completions_ = std::move(completions);
+        in_flight_ = 0;
+
+        auto& reactor = Util::get_reactor();
+
+        if (!reactor.add(listen_fd_, EPOLLIN, [this](std::uint32_t) { accept_clients(); }) ||
+            !reactor.add(completions_->event_fd, EPOLLIN, [this](std::uint32_t) {
+                collect_replies();
+                serve_clients();
+            })) {
+            Util::log_error("Failed to serve the control socket, the launcher reactor is not running");
+            reactor.remove(listen_fd_);
+            completions_.reset();
+            ::close(listen_fd_);
+            listen_fd_ = -1;
+            ::unlink(socket_path.c_str());
+            return false;
+        }
+
+        return true;
+    }
+
+    void ControlSocket::stop()
+    {
+        const std::lock_guard lock{mutex_};
+
+        if (listen_fd_ < 0) {
+            return;
+        }
+
+        // The clients are only used on the reactor thread, a handler may be running
+        Util::get_reactor().run_and_wait([this] {
+            auto& reactor = Util::get_reactor();
+            reactor.remove(listen_fd_);
+            reactor.remove(completions_->event_fd);
+
+            for (const auto& client : clients_) {
+                close_client(client);
+            }
+
+            clients_.clear();
+        });
+
+        completions_->closed = true;
+        completions_.reset();
+        ::close(listen_fd_);
+        listen_fd_ = -1;
+        ::unlink(socket_path_.c_str());
+    }
+
+    void ControlSocket::accept_clients()
+    {
+        while (true) {
+            const auto fd = ::accept4(listen_fd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+            if (fd < 0) {
+                return;
+            }
+
+            const auto serial = next_serial_;
+
+            if (clients_.size() >= MAX_CLIENTS ||
+                !Util::get_reactor().add(fd, EPOLLIN, [this, serial](const std::uint32_t events) {
+                    on_client_event(serial, events);
+                })) {
+                ::close(fd);
+                continue;
+            }
+
+            clients_.push_back({fd, serial, EPOLLIN});
+            ++next_serial_;
+        }
+    }
+
+    void ControlSocket::on_client_event(const std::uint64_t serial, const std::uint32_t events)
+    {
+        const auto client = std::find_if(clients_.begin(), clients_.end(), [serial](const Client& candidate) {
+            return candidate.serial == serial;
+        });
+
+        if (client == clients_.end()) {
+            return;
+        }
+
+        std::vector<Request> batch{};
+        // A hang-up means the client has closed both directions and cannot receive its replies
+        auto connected = (events & (EPOLLERR | EPOLLHUP)) == 0;
+
+        if (connected && (events & EPOLLIN) != 0) {
+            connected = receive_requests(*client, batch);
+        }
+
+        if (!connected) {
+            close_client(*client);
+            clients_.erase(client);
+        }
+
+        if (!batch.empty()) {
+            enqueue_batch(std::move(batch));
+        }
+
+        // The number of requests in flight decides whether the other clients are read as well
+        serve_clients();
+    }
+
+    bool ControlSocket::receive_requests(Client& client, std::vector<Request>& batch)
+    {
+        char buffer[RECEIVE_BUFFER_SIZE];
+        const auto received = ::recv(client.fd, buffer, sizeof(buffer), 0);
+
+        if (received < 0) {
+            return EAGAIN == errno || EINTR == errno;
+        }
+
+        const auto add_request = [&client, &batch](const std::string_view line) {
+            const auto separator = line.find_first_of(" \t");
+            auto command =
+              std::string_view::npos == separator ? std::string{} : Util::str::trim(line.substr(separator));
+
+            batch.push_back({client.serial, std::string{line.substr(0, separator)}, std::move(command)});
+            ++client.in_flight;
+        };
+
+        const auto in_flight = client.in_flight;
+
+        if (0 == received) {
+            // The client has finished sending, the replies to its requests are still delivered
+            client.splitter.finish(add_request);
+            client.input_closed = true;
+        }
+        else {
+            client.splitter.feed({buffer, static_cast<std::size_t>(received)}, add_request);
+        }
+
+        in_flight_ += client.in_flight - in_flight;
+
+        return true;
+    }
+
+    void ControlSocket::enqueue_batch(std::vector<Request> batch)
+    {
+        for (std::size_t first = 0; first < batch.size(); first += MAX_BATCH_SIZE) {
+            const auto last = std::min(first + MAX_BATCH_SIZE, batch.size());
+            auto requests = std::make_shared<std::vector<Request>>(
+              std::make_move_iterator(std::next(batch.begin(), static_cast<std::ptrdiff_t>(first))),
+              std::make_move_iterator(std::next(batch.begin(), static_cast<std::ptrdiff_t>(last))));
+
+            server_loop_->enqueue_task<void>(
+              [completions = completions_, console_commands = console_commands_, requests = std::move(requests)] {
+                  if (completions->closed.load(std::memory_order_relaxed)) {
+                      return;
+                  }
+
+                  for (auto& request : *requests) {
+                      if (!request.command.empty()) {
+                          request.output = console_commands->execute(request.command);
+                      }
+                  }
+
+                  {
+                      const std::lock_guard lock{completions->mutex};
+                      std::move(requests->begin(), requests->end(), std::back_inserter(completions->requests));
+                  }
+
+                  constexpr std::uint64_t signal = 1;
+                  [[maybe_unused]] const auto written = ::write(completions->event_fd, &signal, sizeof(signal));
+              });
+        }
+    }
+
+    void ControlSocket::collect_replies()
+    {
+        std::uint64_t signal = 0;
+        [[maybe_unused]] const auto read = ::read(completions_->event_fd, &signal, sizeof(signal));
+
+        std::vector<Request> requests{};
+        {
+            const std::lock_guard lock{completions_->mutex};
+            requests.swap(completions_->requests);
+        }
+
+        in_flight_ -= std::min(in_flight_, requests.size());
+
+        for (const auto& request : requests) {
+            const auto client = std::find_if(clients_.begin(), clients_.end(), [&request](const Client& candidate) {
+                return candidate.serial == request.client;
+            });
+
+            // The client has disconnected before the reply
+            if (client == clients_.end()) {
+                continue;
+            }
+
+            fmt::format_to(std::back_inserter(client->pending), "{} {}\n", request.id, request.output.size());
+            client->pending.append(request.output);
+            --client->in_flight;
+        }
+    }
+
+    void ControlSocket::serve_clients()
+    {
+        for (std::size_t i = clients_.size(); i-- > 0;) {
+            auto& client = clients_[i];
+
+            if (!send_replies(client) || (client.input_closed && 0 == client.in_flight && client.pending.empty())) {
+                close_client(client);
+                clients_.erase(clients_.begin() + static_cast<std::ptrdiff_t>(i));
+                continue;
+            }
+
+            std::uint32_t events = 0;
+
+            if (!client.input_closed && in_flight_ < MAX_IN_FLIGHT && client.pending.size() < MAX_CLIENT_PENDING_SIZE) {
+                events |= EPOLLIN;
+            }
+
+            if (!client.pending.empty()) {
+                events |= EPOLLOUT;
+            }
+
+            if (events != client.events && Util::get_reactor().modify(client.fd, events)) {
+                client.events = events;
+            }
+        }
+    }
+
+    bool ControlSocket::send_replies(Client& client)
+    {
+        if (client.pending.empty()) {
+            return true;
+        }
+
+        const auto sent = ::send(client.fd, client.pending.data(), client.pending.size(), MSG_NOSIGNAL);
+
+        if (sent < 0) {
+            return EAGAIN == errno || EINTR == errno;
+        }
+
+        client.pending.erase(0, static_cast<std::size_t>(sent));
+
+        return true;
+    }
+
+    void ControlSocket::close_client(const Client& client)
+    {
+        Util::get_reactor().remove(client.fd);
+        ::close(client.fd);
+    }
+}
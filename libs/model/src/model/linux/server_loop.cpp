@@ -21,10 +21,11 @@
 #include "model/server_loop.hpp"
 #include "common/engine/engine_wrapper.hpp"
 #include "common/engine/interface/dedicated_serverapi_interface.hpp"
-#include "util/signal.hpp"
-#include <sys/time.h>
+#include "util/linux/system/error.hpp"
+#include "util/logger.hpp"
+#include <sys/timerfd.h>
 #include <chrono>
-#include <csignal>
+#include <cstdint>
 #include <cstdlib>
 #include <optional>
 #include <poll.h>
@@ -38,29 +39,8 @@ namespace {
     using SleepNetFunc = int (*)();
     SleepNetFunc sleep_thread_net = nullptr;
 
-    /// Track pause status
-    volatile std::sig_atomic_t paused = 0;
-
-    int set_timer_real() noexcept
-    {
-        constexpr itimerval timer_value{
-          {0, 0   },
-          {0, 1000}
-        };
-
-        return ::setitimer(::ITIMER_REAL, &timer_value, nullptr);
-    }
-
-    void sigalrm_handler(const int /* signal_number */) noexcept
-    {
-        if (SIG_ERR == std::signal(SIGALRM, &sigalrm_handler)) {
-            std::abort();
-        }
-
-        if (0 == paused) {
-            set_timer_real();
-        }
-    }
+    /// The one-shot timer the server thread waits on with pingboost 1.
+    int sleep_timer_fd = -1;
 
     SleepNetFunc get_sleep_net_func() noexcept
     {
@@ -78,13 +58,16 @@ namespace {
     /// pingboost 1
     void sleep_timer() noexcept
     {
-        paused = 0;
+        constexpr ::itimerspec timer_value{
+          {0, 0        },
+          {0, 1'000'000}
+        };
 
-        if (0 == set_timer_real()) {
-            ::pause();
+        // The read blocks until the timer expires, no signal is involved
+        if (0 == ::timerfd_settime(sleep_timer_fd, 0, &timer_value, nullptr)) {
+            std::uint64_t expirations = 0;
+            [[maybe_unused]] const auto bytes_read = ::read(sleep_timer_fd, &expirations, sizeof(expirations));
         }
-
-        paused = 1;
     }
 
     /// pingboost 2
@@ -117,6 +100,15 @@ namespace {
         std::this_thread::yield();
     }
 
+    /// Closes the pingboost timer once the server loop has finished.
+    void close_sleep_timer() noexcept
+    {
+        if (sleep_timer_fd >= 0) {
+            ::close(sleep_timer_fd);
+            sleep_timer_fd = -1;
+        }
+    }
+
     SleepFunc get_sleep_func(const int pingboost) noexcept
     {
         constexpr auto pingboost_timer = 1;
@@ -125,8 +117,11 @@ namespace {
         constexpr auto pingboost_sleep = 4;
         constexpr auto pingboost_yield = 5;
 
-        if (pingboost_timer == pingboost) {
-            if (!Util::try_set_signal_handler(SIGALRM, &sigalrm_handler)) {
+        if (pingboost_timer == pingboost && sleep_timer_fd < 0) {
+            sleep_timer_fd = ::timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+
+            if (sleep_timer_fd < 0) {
+                Util::log_critical("Failed to create the pingboost timer: {}", Util::get_last_error_string());
                 std::abort();
             }
         }
@@ -159,7 +154,10 @@ namespace Model {
                 sleep_thread();
                 process_tasks();
                 process_input(serverapi_interface);
+                update_status(serverapi_interface);
             }
+
+            close_sleep_timer();
         }
     }
 }
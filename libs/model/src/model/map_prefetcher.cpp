@@ -0,0 +1,435 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#include "model/map_prefetcher.hpp"
+#include "util/file.hpp"
+#include "util/logger.hpp"
+#include "util/string.hpp"
+#include "util/system.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <unordered_set>
+#include <utility>
+
+namespace {
+    /// Time given to the engine to finish loading the current map before the next one is prefetched.
+    constexpr std::chrono::seconds SETTLE_DELAY{15};
+
+    /// The version of the Half-Life BSP format.
+    constexpr std::int32_t BSP_VERSION = 30;
+
+    /// The index of the entities lump in the BSP header.
+    constexpr std::size_t BSP_LUMP_ENTITIES = 0;
+
+    /// The number of lumps in the BSP header.
+    constexpr std::size_t BSP_HEADER_LUMPS = 15;
+
+    /// The maximum size of the entities lump that will be parsed.
+    constexpr std::int32_t BSP_MAX_ENTITIES_SIZE = 16 * 1024 * 1024;
+
+    /// The sides of a sky box, in the order the engine loads them.
+    constexpr std::array<std::string_view, 6> SKY_SIDES{"rt", "bk", "lf", "ft", "up", "dn"};
+
+    struct BspLump {
+        std::int32_t offset;
+        std::int32_t length;
+    };
+
+    struct BspHeader {
+        std::int32_t version;
+        std::array<BspLump, BSP_HEADER_LUMPS> lumps;
+    };
+
+    [[nodiscard]] bool ends_with_no_case(const std::string_view str, const std::string_view suffix)
+    {
+        return (str.size() >= suffix.size()) &&
+               Util::str::equal(Util::str::to_lower(str.substr(str.size() - suffix.size())), suffix);
+    }
+
+    [[nodiscard]] std::string normalize_map_name(std::string_view map_name)
+    {
+        // The engine reports the map name in a fixed-size buffer padded with NULs
+        if (const auto pos = map_name.find('\0'); pos != std::string_view::npos) {
+            map_name.remove_suffix(map_name.size() - pos);
+        }
+
+        if (const auto pos = map_name.find_last_of("/\\"); pos != std::string_view::npos) {
+            map_name.remove_prefix(pos + 1);
+        }
+
+        if (ends_with_no_case(map_name, ".bsp")) {
+            map_name.remove_suffix(4);
+        }
+
+        return Util::str::trim(map_name);
+    }
+
+    /// Removes a "//" comment from the end of the line.
+    [[nodiscard]] std::string_view strip_comment(std::string_view line)
+    {
+        if (const auto pos = line.find("//"); pos != std::string_view::npos) {
+            line.remove_suffix(line.size() - pos);
+        }
+
+        return line;
+    }
+
+    /// Reads the entities lump of a BSP file.
+    [[nodiscard]] std::string read_bsp_entities(const std::string& path)
+    {
+        std::ifstream file{path, std::ios::binary};
+        BspHeader header{};
+
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) || (header.version != BSP_VERSION)) {
+            return std::string{};
+        }
+
+        const auto& lump = header.lumps[BSP_LUMP_ENTITIES];
+
+        if ((lump.offset < 0) || (lump.length <= 0) || (lump.length > BSP_MAX_ENTITIES_SIZE)) {
+            return std::string{};
+        }
+
+        std::string entities(static_cast<std::size_t>(lump.length), '\0');
+
+        if (!file.seekg(lump.offset) || !file.read(entities.data(), lump.length)) {
+            return std::string{};
+        }
+
+        return entities;
+    }
+
+    /// Adds the files referenced by an entity key/value pair.
+    void add_entity_references(const std::string_view key, const std::string_view value,
+                               std::vector<std::string>& paths)
+    {
+        if (value.empty() || ('*' == value.front())) {
+            return;
+        }
+
+        if (Util::str::equal(key, "wad")) {
+            std::string_view wads = value;
+
+            while (!wads.empty()) {
+                const auto end = std::min(wads.find(';'), wads.size());
+                auto wad = wads.substr(0, end);
+                wads.remove_prefix(std::min(end + 1, wads.size()));
+
+                // The WAD paths are absolute paths on the mapper's machine, only the file name matters
+                if (const auto pos = wad.find_last_of("/\\"); pos != std::string_view::npos) {
+                    wad.remove_prefix(pos + 1);
+                }
+
+                if (!wad.empty()) {
+                    paths.emplace_back(wad);
+                }
+            }
+        }
+        else if (Util::str::equal(key, "skyname")) {
+            for (const auto side : SKY_SIDES) {
+                paths.emplace_back(Util::str::format("gfx/env/{}{}.tga", value, side));
+            }
+        }
+        else if (ends_with_no_case(value, ".mdl") || ends_with_no_case(value, ".spr")) {
+            paths.emplace_back(value);
+        }
+        else if (ends_with_no_case(value, ".wav")) {
+            paths.emplace_back(Util::str::format("sound/{}", value));
+        }
+    }
+
+}
+
+namespace Model {
+    std::vector<std::string> parse_mapcycle(const std::string& content)
+    {
+        std::vector<std::string> maps{};
+        auto depth = 0;
+
+        for (const auto& line : Util::str::split_lines(content)) {
+            for (auto& token : Util::str::split(strip_comment(line))) {
+                if ("{" == token) {
+                    ++depth;
+                }
+                else if ("}" == token) {
+                    depth = std::max(0, depth - 1);
+                }
+                else if (0 == depth) {
+                    maps.emplace_back(normalize_map_name(token));
+                }
+            }
+        }
+
+        return maps;
+    }
+
+    std::vector<std::string> parse_res(const std::string& content)
+    {
+        std::vector<std::string> paths{};
+
+        for (const auto& line : Util::str::split_lines(content)) {
+            if (auto path = Util::str::trim(Util::str::trim(strip_comment(line)), "\""); !path.empty()) {
+                std::replace(path.begin(), path.end(), '\\', '/');
+                paths.emplace_back(std::move(path));
+            }
+        }
+
+        return paths;
+    }
+
+    std::vector<std::string> parse_entities(const std::string_view entities)
+    {
+        std::vector<std::string> paths{};
+        std::string_view key{};
+        auto is_key = true;
+
+        for (std::size_t pos = 0; pos < entities.size(); ++pos) {
+            const auto ch = entities[pos];
+
+            if (('{' == ch) || ('}' == ch)) {
+                is_key = true;
+                continue;
+            }
+
+            if (ch != '"') {
+                continue;
+            }
+
+            const auto end = entities.find('"', pos + 1);
+
+            if (std::string_view::npos == end) {
+                break;
+            }
+
+            const auto token = entities.substr(pos + 1, end - pos - 1);
+            pos = end;
+
+            if (is_key) {
+                key = token;
+            }
+            else {
+                add_entity_references(key, token, paths);
+            }
+
+            is_key = !is_key;
+        }
+
+        return paths;
+    }
+
+    MapPrefetcher::MapPrefetcher(std::string game_dir, std::string mapcycle_file) :
+      mapcycle_file_(game_dir + "/" + mapcycle_file)
+    {
+        search_dirs_.emplace_back(game_dir);
+        search_dirs_.emplace_back(game_dir + "_addon");
+        search_dirs_.emplace_back(game_dir + "_downloads");
+
+        if (!Util::str::equal(game_dir, "valve")) {
+            search_dirs_.emplace_back("valve");
+        }
+
+        thread_ = std::thread{&MapPrefetcher::run, this};
+    }
+
+    MapPrefetcher::~MapPrefetcher()
+    {
+        stop();
+    }
+
+    void MapPrefetcher::on_map_changed(const std::string_view map_name)
+    {
+        auto name = normalize_map_name(map_name);
+
+        if (name.empty()) {
+            return;
+        }
+
+        {
+            const std::scoped_lock lock{mutex_};
+
+            if (stopped_ || (name == current_map_)) {
+                return;
+            }
+
+            current_map_ = name;
+            pending_map_ = std::move(name);
+        }
+
+        condition_.notify_one();
+    }
+
+    void MapPrefetcher::stop()
+    {
+        {
+            const std::scoped_lock lock{mutex_};
+            stopped_ = true;
+            pending_map_.clear();
+        }
+
+        condition_.notify_one();
+
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+
+    void MapPrefetcher::run()
+    {
+        if (!Util::set_thread_background_io_priority()) {
+            Util::log_debug("Map prefetcher: unable to lower the I/O priority.");
+        }
+
+        std::unique_lock lock{mutex_};
+
+        while (!stopped_) {
+            condition_.wait(lock, [this] {
+                return stopped_ || !pending_map_.empty();
+            });
+
+            // Let the engine finish loading the current map before competing with it for the disk
+            if (condition_.wait_for(lock, SETTLE_DELAY, [this] {
+                    return stopped_;
+                })) {
+                break;
+            }
+
+            if (pending_map_.empty()) {
+                continue;
+            }
+
+            const auto current_map = std::exchange(pending_map_, std::string{});
+
+            lock.unlock();
+            prefetch_next_map(current_map);
+            lock.lock();
+        }
+    }
+
+    void MapPrefetcher::prefetch_next_map(const std::string& current_map)
+    {
+        const auto next_map = find_next_map(current_map);
+
+        if (next_map.empty() || (next_map == prefetched_map_)) {
+            return;
+        }
+
+        const auto files = collect_map_files(next_map);
+        std::size_t prefetched = 0;
+
+        for (const auto& file : files) {
+            {
+                const std::scoped_lock lock{mutex_};
+
+                // A newer map change or shutdown makes the rest of the list useless
+                if (stopped_ || !pending_map_.empty()) {
+                    return;
+                }
+            }
+
+            if (Util::file_prefetch(file)) {
+                ++prefetched;
+            }
+        }
+
+        prefetched_map_ = next_map;
+        Util::log_debug("Map prefetcher: {} of {} files of the next map '{}' prefetched.", prefetched, files.size(),
+                        next_map);
+    }
+
+    std::string MapPrefetcher::find_next_map(const std::string& current_map) const
+    {
+        std::string content{};
+
+        if (Util::file_read(mapcycle_file_, content) != Util::FileReadErrorCode::success) {
+            return std::string{};
+        }
+
+        const auto maps = parse_mapcycle(content);
+
+        if (maps.empty()) {
+            return std::string{};
+        }
+
+        const auto current_name = Util::str::to_lower(current_map);
+        const auto it = std::find_if(maps.cbegin(), maps.cend(), [&current_name](const std::string& map) {
+            return Util::str::equal(Util::str::to_lower(map), current_name);
+        });
+
+        // The engine starts over from the first map if the current one is not in the cycle
+        const auto& next_map = (maps.cend() == it || maps.cend() == std::next(it)) ? maps.front() : *std::next(it);
+
+        return Util::str::equal(Util::str::to_lower(next_map), current_name) ? std::string{} : next_map;
+    }
+
+    std::vector<std::string> MapPrefetcher::collect_map_files(const std::string& map_name) const
+    {
+        std::vector<std::string> files{};
+        std::unordered_set<std::string> seen{};
+
+        const auto add_file = [this, &files, &seen](const std::string_view relative_path) {
+            if (auto path = resolve_path(relative_path); !path.empty() && seen.insert(path).second) {
+                files.emplace_back(std::move(path));
+            }
+        };
+
+        const auto bsp_path = resolve_path(Util::str::format("maps/{}.bsp", map_name));
+
+        if (bsp_path.empty()) {
+            return files;
+        }
+
+        add_file(Util::str::format("maps/{}.bsp", map_name));
+
+        if (const auto res_path = resolve_path(Util::str::format("maps/{}.res", map_name)); !res_path.empty()) {
+            add_file(Util::str::format("maps/{}.res", map_name));
+
+            if (std::string content{}; Util::file_read(res_path, content) == Util::FileReadErrorCode::success) {
+                for (const auto& path : parse_res(content)) {
+                    add_file(path);
+                }
+            }
+        }
+
+        for (const auto& path : parse_entities(read_bsp_entities(bsp_path))) {
+            add_file(path);
+        }
+
+        return files;
+    }
+
+    std::string MapPrefetcher::resolve_path(const std::string_view relative_path) const
+    {
+        for (const auto& search_dir : search_dirs_) {
+            std::error_code error_code{};
+            auto path = Util::str::format("{}/{}", search_dir, relative_path);
+
+            if (std::filesystem::is_regular_file(path, error_code)) {
+                return path;
+            }
+        }
+
+        return std::string{};
+    }
+}
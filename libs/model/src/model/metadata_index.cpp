@@ -0,0 +1,416 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#include "model/metadata_index.hpp"
+#include "util/logger.hpp"
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+
+namespace {
+    /// The identifier of an index file.
+    constexpr std::array<char, 4> INDEX_ID{'H', 'L', 'M', 'C'};
+
+    /// The version of the index file format.
+    constexpr std::uint32_t INDEX_VERSION = 1;
+
+    /// The stamp of a directory that does not exist.
+    constexpr std::int64_t MISSING_STAMP = std::numeric_limits<std::int64_t>::min();
+
+    /// The value of an empty hash table slot.
+    constexpr std::uint32_t EMPTY_SLOT = 0;
+
+    /// The flags of an entry.
+    enum EntryFlags : std::uint32_t {
+        EXISTS_KNOWN = 1U << 0U,
+        EXISTS = 1U << 1U,
+        IS_DIRECTORY_KNOWN = 1U << 2U,
+        IS_DIRECTORY = 1U << 3U,
+        SIZE_KNOWN = 1U << 4U,
+        FILETIME_KNOWN = 1U << 5U
+    };
+
+    // All the records are naturally aligned, the file is meant to be read on the machine that wrote it
+    struct IndexHeader {
+        std::array<char, 4> id;
+        std::uint32_t version;
+        std::uint32_t root_count;
+        std::uint32_t stamp_count;
+        std::uint32_t entry_count;
+        std::uint32_t slot_count;
+        std::uint32_t strings_size;
+        std::uint32_t reserved;
+    };
+
+    struct IndexString {
+        std::uint32_t offset;
+        std::uint32_t length;
+    };
+
+    struct IndexStamp {
+        IndexString path;
+        std::int64_t mtime;
+    };
+
+    struct IndexEntry {
+        std::uint32_t hash;
+        IndexString path;
+        std::uint32_t flags;
+        std::uint32_t size;
+        std::uint32_t reserved;
+        std::int64_t filetime;
+    };
+
+    static_assert(sizeof(IndexHeader) == 32);
+    static_assert(sizeof(IndexStamp) == 16);
+    static_assert(sizeof(IndexEntry) == 32);
+
+    /// Computes the 32-bit FNV-1a hash of a string.
+    [[nodiscard]] std::uint32_t hash_string(const std::string_view str) noexcept
+    {
+        std::uint32_t hash = 2166136261U;
+
+        for (const auto ch : str) {
+            hash ^= static_cast<unsigned char>(ch);
+            hash *= 16777619U;
+        }
+
+        return hash;
+    }
+
+    /// Gets the modification time stamp of a directory, or MISSING_STAMP if it does not exist.
+    [[nodiscard]] std::int64_t get_directory_stamp(const std::string& path)
+    {
+        std::error_code error_code{};
+        const auto write_time = std::filesystem::last_write_time(path, error_code);
+
+        return error_code ? MISSING_STAMP : static_cast<std::int64_t>(write_time.time_since_epoch().count());
+    }
+
+    /// Gets the number of hash table slots for the specified number of entries, keeps the load factor below 0.5.
+    [[nodiscard]] std::uint32_t get_slot_count(const std::size_t entry_count) noexcept
+    {
+        std::uint32_t slot_count = 16;
+
+        while (slot_count < entry_count * 2) {
+            slot_count *= 2;
+        }
+
+        return slot_count;
+    }
+
+    /// Copies a record out of the mapped data, the mapping is page aligned but the format does not rely on it.
+    template <typename T>
+    [[nodiscard]] T read_record(const char* const data, const std::size_t offset, const std::size_t index) noexcept
+    {
+        T record{};
+        std::memcpy(&record, data + offset + (index * sizeof(T)), sizeof(T));
+
+        return record;
+    }
+
+    /// Accumulates the strings of an index file being written.
+    class StringTable final {
+      public:
+        IndexString add(const std::string_view str)
+        {
+            const IndexString result{static_cast<std::uint32_t>(data_.size()), static_cast<std::uint32_t>(str.size())};
+            data_.append(str);
+
+            return result;
+        }
+
+        [[nodiscard]] const std::string& data() const noexcept
+        {
+            return data_;
+        }
+
+      private:
+        std::string data_{};
+    };
+
+    /// Writes a vector of records to a stream.
+    template <typename T>
+    void write_records(std::ofstream& stream, const std::vector<T>& records)
+    {
+        stream.write(reinterpret_cast<const char*>(records.data()),
+                     static_cast<std::streamsize>(records.size() * sizeof(T)));
+    }
+}
+
+namespace Model {
+    bool MetadataIndex::load(const std::string& path)
+    {
+        unload();
+
+        if (!file_.open(path)) {
+            return false;
+        }
+
+        const auto* const data = file_.data();
+        const auto size = file_.size();
+
+        if (size < sizeof(IndexHeader)) {
+            Util::log_error("Metadata cache \"{}\": the file is truncated.", path);
+            unload();
+            return false;
+        }
+
+        const auto header = read_record<IndexHeader>(data, 0, 0);
+
+        if ((header.id != INDEX_ID) || (header.version != INDEX_VERSION)) {
+            Util::log_warn("Metadata cache \"{}\": unsupported file format, the cache will be rebuilt.", path);
+            unload();
+            return false;
+        }
+
+        // The counts are 32-bit, the sums below cannot overflow a 64-bit integer
+        const auto roots_size = std::uint64_t{header.root_count} * sizeof(IndexString);
+        const auto stamps_size = std::uint64_t{header.stamp_count} * sizeof(IndexStamp);
+        const auto entries_size = std::uint64_t{header.entry_count} * sizeof(IndexEntry);
+        const auto slots_size = std::uint64_t{header.slot_count} * sizeof(std::uint32_t);
+        const auto total_size =
+          sizeof(IndexHeader) + roots_size + stamps_size + entries_size + slots_size + header.strings_size;
+
+        const auto is_power_of_two = (0 != header.slot_count) && (0 == (header.slot_count & (header.slot_count - 1)));
+
+        if ((total_size != size) || !is_power_of_two || (header.entry_count >= header.slot_count)) {
+            Util::log_error("Metadata cache \"{}\": the file is corrupted.", path);
+            unload();
+            return false;
+        }
+
+        root_count_ = header.root_count;
+        stamp_count_ = header.stamp_count;
+        entry_count_ = header.entry_count;
+        slot_count_ = header.slot_count;
+        roots_offset_ = sizeof(IndexHeader);
+        stamps_offset_ = roots_offset_ + static_cast<std::size_t>(roots_size);
+        entries_offset_ = stamps_offset_ + static_cast<std::size_t>(stamps_size);
+        slots_offset_ = entries_offset_ + static_cast<std::size_t>(entries_size);
+        strings_offset_ = slots_offset_ + static_cast<std::size_t>(slots_size);
+        strings_size_ = header.strings_size;
+
+        return true;
+    }
+
+    void MetadataIndex::unload() noexcept
+    {
+        file_.close();
+        root_count_ = 0;
+        stamp_count_ = 0;
+        entry_count_ = 0;
+        slot_count_ = 0;
+    }
+
+    bool MetadataIndex::is_up_to_date() const
+    {
+        if (!is_loaded()) {
+            return false;
+        }
+
+        for (std::size_t i = 0; i < stamp_count_; ++i) {
+            const auto stamp = read_record<IndexStamp>(file_.data(), stamps_offset_, i);
+            const auto path = get_string(stamp.path.offset, stamp.path.length);
+
+            if (get_directory_stamp(std::string{path}) != stamp.mtime) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    std::vector<std::string> MetadataIndex::get_search_roots() const
+    {
+        std::vector<std::string> roots{};
+        roots.reserve(root_count_);
+
+        for (std::size_t i = 0; i < root_count_; ++i) {
+            const auto root = read_record<IndexString>(file_.data(), roots_offset_, i);
+            roots.emplace_back(get_string(root.offset, root.length));
+        }
+
+        return roots;
+    }
+
+    std::optional<FileMetadata> MetadataIndex::find(const std::string_view path) const
+    {
+        if (0 == entry_count_) {
+            return std::nullopt;
+        }
+
+        const auto hash = hash_string(path);
+        const auto mask = slot_count_ - 1;
+
+        // The table always has empty slots, the probing terminates
+        for (auto slot = hash & mask;; slot = (slot + 1) & mask) {
+            const auto value = read_record<std::uint32_t>(file_.data(), slots_offset_, slot);
+
+            if (EMPTY_SLOT == value) {
+                return std::nullopt;
+            }
+
+            const auto entry_index = value - 1;
+
+            if (entry_index >= entry_count_) {
+                return std::nullopt;
+            }
+
+            const auto entry = read_record<IndexEntry>(file_.data(), entries_offset_, entry_index);
+
+            if ((entry.hash == hash) && (get_string(entry.path.offset, entry.path.length) == path)) {
+                return get_metadata(entry_index);
+            }
+        }
+    }
+
+    bool MetadataIndex::save(const std::string& path, const std::vector<std::string>& search_roots,
+                             const std::vector<std::string>& directories,
+                             const std::unordered_map<std::string, FileMetadata>& entries)
+    {
+        StringTable strings{};
+        std::vector<IndexString> roots{};
+        std::vector<IndexStamp> stamps{};
+        std::vector<IndexEntry> records{};
+        std::vector<std::uint32_t> slots(get_slot_count(entries.size()), EMPTY_SLOT);
+
+        roots.reserve(search_roots.size());
+        stamps.reserve(directories.size());
+        records.reserve(entries.size());
+
+        for (const auto& root : search_roots) {
+            roots.push_back(strings.add(root));
+        }
+
+        for (const auto& directory : directories) {
+            stamps.push_back({strings.add(directory), get_directory_stamp(directory)});
+        }
+
+        const auto mask = static_cast<std::uint32_t>(slots.size()) - 1;
+
+        for (const auto& [entry_path, metadata] : entries) {
+            if (!metadata.is_known()) {
+                continue;
+            }
+
+            IndexEntry record{};
+            record.hash = hash_string(entry_path);
+            record.path = strings.add(entry_path);
+            record.flags = (metadata.exists_known ? EXISTS_KNOWN : 0U) | (metadata.exists ? EXISTS : 0U) |
+                           (metadata.is_directory_known ? IS_DIRECTORY_KNOWN : 0U) |
+                           (metadata.is_directory ? IS_DIRECTORY : 0U) | (metadata.size_known ? SIZE_KNOWN : 0U) |
+                           (metadata.filetime_known ? FILETIME_KNOWN : 0U);
+            record.size = metadata.size;
+            record.filetime = metadata.filetime;
+
+            auto slot = record.hash & mask;
+
+            while (EMPTY_SLOT != slots[slot]) {
+                slot = (slot + 1) & mask;
+            }
+
+            records.push_back(record);
+            slots[slot] = static_cast<std::uint32_t>(records.size());
+        }
+
+        if (strings.data().size() > std::numeric_limits<std::uint32_t>::max()) {
+            Util::log_error("Metadata cache \"{}\": too many entries.", path);
+            return false;
+        }
+
+        IndexHeader header{};
+        header.id = INDEX_ID;
+        header.version = INDEX_VERSION;
+        header.root_count = static_cast<std::uint32_t>(roots.size());
+        header.stamp_count = static_cast<std::uint32_t>(stamps.size());
+        header.entry_count = static_cast<std::uint32_t>(records.size());
+        header.slot_count = static_cast<std::uint32_t>(slots.size());
+        header.strings_size = static_cast<std::uint32_t>(strings.data().size());
+
+        // Writes to a temporary file first, a running server may still have the old index mapped
+        const auto temp_path = path + ".tmp";
+        std::ofstream stream{temp_path, std::ios::binary | std::ios::trunc};
+
+        if (!stream) {
+            Util::log_error("Metadata cache \"{}\": failed to open the file for writing.", temp_path);
+            return false;
+        }
+
+        stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        write_records(stream, roots);
+        write_records(stream, stamps);
+        write_records(stream, records);
+        write_records(stream, slots);
+        stream.write(strings.data().data(), static_cast<std::streamsize>(strings.data().size()));
+        stream.close();
+
+        std::error_code error_code{};
+
+        if (stream) {
+            std::filesystem::rename(temp_path, path, error_code);
+
+            if (!error_code) {
+                return true;
+            }
+        }
+
+        Util::log_error("Metadata cache \"{}\": failed to write the file.", path);
+        std::filesystem::remove(temp_path, error_code);
+
+        return false;
+    }
+
+    FileMetadata MetadataIndex::get_metadata(const std::size_t entry_index) const
+    {
+        const auto entry = read_record<IndexEntry>(file_.data(), entries_offset_, entry_index);
+
+        FileMetadata metadata{};
+        metadata.exists_known = 0 != (entry.flags & EXISTS_KNOWN);
+        metadata.exists = 0 != (entry.flags & EXISTS);
+        metadata.is_directory_known = 0 != (entry.flags & IS_DIRECTORY_KNOWN);
+        metadata.is_directory = 0 != (entry.flags & IS_DIRECTORY);
+        metadata.size_known = 0 != (entry.flags & SIZE_KNOWN);
+        metadata.size = entry.size;
+        metadata.filetime_known = 0 != (entry.flags & FILETIME_KNOWN);
+        metadata.filetime = entry.filetime;
+
+        return metadata;
+    }
+
+    std::string_view MetadataIndex::get_entry_path(const std::size_t entry_index) const
+    {
+        const auto entry = read_record<IndexEntry>(file_.data(), entries_offset_, entry_index);
+
+        return get_string(entry.path.offset, entry.path.length);
+    }
+
+    std::string_view MetadataIndex::get_string(const std::uint32_t offset, const std::uint32_t length) const
+    {
+        // Out of range strings can only come from a damaged file, they never match anything
+        if ((offset > strings_size_) || (length > strings_size_ - offset)) {
+            return {};
+        }
+
+        return {file_.data() + strings_offset_ + offset, length};
+    }
+}
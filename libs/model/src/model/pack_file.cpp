@@ -0,0 +1,169 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#include "model/pack_file.hpp"
+#include "util/file.hpp"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+    /// The identifier of a pack with 32-bit offsets.
+    constexpr std::string_view PACK_ID = "PACK";
+
+    /// The identifier of a pack with 64-bit offsets.
+    constexpr std::string_view PACK64_ID = "PK64";
+
+#pragma pack(push, 1)
+    struct PackHeader {
+        std::array<char, 4> id;
+        std::int32_t directory_offset;
+        std::int32_t directory_length;
+    };
+
+    struct PackEntry {
+        std::array<char, 56> name;
+        std::int32_t position;
+        std::int32_t length;
+    };
+
+    struct Pack64Header {
+        std::array<char, 4> id;
+        std::int64_t directory_offset;
+        std::int64_t directory_length;
+    };
+
+    struct Pack64Entry {
+        std::array<char, 112> name;
+        std::int64_t position;
+        std::int64_t length;
+    };
+#pragma pack(pop)
+
+    /// Checks that a range lies within a buffer of the specified size.
+    [[nodiscard]] bool is_valid_range(const std::int64_t offset, const std::int64_t length,
+                                      const std::size_t size) noexcept
+    {
+        return (offset >= 0) && (length >= 0) && (static_cast<std::uint64_t>(offset) <= size) &&
+               (static_cast<std::uint64_t>(length) <= size - static_cast<std::uint64_t>(offset));
+    }
+}
+
+namespace Model {
+    bool PackFile::open(const std::string& path)
+    {
+        index_.clear();
+
+        if (!file_.open(path)) {
+            return false;
+        }
+
+        const auto id = std::string_view{file_.data(), std::min<std::size_t>(file_.size(), PACK_ID.size())};
+        auto result = false;
+
+        if (id == PACK_ID) {
+            result = build_index<PackHeader, PackEntry>();
+        }
+        else if (id == PACK64_ID) {
+            result = build_index<Pack64Header, Pack64Entry>();
+        }
+
+        if (!result) {
+            index_.clear();
+            file_.close();
+            return false;
+        }
+
+        filetime_ = Util::file_mtime(path);
+
+        return true;
+    }
+
+    std::optional<std::string_view> PackFile::find(const std::string_view path) const
+    {
+        // Reused to avoid an allocation for every lookup
+        thread_local std::string key{};
+        make_key(path, key);
+
+        if (const auto it = index_.find(key); it != index_.end()) {
+            return it->second;
+        }
+
+        return std::nullopt;
+    }
+
+    void PackFile::make_key(std::string_view path, std::string& key)
+    {
+        while (!path.empty() && (('/' == path.front()) || ('\\' == path.front()))) {
+            path.remove_prefix(1);
+        }
+
+        key.assign(path);
+
+        std::transform(key.begin(), key.end(), key.begin(), [](const unsigned char ch) {
+            return '\\' == ch ? '/' : static_cast<char>(std::tolower(ch));
+        });
+    }
+
+    template <typename Header, typename Entry>
+    bool PackFile::build_index()
+    {
+        const auto* const data = file_.data();
+        const auto size = file_.size();
+
+        if (size < sizeof(Header)) {
+            return false;
+        }
+
+        Header header{};
+        std::memcpy(&header, data, sizeof(header));
+
+        if (!is_valid_range(header.directory_offset, header.directory_length, size) ||
+            (0 != header.directory_length % static_cast<std::int64_t>(sizeof(Entry)))) {
+            return false;
+        }
+
+        const auto entry_count = static_cast<std::size_t>(header.directory_length) / sizeof(Entry);
+        const auto* const directory = data + header.directory_offset;
+        index_.reserve(entry_count);
+
+        for (std::size_t i = 0; i < entry_count; ++i) {
+            Entry entry{};
+            std::memcpy(&entry, directory + (i * sizeof(Entry)), sizeof(entry));
+
+            if (!is_valid_range(entry.position, entry.length, size)) {
+                return false;
+            }
+
+            const auto name_length =
+              static_cast<std::size_t>(std::find(entry.name.cbegin(), entry.name.cend(), '\0') - entry.name.cbegin());
+
+            std::string key{};
+            make_key(std::string_view{entry.name.data(), name_length}, key);
+
+            // The first entry wins, like in a linear directory scan
+            index_.try_emplace(std::move(key), data + entry.position, static_cast<std::size_t>(entry.length));
+        }
+
+        return true;
+    }
+}
@@ -20,10 +20,13 @@
 
 #include "model/server_loop.hpp"
 #include "common/engine/interface/dedicated_serverapi_interface.hpp"
+#include "util/logger.hpp"
+#include "util/string.hpp"
 #include <algorithm>
 #include <cassert>
 #include <chrono>
 #include <cmath>
+#include <cstring>
 #include <utility>
 
 #ifdef _WIN32
@@ -92,11 +95,11 @@ namespace Model {
             const auto sleep_duration = std::max(std::chrono::nanoseconds{100}, target_sleep_duration - ama_duration);
             interval.QuadPart = sleep_duration.count() / (-100LL);
             Util::ntdll::delay_execution(FALSE, &interval);
-            update_status(serverapi_interface);
 #else
             const auto sleep_duration = std::max(std::chrono::nanoseconds{1}, target_sleep_duration - ama_duration);
             std::this_thread::sleep_for(sleep_duration);
 #endif
+            update_status(serverapi_interface);
             process_tasks();
             process_input(serverapi_interface);
 
@@ -111,22 +114,54 @@ namespace Model {
 
     void ServerLoop::process_tasks()
     {
-        if (!task_queue_.empty()) {
-            const auto task = task_queue_.pop();
+        Util::log_report_suppressed();
+
+        if (TaskQueue::ValueType task{}; task_queue_.try_pop(task)) {
             task();
         }
     }
 
     void ServerLoop::process_input(Common::DedicatedServerApiInterface& serverapi_interface)
     {
-        if (!input_queue_.empty()) {
-            const auto input = input_queue_.pop();
-            serverapi_interface.add_console_text(input.c_str());
+        if (InputQueue::ValueType input{}; input_queue_.try_pop(input)) {
+            if (!execute_command(input)) {
+                serverapi_interface.add_console_text(input.c_str());
+            }
         }
     }
 
+    void ServerLoop::register_command(const std::string_view name, CommandHandler handler)
+    {
+        commands_.insert_or_assign(Util::str::to_lower(name), std::move(handler));
+    }
+
+    bool ServerLoop::execute_command(const std::string& input)
+    {
+        if (commands_.empty()) {
+            return false;
+        }
+
+        const auto args = Util::str::split(input);
+
+        if (args.empty()) {
+            return false;
+        }
+
+        const auto it = commands_.find(Util::str::to_lower(args.front()));
+
+        if (commands_.end() == it) {
+            return false;
+        }
+
+        it->second(args);
+
+        return true;
+    }
+
     void ServerLoop::update_status(Common::DedicatedServerApiInterface& serverapi_interface)
     {
+        frame_times_.mark_frame();
+
         if (!is_time_to_update()) {
             return;
         }
@@ -135,6 +170,8 @@ namespace Model {
         status_.current_map.resize(32U, '\0');
         serverapi_interface.update_status(
           &status_.fps, &status_.num_players, &status_.max_players, status_.current_map.data());
+        status_.current_map.resize(std::strlen(status_.current_map.c_str()));
+        status_.frame_times = frame_times_.take_stats();
 
         notify(ServerLoopEvent::status_updated);
     }
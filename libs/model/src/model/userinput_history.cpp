@@ -21,12 +21,15 @@
 #include "model/userinput_history.hpp"
 #include "util/file.hpp"
 #include "util/string.hpp"
+#include <algorithm>
+#include <iterator>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 namespace {
-    /// A vector to store history lines when saving to file.
-    std::vector<std::string> history_lines{};
+    /// The number of journal lines at which the journal is compacted to the history capacity.
+    constexpr std::size_t JOURNAL_COMPACT_LINES = 2 * Model::HISTORY_CAPACITY;
 
     /// Check if the input is valid.
     bool is_valid_input(const std::string_view input) noexcept
@@ -38,13 +41,31 @@ namespace {
 namespace Model {
     UserInputHistory::UserInputHistory(const std::string_view filename) : filename_(filename)
     {
-        history_lines.reserve(HISTORY_CAPACITY);
+    }
+
+    UserInputHistory::~UserInputHistory()
+    {
+        if (!writer_.joinable()) {
+            return;
+        }
+
+        {
+            const std::lock_guard lock{mutex_};
+            stopping_ = true;
+        }
+
+        condition_.notify_all();
+        writer_.join();
     }
 
     void UserInputHistory::append(const std::string_view input)
     {
         if (is_valid_input(input) && (input != history_.back())) {
             history_.emplace_back(input);
+
+            if (!filename_.empty()) {
+                unsaved_.emplace_back(input);
+            }
         }
 
         position_ = history_.size();
@@ -77,6 +98,14 @@ namespace Model {
     {
         history_.clear();
         position_ = history_.size();
+        unsaved_.clear();
+
+        std::unique_lock lock{mutex_};
+        condition_.wait(lock, [this] { return !writing_; });
+
+        pending_.clear();
+        journal_tail_.clear();
+        journal_lines_ = 0;
 
         if (Util::file_exists(filename_)) {
             Util::try_file_remove(filename_);
@@ -91,30 +120,94 @@ namespace Model {
 
         if (std::string content{}; Util::try_file_read(filename_, content)) {
             history_.clear();
+            unsaved_.clear();
+            const auto lines = Util::str::split_lines(content);
 
-            for (const auto& input : Util::str::split_lines(content)) {
+            for (const auto& input : lines) {
                 if (is_valid_input(input) && (input != history_.back())) {
                     history_.emplace_back(input); // cppcheck-suppress useStlAlgorithm
                 }
             }
 
             position_ = history_.size();
+
+            std::unique_lock lock{mutex_};
+            condition_.wait(lock, [this] { return !writing_; });
+
+            pending_.clear();
+            journal_tail_ = history_;
+            journal_lines_ = lines.size();
         }
     }
 
     void UserInputHistory::save()
     {
-        if (filename_.empty() || history_.empty()) {
+        if (filename_.empty() || unsaved_.empty()) {
             return;
         }
 
-        history_lines.clear();
-        const auto history_size = history_.size();
+        {
+            const std::lock_guard lock{mutex_};
 
-        for (SizeType i = 0; i < history_size; ++i) {
-            history_lines.emplace_back(history_[i]);
+            if (pending_.empty()) {
+                pending_.swap(unsaved_);
+            }
+            else {
+                std::move(unsaved_.begin(), unsaved_.end(), std::back_inserter(pending_));
+                unsaved_.clear();
+            }
+        }
+
+        if (!writer_.joinable()) {
+            writer_ = std::thread{&UserInputHistory::write_journal, this};
         }
 
-        Util::try_file_write_lines(filename_, history_lines, false);
+        condition_.notify_all();
+    }
+
+    void UserInputHistory::flush()
+    {
+        std::unique_lock lock{mutex_};
+        condition_.wait(lock, [this] { return pending_.empty() && !writing_; });
+    }
+
+    void UserInputHistory::write_journal()
+    {
+        std::vector<std::string> lines{};
+        std::unique_lock lock{mutex_};
+
+        while (true) {
+            condition_.wait(lock, [this] { return stopping_ || !pending_.empty(); });
+
+            if (pending_.empty()) {
+                break;
+            }
+
+            lines.clear();
+            lines.swap(pending_);
+            writing_ = true;
+
+            for (const auto& input : lines) {
+                journal_tail_.emplace_back(input);
+            }
+
+            const auto compact = journal_lines_ + lines.size() >= JOURNAL_COMPACT_LINES;
+
+            if (compact) {
+                // The tail is only changed under the lock, the lines are copied before the file is written
+                lines.assign(journal_tail_.cbegin(), journal_tail_.cend());
+            }
+
+            lock.unlock();
+            const auto written = Util::try_file_write_lines(filename_, lines, !compact);
+            lock.lock();
+
+            if (written) {
+                journal_lines_ = compact ? lines.size() : journal_lines_ + lines.size();
+            }
+
+            writing_ = false;
+            condition_.notify_all();
+        }
     }
 }
@@ -0,0 +1,68 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+
+#include "model/command_index.hpp"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace {
+    using Names = std::vector<std::string>;
+
+    TEST(CommandIndexTest, FindMatches)
+    {
+        Model::CommandIndex index{};
+        ASSERT_FALSE(index.is_built());
+        ASSERT_TRUE(index.find_matches("sv").empty());
+
+        index.update({}, {"sv_gravity", "map", "sv_cheats", "status", "sv_cheats"});
+        ASSERT_TRUE(index.is_built());
+
+        ASSERT_EQ(index.find_matches("sv_"), (Names{"sv_cheats", "sv_gravity"}));
+        ASSERT_EQ(index.find_matches("S"), (Names{"status", "sv_cheats", "sv_gravity"}));
+        ASSERT_EQ(index.find_matches("map"), Names{"map"});
+        ASSERT_TRUE(index.find_matches("x").empty());
+        ASSERT_TRUE(index.find_matches("").empty());
+    }
+
+    TEST(CommandIndexTest, UpdatePrefix)
+    {
+        Model::CommandIndex index{};
+        index.update({}, {"sv_gravity", "map", "status"});
+        index.update("s", {"sv_gravity", "sv_maxspeed"});
+
+        ASSERT_EQ(index.find_matches("s"), (Names{"sv_gravity", "sv_maxspeed"}));
+        ASSERT_EQ(index.find_matches("m"), Names{"map"});
+    }
+
+    TEST(CommandIndexTest, TakeRefresh)
+    {
+        Model::CommandIndex index{std::chrono::seconds{5}};
+        const auto now = Model::CommandIndex::Clock::now();
+
+        ASSERT_TRUE(index.take_refresh("sv", now));
+        ASSERT_FALSE(index.take_refresh("S", now + std::chrono::seconds{1}));
+        ASSERT_TRUE(index.take_refresh("map", now + std::chrono::seconds{1}));
+        ASSERT_TRUE(index.take_refresh("sv", now + std::chrono::seconds{5}));
+        ASSERT_FALSE(index.take_refresh("", now));
+    }
+}
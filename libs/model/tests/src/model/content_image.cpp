@@ -0,0 +1,141 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#include "model/content_image.hpp"
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace {
+    class ContentImageTest : public ::testing::Test {
+      protected:
+        void SetUp() override
+        {
+            write_file("valve/maps/crossfire.bsp", "crossfire");
+            write_file("valve/sound/weapons/ak47.wav", "base ak47");
+            write_file("cstrike/sound/weapons/ak47.wav", "mod ak47");
+            write_file("cstrike/Models/Player.mdl", "player");
+            write_file("cstrike/empty.txt", "");
+        }
+
+        void TearDown() override
+        {
+            std::filesystem::remove_all(temp_dir);
+        }
+
+        void write_file(const std::string& path, const std::string& content) const
+        {
+            const auto full_path = temp_dir / path;
+            std::filesystem::create_directories(full_path.parent_path());
+            std::ofstream{full_path, std::ios::binary} << content;
+        }
+
+        [[nodiscard]] std::string get_path(const std::string& path) const
+        {
+            return (temp_dir / path).string();
+        }
+
+        std::filesystem::path temp_dir{std::filesystem::temp_directory_path() / "test_content_image"};
+        Model::ContentImageBuilder builder{};
+        Model::ContentImage image{};
+    };
+
+    TEST_F(ContentImageTest, OpenMissingFile)
+    {
+        ASSERT_FALSE(image.open(get_path("missing.img")));
+        ASSERT_FALSE(image.find("maps/crossfire.bsp").has_value());
+    }
+
+    TEST_F(ContentImageTest, OpenInvalidFile)
+    {
+        write_file("invalid.img", "PACK this is not a content image");
+
+        ASSERT_FALSE(image.open(get_path("invalid.img")));
+        ASSERT_EQ(0, image.get_entry_count());
+    }
+
+    TEST_F(ContentImageTest, AddMissingDirectory)
+    {
+        ASSERT_FALSE(builder.add_directory(get_path("missing")));
+        ASSERT_EQ(0, builder.get_file_count());
+    }
+
+    TEST_F(ContentImageTest, RoundTrip)
+    {
+        ASSERT_TRUE(builder.add_directory(get_path("cstrike")));
+        ASSERT_TRUE(builder.add_directory(get_path("valve")));
+        ASSERT_EQ(4, builder.get_file_count());
+        ASSERT_TRUE(builder.write(get_path("content.img")));
+
+        ASSERT_TRUE(image.open(get_path("content.img")));
+        ASSERT_EQ(4, image.get_entry_count());
+
+        const auto map = image.find("maps/crossfire.bsp");
+        ASSERT_TRUE(map.has_value());
+        ASSERT_EQ("crossfire", map->data);
+        ASSERT_NE(0, map->filetime);
+
+        // The tree added first wins
+        const auto sound = image.find("sound/weapons/ak47.wav");
+        ASSERT_TRUE(sound.has_value());
+        ASSERT_EQ("mod ak47", sound->data);
+
+        const auto empty = image.find("empty.txt");
+        ASSERT_TRUE(empty.has_value());
+        ASSERT_TRUE(empty->data.empty());
+
+        ASSERT_FALSE(image.find("maps/de_dust2.bsp").has_value());
+        ASSERT_FALSE(image.find("maps").has_value());
+    }
+
+    TEST_F(ContentImageTest, FindNormalizesPaths)
+    {
+        ASSERT_TRUE(builder.add_directory(get_path("cstrike")));
+        ASSERT_TRUE(builder.write(get_path("content.img")));
+        ASSERT_TRUE(image.open(get_path("content.img")));
+
+        ASSERT_TRUE(image.find("models/player.mdl").has_value());
+        ASSERT_TRUE(image.find("MODELS\\PLAYER.MDL").has_value());
+        ASSERT_TRUE(image.find("/models/player.mdl").has_value());
+    }
+
+    TEST_F(ContentImageTest, AlignsFileContents)
+    {
+        constexpr std::uint32_t alignment = 512;
+
+        ASSERT_TRUE(builder.add_directory(get_path("cstrike")));
+        ASSERT_TRUE(builder.add_directory(get_path("valve")));
+        ASSERT_TRUE(builder.write(get_path("content.img"), alignment));
+        ASSERT_TRUE(image.open(get_path("content.img")));
+
+        const auto first = image.find("maps/crossfire.bsp");
+        const auto second = image.find("models/player.mdl");
+        ASSERT_TRUE(first.has_value() && second.has_value());
+        ASSERT_EQ(0, (second->data.data() - first->data.data()) % alignment);
+    }
+
+    TEST_F(ContentImageTest, RejectsInvalidAlignment)
+    {
+        ASSERT_TRUE(builder.add_directory(get_path("cstrike")));
+        ASSERT_FALSE(builder.write(get_path("content.img"), 3));
+        ASSERT_FALSE(builder.write(get_path("content.img"), 0));
+    }
+}
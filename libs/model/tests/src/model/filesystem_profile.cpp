@@ -0,0 +1,134 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#include "model/filesystem_profile.hpp"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <filesystem>
+
+namespace {
+    using namespace std::chrono_literals;
+
+    TEST(FileSystemProfileTest, StartsWithStartupSection)
+    {
+        const Model::FileSystemProfile profile{};
+        const auto maps = profile.get_maps();
+
+        ASSERT_EQ(maps.size(), 1);
+        ASSERT_EQ(maps.back().map_name, "(startup)");
+        ASSERT_EQ(maps.back().total.calls, 0);
+    }
+
+    TEST(FileSystemProfileTest, RecordsPerPathAndPathId)
+    {
+        Model::FileSystemProfile profile{};
+        profile.record("maps\\De_Dust2.bsp", "GAME", Model::FileOperation::open, 0, 2ms, true);
+        profile.record("maps/de_dust2.bsp", "GAME", Model::FileOperation::read, 1024, 3ms, true);
+        profile.record("sound/missing.wav", "", Model::FileOperation::open, 0, 1ms, false);
+
+        const auto maps = profile.get_maps();
+        const auto& map = maps.back();
+        ASSERT_EQ(map.paths.size(), 2);
+        ASSERT_EQ(map.path_ids.size(), 2);
+
+        const auto& bsp = map.paths.at("maps/de_dust2.bsp");
+        ASSERT_EQ(bsp.calls, 2);
+        ASSERT_EQ(bsp.opens, 1);
+        ASSERT_EQ(bsp.reads, 1);
+        ASSERT_EQ(bsp.bytes_read, 1024);
+        ASSERT_EQ(bsp.total_time, 5ms);
+        ASSERT_EQ(bsp.max_time, 3ms);
+
+        ASSERT_EQ(map.paths.at("sound/missing.wav").misses, 1);
+        ASSERT_EQ(map.path_ids.at("game").calls, 2);
+        ASSERT_EQ(map.total.calls, 3);
+        ASSERT_EQ(map.total.misses, 1);
+    }
+
+    TEST(FileSystemProfileTest, BeginMapStartsNewSection)
+    {
+        Model::FileSystemProfile profile{};
+        profile.record("liblist.gam", "", Model::FileOperation::query, 0, 1ms, true);
+        profile.begin_map("de_dust2");
+        profile.record("maps/de_dust2.bsp", "", Model::FileOperation::open, 0, 1ms, true);
+
+        const auto maps = profile.get_maps();
+        ASSERT_EQ(maps.size(), 2);
+        ASSERT_EQ(maps.front().total.calls, 1);
+        ASSERT_EQ(maps.back().map_name, "de_dust2");
+        ASSERT_EQ(maps.back().paths.count("maps/de_dust2.bsp"), 1);
+        ASSERT_EQ(maps.back().paths.count("liblist.gam"), 0);
+    }
+
+    TEST(FileSystemProfileTest, KeepsLimitedNumberOfMaps)
+    {
+        Model::FileSystemProfile profile{};
+
+        for (std::size_t i = 0; i < Model::FileSystemProfile::MAX_MAPS * 2; ++i) {
+            profile.begin_map("map" + std::to_string(i));
+        }
+
+        const auto maps = profile.get_maps();
+        ASSERT_EQ(maps.size(), Model::FileSystemProfile::MAX_MAPS);
+        ASSERT_EQ(maps.back().map_name, "map" + std::to_string(Model::FileSystemProfile::MAX_MAPS * 2 - 1));
+    }
+
+    TEST(FileSystemProfileTest, ResetKeepsCurrentMap)
+    {
+        Model::FileSystemProfile profile{};
+        profile.begin_map("de_dust2");
+        profile.record("maps/de_dust2.bsp", "", Model::FileOperation::open, 0, 1ms, true);
+        profile.reset();
+
+        const auto maps = profile.get_maps();
+        ASSERT_EQ(maps.size(), 1);
+        ASSERT_EQ(maps.back().map_name, "de_dust2");
+        ASSERT_EQ(maps.back().total.calls, 0);
+    }
+
+    TEST(FileSystemProfileTest, ReportListsSlowestFilesFirst)
+    {
+        Model::FileSystemProfile profile{};
+        profile.record("fast.txt", "", Model::FileOperation::open, 0, 1ms, true);
+        profile.record("slow.txt", "", Model::FileOperation::open, 0, 9ms, true);
+        profile.record("medium.txt", "", Model::FileOperation::open, 0, 5ms, true);
+
+        const auto lines = profile.report(2);
+
+        // Summary, column headers, two files, path ID header and one path ID
+        ASSERT_EQ(lines.size(), 6);
+        ASSERT_NE(lines[2].find("slow.txt"), std::string::npos);
+        ASSERT_NE(lines[3].find("medium.txt"), std::string::npos);
+    }
+
+    TEST(FileSystemProfileTest, DumpWritesFile)
+    {
+        const auto temp_file = std::filesystem::temp_directory_path() / "test_fs_profile.txt";
+
+        Model::FileSystemProfile profile{};
+        profile.record("maps/de_dust2.bsp", "", Model::FileOperation::open, 0, 1ms, true);
+
+        ASSERT_TRUE(profile.dump(temp_file.string(), 10));
+        ASSERT_TRUE(std::filesystem::exists(temp_file));
+        ASSERT_GT(std::filesystem::file_size(temp_file), 0);
+
+        std::filesystem::remove(temp_file);
+    }
+}
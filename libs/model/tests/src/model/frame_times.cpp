@@ -0,0 +1,94 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+
+#include "model/frame_times.hpp"
+#include <gtest/gtest.h>
+#include <chrono>
+
+namespace {
+    using namespace std::chrono_literals;
+
+    TEST(FrameTimesTest, NoFrames)
+    {
+        Model::FrameTimes frame_times{};
+        const auto stats = frame_times.take_stats();
+
+        ASSERT_FLOAT_EQ(stats.fps, 0.0F);
+        ASSERT_FLOAT_EQ(stats.max_ms, 0.0F);
+    }
+
+    TEST(FrameTimesTest, Percentiles)
+    {
+        Model::FrameTimes frame_times{};
+
+        // 1 to 100 ms, in reverse order
+        for (int i = 100; i > 0; --i) {
+            frame_times.record(std::chrono::milliseconds{i});
+        }
+
+        const auto stats = frame_times.take_stats();
+        ASSERT_FLOAT_EQ(stats.median_ms, 50.0F);
+        ASSERT_FLOAT_EQ(stats.p99_ms, 99.0F);
+        ASSERT_FLOAT_EQ(stats.max_ms, 100.0F);
+        ASSERT_NEAR(stats.fps, 100.0F / 5.05F, 0.001F);
+    }
+
+    TEST(FrameTimesTest, TakeStartsNewInterval)
+    {
+        Model::FrameTimes frame_times{};
+        frame_times.record(10ms);
+        static_cast<void>(frame_times.take_stats());
+
+        frame_times.record(1ms);
+        frame_times.record(1ms);
+
+        const auto stats = frame_times.take_stats();
+        ASSERT_FLOAT_EQ(stats.max_ms, 1.0F);
+        ASSERT_FLOAT_EQ(stats.fps, 1000.0F);
+    }
+
+    TEST(FrameTimesTest, FramesBeyondCapacityCountTowardsFps)
+    {
+        Model::FrameTimes frame_times{2};
+
+        for (int i = 0; i < 10; ++i) {
+            frame_times.record(100ms);
+        }
+
+        const auto stats = frame_times.take_stats();
+        ASSERT_FLOAT_EQ(stats.fps, 10.0F);
+        ASSERT_FLOAT_EQ(stats.median_ms, 100.0F);
+    }
+
+    TEST(FrameTimesTest, MarkFrame)
+    {
+        Model::FrameTimes frame_times{};
+        frame_times.mark_frame();
+        ASSERT_FLOAT_EQ(frame_times.take_stats().fps, 0.0F);
+
+        frame_times.mark_frame();
+        frame_times.mark_frame();
+
+        const auto stats = frame_times.take_stats();
+        ASSERT_GT(stats.fps, 0.0F);
+        ASSERT_GE(stats.max_ms, stats.median_ms);
+    }
+}
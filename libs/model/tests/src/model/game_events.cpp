@@ -0,0 +1,95 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+
+#include "model/game_events.hpp"
+#include <gtest/gtest.h>
+#include <string>
+#include <string_view>
+
+namespace {
+    /// Gets the record without its leading time.
+    [[nodiscard]] std::string_view strip_time(const std::string& record)
+    {
+        return std::string_view{record}.substr(record.find('\t') + 1);
+    }
+
+    TEST(GameEventsTest, LogPrefix)
+    {
+        ASSERT_TRUE(Model::has_game_log_prefix("L 01/02/2024 - 12:34:56: World triggered \"Round_Start\""));
+        ASSERT_FALSE(Model::has_game_log_prefix("L 01/02/2024 - 12:34:56 World triggered \"Round_Start\""));
+        ASSERT_FALSE(Model::has_game_log_prefix("L 0x/02/2024 - 12:34:56: World triggered \"Round_Start\""));
+        ASSERT_FALSE(Model::has_game_log_prefix("Server IP address 127.0.0.1:27015"));
+        ASSERT_FALSE(Model::has_game_log_prefix("L 01/02/2024"));
+    }
+
+    TEST(GameEventsTest, Kill)
+    {
+        Model::GameEventExtractor extractor{};
+
+        ASSERT_TRUE(extractor.process_line("L 01/02/2024 - 12:34:56: \"Player<2><STEAM_0:1:123><CT>\" killed "
+                                           "\"Other <3><STEAM_0:0:456><TERRORIST>\" with \"ak47\""));
+        ASSERT_EQ(strip_time(extractor.get_last_record()),
+                  "kill\tPlayer\tSTEAM_0:1:123\tCT\tOther \tSTEAM_0:0:456\tTERRORIST\tak47");
+    }
+
+    TEST(GameEventsTest, PlayerEventsAndMap)
+    {
+        Model::GameEventExtractor extractor{};
+
+        ASSERT_TRUE(extractor.process_line(
+          "L 01/02/2024 - 12:34:56: \"Player<2><STEAM_0:1:123><>\" connected, address \"10.0.0.1:27005\""));
+        ASSERT_EQ(strip_time(extractor.get_last_record()), "connect\tPlayer\tSTEAM_0:1:123\t\t10.0.0.1:27005");
+
+        ASSERT_TRUE(extractor.process_line("L 01/02/2024 - 12:34:56: \"Player<2><STEAM_0:1:123><>\" entered the game"));
+        ASSERT_EQ(strip_time(extractor.get_last_record()), "enter\tPlayer\tSTEAM_0:1:123\t");
+
+        ASSERT_TRUE(
+          extractor.process_line("L 01/02/2024 - 12:34:56: \"Player<2><STEAM_0:1:123><CT>\" disconnected\r"));
+        ASSERT_EQ(strip_time(extractor.get_last_record()), "disconnect\tPlayer\tSTEAM_0:1:123\tCT");
+
+        ASSERT_TRUE(extractor.process_line("L 01/02/2024 - 12:34:56: Started map \"de_dust2\" (CRC \"-12345\")"));
+        ASSERT_EQ(strip_time(extractor.get_last_record()), "map\tde_dust2");
+
+        ASSERT_FALSE(extractor.process_line("L 01/02/2024 - 12:34:56: \"Player<2><STEAM_0:1:123><CT>\" say \"hi\""));
+        ASSERT_EQ(extractor.get_event_count(), 4);
+    }
+
+    TEST(GameEventsTest, TypeFilter)
+    {
+        Model::GameEventExtractor extractor{Model::parse_game_event_types("map, Kill,unknown")};
+
+        ASSERT_TRUE(extractor.process_line("L 01/02/2024 - 12:34:56: Started map \"de_dust2\""));
+        ASSERT_FALSE(
+          extractor.process_line("L 01/02/2024 - 12:34:56: \"Player<2><STEAM_0:1:123><>\" entered the game"));
+    }
+
+    TEST(GameEventsTest, LinesAreReassembled)
+    {
+        Model::GameEventExtractor extractor{};
+
+        extractor.feed("Unrelated output\nL 01/02/2024 - 12:34:56: Started");
+        ASSERT_EQ(extractor.get_event_count(), 0);
+
+        extractor.feed(" map \"de_inferno\"\nL 01/02/2024 - 12:35:00: Started map \"de_nuke\"\n");
+        ASSERT_EQ(extractor.get_event_count(), 2);
+        ASSERT_EQ(strip_time(extractor.get_last_record()), "map\tde_nuke");
+    }
+}
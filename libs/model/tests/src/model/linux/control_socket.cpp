@@ -0,0 +1,458 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#include "model/linux/control_socket.hpp"
+#include "common/engine/interface/dedicated_serverapi_interface.hpp"
+#include "common/engine/interface/system_interface.hpp"
+#include "util/linux/reactor.hpp"
+#include <gtest/gtest.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+namespace {
+    /// Runs frames until it is stopped.
+    class FakeServerApi final : public Common::DedicatedServerApiInterface {
+      public:
+        bool init(const char*, const char*, Common::CreateInterfaceFunc, Common::CreateInterfaceFunc) override
+        {
+            return true;
+        }
+
+        int shutdown() override
+        {
+            return 0;
+        }
+
+        bool run_frame() override
+        {
+            return !stopped.load();
+        }
+
+        void add_console_text(const char*) override
+        {
+        }
+
+        void update_status(float* const fps, int* const active_players, int* const max_players,
+                           char* const current_map) override
+        {
+            *fps = 0.0F;
+            *active_players = 0;
+            *max_players = 0;
+            *current_map = '\0';
+        }
+
+        std::atomic<bool> stopped{};
+    };
+
+    /// Answers every command with the line "ran: <command>" through the redirect buffer.
+    class FakeSystem final : public Common::SystemInterface {
+      public:
+        bool init(Common::SystemInterface*, int, const char*) override
+        {
+            return true;
+        }
+
+        void run_frame(double) override
+        {
+        }
+
+        void receive_signal(SystemModuleInterface*, unsigned int, void*) override
+        {
+        }
+
+        void execute_command(int, const char*) override
+        {
+        }
+
+        void register_listener(SystemModuleInterface*) override
+        {
+        }
+
+        void remove_listener(SystemModuleInterface*) override
+        {
+        }
+
+        Common::SystemInterface* get_system() override
+        {
+            return this;
+        }
+
+        int get_serial() override
+        {
+            return 0;
+        }
+
+        char* get_status_line() override
+        {
+            return nullptr;
+        }
+
+        char* get_type() override
+        {
+            return nullptr;
+        }
+
+        char* get_name() override
+        {
+            return nullptr;
+        }
+
+        int get_state() override
+        {
+            return 0;
+        }
+
+        int get_version() override
+        {
+            return 0;
+        }
+
+        void shutdown() override
+        {
+        }
+
+        double get_time() override
+        {
+            return 0.0;
+        }
+
+        unsigned int get_tick() override
+        {
+            return 0;
+        }
+
+        void set_fps(float) override
+        {
+        }
+
+        void print(const char*, ...) override
+        {
+        }
+
+        void print_debug(const char*, ...) override
+        {
+        }
+
+        void redirect_output(char* const buffer, const int max_size) override
+        {
+            redirect_buffer_ = buffer;
+            redirect_size_ = max_size;
+        }
+
+        Common::FileSystemInterface* get_file_system() override
+        {
+            return nullptr;
+        }
+
+        void* load_file(const char*, int*) override
+        {
+            return nullptr;
+        }
+
+        void free_file(void*) override
+        {
+        }
+
+        void set_title(const char*) override
+        {
+        }
+
+        void set_status(const char*) override
+        {
+        }
+
+        void show_console(bool) override
+        {
+        }
+
+        void log_console(const char*) override
+        {
+        }
+
+        bool init_vgui(Common::VGuiModuleInterface*) override
+        {
+            return false;
+        }
+
+        bool register_command(const char*, SystemModuleInterface*, int) override
+        {
+            return false;
+        }
+
+        void get_command_matches(const char*, Common::ObjectContainer*) override
+        {
+        }
+
+        void execute_string(const char* const commands) override
+        {
+            if (nullptr != redirect_buffer_) {
+                const auto output = std::string{"ran: "}.append(commands);
+                const auto used = std::strlen(redirect_buffer_);
+                const auto size = std::min(output.size(), static_cast<std::size_t>(redirect_size_) - used);
+                std::memcpy(redirect_buffer_ + used, output.data(), size);
+            }
+        }
+
+        void execute_file(const char*) override
+        {
+        }
+
+        void print_error(const char*, ...) override
+        {
+        }
+
+        const char* check_param(const char*) override
+        {
+            return nullptr;
+        }
+
+        bool add_module(SystemModuleInterface*, const char*) override
+        {
+            return false;
+        }
+
+        SystemModuleInterface* get_module(const char*, const char*, const char*) override
+        {
+            return nullptr;
+        }
+
+        bool remove_module(SystemModuleInterface*) override
+        {
+            return false;
+        }
+
+        void stop() override
+        {
+        }
+
+        const char* get_base_dir() override
+        {
+            return "";
+        }
+
+      private:
+        char* redirect_buffer_{};
+        int redirect_size_{};
+    };
+
+    /// A reply read from the socket.
+    struct Reply {
+        std::string id{};
+        std::string output{};
+
+        bool operator==(const Reply& other) const
+        {
+            return id == other.id && output == other.output;
+        }
+    };
+
+    class ControlSocketTest : public ::testing::Test {
+      protected:
+        static void SetUpTestSuite()
+        {
+            ASSERT_TRUE(Util::get_reactor().start());
+        }
+
+        static void TearDownTestSuite()
+        {
+            Util::get_reactor().stop();
+        }
+
+        void SetUp() override
+        {
+            auto directory = (std::filesystem::temp_directory_path() / "control_socket.XXXXXX").string();
+            ASSERT_NE(::mkdtemp(directory.data()), nullptr);
+            directory_ = directory;
+            socket_path = (directory_ / "server.ctl").string();
+
+            server_thread_ = std::thread{[this] {
+                server_loop_->run(server_api_);
+            }};
+
+            ASSERT_TRUE(control_socket_.start(socket_path));
+        }
+
+        void TearDown() override
+        {
+            control_socket_.stop();
+            server_api_.stopped = true;
+
+            if (server_thread_.joinable()) {
+                server_thread_.join();
+            }
+
+            std::filesystem::remove_all(directory_);
+        }
+
+        /// Connects a client with a receive timeout, so a missing reply fails the test instead of hanging it.
+        [[nodiscard]] int connect_client() const
+        {
+            const auto fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+            ::sockaddr_un address{};
+            address.sun_family = AF_UNIX;
+            std::memcpy(address.sun_path, socket_path.c_str(), socket_path.size() + 1);
+
+            const ::timeval timeout{5, 0};
+            ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+            if (::connect(fd, reinterpret_cast<const ::sockaddr*>(&address), sizeof(address)) < 0) {
+                ::close(fd);
+                return -1;
+            }
+
+            return fd;
+        }
+
+        static void send_text(const int fd, const std::string& text)
+        {
+            ASSERT_EQ(::send(fd, text.data(), text.size(), MSG_NOSIGNAL), static_cast<ssize_t>(text.size()));
+        }
+
+        /// Reads the given number of replies, fewer if the connection ends or times out.
+        static std::vector<Reply> read_replies(const int fd, const std::size_t count)
+        {
+            std::vector<Reply> replies{};
+            std::string data{};
+
+            while (replies.size() < count) {
+                const auto header_end = data.find('\n');
+
+                if (std::string::npos != header_end) {
+                    const auto separator = data.find(' ');
+                    const auto size = std::stoul(data.substr(separator + 1, header_end - separator - 1));
+
+                    if (data.size() >= header_end + 1 + size) {
+                        replies.push_back({data.substr(0, separator), data.substr(header_end + 1, size)});
+                        data.erase(0, header_end + 1 + size);
+                        continue;
+                    }
+                }
+
+                char buffer[4096];
+                const auto received = ::recv(fd, buffer, sizeof(buffer), 0);
+
+                if (received <= 0) {
+                    break;
+                }
+
+                data.append(buffer, static_cast<std::size_t>(received));
+            }
+
+            return replies;
+        }
+
+        std::string socket_path{};
+
+      private:
+        std::filesystem::path directory_{};
+        FakeServerApi server_api_{};
+        FakeSystem system_{};
+        std::shared_ptr<Model::ServerLoop> server_loop_{std::make_shared<Model::ServerLoop>()};
+        Model::ControlSocket control_socket_{server_loop_, std::make_shared<Model::ConsoleCommands>(&system_)};
+        std::thread server_thread_{};
+    };
+
+    TEST_F(ControlSocketTest, SocketIsOwnerOnly)
+    {
+        struct ::stat status{};
+        ASSERT_EQ(::stat(socket_path.c_str(), &status), 0);
+        ASSERT_TRUE(S_ISSOCK(status.st_mode));
+        ASSERT_EQ(status.st_mode & 0777U, 0600U);
+
+        // The directory the socket was bound in is removed
+        const auto directory = std::filesystem::path{socket_path}.parent_path();
+        ASSERT_EQ(std::distance(std::filesystem::directory_iterator{directory}, {}), 1);
+    }
+
+    TEST_F(ControlSocketTest, RepliesToPipelinedRequestsInOrder)
+    {
+        const auto client = connect_client();
+        ASSERT_GE(client, 0);
+
+        send_text(client, "1 status\n"
+                          "two  echo a b \n"
+                          "3\n"
+                          "4 sta");
+        send_text(client, "ts\r\n");
+
+        ASSERT_EQ(read_replies(client, 4), (std::vector<Reply>{{"1", "ran: status\n"},
+                                                              {"two", "ran: echo a b\n"},
+                                                              {"3", ""},
+                                                              {"4", "ran: stats\n"}}));
+        ::close(client);
+    }
+
+    TEST_F(ControlSocketTest, HalfClosedClientGetsRepliesBeforeDisconnect)
+    {
+        const auto client = connect_client();
+        ASSERT_GE(client, 0);
+
+        // The last request has no line break, the end of the input completes it
+        send_text(client, "1 status\n2 users");
+        ASSERT_EQ(::shutdown(client, SHUT_WR), 0);
+
+        ASSERT_EQ(read_replies(client, 2), (std::vector<Reply>{{"1", "ran: status\n"}, {"2", "ran: users\n"}}));
+
+        char data = 0;
+        ASSERT_EQ(::recv(client, &data, 1, 0), 0);
+        ::close(client);
+    }
+
+    TEST_F(ControlSocketTest, ClientDisconnectingMidBatchDoesNotAffectOthers)
+    {
+        const auto leaving = connect_client();
+        const auto staying = connect_client();
+        ASSERT_GE(leaving, 0);
+        ASSERT_GE(staying, 0);
+
+        std::string requests{};
+
+        for (auto i = 0; i < 1000; ++i) {
+            requests.append(std::to_string(i)).append(" status\n");
+        }
+
+        // The replies of the first client are still being executed when it disconnects
+        send_text(leaving, requests);
+        ::close(leaving);
+
+        send_text(staying, "1 status\n");
+        ASSERT_EQ(read_replies(staying, 1), (std::vector<Reply>{{"1", "ran: status\n"}}));
+
+        const auto reconnected = connect_client();
+        ASSERT_GE(reconnected, 0);
+        send_text(reconnected, "2 users\n");
+        ASSERT_EQ(read_replies(reconnected, 1), (std::vector<Reply>{{"2", "ran: users\n"}}));
+
+        ::close(staying);
+        ::close(reconnected);
+    }
+}
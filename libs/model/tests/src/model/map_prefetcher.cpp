@@ -0,0 +1,85 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#include "model/map_prefetcher.hpp"
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+namespace {
+    TEST(MapPrefetcherTest, ParseMapcycle)
+    {
+        const std::string content = "de_dust2\n"
+                                    "// de_commented\n"
+                                    "maps/de_inferno.bsp // trailing comment\r\n"
+                                    "cs_office\n"
+                                    "{\n"
+                                    "  minplayers 4\n"
+                                    "}\n"
+                                    "  de_nuke.BSP  \n"
+                                    "\n";
+
+        EXPECT_EQ(Model::parse_mapcycle(content),
+                  (std::vector<std::string>{"de_dust2", "de_inferno", "cs_office", "de_nuke"}));
+        EXPECT_TRUE(Model::parse_mapcycle("").empty());
+    }
+
+    TEST(MapPrefetcherTest, ParseRes)
+    {
+        const std::string content = "// resources of the map\n"
+                                    "sound\\ambience\\wind.wav\n"
+                                    "  \"models/custom.mdl\"  \n"
+                                    "\n"
+                                    "gfx/env/skyrt.tga // sky\n";
+
+        EXPECT_EQ(Model::parse_res(content), (std::vector<std::string>{
+                                               "sound/ambience/wind.wav", "models/custom.mdl", "gfx/env/skyrt.tga"}));
+    }
+
+    TEST(MapPrefetcherTest, ParseEntities)
+    {
+        const std::string entities = "{\n"
+                                     "\"classname\" \"worldspawn\"\n"
+                                     "\"wad\" \"\\half-life\\valve\\halflife.wad;C:/maps/cs_dust.wad;\"\n"
+                                     "\"skyname\" \"des\"\n"
+                                     "}\n"
+                                     "{\n"
+                                     "\"classname\" \"cycler\"\n"
+                                     "\"model\" \"models/barney.mdl\"\n"
+                                     "}\n"
+                                     "{\n"
+                                     "\"classname\" \"ambient_generic\"\n"
+                                     "\"message\" \"ambience/rain.wav\"\n"
+                                     "\"model\" \"*12\"\n"
+                                     "\"target\" \"sprites/ignored\"\n"
+                                     "}\n";
+
+        EXPECT_EQ(Model::parse_entities(entities),
+                  (std::vector<std::string>{"halflife.wad", "cs_dust.wad", "gfx/env/desrt.tga", "gfx/env/desbk.tga",
+                                            "gfx/env/deslf.tga", "gfx/env/desft.tga", "gfx/env/desup.tga",
+                                            "gfx/env/desdn.tga", "models/barney.mdl", "sound/ambience/rain.wav"}));
+    }
+
+    TEST(MapPrefetcherTest, ParseEntitiesUnterminated)
+    {
+        EXPECT_EQ(Model::parse_entities("{ \"model\" \"models/a.mdl\" \"model\" \"models/b"),
+                  (std::vector<std::string>{"models/a.mdl"}));
+    }
+}
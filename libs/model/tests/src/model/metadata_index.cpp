@@ -0,0 +1,187 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#include "model/metadata_index.hpp"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    class MetadataIndexTest : public ::testing::Test {
+      protected:
+        void SetUp() override
+        {
+            std::filesystem::create_directories(temp_dir / "maps");
+        }
+
+        void TearDown() override
+        {
+            index.unload();
+            std::filesystem::remove_all(temp_dir);
+        }
+
+        [[nodiscard]] bool save(const std::unordered_map<std::string, Model::FileMetadata>& entries) const
+        {
+            return Model::MetadataIndex::save(index_file.string(), {"valve", "cstrike"},
+                                              {(temp_dir / "maps").string()}, entries);
+        }
+
+        [[nodiscard]] static Model::FileMetadata make_file(const std::uint32_t size, const std::int64_t filetime)
+        {
+            Model::FileMetadata metadata{};
+            metadata.exists_known = true;
+            metadata.exists = true;
+            metadata.size_known = true;
+            metadata.size = size;
+            metadata.filetime_known = true;
+            metadata.filetime = filetime;
+
+            return metadata;
+        }
+
+        std::filesystem::path temp_dir{std::filesystem::temp_directory_path() / "test_metadata_index"};
+        std::filesystem::path index_file{temp_dir / "metadata.bin"};
+        Model::MetadataIndex index{};
+    };
+
+    TEST_F(MetadataIndexTest, LoadMissingFile)
+    {
+        ASSERT_FALSE(index.load(index_file.string()));
+        ASSERT_FALSE(index.is_loaded());
+        ASSERT_FALSE(index.is_up_to_date());
+    }
+
+    TEST_F(MetadataIndexTest, LoadInvalidFile)
+    {
+        std::ofstream{index_file, std::ios::binary} << "not a metadata cache file at all";
+
+        ASSERT_FALSE(index.load(index_file.string()));
+        ASSERT_FALSE(index.is_loaded());
+    }
+
+    TEST_F(MetadataIndexTest, LoadTruncatedFile)
+    {
+        ASSERT_TRUE(save({{"maps/de_dust2.bsp", make_file(1024, 42)}}));
+        std::filesystem::resize_file(index_file, std::filesystem::file_size(index_file) - 1);
+
+        ASSERT_FALSE(index.load(index_file.string()));
+    }
+
+    TEST_F(MetadataIndexTest, RoundTrip)
+    {
+        Model::FileMetadata missing{};
+        missing.exists_known = true;
+
+        Model::FileMetadata directory{};
+        directory.is_directory_known = true;
+        directory.is_directory = true;
+
+        ASSERT_TRUE(save({{"maps/de_dust2.bsp", make_file(1024, 42)},
+                          {"maps/missing.bsp", missing},
+                          {"maps", directory}}));
+        ASSERT_TRUE(index.load(index_file.string()));
+        ASSERT_EQ(3, index.get_entry_count());
+        ASSERT_EQ((std::vector<std::string>{"valve", "cstrike"}), index.get_search_roots());
+
+        const auto file = index.find("maps/de_dust2.bsp");
+        ASSERT_TRUE(file.has_value());
+        ASSERT_TRUE(file->exists_known && file->exists);
+        ASSERT_FALSE(file->is_directory_known);
+        ASSERT_TRUE(file->size_known);
+        ASSERT_EQ(1024, file->size);
+        ASSERT_TRUE(file->filetime_known);
+        ASSERT_EQ(42, file->filetime);
+
+        const auto missing_file = index.find("maps/missing.bsp");
+        ASSERT_TRUE(missing_file.has_value());
+        ASSERT_TRUE(missing_file->exists_known);
+        ASSERT_FALSE(missing_file->exists);
+
+        const auto dir = index.find("maps");
+        ASSERT_TRUE(dir.has_value());
+        ASSERT_TRUE(dir->is_directory_known && dir->is_directory);
+
+        ASSERT_FALSE(index.find("maps/de_inferno.bsp").has_value());
+    }
+
+    TEST_F(MetadataIndexTest, ManyEntries)
+    {
+        std::unordered_map<std::string, Model::FileMetadata> entries{};
+
+        for (std::uint32_t i = 0; i < 1000; ++i) {
+            entries.emplace("sound/file" + std::to_string(i) + ".wav", make_file(i, i));
+        }
+
+        ASSERT_TRUE(save(entries));
+        ASSERT_TRUE(index.load(index_file.string()));
+        ASSERT_EQ(entries.size(), index.get_entry_count());
+
+        for (std::uint32_t i = 0; i < 1000; ++i) {
+            const auto file = index.find("sound/file" + std::to_string(i) + ".wav");
+            ASSERT_TRUE(file.has_value());
+            ASSERT_EQ(i, file->size);
+        }
+
+        std::size_t visited = 0;
+        index.for_each([&](const std::string_view path, const Model::FileMetadata& metadata) {
+            ASSERT_EQ(entries.at(std::string{path}).size, metadata.size);
+            ++visited;
+        });
+
+        ASSERT_EQ(entries.size(), visited);
+    }
+
+    TEST_F(MetadataIndexTest, SkipsUnknownEntries)
+    {
+        ASSERT_TRUE(save({{"maps/de_dust2.bsp", make_file(1, 1)}, {"maps/unknown.bsp", Model::FileMetadata{}}}));
+        ASSERT_TRUE(index.load(index_file.string()));
+        ASSERT_EQ(1, index.get_entry_count());
+        ASSERT_FALSE(index.find("maps/unknown.bsp").has_value());
+    }
+
+    TEST_F(MetadataIndexTest, DetectsDirectoryChanges)
+    {
+        ASSERT_TRUE(save({{"maps/de_dust2.bsp", make_file(1, 1)}}));
+        ASSERT_TRUE(index.load(index_file.string()));
+        ASSERT_TRUE(index.is_up_to_date());
+
+        // Makes sure the change is visible even on filesystems with a coarse timestamp resolution
+        const auto maps_dir = temp_dir / "maps";
+        std::filesystem::last_write_time(maps_dir,
+                                         std::filesystem::last_write_time(maps_dir) - std::chrono::seconds{10});
+
+        ASSERT_FALSE(index.is_up_to_date());
+    }
+
+    TEST_F(MetadataIndexTest, DetectsRemovedDirectories)
+    {
+        ASSERT_TRUE(save({{"maps/de_dust2.bsp", make_file(1, 1)}}));
+        ASSERT_TRUE(index.load(index_file.string()));
+
+        std::filesystem::remove_all(temp_dir / "maps");
+
+        ASSERT_FALSE(index.is_up_to_date());
+    }
+}
@@ -0,0 +1,132 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#include "model/pack_file.hpp"
+#include <gtest/gtest.h>
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+    class PackFileTest : public ::testing::Test {
+      protected:
+        void TearDown() override
+        {
+            std::filesystem::remove(temp_file);
+        }
+
+        /// Writes a pack file with 32-bit offsets.
+        void write_pack(const std::vector<std::pair<std::string, std::string>>& files) const
+        {
+            constexpr std::size_t header_size = 12;
+            constexpr std::size_t entry_size = 64;
+            constexpr std::size_t name_size = 56;
+
+            std::string content(header_size, '\0');
+            std::string directory{};
+
+            for (const auto& [name, data] : files) {
+                std::string entry(entry_size, '\0');
+                name.copy(entry.data(), name_size - 1);
+                write_int32(entry, name_size, static_cast<std::int32_t>(content.size()));
+                write_int32(entry, name_size + 4, static_cast<std::int32_t>(data.size()));
+
+                content += data;
+                directory += entry;
+            }
+
+            content.replace(0, 4, "PACK");
+            write_int32(content, 4, static_cast<std::int32_t>(content.size()));
+            write_int32(content, 8, static_cast<std::int32_t>(directory.size()));
+            content += directory;
+
+            std::ofstream{temp_file, std::ios::binary} << content;
+        }
+
+        static void write_int32(std::string& buffer, const std::size_t offset, const std::int32_t value)
+        {
+            for (std::size_t i = 0; i < 4; ++i) {
+                buffer[offset + i] = static_cast<char>((static_cast<std::uint32_t>(value) >> (i * 8)) & 0xFFU);
+            }
+        }
+
+        std::filesystem::path temp_file{std::filesystem::temp_directory_path() / "test_pack.pak"};
+        Model::PackFile pack{};
+    };
+
+    TEST_F(PackFileTest, OpenMissingFile)
+    {
+        ASSERT_FALSE(pack.open(temp_file.string()));
+    }
+
+    TEST_F(PackFileTest, OpenInvalidFile)
+    {
+        std::ofstream{temp_file, std::ios::binary} << "not a pack file";
+        ASSERT_FALSE(pack.open(temp_file.string()));
+    }
+
+    TEST_F(PackFileTest, OpenTruncatedDirectory)
+    {
+        write_pack({{"maps/de_dust2.bsp", "bsp"}});
+        std::filesystem::resize_file(temp_file, std::filesystem::file_size(temp_file) - 1);
+
+        ASSERT_FALSE(pack.open(temp_file.string()));
+    }
+
+    TEST_F(PackFileTest, FindEntries)
+    {
+        write_pack({{"maps/de_dust2.bsp", "bsp data"}, {"sound/ambience/wind.wav", "wav"}});
+
+        ASSERT_TRUE(pack.open(temp_file.string()));
+        ASSERT_EQ(pack.get_entry_count(), 2);
+        ASSERT_EQ(pack.find("maps/de_dust2.bsp"), "bsp data");
+        ASSERT_EQ(pack.find("sound/ambience/wind.wav"), "wav");
+        ASSERT_EQ(pack.find("maps/de_aztec.bsp"), std::nullopt);
+    }
+
+    TEST_F(PackFileTest, FindIgnoresCaseAndSlashes)
+    {
+        write_pack({{"Maps/De_Dust2.bsp", "bsp"}});
+
+        ASSERT_TRUE(pack.open(temp_file.string()));
+        ASSERT_EQ(pack.find("maps\\de_dust2.BSP"), "bsp");
+        ASSERT_EQ(pack.find("/maps/de_dust2.bsp"), "bsp");
+    }
+
+    TEST_F(PackFileTest, FirstDuplicateEntryWins)
+    {
+        write_pack({{"gfx.wad", "first"}, {"gfx.wad", "second"}});
+
+        ASSERT_TRUE(pack.open(temp_file.string()));
+        ASSERT_EQ(pack.find("gfx.wad"), "first");
+    }
+
+    TEST_F(PackFileTest, EmptyEntry)
+    {
+        write_pack({{"empty.txt", ""}});
+
+        ASSERT_TRUE(pack.open(temp_file.string()));
+        ASSERT_EQ(pack.find("empty.txt"), "");
+    }
+}
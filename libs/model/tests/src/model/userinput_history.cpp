@@ -22,8 +22,22 @@
 #include <gtest/gtest.h>
 #include <filesystem>
 #include <fstream>
+#include <string>
+#include <vector>
 
 namespace {
+    std::vector<std::string> read_lines(const std::filesystem::path& path)
+    {
+        std::ifstream file(path);
+        std::vector<std::string> lines;
+
+        for (std::string line; std::getline(file, line);) {
+            lines.push_back(line);
+        }
+
+        return lines;
+    }
+
     class UserInputHistoryTest : public ::testing::Test {
       protected:
         void SetUp() override
@@ -195,6 +209,7 @@ namespace {
         history.append("test1");
         history.append("test2");
         history.save();
+        history.flush();
 
         ASSERT_TRUE(std::filesystem::exists(temp_file));
         std::ifstream file(temp_file);
@@ -208,4 +223,40 @@ namespace {
         ASSERT_EQ(lines[0], "test1");
         ASSERT_EQ(lines[1], "test2");
     }
+
+    TEST_F(UserInputHistoryTest, SaveAppendsToJournal)
+    {
+        history.append("test1");
+        history.save();
+        history.append("test2");
+        history.append("test3");
+        history.save();
+        history.save();
+        history.flush();
+
+        ASSERT_EQ(read_lines(temp_file), (std::vector<std::string>{"test1", "test2", "test3"}));
+    }
+
+    TEST_F(UserInputHistoryTest, JournalIsCompacted)
+    {
+        for (int i = 0; i < 250; ++i) {
+            history.append("test" + std::to_string(i));
+            history.save();
+        }
+
+        history.flush();
+        const auto lines = read_lines(temp_file);
+
+        ASSERT_LT(lines.size(), 2 * Model::HISTORY_CAPACITY);
+        ASSERT_EQ(lines.back(), "test249");
+
+        Model::UserInputHistory loaded{temp_file.string()};
+        loaded.load();
+
+        for (int i = 249; i >= 250 - static_cast<int>(Model::HISTORY_CAPACITY); --i) {
+            ASSERT_EQ(loaded.previous(), "test" + std::to_string(i));
+        }
+
+        ASSERT_EQ(loaded.previous(), std::nullopt);
+    }
 }
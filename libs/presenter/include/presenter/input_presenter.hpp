@@ -23,6 +23,7 @@
 #include "model/console_commands.hpp"
 #include "model/server_loop.hpp"
 #include "model/userinput_history.hpp"
+#include "util/string.hpp"
 #include <cassert>
 #include <memory>
 #include <utility>
@@ -64,9 +65,23 @@ namespace Presenter {
          */
         void enqueue_input(std::string_view input) const;
 
+        /**
+         * @brief Enqueues a line read from a standard input that is not a terminal to the ServerLoop.
+         *
+         * Scripted input is not added to the input history, which is saved to a file on every change.
+         *
+         * @param input The input line to enqueue.
+         */
+        void enqueue_piped_input(std::string_view input) const;
+
         /**
          * @brief Searches for console command matches for the given command.
          *
+         * The matches are looked up in the launcher-side index without waiting for the server thread,
+         * which refreshes the names with the same first character in the background if they are stale.
+         * Until the index is built, no matches are returned and the build is requested again,
+         * the caller never waits for the server thread.
+         *
          * @param command The command to search for matches.
          *
          * @return A vector of matching console commands.
@@ -110,6 +125,11 @@ namespace Presenter {
         assert(input_history_ != nullptr);
         assert(console_commands_ != nullptr);
         input_history_->load();
+
+        // Built on the server thread once the loop starts, completions are answered from it afterwards
+        server_loop_->enqueue_task<void>([console_commands = console_commands_] {
+            console_commands->refresh_index({});
+        });
     }
 
     inline void InputPresenter::enqueue_input(const std::string_view input) const
@@ -119,13 +139,33 @@ namespace Presenter {
         input_history_->save();
     }
 
+    inline void InputPresenter::enqueue_piped_input(const std::string_view input) const
+    {
+        server_loop_->enqueue_input(input);
+    }
+
     inline std::vector<std::string> InputPresenter::find_command_matches(const std::string_view command) const
     {
-        auto matches = server_loop_->enqueue_task<std::vector<std::string>>([this, command] {
-            return console_commands_->find_command_matches(std::string{command});
+        if (auto& index = console_commands_->get_index(); index.is_built()) {
+            // Names registered since the last refresh show up on the next completion
+            if (index.take_refresh(command)) {
+                auto prefix = Util::str::to_lower(command.substr(0, 1));
+
+                server_loop_->enqueue_task<void>([console_commands = console_commands_, prefix = std::move(prefix)] {
+                    console_commands->refresh_index(prefix);
+                });
+            }
+
+            return index.find_matches(command);
+        }
+
+        // Called from the input handlers, which must not wait for the server thread, so there are no matches
+        // until the index is built
+        server_loop_->enqueue_task<void>([console_commands = console_commands_] {
+            console_commands->refresh_index({});
         });
 
-        return matches.get();
+        return {};
     }
 
     inline std::optional<std::string> InputPresenter::history_previous() const
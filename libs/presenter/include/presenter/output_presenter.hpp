@@ -76,8 +76,11 @@ namespace Presenter {
     inline void OutputPresenter::update_server_status(const Model::ServerLoopEvent event) const
     {
         if (Model::ServerLoopEvent::status_updated == event) {
-            const auto& [fps, num_players, max_players, current_map] = server_loop_->get_status();
-            view_->display_server_status(fps, num_players, max_players, current_map);
+            const auto& status = server_loop_->get_status();
+            const auto& frame_times = status.frame_times;
+
+            view_->display_frame_times(frame_times.fps, frame_times.median_ms, frame_times.p99_ms, frame_times.max_ms);
+            view_->display_server_status(status.fps, status.num_players, status.max_players, status.current_map);
         }
     }
 }
@@ -0,0 +1,112 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+
+#include "util/log_output.hpp"
+#include "util/logger.hpp"
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string_view>
+
+namespace {
+    /// The number of heap allocations made by the process.
+    std::atomic<std::int64_t> allocation_count{};
+
+    /// Discards the messages, so only the formatting path is measured.
+    class NullLogOutput final : public Util::LogOutput {
+      public:
+        void write_log(const std::string_view message) override
+        {
+            benchmark::DoNotOptimize(message.data());
+        }
+    };
+
+    /// Routes the log messages to the view only.
+    void init_view_logger()
+    {
+        Util::LogSettings settings{};
+        settings.log_output = std::make_shared<NullLogOutput>();
+        settings.rate_limit.enabled = false;
+        Util::log_init(settings);
+    }
+
+    /// Reports the number of heap allocations per logged line.
+    void report_allocations(benchmark::State& state, const std::int64_t allocations_before)
+    {
+        const auto allocations = allocation_count.load(std::memory_order_relaxed) - allocations_before;
+        state.counters["allocs_per_line"] =
+          benchmark::Counter(static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+    }
+
+    /// Logs a line without arguments at the info level.
+    void BM_LogInfoLine(benchmark::State& state)
+    {
+        init_view_logger();
+        const auto allocations_before = allocation_count.load(std::memory_order_relaxed);
+
+        for ([[maybe_unused]] auto _ : state) {
+            Util::log_info("Executing server.cfg\n");
+        }
+
+        report_allocations(state, allocations_before);
+    }
+
+    /// Logs a line with formatted arguments at a prefixed level.
+    void BM_LogWarningWithArguments(benchmark::State& state)
+    {
+        init_view_logger();
+        const auto allocations_before = allocation_count.load(std::memory_order_relaxed);
+
+        for ([[maybe_unused]] auto _ : state) {
+            Util::log_warn("Player {} (#{}) dropped, {} ms timeout", "unnamed", 17, 2500);
+        }
+
+        report_allocations(state, allocations_before);
+    }
+}
+
+void* operator new(const std::size_t size)
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+
+    if (auto* const ptr = std::malloc(size == 0 ? 1 : size); ptr != nullptr) {
+        return ptr;
+    }
+
+    std::abort();
+}
+
+void operator delete(void* const ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* const ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+BENCHMARK(BM_LogInfoLine);
+BENCHMARK(BM_LogWarningWithArguments);
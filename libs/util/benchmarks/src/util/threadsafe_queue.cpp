@@ -0,0 +1,114 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#include "util/threadsafe_queue.hpp"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    /// The number of elements pushed by each producer in an iteration.
+    constexpr int ITEMS_PER_PRODUCER = 20000;
+
+    /// The capacity of the bounded queue, about what a console input backlog holds.
+    constexpr Util::ThreadSafeQueue<std::string>::SizeType BOUNDED_CAPACITY = 256;
+
+    /// Starts the producers, each pushing its elements as fast as the queue takes them.
+    std::vector<std::thread> start_producers(Util::ThreadSafeQueue<std::string>& queue, const std::int64_t count)
+    {
+        std::vector<std::thread> producers{};
+
+        for (std::int64_t producer = 0; producer < count; ++producer) {
+            producers.emplace_back([&queue] {
+                for (int i = 0; i < ITEMS_PER_PRODUCER; ++i) {
+                    queue.emplace("status");
+                }
+            });
+        }
+
+        return producers;
+    }
+
+    /// A single consumer takes the elements one at a time with blocking pops.
+    void BM_Pop(benchmark::State& state)
+    {
+        const auto total = state.range(0) * ITEMS_PER_PRODUCER;
+
+        for ([[maybe_unused]] auto _ : state) {
+            Util::ThreadSafeQueue<std::string> queue{};
+            queue.set_capacity(static_cast<Util::ThreadSafeQueue<std::string>::SizeType>(state.range(1)));
+            auto producers = start_producers(queue, state.range(0));
+
+            for (std::int64_t received = 0; received < total; ++received) {
+                benchmark::DoNotOptimize(queue.pop());
+            }
+
+            for (auto& producer : producers) {
+                producer.join();
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * total);
+    }
+
+    /// A single consumer takes every queued element under one lock, waiting for the next one when empty.
+    void BM_DrainInto(benchmark::State& state)
+    {
+        const auto total = state.range(0) * ITEMS_PER_PRODUCER;
+
+        for ([[maybe_unused]] auto _ : state) {
+            Util::ThreadSafeQueue<std::string> queue{};
+            queue.set_capacity(static_cast<Util::ThreadSafeQueue<std::string>::SizeType>(state.range(1)));
+            auto producers = start_producers(queue, state.range(0));
+            std::vector<std::string> items{};
+            std::int64_t received = 0;
+
+            while (received < total) {
+                items.clear();
+
+                if (queue.drain_into(items) == 0) {
+                    benchmark::DoNotOptimize(queue.pop());
+                    ++received;
+                }
+
+                received += static_cast<std::int64_t>(items.size());
+                benchmark::DoNotOptimize(items.data());
+            }
+
+            for (auto& producer : producers) {
+                producer.join();
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * total);
+    }
+}
+
+// Arguments: the number of producers, the capacity of the queue (0 for an unbounded queue)
+BENCHMARK(BM_Pop)
+  ->ArgsProduct({{1, 2, 4}, {0, BOUNDED_CAPACITY}})
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
+BENCHMARK(BM_DrainInto)
+  ->ArgsProduct({{1, 2, 4}, {0, BOUNDED_CAPACITY}})
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
@@ -0,0 +1,209 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#pragma once
+
+#include "util/log_output.hpp"
+#include "util/logger.hpp"
+#include "util/mpmc_ring.hpp"
+#include "util/rotating_log_file.hpp"
+#include <spdlog/common.h>
+#include <spdlog/details/log_msg.h>
+#include <spdlog/formatter.h>
+#include <spdlog/sinks/sink.h>
+#include <atomic>
+#include <cstddef>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Util {
+    /**
+     * @brief A spdlog sink that queues the messages and writes them to the log outputs on a dedicated thread.
+     *
+     * The logging threads only copy the message into a preallocated slot of a lock-free ring buffer,
+     * messages longer than \c MAX_MESSAGE_SIZE are truncated. The writer thread formats
+     * the queued messages in batches and hands each batch to the view and the log file with a single call,
+     * the log file is flushed periodically. Critical messages are written and flushed before \c log() returns.
+     */
+    class AsyncLogSink final : public spdlog::sinks::sink {
+      public:
+        /**
+         * @brief The maximum size of a queued message in bytes.
+         */
+        static constexpr std::size_t MAX_MESSAGE_SIZE = 1024;
+
+        /**
+         * @brief Constructs a new AsyncLogSink object and starts the writer thread.
+         *
+         * @param settings The settings for asynchronous logging.
+         * @param log_output The object to display the messages, or \c nullptr to not display them.
+         * @param logfile The log file to append the messages to, or an empty string to not write a file.
+         * @param rotation The settings for the rotation of the log file.
+         */
+        AsyncLogSink(const LogAsyncSettings& settings, std::shared_ptr<LogOutput> log_output,
+                     const std::string& logfile, const LogRotationSettings& rotation);
+
+        /**
+         * @brief Writes the queued messages and stops the writer thread.
+         */
+        ~AsyncLogSink() override;
+
+        /// Move constructor.
+        AsyncLogSink(AsyncLogSink&&) = delete;
+
+        /// Copy constructor.
+        AsyncLogSink(const AsyncLogSink&) = delete;
+
+        /// Move assignment operator.
+        AsyncLogSink& operator=(AsyncLogSink&&) = delete;
+
+        /// Copy assignment operator.
+        AsyncLogSink& operator=(const AsyncLogSink&) = delete;
+
+        void log(const spdlog::details::log_msg& msg) override;
+
+        /**
+         * @brief Requests the writer thread to flush the outputs after the queued messages, does not wait.
+         */
+        void flush() override;
+
+        void set_pattern(const std::string& pattern) override;
+        void set_formatter(std::unique_ptr<spdlog::formatter> sink_formatter) override;
+
+        /**
+         * @brief Writes the queued messages and stops the writer thread.
+         *
+         * Messages logged afterwards are written synchronously.
+         */
+        void stop();
+
+        /**
+         * @brief Gets the counters of the sink.
+         *
+         * @return The counters of the sink.
+         */
+        [[nodiscard]] LogAsyncStats get_stats() const noexcept;
+
+      private:
+        /// A queued message, copying it only copies the used part of the payload.
+        struct Record {
+            spdlog::log_clock::time_point time{};
+            spdlog::level::level_enum level{};
+
+            /// The size of the payload.
+            std::size_t size{};
+
+            /// The payload, only the first \c size bytes are set.
+            char payload[MAX_MESSAGE_SIZE];
+
+            /// Default constructor, leaves the payload uninitialized.
+            Record() noexcept = default;
+
+            /// Constructs a record from a message, truncating its payload.
+            explicit Record(const spdlog::details::log_msg& msg) noexcept;
+
+            /// Copy constructor.
+            Record(const Record& other) noexcept;
+
+            /// Copy assignment operator.
+            Record& operator=(const Record& other) noexcept;
+
+            /// Default destructor.
+            ~Record() = default;
+
+            /// Gets the payload.
+            [[nodiscard]] spdlog::string_view_t get_payload() const noexcept
+            {
+                return {payload, size};
+            }
+        };
+
+        /// The body of the writer thread.
+        void run();
+
+        /// Writes a batch of messages to the outputs.
+        void write_records(const std::vector<Record>& records);
+
+        /// Flushes the outputs.
+        void flush_outputs();
+
+        /// Wakes up the writer thread if it is waiting for messages.
+        void wake_writer();
+
+        /// Requests a flush and waits until the writer thread has written everything queued before.
+        void flush_and_wait();
+
+        /// The settings for asynchronous logging.
+        const LogAsyncSettings settings_;
+
+        /// The object to display the messages.
+        const std::shared_ptr<LogOutput> log_output_;
+
+        /// The queued messages.
+        MpmcRing<Record> ring_;
+
+        /// Guards the formatter and the outputs.
+        std::mutex output_mutex_{};
+
+        /// Formats the messages.
+        std::unique_ptr<spdlog::formatter> formatter_{};
+
+        /// The log file, \c nullptr if the messages are not written to a file.
+        std::unique_ptr<RotatingLogFile> file_{};
+
+        /// Guards the waiting on the conditions below.
+        std::mutex mutex_{};
+
+        /// Signals the writer thread about new messages or requests.
+        std::condition_variable work_condition_{};
+
+        /// Signals the threads waiting for a flush.
+        std::condition_variable flush_condition_{};
+
+        /// Whether the writer thread is waiting for messages.
+        std::atomic<bool> sleeping_{};
+
+        /// Whether the writer thread is stopped.
+        std::atomic<bool> stopped_{};
+
+        /// The last requested flush.
+        std::atomic<std::uint64_t> flush_requested_{};
+
+        /// The last completed flush, guarded by \c mutex_.
+        std::uint64_t flush_completed_{};
+
+        /// The number of messages written.
+        std::atomic<std::uint64_t> written_{};
+
+        /// The number of messages dropped.
+        std::atomic<std::uint64_t> dropped_{};
+
+        /// The number of dropped messages already reported in the log.
+        std::uint64_t dropped_reported_{};
+
+        /// The writer thread.
+        std::thread thread_{};
+    };
+}
@@ -0,0 +1,310 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Util {
+    /**
+     * @brief An observable object whose listeners are notified without locks or allocations.
+     *
+     * Listeners are owned by the observable, the notifying thread only sees an immutable set of references
+     * to them, with the first few stored inline. Appending or removing a listener copies the set and
+     * publishes the copy atomically. The replaced sets and removed listeners are freed by a later change or
+     * by the destructor once no notification is in progress, so listeners may be changed from any thread,
+     * including from a listener.
+     *
+     * @tparam EventType The type of the event generated by the observable object.
+     * @tparam Args The types of the arguments passed to the listeners when an event is generated.
+     */
+    template <typename EventType, typename... Args>
+    class AtomicObservable {
+      public:
+        /**
+         * @brief Type alias for the handle used to identify listeners.
+         */
+        using Handle = std::size_t;
+
+        /**
+         * @brief The number of listeners stored inline in a listener set.
+         */
+        static constexpr std::size_t INLINE_LISTENERS = 8;
+
+        /**
+         * @brief Default constructor.
+         */
+        AtomicObservable() = default;
+
+        /// Move constructor.
+        AtomicObservable(AtomicObservable&&) = delete;
+
+        /// Copy constructor.
+        AtomicObservable(const AtomicObservable&) = delete;
+
+        /// Move assignment operator.
+        AtomicObservable& operator=(AtomicObservable&&) = delete;
+
+        /// Copy assignment operator.
+        AtomicObservable& operator=(const AtomicObservable&) = delete;
+
+        /**
+         * @brief Destructor.
+         */
+        ~AtomicObservable() = default;
+
+        /**
+         * @brief Adds a listener to the observable object.
+         *
+         * @tparam Listener The type of the listener, callable with the event and the arguments.
+         *
+         * @param listener The listener.
+         *
+         * @return A handle that can be used to remove the listener.
+         */
+        template <typename Listener>
+        Handle append_listener(Listener&& listener);
+
+        /**
+         * @brief Removes a listener from the observable object.
+         *
+         * A notification in progress may still call the listener.
+         *
+         * @param handle The handle of the listener to remove.
+         */
+        void remove_listener(Handle handle);
+
+      protected:
+        /**
+         * @brief Notifies all listeners of an event.
+         *
+         * @param event The event generated by the observable object.
+         * @param args The arguments to pass to the listeners.
+         */
+        void notify(const EventType& event, Args... args) const;
+
+      private:
+        /// A listener owned by the observable.
+        class OwnedListener {
+          public:
+            /// Default constructor.
+            OwnedListener() = default;
+
+            /// Move constructor.
+            OwnedListener(OwnedListener&&) = delete;
+
+            /// Copy constructor.
+            OwnedListener(const OwnedListener&) = delete;
+
+            /// Move assignment operator.
+            OwnedListener& operator=(OwnedListener&&) = delete;
+
+            /// Copy assignment operator.
+            OwnedListener& operator=(const OwnedListener&) = delete;
+
+            /// Virtual destructor.
+            virtual ~OwnedListener() = default;
+        };
+
+        /// A listener of a specific type.
+        template <typename Listener>
+        class TypedListener final : public OwnedListener {
+          public:
+            /// Constructs the listener by moving it.
+            explicit TypedListener(Listener&& listener) :
+              listener_(std::move(listener))
+            {
+            }
+
+            /// Constructs the listener by copying it.
+            explicit TypedListener(const Listener& listener) :
+              listener_(listener)
+            {
+            }
+
+            /// Calls the listener referenced by a \c ListenerRef.
+            static void invoke(const OwnedListener* const listener, const EventType& event, Args... args)
+            {
+                static_cast<const TypedListener*>(listener)->listener_(event, args...);
+            }
+
+          private:
+            /// The listener, mutable so listeners with state can be called.
+            mutable Listener listener_;
+        };
+
+        /// A reference to a listener: the listener and the function calling it.
+        struct ListenerRef {
+            /// The listener.
+            const OwnedListener* listener;
+
+            /// Calls the listener.
+            void (*invoke)(const OwnedListener*, const EventType&, Args...);
+
+            /// The handle of the listener.
+            Handle handle;
+        };
+
+        /// An immutable set of listeners, published to the notifying threads.
+        struct ListenerSet {
+            /// The number of listeners in the set.
+            std::size_t size{};
+
+            /// The first listeners of the set.
+            std::array<ListenerRef, INLINE_LISTENERS> inline_refs{};
+
+            /// The listeners past the inline ones.
+            std::vector<ListenerRef> overflow_refs{};
+
+            /// Gets a listener of the set.
+            [[nodiscard]] const ListenerRef& at(const std::size_t index) const noexcept
+            {
+                return (index < INLINE_LISTENERS) ? inline_refs[index] : overflow_refs[index - INLINE_LISTENERS];
+            }
+
+            /// Adds a listener to the set.
+            void add(const ListenerRef& ref)
+            {
+                if (size < INLINE_LISTENERS) {
+                    inline_refs[size] = ref;
+                }
+                else {
+                    overflow_refs.push_back(ref);
+                }
+
+                ++size;
+            }
+        };
+
+        /// Publishes a new set of listeners and frees what no notification can use anymore, under the lock.
+        void publish(std::unique_ptr<ListenerSet> listeners);
+
+        /// Serializes the changes of the listeners.
+        std::mutex mutex_{};
+
+        /// The published set of listeners, null when there are none.
+        std::atomic<const ListenerSet*> published_{};
+
+        /// The number of notifications in progress.
+        mutable std::atomic<std::size_t> notifying_{};
+
+        /// The published set of listeners, owned.
+        std::unique_ptr<ListenerSet> listeners_{};
+
+        /// The listeners, owned.
+        std::vector<std::pair<Handle, std::unique_ptr<OwnedListener>>> owned_listeners_{};
+
+        /// The replaced sets that a notification in progress may still use.
+        std::vector<std::unique_ptr<ListenerSet>> retired_sets_{};
+
+        /// The removed listeners that a notification in progress may still call.
+        std::vector<std::unique_ptr<OwnedListener>> retired_listeners_{};
+
+        /// The handle of the next listener.
+        Handle next_handle_{1};
+    };
+
+    template <typename EventType, typename... Args>
+    template <typename Listener>
+    typename AtomicObservable<EventType, Args...>::Handle
+      AtomicObservable<EventType, Args...>::append_listener(Listener&& listener)
+    {
+        using Typed = TypedListener<std::decay_t<Listener>>;
+
+        const std::scoped_lock lock{mutex_};
+        const auto handle = next_handle_++;
+        auto owned = std::make_unique<Typed>(std::forward<Listener>(listener));
+        auto listeners = listeners_ ? std::make_unique<ListenerSet>(*listeners_) : std::make_unique<ListenerSet>();
+
+        listeners->add(ListenerRef{owned.get(), &Typed::invoke, handle});
+        owned_listeners_.emplace_back(handle, std::move(owned));
+        publish(std::move(listeners));
+
+        return handle;
+    }
+
+    template <typename EventType, typename... Args>
+    void AtomicObservable<EventType, Args...>::remove_listener(const Handle handle)
+    {
+        const std::scoped_lock lock{mutex_};
+
+        for (auto it = owned_listeners_.begin(); it != owned_listeners_.end(); ++it) {
+            if (it->first != handle) {
+                continue;
+            }
+
+            auto listeners = std::make_unique<ListenerSet>();
+
+            for (std::size_t i = 0; i < listeners_->size; ++i) {
+                if (listeners_->at(i).handle != handle) {
+                    listeners->add(listeners_->at(i));
+                }
+            }
+
+            retired_listeners_.push_back(std::move(it->second));
+            owned_listeners_.erase(it);
+            publish(std::move(listeners));
+
+            return;
+        }
+    }
+
+    template <typename EventType, typename... Args>
+    void AtomicObservable<EventType, Args...>::notify(const EventType& event, Args... args) const
+    {
+        // Announcing the notification before loading the set keeps the set alive until it is done
+        notifying_.fetch_add(1, std::memory_order_seq_cst);
+
+        if (const auto* const listeners = published_.load(std::memory_order_seq_cst); listeners != nullptr) {
+            for (std::size_t i = 0; i < listeners->size; ++i) {
+                const auto& ref = listeners->at(i);
+                ref.invoke(ref.listener, event, args...);
+            }
+        }
+
+        notifying_.fetch_sub(1, std::memory_order_release);
+    }
+
+    template <typename EventType, typename... Args>
+    void AtomicObservable<EventType, Args...>::publish(std::unique_ptr<ListenerSet> listeners)
+    {
+        published_.store(listeners.get(), std::memory_order_seq_cst);
+
+        if (listeners_) {
+            retired_sets_.push_back(std::move(listeners_));
+        }
+
+        listeners_ = std::move(listeners);
+
+        // A notification starting from now on sees the new set, so when none is in progress, nothing uses
+        // the retired sets and listeners anymore
+        if (notifying_.load(std::memory_order_seq_cst) == 0) {
+            retired_sets_.clear();
+            retired_listeners_.clear();
+        }
+    }
+}
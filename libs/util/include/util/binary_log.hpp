@@ -0,0 +1,325 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#pragma once
+
+#include "util/mapped_file.hpp"
+#include <fmt/format.h>
+#include <spdlog/common.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+namespace Util {
+    /**
+     * @brief The types of the records in a binary log.
+     */
+    enum class BinaryLogRecordType : std::uint8_t {
+        /**
+         * @brief Starts a logging session, the format IDs of the previous session are no longer valid.
+         *
+         * Followed by \c BinaryLogWriter::SESSION_MARKER, which the reader searches for to resume reading
+         * after a record torn by a crash.
+         */
+        session = 1,
+
+        /** @brief Defines the format string for a format ID. */
+        format = 2,
+
+        /** @brief A message given as a format ID and the raw arguments. */
+        event = 3,
+
+        /** @brief A message given as plain text. */
+        text = 4
+    };
+
+    /**
+     * @brief The types of the arguments of a binary log event.
+     */
+    enum class BinaryLogArgType : std::uint8_t {
+        signed_integer = 1,
+        unsigned_integer = 2,
+        floating_point = 3,
+        boolean = 4,
+        character = 5,
+        string = 6
+    };
+
+    /**
+     * @brief Appends an argument of a log message to the encoded arguments of a binary log event.
+     *
+     * Arithmetic types and strings are stored as is, other types are stored as their formatted text.
+     *
+     * @tparam T The type of the argument.
+     *
+     * @param buffer The encoded arguments.
+     * @param value The argument.
+     */
+    template <typename T>
+    void encode_binary_log_arg(spdlog::memory_buf_t& buffer, const T& value)
+    {
+        using Type = std::decay_t<T>;
+
+        const auto append = [&buffer](const BinaryLogArgType type, const auto& data) {
+            buffer.push_back(static_cast<char>(type));
+            const auto* const bytes = reinterpret_cast<const char*>(&data);
+            buffer.append(bytes, bytes + sizeof(data));
+        };
+
+        const auto append_string = [&buffer](const std::string_view text) {
+            const auto size = static_cast<std::uint32_t>(text.size());
+            const auto* const size_bytes = reinterpret_cast<const char*>(&size);
+            buffer.push_back(static_cast<char>(BinaryLogArgType::string));
+            buffer.append(size_bytes, size_bytes + sizeof(size));
+            buffer.append(text.data(), text.data() + text.size());
+        };
+
+        if constexpr (std::is_same_v<Type, bool>) {
+            append(BinaryLogArgType::boolean, static_cast<std::uint8_t>(value ? 1 : 0));
+        }
+        else if constexpr (std::is_same_v<Type, char>) {
+            append(BinaryLogArgType::character, value);
+        }
+        else if constexpr (std::is_integral_v<Type> && std::is_signed_v<Type>) {
+            append(BinaryLogArgType::signed_integer, static_cast<std::int64_t>(value));
+        }
+        else if constexpr (std::is_integral_v<Type>) {
+            append(BinaryLogArgType::unsigned_integer, static_cast<std::uint64_t>(value));
+        }
+        else if constexpr (std::is_floating_point_v<Type>) {
+            append(BinaryLogArgType::floating_point, static_cast<double>(value));
+        }
+        else if constexpr (std::is_convertible_v<const Type&, std::string_view>) {
+            append_string(std::string_view{value});
+        }
+        else {
+            append_string(fmt::format("{}", value));
+        }
+    }
+
+    /**
+     * @brief Writes log messages as a compact binary record stream.
+     *
+     * Messages with arguments are stored as the ID of their format string and the raw arguments,
+     * each format string is written once per session. Formatting is left to the decoder.
+     */
+    class BinaryLogWriter final {
+      public:
+        /// The magic number at the start of a binary log file.
+        static constexpr std::uint32_t MAGIC = 0x4C424C48; // "HLBL"
+
+        /// The version of the format.
+        static constexpr std::uint32_t VERSION = 2;
+
+        /// Follows the type of a session record, "HLBLSYNC".
+        static constexpr std::uint64_t SESSION_MARKER = 0x434E59534C424C48;
+
+        /**
+         * @brief Default constructor.
+         */
+        BinaryLogWriter() = default;
+
+        /**
+         * @brief Flushes and closes the file.
+         */
+        ~BinaryLogWriter();
+
+        /// Move constructor.
+        BinaryLogWriter(BinaryLogWriter&&) = delete;
+
+        /// Copy constructor.
+        BinaryLogWriter(const BinaryLogWriter&) = delete;
+
+        /// Move assignment operator.
+        BinaryLogWriter& operator=(BinaryLogWriter&&) = delete;
+
+        /// Copy assignment operator.
+        BinaryLogWriter& operator=(const BinaryLogWriter&) = delete;
+
+        /**
+         * @brief Opens a binary log file for appending and starts a new session.
+         *
+         * @param path The path to the file.
+         *
+         * @return \c true if the file is open, \c false if it cannot be opened or has another format.
+         */
+        bool open(const std::string& path);
+
+        /**
+         * @brief Writes a message given as a format string and its encoded arguments.
+         *
+         * @param level The level of the message.
+         * @param format The format string.
+         * @param args The arguments encoded with \c Util::encode_binary_log_arg.
+         * @param arg_count The number of arguments.
+         */
+        void write_event(int level, std::string_view format, const spdlog::memory_buf_t& args, std::size_t arg_count);
+
+        /**
+         * @brief Writes a message given as plain text.
+         *
+         * @param level The level of the message.
+         * @param text The text of the message.
+         */
+        void write_text(int level, std::string_view text);
+
+        /**
+         * @brief Flushes the buffered records to the file.
+         */
+        void flush();
+
+      private:
+        /// Gets the ID of a format string, writing its definition on first use. \c mutex_ must be held.
+        [[nodiscard]] std::uint32_t intern_format(std::string_view format);
+
+        /// Writes the buffered record and flushes the file for errors. \c mutex_ must be held.
+        void commit(const spdlog::memory_buf_t& record, int level);
+
+        /// Guards the file and the format strings.
+        std::mutex mutex_{};
+
+        /// The open file.
+        std::FILE* file_{};
+
+        /// The format strings of the session.
+        std::deque<std::string> formats_{};
+
+        /// The IDs of the format strings of the session.
+        std::unordered_map<std::string_view, std::uint32_t> format_ids_{};
+    };
+
+    /**
+     * @brief An argument of a decoded binary log event.
+     */
+    using BinaryLogArg = std::variant<std::int64_t, std::uint64_t, double, bool, char, std::string_view>;
+
+    /**
+     * @brief A decoded binary log message.
+     */
+    struct BinaryLogMessage {
+        /// The time of the message in nanoseconds since the epoch.
+        std::int64_t time{};
+
+        /// The level of the message, a \c Util::LogLevel value.
+        int level{};
+
+        /// The format string, or the text of a plain text message.
+        std::string_view format{};
+
+        /// The arguments, empty for a plain text message.
+        std::vector<BinaryLogArg> args{};
+
+        /// Whether the message is plain text.
+        bool is_text{};
+
+        /**
+         * @brief Formats the message.
+         *
+         * @return The text of the message.
+         */
+        [[nodiscard]] std::string format_message() const;
+    };
+
+    /**
+     * @brief Reads the messages of a binary log file.
+     */
+    class BinaryLogReader final {
+      public:
+        /**
+         * @brief Opens a binary log file.
+         *
+         * @param path The path to the file.
+         *
+         * @return \c true if the file is a binary log, \c false otherwise.
+         */
+        bool open(const std::string& path);
+
+        /**
+         * @brief Reads the next message.
+         *
+         * A damaged or truncated record, e.g. the last record written before a crash, is skipped
+         * up to the next session.
+         *
+         * @param message The message to fill, its strings point into the file.
+         *
+         * @return \c true if a message was read, \c false at the end of the file or at a damaged record
+         * not followed by another session.
+         */
+        [[nodiscard]] bool next(BinaryLogMessage& message);
+
+        /**
+         * @brief Checks if the reader skipped or stopped at a damaged or truncated record.
+         *
+         * @return \c true if the file is damaged, \c false otherwise.
+         */
+        [[nodiscard]] bool is_damaged() const noexcept
+        {
+            return damaged_;
+        }
+
+      private:
+        /// The outcome of reading a record.
+        enum class RecordResult {
+            message,
+            skipped,
+            damaged
+        };
+
+        /// Reads the record at the current position.
+        [[nodiscard]] RecordResult read_record(BinaryLogMessage& message);
+
+        /// Finds the first session record starting in [\c from, \c end), returns \c npos if there is none.
+        [[nodiscard]] std::size_t find_session(std::size_t from, std::size_t end) const;
+
+        /// Reads an argument of the given type and appends it to the arguments.
+        [[nodiscard]] bool read_arg(BinaryLogArgType type, std::vector<BinaryLogArg>& args);
+
+        /// Reads an argument stored as is and appends it to the arguments.
+        template <typename T>
+        [[nodiscard]] bool read_value(std::vector<BinaryLogArg>& args);
+
+        /// Reads a value from the current position.
+        template <typename T>
+        [[nodiscard]] bool read(T& value);
+
+        /// Reads a length-prefixed string from the current position.
+        [[nodiscard]] bool read_string(std::string_view& value);
+
+        /// The mapped file.
+        MappedFile file_{};
+
+        /// The current position in the file.
+        std::size_t position_{};
+
+        /// The format strings of the current session.
+        std::unordered_map<std::uint32_t, std::string_view> formats_{};
+
+        /// Whether the reader stopped at a damaged record.
+        bool damaged_{};
+    };
+}
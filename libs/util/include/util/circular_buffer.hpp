@@ -20,14 +20,24 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 
 namespace Util {
     /**
      * @brief A fixed-size circular buffer.
      *
+     * Every slot holds a constructed element, the slots out of the buffer hold their last value. When \c N is
+     * a power of two, the indices are wrapped with a mask, otherwise with a comparison. The elements are stored
+     * in at most two contiguous segments, see \c get_segments.
+     *
      * @tparam T The type of elements in the buffer.
      * @tparam N The maximum number of elements in the buffer.
      */
@@ -54,6 +64,160 @@ namespace Util {
          */
         using ValueType = typename std::array<T, N>::value_type;
 
+        /**
+         * @brief Type alias for a pointer to an element in the buffer.
+         */
+        using Pointer = typename std::array<T, N>::pointer;
+
+        /**
+         * @brief Type alias for a const pointer to an element in the buffer.
+         */
+        using ConstPointer = typename std::array<T, N>::const_pointer;
+
+        /**
+         * @brief A bidirectional iterator over the elements of the buffer, from the front to the back.
+         *
+         * @tparam Buffer The type of the buffer, const for a constant iterator.
+         * @tparam Value The type of elements, const for a constant iterator.
+         */
+        template <typename Buffer, typename Value>
+        class BasicIterator {
+          public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using value_type = std::remove_const_t<Value>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = Value*;
+            using reference = Value&;
+
+            /**
+             * @brief Default constructor.
+             */
+            BasicIterator() = default;
+
+            /**
+             * @brief Constructs an iterator to an element of a buffer.
+             *
+             * @param buffer The buffer.
+             * @param index The index of the element, counted from the front of the buffer.
+             */
+            BasicIterator(Buffer* const buffer, const SizeType index) noexcept :
+              buffer_(buffer), index_(index)
+            {
+            }
+
+            /// Returns the element.
+            [[nodiscard]] reference operator*() const noexcept
+            {
+                return (*buffer_)[index_];
+            }
+
+            /// Returns a pointer to the element.
+            [[nodiscard]] pointer operator->() const noexcept
+            {
+                return &(*buffer_)[index_];
+            }
+
+            /// Moves to the next element.
+            BasicIterator& operator++() noexcept
+            {
+                ++index_;
+                return *this;
+            }
+
+            /// Moves to the next element, returns the previous position.
+            BasicIterator operator++(int) noexcept
+            {
+                auto it = *this;
+                ++index_;
+
+                return it;
+            }
+
+            /// Moves to the previous element.
+            BasicIterator& operator--() noexcept
+            {
+                --index_;
+                return *this;
+            }
+
+            /// Moves to the previous element, returns the previous position.
+            BasicIterator operator--(int) noexcept
+            {
+                auto it = *this;
+                --index_;
+
+                return it;
+            }
+
+            /// Checks whether both iterators point to the same element.
+            [[nodiscard]] bool operator==(const BasicIterator& other) const noexcept
+            {
+                return index_ == other.index_;
+            }
+
+            /// Checks whether the iterators point to different elements.
+            [[nodiscard]] bool operator!=(const BasicIterator& other) const noexcept
+            {
+                return index_ != other.index_;
+            }
+
+          private:
+            /// The buffer.
+            Buffer* buffer_{};
+
+            /// The index of the element, counted from the front of the buffer.
+            SizeType index_{};
+        };
+
+        /**
+         * @brief Type alias for the iterator of the buffer.
+         */
+        using Iterator = BasicIterator<CircularBuffer, ValueType>;
+
+        /**
+         * @brief Type alias for the constant iterator of the buffer.
+         */
+        using ConstIterator = BasicIterator<const CircularBuffer, const ValueType>;
+
+        /**
+         * @brief Type alias for the reverse iterator of the buffer.
+         */
+        using ReverseIterator = std::reverse_iterator<Iterator>;
+
+        /**
+         * @brief Type alias for the constant reverse iterator of the buffer.
+         */
+        using ConstReverseIterator = std::reverse_iterator<ConstIterator>;
+
+        /**
+         * @brief A contiguous run of elements of the buffer.
+         *
+         * @tparam Data The type of the pointer to the elements.
+         */
+        template <typename Data>
+        struct BasicSegment {
+            /// The first element of the segment.
+            Data data;
+
+            /// The number of elements in the segment.
+            SizeType size;
+        };
+
+        /**
+         * @brief Type alias for a segment of the buffer.
+         */
+        using Segment = BasicSegment<Pointer>;
+
+        /**
+         * @brief Type alias for a constant segment of the buffer.
+         */
+        using ConstSegment = BasicSegment<ConstPointer>;
+
+        /**
+         * @brief Indicates whether the indices are wrapped with a mask.
+         */
+        static constexpr bool IS_POWER_OF_TWO = (N > 0) && ((N & (N - 1)) == 0);
+
         /**
          * @brief Inserts an element at the front of the buffer.
          *
@@ -64,6 +228,9 @@ namespace Util {
         /**
          * @brief Constructs an element in place at the front of the buffer.
          *
+         * When an argument may refer to an element of the buffer, such as a reference or a pointer, the element
+         * is constructed first and then moved into its slot.
+         *
          * @tparam Args The types of arguments to forward to the constructor of the element.
          *
          * @param args The arguments to forward to the constructor of the element.
@@ -83,6 +250,9 @@ namespace Util {
         /**
          * @brief Constructs an element in place at the back of the buffer.
          *
+         * When an argument may refer to an element of the buffer, such as a reference or a pointer, the element
+         * is constructed first and then moved into its slot.
+         *
          * @tparam Args The types of arguments to forward to the constructor of the element.
          *
          * @param args The arguments to forward to the constructor of the element.
@@ -92,6 +262,44 @@ namespace Util {
         template <typename... Args>
         Reference emplace_back(Args&&... args) noexcept;
 
+        /**
+         * @brief Inserts elements at the back of the buffer, overwriting the elements at the front when it is full.
+         *
+         * If there are more elements than the buffer holds, only the last ones are inserted.
+         *
+         * @param items The elements to insert at the back of the buffer.
+         * @param count The number of elements to insert.
+         */
+        void push_back(ConstPointer items, SizeType count) noexcept;
+
+        /**
+         * @brief Copies elements from the front of the buffer.
+         *
+         * @param output The destination of the elements.
+         * @param count The maximum number of elements to copy.
+         *
+         * @return The number of elements copied.
+         */
+        SizeType copy_to(Pointer output, SizeType count) const noexcept;
+
+        /**
+         * @brief Returns the elements of the buffer as two contiguous segments, from the front to the back.
+         *
+         * The second segment is empty unless the elements wrap around the end of the storage.
+         *
+         * @return The segments of the buffer.
+         */
+        [[nodiscard]] std::array<Segment, 2> get_segments() noexcept;
+
+        /**
+         * @brief Returns the elements of the buffer as two contiguous constant segments, from the front to the back.
+         *
+         * The second segment is empty unless the elements wrap around the end of the storage.
+         *
+         * @return The constant segments of the buffer.
+         */
+        [[nodiscard]] std::array<ConstSegment, 2> get_segments() const noexcept;
+
         /**
          * @brief Removes an element from the front of the buffer.
          */
@@ -181,7 +389,113 @@ namespace Util {
          */
         [[nodiscard]] ConstReference operator[](SizeType index) const noexcept;
 
+        /**
+         * @brief Returns an iterator to the front of the buffer.
+         *
+         * @return An iterator to the front of the buffer.
+         */
+        [[nodiscard]] Iterator begin() noexcept;
+
+        /**
+         * @brief Returns a constant iterator to the front of the buffer.
+         *
+         * @return A constant iterator to the front of the buffer.
+         */
+        [[nodiscard]] ConstIterator begin() const noexcept;
+
+        /**
+         * @brief Returns a constant iterator to the front of the buffer.
+         *
+         * @return A constant iterator to the front of the buffer.
+         */
+        [[nodiscard]] ConstIterator cbegin() const noexcept;
+
+        /**
+         * @brief Returns an iterator past the back of the buffer.
+         *
+         * @return An iterator past the back of the buffer.
+         */
+        [[nodiscard]] Iterator end() noexcept;
+
+        /**
+         * @brief Returns a constant iterator past the back of the buffer.
+         *
+         * @return A constant iterator past the back of the buffer.
+         */
+        [[nodiscard]] ConstIterator end() const noexcept;
+
+        /**
+         * @brief Returns a constant iterator past the back of the buffer.
+         *
+         * @return A constant iterator past the back of the buffer.
+         */
+        [[nodiscard]] ConstIterator cend() const noexcept;
+
+        /**
+         * @brief Returns a reverse iterator to the back of the buffer.
+         *
+         * @return A reverse iterator to the back of the buffer.
+         */
+        [[nodiscard]] ReverseIterator rbegin() noexcept;
+
+        /**
+         * @brief Returns a constant reverse iterator to the back of the buffer.
+         *
+         * @return A constant reverse iterator to the back of the buffer.
+         */
+        [[nodiscard]] ConstReverseIterator rbegin() const noexcept;
+
+        /**
+         * @brief Returns a constant reverse iterator to the back of the buffer.
+         *
+         * @return A constant reverse iterator to the back of the buffer.
+         */
+        [[nodiscard]] ConstReverseIterator crbegin() const noexcept;
+
+        /**
+         * @brief Returns a reverse iterator past the front of the buffer.
+         *
+         * @return A reverse iterator past the front of the buffer.
+         */
+        [[nodiscard]] ReverseIterator rend() noexcept;
+
+        /**
+         * @brief Returns a constant reverse iterator past the front of the buffer.
+         *
+         * @return A constant reverse iterator past the front of the buffer.
+         */
+        [[nodiscard]] ConstReverseIterator rend() const noexcept;
+
+        /**
+         * @brief Returns a constant reverse iterator past the front of the buffer.
+         *
+         * @return A constant reverse iterator past the front of the buffer.
+         */
+        [[nodiscard]] ConstReverseIterator crend() const noexcept;
+
       private:
+        /// Returns the index of the slot after the given one.
+        [[nodiscard]] static constexpr SizeType next_index(SizeType index) noexcept;
+
+        /// Returns the index of the slot before the given one.
+        [[nodiscard]] static constexpr SizeType prev_index(SizeType index) noexcept;
+
+        /// Wraps an index less than twice the capacity into the storage.
+        [[nodiscard]] static constexpr SizeType wrap_index(SizeType index) noexcept;
+
+        /// Checks if an argument is passed by value and cannot refer to an element.
+        template <typename Arg>
+        static constexpr bool IS_SCALAR_ARGUMENT =
+          std::is_arithmetic_v<std::decay_t<Arg>> || std::is_enum_v<std::decay_t<Arg>> ||
+          std::is_null_pointer_v<std::decay_t<Arg>>;
+
+        /// Constructs an element in place of the one held by a slot.
+        template <typename... Args>
+        static void construct(ValueType& slot, Args&&... args) noexcept;
+
+        /// Returns the number of elements from the front of the buffer to the end of the storage.
+        [[nodiscard]] SizeType get_first_segment_size() const noexcept;
+
         /// The underlying fixed-size array storage.
         std::array<T, N> buffer_{};
 
@@ -198,11 +512,11 @@ namespace Util {
     template <typename T, std::size_t N>
     void CircularBuffer<T, N>::push_front(const ValueType& item) noexcept
     {
-        tail_ = ((tail_ + N) - 1) % N;
+        tail_ = prev_index(tail_);
         buffer_[tail_] = item;
 
         if (full_) {
-            head_ = ((head_ + N) - 1) % N;
+            head_ = prev_index(head_);
         }
 
         full_ = head_ == tail_;
@@ -212,11 +526,11 @@ namespace Util {
     template <typename... Args>
     auto CircularBuffer<T, N>::emplace_front(Args&&... args) noexcept -> Reference
     {
-        tail_ = ((tail_ + N) - 1) % N;
-        buffer_[tail_] = ValueType(std::forward<Args>(args)...);
+        tail_ = prev_index(tail_);
+        construct(buffer_[tail_], std::forward<Args>(args)...);
 
         if (full_) {
-            head_ = ((head_ + N) - 1) % N;
+            head_ = prev_index(head_);
         }
 
         full_ = head_ == tail_;
@@ -228,10 +542,10 @@ namespace Util {
     void CircularBuffer<T, N>::push_back(const ValueType& item) noexcept
     {
         buffer_[head_] = item;
-        head_ = (head_ + 1) % N;
+        head_ = next_index(head_);
 
         if (full_) {
-            tail_ = (tail_ + 1) % N;
+            tail_ = next_index(tail_);
         }
 
         full_ = head_ == tail_;
@@ -241,11 +555,11 @@ namespace Util {
     template <typename... Args>
     auto CircularBuffer<T, N>::emplace_back(Args&&... args) noexcept -> Reference
     {
-        buffer_[head_] = ValueType(std::forward<Args>(args)...);
-        head_ = (head_ + 1) % N;
+        construct(buffer_[head_], std::forward<Args>(args)...);
+        head_ = next_index(head_);
 
         if (full_) {
-            tail_ = (tail_ + 1) % N;
+            tail_ = next_index(tail_);
         }
 
         full_ = head_ == tail_;
@@ -253,12 +567,60 @@ namespace Util {
         return back();
     }
 
+    template <typename T, std::size_t N>
+    void CircularBuffer<T, N>::push_back(ConstPointer items, SizeType count) noexcept
+    {
+        if (count > N) {
+            items += count - N;
+            count = N;
+        }
+
+        const auto first_count = std::min(count, N - head_);
+        std::copy(items, items + first_count, buffer_.data() + head_);
+        std::copy(items + first_count, items + count, buffer_.data());
+
+        full_ = (size() + count) >= N;
+        head_ = wrap_index(head_ + count);
+
+        if (full_) {
+            tail_ = head_;
+        }
+    }
+
+    template <typename T, std::size_t N>
+    auto CircularBuffer<T, N>::copy_to(Pointer output, const SizeType count) const noexcept -> SizeType
+    {
+        auto copied = SizeType{0};
+
+        for (const auto& segment : get_segments()) {
+            const auto segment_count = std::min(segment.size, count - copied);
+            output = std::copy(segment.data, segment.data + segment_count, output);
+            copied += segment_count;
+        }
+
+        return copied;
+    }
+
+    template <typename T, std::size_t N>
+    auto CircularBuffer<T, N>::get_segments() noexcept -> std::array<Segment, 2>
+    {
+        const auto first_size = get_first_segment_size();
+        return {Segment{buffer_.data() + tail_, first_size}, Segment{buffer_.data(), size() - first_size}};
+    }
+
+    template <typename T, std::size_t N>
+    auto CircularBuffer<T, N>::get_segments() const noexcept -> std::array<ConstSegment, 2>
+    {
+        const auto first_size = get_first_segment_size();
+        return {ConstSegment{buffer_.data() + tail_, first_size}, ConstSegment{buffer_.data(), size() - first_size}};
+    }
+
     template <typename T, std::size_t N>
     void CircularBuffer<T, N>::pop_front() noexcept
     {
         if (!empty()) {
             full_ = false;
-            tail_ = (tail_ + 1) % N;
+            tail_ = next_index(tail_);
         }
     }
 
@@ -267,7 +629,7 @@ namespace Util {
     {
         if (!empty()) {
             full_ = false;
-            head_ = ((head_ + N) - 1) % N;
+            head_ = prev_index(head_);
         }
     }
 
@@ -286,13 +648,13 @@ namespace Util {
     template <typename T, std::size_t N>
     auto CircularBuffer<T, N>::back() noexcept -> Reference
     {
-        return buffer_[((head_ + N) - 1) % N];
+        return buffer_[prev_index(head_)];
     }
 
     template <typename T, std::size_t N>
     auto CircularBuffer<T, N>::back() const noexcept -> ConstReference
     {
-        return buffer_[((head_ + N) - 1) % N];
+        return buffer_[prev_index(head_)];
     }
 
     template <typename T, std::size_t N>
@@ -337,12 +699,144 @@ namespace Util {
     template <typename T, std::size_t N>
     auto CircularBuffer<T, N>::operator[](const SizeType index) noexcept -> Reference
     {
-        return buffer_[(tail_ + index) % N];
+        return buffer_[wrap_index(tail_ + index)];
     }
 
     template <typename T, std::size_t N>
     auto CircularBuffer<T, N>::operator[](const SizeType index) const noexcept -> ConstReference
     {
-        return buffer_[(tail_ + index) % N];
+        return buffer_[wrap_index(tail_ + index)];
+    }
+
+    template <typename T, std::size_t N>
+    auto CircularBuffer<T, N>::begin() noexcept -> Iterator
+    {
+        return Iterator{this, 0};
+    }
+
+    template <typename T, std::size_t N>
+    auto CircularBuffer<T, N>::begin() const noexcept -> ConstIterator
+    {
+        return ConstIterator{this, 0};
+    }
+
+    template <typename T, std::size_t N>
+    auto CircularBuffer<T, N>::cbegin() const noexcept -> ConstIterator
+    {
+        return ConstIterator{this, 0};
+    }
+
+    template <typename T, std::size_t N>
+    auto CircularBuffer<T, N>::end() noexcept -> Iterator
+    {
+        return Iterator{this, size()};
+    }
+
+    template <typename T, std::size_t N>
+    auto CircularBuffer<T, N>::end() const noexcept -> ConstIterator
+    {
+        return ConstIterator{this, size()};
+    }
+
+    template <typename T, std::size_t N>
+    auto CircularBuffer<T, N>::cend() const noexcept -> ConstIterator
+    {
+        return ConstIterator{this, size()};
+    }
+
+    template <typename T, std::size_t N>
+    auto CircularBuffer<T, N>::rbegin() noexcept -> ReverseIterator
+    {
+        return ReverseIterator{end()};
+    }
+
+    template <typename T, std::size_t N>
+    auto CircularBuffer<T, N>::rbegin() const noexcept -> ConstReverseIterator
+    {
+        return ConstReverseIterator{end()};
+    }
+
+    template <typename T, std::size_t N>
+    auto CircularBuffer<T, N>::crbegin() const noexcept -> ConstReverseIterator
+    {
+        return ConstReverseIterator{cend()};
+    }
+
+    template <typename T, std::size_t N>
+    auto CircularBuffer<T, N>::rend() noexcept -> ReverseIterator
+    {
+        return ReverseIterator{begin()};
+    }
+
+    template <typename T, std::size_t N>
+    auto CircularBuffer<T, N>::rend() const noexcept -> ConstReverseIterator
+    {
+        return ConstReverseIterator{begin()};
+    }
+
+    template <typename T, std::size_t N>
+    auto CircularBuffer<T, N>::crend() const noexcept -> ConstReverseIterator
+    {
+        return ConstReverseIterator{cbegin()};
+    }
+
+    template <typename T, std::size_t N>
+    constexpr auto CircularBuffer<T, N>::next_index(const SizeType index) noexcept -> SizeType
+    {
+        if constexpr (IS_POWER_OF_TWO) {
+            return (index + 1) & (N - 1);
+        }
+        else {
+            return ((index + 1) == N) ? 0 : (index + 1);
+        }
+    }
+
+    template <typename T, std::size_t N>
+    constexpr auto CircularBuffer<T, N>::prev_index(const SizeType index) noexcept -> SizeType
+    {
+        if constexpr (IS_POWER_OF_TWO) {
+            return (index - 1) & (N - 1);
+        }
+        else {
+            return (index == 0) ? (N - 1) : (index - 1);
+        }
+    }
+
+    template <typename T, std::size_t N>
+    constexpr auto CircularBuffer<T, N>::wrap_index(const SizeType index) noexcept -> SizeType
+    {
+        if constexpr (IS_POWER_OF_TWO) {
+            return index & (N - 1);
+        }
+        else {
+            return (index >= N) ? (index - N) : index;
+        }
+    }
+
+    template <typename T, std::size_t N>
+    template <typename... Args>
+    void CircularBuffer<T, N>::construct(ValueType& slot, Args&&... args) noexcept
+    {
+        if constexpr (std::is_same_v<std::tuple<std::decay_t<Args>...>, std::tuple<ValueType>>) {
+            // Assigning an element reuses the resources of the one it replaces, such as the capacity of a string
+            slot = (std::forward<Args>(args), ...);
+        }
+        else if constexpr (std::is_trivially_copyable_v<ValueType>) {
+            slot = ValueType(std::forward<Args>(args)...);
+        }
+        else if constexpr ((IS_SCALAR_ARGUMENT<Args> && ...)) {
+            std::destroy_at(&slot);
+            ::new (static_cast<void*>(&slot)) ValueType(std::forward<Args>(args)...);
+        }
+        else {
+            // A reference or a pointer may refer to the slot itself, the element is complete before it is replaced
+            slot = ValueType(std::forward<Args>(args)...);
+        }
+    }
+
+    template <typename T, std::size_t N>
+    auto CircularBuffer<T, N>::get_first_segment_size() const noexcept -> SizeType
+    {
+        return std::min(size(), N - tail_);
     }
 }
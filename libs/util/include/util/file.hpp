@@ -94,6 +94,15 @@ namespace Util {
      */
     std::error_code file_remove(std::string_view path) noexcept;
 
+    /**
+     * @brief Gets the modification time of a file.
+     *
+     * @param path The path to the file.
+     *
+     * @return The modification time of the file as a Unix timestamp, or 0 if it cannot be determined.
+     */
+    [[nodiscard]] long file_mtime(const std::string& path) noexcept;
+
     /**
      * @brief Reads the content of a file into a string and logs any errors.
      *
@@ -0,0 +1,167 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace Util {
+    /**
+     * @brief Splits a stream of bytes that arrives in arbitrary chunks into lines.
+     *
+     * Line breaks are located 16 bytes at a time, the lines that are complete within a chunk are passed on
+     * without copying, only the unterminated tail of a chunk is buffered until the next one. A trailing
+     * carriage return is removed and empty lines are skipped. Lines longer than the limit are dropped whole,
+     * a truncated line could run a different command than the one that was sent.
+     */
+    class LineSplitter final {
+      public:
+        /**
+         * @brief The default maximum size of a line in bytes, the size of the engine command buffer.
+         */
+        static constexpr std::size_t DEFAULT_MAX_LINE_SIZE = 8192;
+
+        /**
+         * @brief Constructs a new LineSplitter object.
+         *
+         * @param max_line_size The maximum size of a line in bytes, longer lines are dropped.
+         */
+        explicit LineSplitter(std::size_t max_line_size = DEFAULT_MAX_LINE_SIZE);
+
+        /**
+         * @brief Splits the next chunk of the stream.
+         *
+         * @tparam Callback A callable taking a \c std::string_view, invoked for each complete line.
+         * @param data The next chunk of the stream.
+         * @param on_line The callback for the lines, the view is valid only during the call.
+         */
+        template <typename Callback>
+        void feed(std::string_view data, Callback&& on_line);
+
+        /**
+         * @brief Passes on the unterminated line at the end of the stream, if any.
+         *
+         * @tparam Callback A callable taking a \c std::string_view
+         * @param on_line The callback for the line, the view is valid only during the call.
+         */
+        template <typename Callback>
+        void finish(Callback&& on_line);
+
+        /**
+         * @brief Gets the number of lines dropped because they exceeded the maximum size.
+         *
+         * @return The number of dropped lines.
+         */
+        [[nodiscard]] std::uint64_t get_dropped() const noexcept;
+
+        /**
+         * @brief Finds the first line break in a range of bytes.
+         *
+         * @param first The beginning of the range.
+         * @param last The end of the range.
+         *
+         * @return A pointer to the first line break, or \p last if there is none.
+         */
+        [[nodiscard]] static const char* find_newline(const char* first, const char* last) noexcept;
+
+      private:
+        /// The maximum size of a line in bytes.
+        std::size_t max_line_size_;
+
+        /// The beginning of the current line, kept from the previous chunks.
+        std::string partial_{};
+
+        /// Indicates whether the current line has exceeded the maximum size and is being skipped.
+        bool overflow_{};
+
+        /// The number of lines dropped because they exceeded the maximum size.
+        std::uint64_t dropped_{};
+
+        /// Appends a part of the current line to the buffer, returns false if the line is too long.
+        bool append_partial(std::string_view part);
+
+        /// Passes on a complete line unless it is empty or too long.
+        template <typename Callback>
+        void emit(std::string_view line, Callback& on_line);
+    };
+
+    template <typename Callback>
+    void LineSplitter::feed(const std::string_view data, Callback&& on_line)
+    {
+        const auto* position = data.data();
+        const auto* const end = position + data.size();
+
+        while (position != end) {
+            const auto* const newline = find_newline(position, end);
+            const std::string_view part{position, static_cast<std::size_t>(newline - position)};
+
+            if (newline == end) {
+                append_partial(part);
+                break;
+            }
+
+            if (partial_.empty() && !overflow_) {
+                emit(part, on_line);
+            }
+            else if (append_partial(part)) {
+                emit(partial_, on_line);
+            }
+
+            partial_.clear();
+            overflow_ = false;
+            position = newline + 1;
+        }
+    }
+
+    template <typename Callback>
+    void LineSplitter::finish(Callback&& on_line)
+    {
+        if (!partial_.empty() && !overflow_) {
+            emit(partial_, on_line);
+        }
+
+        partial_.clear();
+        overflow_ = false;
+    }
+
+    inline std::uint64_t LineSplitter::get_dropped() const noexcept
+    {
+        return dropped_;
+    }
+
+    template <typename Callback>
+    void LineSplitter::emit(std::string_view line, Callback& on_line)
+    {
+        if (!line.empty() && '\r' == line.back()) {
+            line.remove_suffix(1);
+        }
+
+        if (line.size() > max_line_size_) {
+            ++dropped_;
+        }
+        else if (!line.empty()) {
+            on_line(line);
+        }
+    }
+}
@@ -29,4 +29,11 @@ namespace Util {
      * @return The current width of the console, or 0 if the width could not be determined.
      */
     std::size_t get_console_width();
+
+    /**
+     * @brief Retrieves the current height of the console.
+     *
+     * @return The current number of rows of the console, or 0 if the standard output and input are not a terminal.
+     */
+    std::size_t get_console_height();
 }
@@ -0,0 +1,47 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+
+#pragma once
+
+#include <string>
+
+namespace Util {
+    /**
+     * @brief Serves the ring of recent log messages on a local Unix socket.
+     *
+     * Every client that connects receives the messages kept in the ring followed by the new messages
+     * as they are logged, until it disconnects. The clients are served by the launcher reactor, which the
+     * ring wakes up when a message is logged, so the logger never waits for the clients. A client that does
+     * not keep up skips the overwritten messages and is told how many were lost.
+     *
+     * @param socket_path The path to the socket, an existing socket at this path is replaced.
+     *
+     * @return \c true if the socket is listening, \c false if it could not be created or the ring is disabled.
+     */
+    bool start_log_tail(const std::string& socket_path);
+
+    /**
+     * @brief Disconnects the clients and removes the socket.
+     *
+     * Does nothing if the socket is not listening.
+     */
+    void stop_log_tail();
+}
@@ -0,0 +1,98 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace Util {
+    /**
+     * @brief The counters of the output capture.
+     */
+    struct OutputCaptureStats {
+        /**
+         * @brief The number of bytes written to the standard output or error by other code.
+         */
+        std::uint64_t captured_bytes{};
+
+        /**
+         * @brief The number of bytes dropped because the terminal did not keep up.
+         *
+         * Only the output queued for the terminal is dropped, writing to the standard output waits
+         * when the pipe is full instead.
+         */
+        std::uint64_t dropped_bytes{};
+    };
+
+    /**
+     * @brief The default number of bytes the output capture buffers for the terminal.
+     */
+    inline constexpr std::size_t DEFAULT_OUTPUT_CAPTURE_BUFFER_SIZE = 4 * 1024 * 1024;
+
+    /**
+     * @brief Redirects the standard output and error of the process to a pipe owned by the launcher.
+     *
+     * A drain thread reads the pipe and reassembles the output into lines, and a writer thread
+     * forwards them to the original terminal and appends them to the log file. Writing to the
+     * standard output never waits for the terminal afterwards: when the terminal does not keep up
+     * and more than \p max_buffered_bytes are pending, the new output is dropped and counted.
+     * The output still in the pipe is written when the process receives a fatal signal, e.g. on abort.
+     *
+     * @param logfile The file to append the captured output to, or an empty string to not write a file.
+     * @param max_buffered_bytes The maximum number of bytes waiting to be written to the terminal.
+     *
+     * @return \c true if the output is captured, \c false otherwise.
+     */
+    bool start_output_capture(const std::string& logfile,
+                              std::size_t max_buffered_bytes = DEFAULT_OUTPUT_CAPTURE_BUFFER_SIZE);
+
+    /**
+     * @brief Writes the pending output and restores the standard output and error.
+     *
+     * Does nothing if the output is not captured.
+     */
+    void stop_output_capture();
+
+    /**
+     * @brief Queues text of the launcher itself for the terminal, bypassing the pipe and the log file.
+     *
+     * @param text The text to write.
+     *
+     * @return \c true if the text was queued, \c false if the output is not captured.
+     */
+    bool write_captured_output(std::string_view text);
+
+    /**
+     * @brief Writes the pending output to the terminal and the log file on the calling thread.
+     *
+     * Called after critical messages, which usually precede an abort. Does nothing if the output is not captured.
+     */
+    void flush_captured_output();
+
+    /**
+     * @brief Gets the counters of the output capture.
+     *
+     * @return The counters, all zero if the output was never captured.
+     */
+    [[nodiscard]] OutputCaptureStats output_capture_stats() noexcept;
+}
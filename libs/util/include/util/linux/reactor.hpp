@@ -0,0 +1,232 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace Util {
+    /**
+     * @brief An event loop that hosts the helper activity of the launcher on a single thread.
+     *
+     * Descriptors, timers, signals and posted callbacks are dispatched by one thread waiting in \c epoll_wait,
+     * which wakes up only when there is something to do. Timers are \c timerfd descriptors, signals are
+     * received through a \c signalfd and callbacks are posted through an \c eventfd. The handlers run on the
+     * reactor thread one at a time and must not block.
+     */
+    class Reactor final {
+      public:
+        /**
+         * @brief Type alias for the handler of a descriptor, receives the \c epoll events that occurred.
+         */
+        using Handler = std::function<void(std::uint32_t events)>;
+
+        /**
+         * @brief Type alias for the handler of a timer, a signal or a posted callback.
+         */
+        using Callback = std::function<void()>;
+
+        /**
+         * @brief Constructs a new Reactor object, the thread is started by \c start
+         */
+        Reactor() = default;
+
+        /// Move constructor.
+        Reactor(Reactor&&) = delete;
+
+        /// Copy constructor.
+        Reactor(const Reactor&) = delete;
+
+        /// Move assignment operator.
+        Reactor& operator=(Reactor&&) = delete;
+
+        /// Copy assignment operator.
+        Reactor& operator=(const Reactor&) = delete;
+
+        /**
+         * @brief Destructor, stops the thread.
+         */
+        ~Reactor();
+
+        /**
+         * @brief Starts the reactor thread.
+         *
+         * @param cpu The CPU to pin the thread to, or a negative number to let it run on any CPU.
+         *
+         * @return \c true if the reactor is running, \c false if it could not be started.
+         */
+        bool start(int cpu = -1);
+
+        /**
+         * @brief Stops the reactor thread and removes all descriptors, timers and signals.
+         */
+        void stop();
+
+        /**
+         * @brief Checks whether the calling thread is the reactor thread.
+         *
+         * @return \c true if called from a handler, \c false otherwise.
+         */
+        [[nodiscard]] bool is_reactor_thread() const noexcept;
+
+        /**
+         * @brief Watches a descriptor.
+         *
+         * @param fd The descriptor, owned by the caller.
+         * @param events The \c epoll events to wait for.
+         * @param handler The handler called with the events that occurred.
+         *
+         * @return \c true if the descriptor is watched, \c false otherwise (regular files cannot be watched).
+         */
+        bool add(int fd, std::uint32_t events, Handler handler);
+
+        /**
+         * @brief Changes the events a watched descriptor waits for.
+         *
+         * @param fd The descriptor.
+         * @param events The \c epoll events to wait for.
+         *
+         * @return \c true if the events were changed, \c false otherwise.
+         */
+        bool modify(int fd, std::uint32_t events);
+
+        /**
+         * @brief Stops watching a descriptor.
+         *
+         * When called from another thread, waits until the running handler and the callbacks posted before
+         * have returned, so the handler is not called after this returns.
+         *
+         * @param fd The descriptor.
+         */
+        void remove(int fd);
+
+        /**
+         * @brief Adds a periodic timer.
+         *
+         * @param interval The interval of the timer.
+         * @param callback The callback called on every expiration.
+         *
+         * @return The ID of the timer, or -1 if it could not be created.
+         */
+        int add_timer(std::chrono::milliseconds interval, Callback callback);
+
+        /**
+         * @brief Removes a timer, with the same guarantee as \c remove
+         *
+         * @param timer The ID of the timer.
+         */
+        void remove_timer(int timer);
+
+        /**
+         * @brief Handles a signal on the reactor thread.
+         *
+         * The signal is blocked in the calling thread and must be blocked in all the other threads as well,
+         * which holds for the reactor thread and for the threads created afterwards by the calling thread.
+         *
+         * @param signal The signal number.
+         * @param callback The callback called when the signal is received.
+         *
+         * @return \c true if the signal is handled, \c false otherwise.
+         */
+        bool add_signal(int signal, Callback callback);
+
+        /**
+         * @brief Runs a callback on the reactor thread.
+         *
+         * @param callback The callback to run.
+         */
+        void post(Callback callback);
+
+        /**
+         * @brief Runs a callback on the reactor thread and waits for it to return.
+         *
+         * The callback runs in the calling thread when called from a handler or when the reactor is not running.
+         *
+         * @param callback The callback to run.
+         */
+        void run_and_wait(const Callback& callback);
+
+      private:
+        /// Waits for the events and dispatches them until stopped (runs in a separate thread).
+        void run();
+
+        /// Runs the posted callbacks.
+        void run_posted();
+
+        /// Receives the pending signals and calls their callbacks.
+        void dispatch_signals();
+
+
+        /// Guards starting and stopping.
+        std::mutex start_mutex_{};
+
+        /// Guards the handlers, the timers, the signals and the posted callbacks.
+        std::mutex mutex_{};
+
+        /// The handlers of the watched descriptors, shared with a running dispatch.
+        std::unordered_map<int, std::shared_ptr<Handler>> handlers_{};
+
+        /// The descriptors of the timers, owned by the reactor.
+        std::unordered_set<int> timers_{};
+
+        /// The callbacks of the handled signals.
+        std::unordered_map<int, Callback> signals_{};
+
+        /// The callbacks posted from other threads.
+        std::vector<Callback> posted_{};
+
+        /// The \c epoll descriptor.
+        int epoll_fd_{-1};
+
+        /// The \c eventfd that wakes the thread up for posted callbacks.
+        int event_fd_{-1};
+
+        /// The \c signalfd of the handled signals.
+        int signal_fd_{-1};
+
+        /// Whether the thread should exit.
+        std::atomic<bool> stopping_{};
+
+        /// The reactor thread.
+        std::thread thread_{};
+
+        /// The ID of the reactor thread.
+        std::atomic<std::thread::id> thread_id_{};
+    };
+
+    /**
+     * @brief Gets the reactor shared by the launcher helpers.
+     *
+     * Created on first use and never destroyed, it has to be started before use.
+     *
+     * @return The reactor.
+     */
+    [[nodiscard]] Reactor& get_reactor();
+}
@@ -0,0 +1,46 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#pragma once
+
+#include <string>
+
+namespace Util {
+    /**
+     * @brief Lowers the I/O priority of the calling thread to the idle class.
+     *
+     * Intended for background threads whose disk access must not compete with the server.
+     *
+     * @return \c true if the priority was changed, \c false otherwise.
+     */
+    bool set_thread_background_io_priority() noexcept;
+
+    /**
+     * @brief Asks the operating system to read the content of a file into the page cache.
+     *
+     * The call does not keep the file open, later reads of the file are served from memory
+     * as long as the cached pages were not evicted.
+     *
+     * @param path The path to the file to prefetch.
+     *
+     * @return \c true if the prefetch request was issued, \c false otherwise.
+     */
+    bool file_prefetch(const std::string& path) noexcept;
+}
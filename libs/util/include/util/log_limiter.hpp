@@ -0,0 +1,166 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+
+#pragma once
+
+#include "util/logger.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Util {
+    /**
+     * @brief Rate limits and collapses repetitive log messages.
+     *
+     * The messages are grouped by their format string. Each group has a token bucket that allows a burst of
+     * messages and then a steady rate, the rest are counted. A message identical to the previous one is counted
+     * as a repeat without taking a token. The counts are passed to the report callback when a different message
+     * is logged and when the report interval elapses. The class is thread-safe, the callback is called without
+     * the lock held.
+     */
+    class LogLimiter final {
+      public:
+        /**
+         * @brief The callback that writes a report about the suppressed messages.
+         */
+        using Report = std::function<void(LogLevel level, std::string_view message)>;
+
+        /**
+         * @brief The clock used for the token buckets and the report interval.
+         */
+        using Clock = std::chrono::steady_clock;
+
+        /**
+         * @brief Constructs a new LogLimiter object.
+         *
+         * @param settings The settings for the rate limiting.
+         * @param report The callback that writes the reports.
+         * @param now The current time, the start of the first report interval.
+         */
+        LogLimiter(const LogRateLimitSettings& settings, Report report, Clock::time_point now = Clock::now());
+
+        /**
+         * @brief Passes a message through the limiter.
+         *
+         * @param level The level of the message.
+         * @param format The format string for the message.
+         * @param args The encoded arguments of the message.
+         * @param now The current time.
+         *
+         * @return \c true if the message should be written, \c false if it is suppressed.
+         */
+        [[nodiscard]] bool allow(LogLevel level, std::string_view format, std::string_view args,
+                                 Clock::time_point now = Clock::now());
+
+        /**
+         * @brief Reports the suppressed messages if the report interval has elapsed, or unconditionally.
+         *
+         * @param force Whether to report regardless of the interval.
+         * @param now The current time.
+         */
+        void report(bool force = false, Clock::time_point now = Clock::now());
+
+        /**
+         * @brief Gets the total number of suppressed messages.
+         *
+         * @return The number of suppressed messages.
+         */
+        [[nodiscard]] std::uint64_t get_suppressed() const noexcept
+        {
+            return suppressed_.load(std::memory_order_relaxed);
+        }
+
+      private:
+        /// The state of a group of messages with the same format string.
+        struct Group {
+            /// The format string of the group.
+            std::string format{};
+
+            /// The level of the last message in the group.
+            LogLevel level{};
+
+            /// The number of messages that can be written right away.
+            double tokens{};
+
+            /// The time at which the tokens were last refilled.
+            Clock::time_point refill_time{};
+
+            /// The number of messages suppressed since the last report.
+            std::uint64_t suppressed{};
+        };
+
+        /// The report messages collected under the lock, with their levels.
+        using Reports = std::vector<std::pair<LogLevel, std::string>>;
+
+        /// Collects the reports for the suppressed messages into the buffer.
+        void collect_reports(Reports& reports);
+
+        /// Collects the report for the repeats of the last message into the buffer.
+        void collect_repeats(Reports& reports);
+
+        /// Passes the collected reports to the callback.
+        void write_reports(const Reports& reports) const;
+
+        /// Checks if a message is the same as the last one.
+        [[nodiscard]] bool is_repeat(LogLevel level, std::string_view format, std::string_view args) const noexcept;
+
+        /// Gets the group of a format string, or \c nullptr if there are too many groups.
+        [[nodiscard]] Group* get_group(std::string_view format, Clock::time_point now);
+
+        /// The settings for the rate limiting.
+        const LogRateLimitSettings settings_;
+
+        /// The callback that writes the reports.
+        const Report report_;
+
+        /// Guards the state.
+        std::mutex mutex_{};
+
+        /// The groups of messages, by the hash of the format string.
+        std::unordered_map<std::size_t, Group> groups_{};
+
+        /// The format string and the encoded arguments of the last message.
+        std::string last_message_{};
+
+        /// The level of the last message.
+        LogLevel last_level_{LogLevel::off};
+
+        /// The number of times the last message was repeated since it was written or reported.
+        std::uint64_t repeats_{};
+
+        /// The time at which the suppressed messages were last reported.
+        Clock::time_point report_time_{};
+
+        /// Whether there are suppressed messages that have not been reported yet.
+        std::atomic_bool has_pending_{};
+
+        /// The total number of suppressed messages.
+        std::atomic_uint64_t suppressed_{};
+    };
+}
@@ -92,5 +92,14 @@ namespace Util {
          * @param message The formatted log message to be written.
          */
         virtual void write_log(std::string_view message) = 0;
+
+        /**
+         * @brief Writes the messages buffered by the output destination before returning.
+         *
+         * Called after critical messages, which usually precede an abort. Does nothing by default.
+         */
+        virtual void flush()
+        {
+        }
     };
 }
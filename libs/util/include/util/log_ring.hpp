@@ -0,0 +1,200 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace Util {
+    /**
+     * @brief A fixed-capacity ring of the most recent log messages.
+     *
+     * Writers are serialized among themselves, readers take no locks: each slot is guarded by a sequence
+     * number that is odd while the slot is being written, so a reader copies the message and checks that
+     * the sequence did not change in the meantime. Readers that fall more than the capacity behind the
+     * writers skip the overwritten messages and count them. Messages longer than a slot are truncated.
+     */
+    class LogRing final {
+      public:
+        /**
+         * @brief The maximum size of a message in bytes.
+         */
+        static constexpr std::size_t MAX_MESSAGE_SIZE = 500;
+
+        /**
+         * @brief Reads the messages of a ring in order, with its own cursor.
+         *
+         * A reader must not be used by multiple threads at once, each thread creates its own.
+         */
+        class Reader final {
+          public:
+            /**
+             * @brief Constructs a new Reader object.
+             *
+             * @param ring The ring to read, must outlive the reader.
+             * @param from_oldest Whether to start from the oldest message in the ring or from the next new one.
+             */
+            explicit Reader(const LogRing& ring, bool from_oldest = true) noexcept;
+
+            /**
+             * @brief Reads the next message.
+             *
+             * @param message The string to copy the message to.
+             *
+             * @return \c true if a message was read, \c false if there are no new messages.
+             */
+            bool read(std::string& message);
+
+            /**
+             * @brief Gets the number of messages overwritten before they were read and resets the counter.
+             *
+             * @return The number of lost messages since the last call.
+             */
+            [[nodiscard]] std::uint64_t take_lost() noexcept;
+
+          private:
+            /// The ring to read.
+            const LogRing* ring_;
+
+            /// The index of the next message to read.
+            std::uint64_t cursor_;
+
+            /// The number of messages lost since the last call to \c take_lost.
+            std::uint64_t lost_{};
+        };
+
+        /**
+         * @brief Constructs a new LogRing object.
+         *
+         * @param capacity The minimum number of messages the ring holds, rounded up to a power of two.
+         */
+        explicit LogRing(std::size_t capacity);
+
+        /// Move constructor.
+        LogRing(LogRing&&) = delete;
+
+        /// Copy constructor.
+        LogRing(const LogRing&) = delete;
+
+        /// Move assignment operator.
+        LogRing& operator=(LogRing&&) = delete;
+
+        /// Copy assignment operator.
+        LogRing& operator=(const LogRing&) = delete;
+
+        /**
+         * @brief Default destructor.
+         */
+        ~LogRing() = default;
+
+        /**
+         * @brief Appends a message, overwriting the oldest one if the ring is full.
+         *
+         * @param message The message to append.
+         */
+        void write(std::string_view message);
+
+        /**
+         * @brief Sets the callback a writer calls after the next message once the wakeup is armed.
+         *
+         * @param wakeup The callback, called by the writer thread with the writers serialized, or an empty
+         * function to remove it.
+         */
+        void set_wakeup(std::function<void()> wakeup);
+
+        /**
+         * @brief Arms the wakeup, the next message written calls it once.
+         *
+         * A reader arms the wakeup once it has read all messages and reads again afterwards, so a message
+         * written in between is not missed.
+         */
+        void arm_wakeup() noexcept
+        {
+            wakeup_armed_.store(true, std::memory_order_seq_cst);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+
+        /**
+         * @brief Gets the number of messages the ring holds.
+         *
+         * @return The capacity of the ring.
+         */
+        [[nodiscard]] std::size_t get_capacity() const noexcept
+        {
+            return mask_ + 1;
+        }
+
+        /**
+         * @brief Gets the total number of messages written.
+         *
+         * @return The index of the next message.
+         */
+        [[nodiscard]] std::uint64_t get_head() const noexcept
+        {
+            return head_.load(std::memory_order_acquire);
+        }
+
+      private:
+        /// The type of the words a message is kept in.
+        using Word = std::uintptr_t;
+
+        /// The number of words a message takes at most.
+        static constexpr std::size_t WORD_COUNT = (MAX_MESSAGE_SIZE + sizeof(Word) - 1) / sizeof(Word);
+
+        /// A message and its sequence number.
+        struct Slot {
+            /// Twice the index of the message plus one while it is written, plus two once it is complete.
+            std::atomic<std::uint64_t> sequence{};
+
+            /// The size of the message.
+            std::atomic<std::size_t> size{};
+
+            /// The message, kept in atomic words so that a reader racing with a writer is well defined.
+            std::array<std::atomic<Word>, WORD_COUNT> words{};
+        };
+
+        /// The mask to get a slot from a message index.
+        const std::size_t mask_;
+
+        /// The slots.
+        const std::unique_ptr<Slot[]> slots_;
+
+        /// The index of the next message.
+        std::atomic<std::uint64_t> head_{};
+
+        /// Serializes the writers.
+        std::mutex mutex_{};
+
+        /// Whether the next message calls the wakeup.
+        std::atomic<bool> wakeup_armed_{};
+
+        /// Called after a message is written when armed, guarded by the writer mutex.
+        std::function<void()> wakeup_{};
+    };
+}
@@ -20,9 +20,14 @@
 
 #pragma once
 
+#include "util/binary_log.hpp"
 #include "util/log_output.hpp"
+#include "util/log_ring.hpp"
 #include <spdlog/common.h>
 #include <spdlog/spdlog.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -85,6 +90,139 @@ namespace Util {
         view_and_file = view | file
     };
 
+    /**
+     * @brief What the asynchronous logger does with a message when its queue is full.
+     */
+    enum class LogOverflowPolicy {
+        /** @brief Wait until the writer thread makes room for the message. */
+        block,
+
+        /** @brief Discard the new message. */
+        drop,
+
+        /** @brief Discard the oldest queued message to make room for the new one. */
+        drop_oldest
+    };
+
+    /**
+     * @brief Contains the settings for asynchronous logging.
+     *
+     * When enabled, messages are queued in a lock-free ring buffer and written in batches by a dedicated thread.
+     */
+    struct LogAsyncSettings {
+        /**
+         * @brief Whether asynchronous logging is enabled.
+         */
+        bool enabled{};
+
+        /**
+         * @brief The number of messages the queue can hold, rounded up to a power of two.
+         */
+        std::size_t queue_size{8192};
+
+        /**
+         * @brief What to do with a message when the queue is full.
+         */
+        LogOverflowPolicy overflow_policy{LogOverflowPolicy::block};
+
+        /**
+         * @brief The interval at which the log file is flushed.
+         *
+         * Critical messages are always written and flushed before the logging call returns.
+         */
+        std::chrono::milliseconds flush_interval{1000};
+    };
+
+    /**
+     * @brief The counters of the asynchronous logger.
+     */
+    struct LogAsyncStats {
+        /**
+         * @brief The number of messages written.
+         */
+        std::uint64_t written{};
+
+        /**
+         * @brief The number of messages dropped because the queue was full.
+         */
+        std::uint64_t dropped{};
+    };
+
+    /**
+     * @brief Contains the settings for the rotation of the log file.
+     *
+     * The rotated segments are renamed with a timestamp and compressed on a background thread.
+     */
+    struct LogRotationSettings {
+        /**
+         * @brief The size in bytes at which the log file is rotated, 0 to not rotate by size.
+         */
+        std::uint64_t max_size{};
+
+        /**
+         * @brief The age at which the log file is rotated, 0 to not rotate by time.
+         */
+        std::chrono::minutes interval{};
+
+        /**
+         * @brief The number of rotated segments to keep, 0 to keep all of them.
+         */
+        std::size_t max_files{10};
+
+        /**
+         * @brief Whether the rotated segments are compressed with gzip.
+         */
+        bool compress{true};
+
+        /**
+         * @brief Checks if the rotation is enabled.
+         *
+         * @return \c true if the log file is rotated by size or by time, \c false otherwise.
+         */
+        [[nodiscard]] bool is_enabled() const noexcept
+        {
+            return max_size > 0 || interval.count() > 0;
+        }
+    };
+
+    /**
+     * @brief Contains the settings for the rate limiting of repetitive messages.
+     *
+     * Each format string gets a token bucket, and a message identical to the previous one is counted instead of
+     * written. The suppressed messages are reported periodically. Critical messages are never suppressed.
+     */
+    struct LogRateLimitSettings {
+        /**
+         * @brief Whether the rate limiting is enabled.
+         *
+         * Disabled by default. The engine output is logged as info messages with the text as the format string,
+         * so it is never limited.
+         */
+        bool enabled{};
+
+        /**
+         * @brief The lowest level of the messages that are limited.
+         *
+         * Info messages are the output of the console commands and are not limited by default.
+         */
+        LogLevel min_level{LogLevel::warn};
+
+        /**
+         * @brief The number of messages per second written for a format string after the burst is used up.
+         */
+        double rate{10.0};
+
+        /**
+         * @brief The number of messages written for a format string before the rate applies.
+         */
+        std::size_t burst{100};
+
+        /**
+         * @brief The interval at which the suppressed messages are reported.
+         */
+        std::chrono::seconds report_interval{10};
+    };
+
     /**
      * @brief Contains the settings for the logger.
      *
@@ -124,6 +262,33 @@ namespace Util {
          * @brief A shared pointer to the object to be used for displaying log messages when view output is enabled.
          */
         std::shared_ptr<LogOutput> log_output{};
+
+        /**
+         * @brief The settings for asynchronous logging.
+         */
+        LogAsyncSettings async{};
+
+        /**
+         * @brief The settings for the rotation of the log file.
+         */
+        LogRotationSettings rotation{};
+
+        /**
+         * @brief The file to write the messages to in the binary format, or an empty string to not write it.
+         *
+         * When set, the file output goes to this file instead of \c logfile.
+         */
+        std::string binary_logfile{};
+
+        /**
+         * @brief The settings for the rate limiting of repetitive messages.
+         */
+        LogRateLimitSettings rate_limit{};
+
+        /**
+         * @brief The number of recent messages kept in memory for live tailing, 0 to not keep them.
+         */
+        std::size_t ring_size{};
     };
 
     /**
@@ -142,6 +307,33 @@ namespace Util {
      */
     void log_init(bool con_debug, std::string logfile, std::shared_ptr<LogOutput> log_output);
 
+    /**
+     * @brief Reports the messages suppressed by the rate limiter, writes the queued messages and stops
+     * the writer thread of the asynchronous logger, and flushes the binary log.
+     */
+    void log_shutdown();
+
+    /**
+     * @brief Gets the counters of the asynchronous logger.
+     *
+     * @return The counters, all zero if asynchronous logging is disabled.
+     */
+    [[nodiscard]] LogAsyncStats log_async_stats() noexcept;
+
+    /**
+     * @brief Gets the ring of recent messages.
+     *
+     * @return The ring, or \c nullptr if it is disabled.
+     */
+    [[nodiscard]] std::shared_ptr<LogRing> log_ring() noexcept;
+
+    /**
+     * @brief Reports the suppressed messages if the report interval has elapsed.
+     *
+     * Cheap enough to be called every frame, so the counts are reported even if no new messages are logged.
+     */
+    void log_report_suppressed();
+
     /**
      * @brief Returns a constant reference to the \c Util::LogSettings object
      * that contains the settings for the logger.
@@ -150,6 +342,91 @@ namespace Util {
      */
     [[nodiscard]] const LogSettings& log_settings();
 
+    namespace detail {
+        /**
+         * @brief Checks if messages of the given level are rate limited.
+         *
+         * @param level The level of the message.
+         *
+         * @return \c true if the messages are passed through the rate limiter, \c false otherwise.
+         */
+        [[nodiscard]] bool is_log_limited(LogLevel level) noexcept;
+
+        /**
+         * @brief Passes a message through the rate limiter.
+         *
+         * @param level The level of the message.
+         * @param format The format string for the message.
+         * @param args The encoded arguments of the message.
+         *
+         * @return \c true if the message should be written, \c false if it is suppressed.
+         */
+        [[nodiscard]] bool is_log_allowed(LogLevel level, std::string_view format, std::string_view args);
+
+        /**
+         * @brief Checks if a message should be written.
+         *
+         * The arguments are compared in their binary log encoding, so no text is formatted to detect a repeat.
+         *
+         * @tparam Args The types of the arguments to be used for formatting the message string.
+         *
+         * @param level The level of the message.
+         * @param str The format string for the message.
+         * @param args The arguments to be used for formatting the message string.
+         *
+         * @return \c true if the message should be written, \c false if it is suppressed.
+         */
+        template <typename... Args>
+        [[nodiscard]] bool log_filter(const LogLevel level, const std::string_view str, const Args&... args)
+        {
+            if (!is_log_limited(level)) {
+                return true;
+            }
+
+            spdlog::memory_buf_t encoded_args{};
+            (encode_binary_log_arg(encoded_args, args), ...);
+
+            return is_log_allowed(level, str, {encoded_args.data(), encoded_args.size()});
+        }
+
+        /**
+         * @brief Gets the binary log writer if a message of the given level is written to the binary log.
+         *
+         * @param level The level of the message.
+         *
+         * @return The writer, or \c nullptr if the message is not written to the binary log.
+         */
+        [[nodiscard]] BinaryLogWriter* get_binary_log(LogLevel level) noexcept;
+
+        /**
+         * @brief Writes a message to the binary log if it is enabled.
+         *
+         * @tparam Args The types of the arguments to be used for formatting the message string.
+         *
+         * @param level The level of the message.
+         * @param str The format string for the message.
+         * @param args The arguments to be used for formatting the message string.
+         */
+        template <typename... Args>
+        void log_binary(const LogLevel level, const std::string_view str, const Args&... args)
+        {
+            auto* const writer = get_binary_log(level);
+
+            if (nullptr == writer) {
+                return;
+            }
+
+            if constexpr (0 == sizeof...(Args)) {
+                writer->write_text(static_cast<int>(level), str);
+            }
+            else {
+                spdlog::memory_buf_t encoded_args{};
+                (encode_binary_log_arg(encoded_args, args), ...);
+                writer->write_event(static_cast<int>(level), str, encoded_args, sizeof...(Args));
+            }
+        }
+    }
+
     /**
      * @brief Logs a message with info level.
      *
@@ -161,6 +438,11 @@ namespace Util {
     template <typename... Args>
     void log_info(const std::string_view str, Args&&... args)
     {
+        if (!detail::log_filter(LogLevel::info, str, args...)) {
+            return;
+        }
+
+        detail::log_binary(LogLevel::info, str, args...);
         spdlog::info(str, std::forward<Args>(args)...);
     }
 
@@ -175,6 +457,11 @@ namespace Util {
     template <typename... Args>
     void log_debug(const std::string_view str, Args&&... args)
     {
+        if (!detail::log_filter(LogLevel::debug, str, args...)) {
+            return;
+        }
+
+        detail::log_binary(LogLevel::debug, str, args...);
         spdlog::debug(str, std::forward<Args>(args)...);
     }
 
@@ -189,6 +476,11 @@ namespace Util {
     template <typename... Args>
     void log_warn(const std::string_view str, Args&&... args)
     {
+        if (!detail::log_filter(LogLevel::warn, str, args...)) {
+            return;
+        }
+
+        detail::log_binary(LogLevel::warn, str, args...);
         spdlog::warn(str, std::forward<Args>(args)...);
     }
 
@@ -203,6 +495,11 @@ namespace Util {
     template <typename... Args>
     void log_error(const std::string_view str, Args&&... args)
     {
+        if (!detail::log_filter(LogLevel::error, str, args...)) {
+            return;
+        }
+
+        detail::log_binary(LogLevel::error, str, args...);
         spdlog::error(str, std::forward<Args>(args)...);
     }
 
@@ -217,6 +514,7 @@ namespace Util {
     template <typename... Args>
     void log_critical(const std::string_view str, Args&&... args)
     {
+        detail::log_binary(LogLevel::critical, str, args...);
         spdlog::critical(str, std::forward<Args>(args)...);
     }
 }
@@ -0,0 +1,139 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace Util {
+    /**
+     * @brief A read-only memory mapping of a whole file.
+     *
+     * The file descriptor is closed as soon as the mapping is created,
+     * accessing the mapped data does not involve any system calls.
+     */
+    class MappedFile final {
+      public:
+        /**
+         * @brief Constructs an empty MappedFile object.
+         */
+        MappedFile() = default;
+
+        /**
+         * @brief Unmaps the file and destroys the MappedFile object.
+         */
+        ~MappedFile();
+
+        /// Move constructor.
+        MappedFile(MappedFile&& other) noexcept;
+
+        /// Copy constructor.
+        MappedFile(const MappedFile&) = delete;
+
+        /// Move assignment operator.
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        /// Copy assignment operator.
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /**
+         * @brief Maps a file into memory, replacing the current mapping.
+         *
+         * @param path The path to the file to map.
+         *
+         * @return \c true if the file was mapped successfully, \c false otherwise. Empty files cannot be mapped.
+         */
+        bool open(const std::string& path) noexcept;
+
+        /**
+         * @brief Unmaps the file.
+         */
+        void close() noexcept;
+
+        /**
+         * @brief Checks if a file is mapped.
+         *
+         * @return \c true if a file is mapped, \c false otherwise.
+         */
+        [[nodiscard]] bool is_open() const noexcept;
+
+        /**
+         * @brief Gets the mapped data.
+         *
+         * @return A pointer to the beginning of the mapped data, or \c nullptr if no file is mapped.
+         */
+        [[nodiscard]] const char* data() const noexcept;
+
+        /**
+         * @brief Gets the size of the mapped data.
+         *
+         * @return The size of the mapped data in bytes.
+         */
+        [[nodiscard]] std::size_t size() const noexcept;
+
+      private:
+        /// The mapped data.
+        const char* data_{};
+
+        /// The size of the mapped data in bytes.
+        std::size_t size_{};
+    };
+
+    inline MappedFile::~MappedFile()
+    {
+        close();
+    }
+
+    inline MappedFile::MappedFile(MappedFile&& other) noexcept : data_(other.data_), size_(other.size_)
+    {
+        other.data_ = nullptr;
+        other.size_ = 0;
+    }
+
+    inline MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+    {
+        if (this != &other) {
+            close();
+
+            data_ = other.data_;
+            size_ = other.size_;
+            other.data_ = nullptr;
+            other.size_ = 0;
+        }
+
+        return *this;
+    }
+
+    inline bool MappedFile::is_open() const noexcept
+    {
+        return data_ != nullptr;
+    }
+
+    inline const char* MappedFile::data() const noexcept
+    {
+        return data_;
+    }
+
+    inline std::size_t MappedFile::size() const noexcept
+    {
+        return size_;
+    }
+}
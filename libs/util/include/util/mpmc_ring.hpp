@@ -0,0 +1,212 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace Util {
+    /**
+     * @brief A bounded lock-free multi-producer multi-consumer queue.
+     *
+     * Each slot carries a sequence number that tells producers and consumers whether the slot is free
+     * or holds an element of the current lap, so pushing and popping only take a compare-and-swap on
+     * the corresponding position. Elements are move-assigned into preallocated slots.
+     *
+     * @tparam T The type of elements in the queue, default constructible and move assignable.
+     */
+    template <typename T>
+    class MpmcRing final {
+      public:
+        /**
+         * @brief Constructs a new MpmcRing object.
+         *
+         * @param capacity The minimum number of elements the queue can hold, rounded up to a power of two.
+         */
+        explicit MpmcRing(std::size_t capacity);
+
+        /// Move constructor.
+        MpmcRing(MpmcRing&&) = delete;
+
+        /// Copy constructor.
+        MpmcRing(const MpmcRing&) = delete;
+
+        /// Move assignment operator.
+        MpmcRing& operator=(MpmcRing&&) = delete;
+
+        /// Copy assignment operator.
+        MpmcRing& operator=(const MpmcRing&) = delete;
+
+        /**
+         * @brief Default destructor.
+         */
+        ~MpmcRing() = default;
+
+        /**
+         * @brief Pushes an element to the back of the queue if there is room for it.
+         *
+         * @param value The element to push, left untouched if the queue is full.
+         *
+         * @return \c true if the element was pushed, \c false if the queue is full.
+         */
+        [[nodiscard]] bool try_push(T& value) noexcept;
+
+        /**
+         * @brief Pops an element from the front of the queue if there is one.
+         *
+         * @param value The variable to move the element to.
+         *
+         * @return \c true if an element was popped, \c false if the queue is empty.
+         */
+        [[nodiscard]] bool try_pop(T& value) noexcept;
+
+        /**
+         * @brief Checks if the queue is empty.
+         *
+         * The result is only a snapshot when other threads use the queue concurrently.
+         *
+         * @return \c true if the queue is empty, \c false otherwise.
+         */
+        [[nodiscard]] bool empty() const noexcept;
+
+        /**
+         * @brief Gets the number of elements the queue can hold.
+         *
+         * @return The capacity of the queue.
+         */
+        [[nodiscard]] std::size_t capacity() const noexcept;
+
+      private:
+        /// The size of a cache line, keeps the positions from sharing one.
+        static constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+        /// A slot of the queue.
+        struct Slot {
+            std::atomic<std::size_t> sequence{};
+            T value{};
+        };
+
+        /// Rounds a capacity up to a power of two.
+        [[nodiscard]] static std::size_t round_capacity(std::size_t capacity) noexcept;
+
+        /// The mask that maps positions to slots.
+        const std::size_t mask_;
+
+        /// The slots of the queue.
+        const std::unique_ptr<Slot[]> slots_;
+
+        /// The position of the next element to push.
+        alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> tail_{};
+
+        /// The position of the next element to pop.
+        alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> head_{};
+    };
+
+    template <typename T>
+    MpmcRing<T>::MpmcRing(const std::size_t capacity)
+      : mask_(round_capacity(capacity) - 1), slots_(std::make_unique<Slot[]>(mask_ + 1))
+    {
+        for (std::size_t i = 0; i <= mask_; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    template <typename T>
+    bool MpmcRing<T>::try_push(T& value) noexcept
+    {
+        auto position = tail_.load(std::memory_order_relaxed);
+
+        while (true) {
+            auto& slot = slots_[position & mask_];
+            const auto sequence = slot.sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<std::ptrdiff_t>(sequence - position);
+
+            if (0 == difference) {
+                if (tail_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    slot.value = std::move(value);
+                    slot.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (difference < 0) {
+                return false;
+            }
+            else {
+                position = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    template <typename T>
+    bool MpmcRing<T>::try_pop(T& value) noexcept
+    {
+        auto position = head_.load(std::memory_order_relaxed);
+
+        while (true) {
+            auto& slot = slots_[position & mask_];
+            const auto sequence = slot.sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<std::ptrdiff_t>(sequence - (position + 1));
+
+            if (0 == difference) {
+                if (head_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    value = std::move(slot.value);
+                    slot.sequence.store(position + mask_ + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (difference < 0) {
+                return false;
+            }
+            else {
+                position = head_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    template <typename T>
+    bool MpmcRing<T>::empty() const noexcept
+    {
+        const auto position = head_.load(std::memory_order_acquire);
+        const auto sequence = slots_[position & mask_].sequence.load(std::memory_order_acquire);
+
+        return sequence != position + 1;
+    }
+
+    template <typename T>
+    std::size_t MpmcRing<T>::capacity() const noexcept
+    {
+        return mask_ + 1;
+    }
+
+    template <typename T>
+    std::size_t MpmcRing<T>::round_capacity(const std::size_t capacity) noexcept
+    {
+        std::size_t result = 2;
+
+        while (result < capacity) {
+            result *= 2;
+        }
+
+        return result;
+    }
+}
@@ -0,0 +1,162 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#pragma once
+
+#include "util/logger.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+
+namespace Util {
+    /**
+     * @brief A log file that is rotated by size or by time.
+     *
+     * Renaming the current file, opening a new one, closing and compressing the rotated segment and removing
+     * the oldest segments is done by a background thread at a low priority; the writing thread only switches
+     * to the new file once it is open. On Windows the file is renamed and reopened by the writing thread,
+     * as open files cannot be renamed there. The class is not thread-safe, the owner serializes the writes.
+     */
+    class RotatingLogFile final {
+      public:
+        /**
+         * @brief Constructs a new RotatingLogFile object.
+         *
+         * @param path The path to the log file.
+         * @param settings The settings for the rotation.
+         */
+        RotatingLogFile(std::string path, const LogRotationSettings& settings);
+
+        /**
+         * @brief Closes the file and waits for the background thread to finish the rotated segments.
+         */
+        ~RotatingLogFile();
+
+        /// Move constructor.
+        RotatingLogFile(RotatingLogFile&&) = delete;
+
+        /// Copy constructor.
+        RotatingLogFile(const RotatingLogFile&) = delete;
+
+        /// Move assignment operator.
+        RotatingLogFile& operator=(RotatingLogFile&&) = delete;
+
+        /// Copy assignment operator.
+        RotatingLogFile& operator=(const RotatingLogFile&) = delete;
+
+        /**
+         * @brief Opens the log file for appending.
+         *
+         * @return \c true if the file is open, \c false otherwise.
+         */
+        bool open();
+
+        /**
+         * @brief Appends data to the log file and rotates it if a limit is reached.
+         *
+         * @param data The data to append.
+         */
+        void write(std::string_view data);
+
+        /**
+         * @brief Flushes the log file.
+         */
+        void flush();
+
+        /**
+         * @brief Gets the path to the log file.
+         *
+         * @return The path to the log file.
+         */
+        [[nodiscard]] const std::string& get_path() const noexcept
+        {
+            return path_;
+        }
+
+      private:
+        /// Requests the background thread to rename the current file and open a new one.
+        void rotate();
+
+        /// Switches the writes to the file opened by the background thread.
+        void switch_file();
+
+        /// Renames the current file and opens a new one, on the background thread.
+        void open_next_file();
+
+        /// Gets a free name for a rotated segment.
+        [[nodiscard]] std::string get_segment_path() const;
+
+        /// Closes, compresses and prunes the rotated segments.
+        void archive();
+
+        /// The path to the log file.
+        const std::string path_;
+
+        /// The settings for the rotation.
+        const LogRotationSettings settings_;
+
+        /// The open log file.
+        std::FILE* file_{};
+
+        /// The size of the current segment.
+        std::uint64_t size_{};
+
+        /// The time at which the current segment is rotated.
+        std::chrono::system_clock::time_point rotation_time_{};
+
+        /// Whether a rotation was requested and the writes have not switched to the new file yet.
+        bool rotation_pending_{};
+
+        /// Whether \c next_file_ is set, checked by the writing thread without locking.
+        std::atomic<bool> next_file_ready_{};
+
+        /// Guards the rotated segments waiting for the background thread.
+        std::mutex mutex_{};
+
+        /// Signals the background thread.
+        std::condition_variable condition_{};
+
+        /// The rotated segments waiting for the background thread, with their still open files.
+        std::deque<std::pair<std::string, std::FILE*>> segments_{};
+
+        /// Whether the background thread should rename the current file and open a new one.
+        bool rotation_requested_{};
+
+        /// The file opened by the background thread, \c nullptr if it could not be opened.
+        std::FILE* next_file_{};
+
+        /// The path the previous file was renamed to, empty if it could not be renamed.
+        std::string next_segment_{};
+
+        /// Whether the background thread should exit.
+        bool stopping_{};
+
+        /// Archives the rotated segments, started on the first rotation.
+        std::thread thread_{};
+    };
+}
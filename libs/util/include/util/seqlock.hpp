@@ -0,0 +1,165 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+namespace Util {
+    /**
+     * @brief A value published by a single writer and read by any number of readers without locks.
+     *
+     * The writer bumps a sequence number to an odd value, stores the value and bumps it to the next even
+     * value. A reader copies the value between two reads of the sequence number and retries if a store was
+     * in progress, so the writer never waits for the readers. The value is kept in atomic words, which makes
+     * the copies of a torn read well defined.
+     *
+     * @tparam T The type of the value, trivially copyable.
+     */
+    template <typename T>
+    class SeqLock final {
+        static_assert(std::is_trivially_copyable_v<T>, "The value must be trivially copyable");
+
+      public:
+        /**
+         * @brief Constructs a new SeqLock object holding a value-initialized value.
+         */
+        SeqLock() noexcept;
+
+        /// Move constructor.
+        SeqLock(SeqLock&&) = delete;
+
+        /// Copy constructor.
+        SeqLock(const SeqLock&) = delete;
+
+        /// Move assignment operator.
+        SeqLock& operator=(SeqLock&&) = delete;
+
+        /// Copy assignment operator.
+        SeqLock& operator=(const SeqLock&) = delete;
+
+        /**
+         * @brief Default destructor.
+         */
+        ~SeqLock() = default;
+
+        /**
+         * @brief Publishes a value, must only be called by one thread at a time.
+         *
+         * @param value The value to publish.
+         */
+        void store(const T& value) noexcept;
+
+        /**
+         * @brief Reads the last published value.
+         *
+         * @return A copy of the value.
+         */
+        [[nodiscard]] T load() const noexcept;
+
+        /**
+         * @brief Gets the number of values published so far.
+         *
+         * @return The number of calls to \c store that have completed.
+         */
+        [[nodiscard]] std::uint64_t get_version() const noexcept;
+
+      private:
+        /// The type of the words the value is kept in.
+        using Word = std::uintptr_t;
+
+        /// The number of words the value takes.
+        static constexpr std::size_t WORD_COUNT = (sizeof(T) + sizeof(Word) - 1) / sizeof(Word);
+
+        /// Odd while a value is being stored.
+        std::atomic<std::uint64_t> sequence_{};
+
+        /// The value.
+        std::array<std::atomic<Word>, WORD_COUNT> words_{};
+    };
+
+    template <typename T>
+    SeqLock<T>::SeqLock() noexcept
+    {
+        store(T{});
+        sequence_.store(0, std::memory_order_relaxed);
+    }
+
+    template <typename T>
+    void SeqLock<T>::store(const T& value) noexcept
+    {
+        std::array<Word, WORD_COUNT> words{};
+        std::memcpy(words.data(), &value, sizeof(T));
+
+        const auto sequence = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for (std::size_t i = 0; i < WORD_COUNT; ++i) {
+            words_[i].store(words[i], std::memory_order_relaxed);
+        }
+
+        sequence_.store(sequence + 2, std::memory_order_release);
+    }
+
+    template <typename T>
+    T SeqLock<T>::load() const noexcept
+    {
+        std::array<Word, WORD_COUNT> words{};
+
+        while (true) {
+            const auto sequence = sequence_.load(std::memory_order_acquire);
+
+            // A store is in progress, it only takes a few instructions
+            if ((sequence & 1) != 0) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            for (std::size_t i = 0; i < WORD_COUNT; ++i) {
+                words[i] = words_[i].load(std::memory_order_relaxed);
+            }
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (sequence_.load(std::memory_order_relaxed) == sequence) {
+                break;
+            }
+        }
+
+        T value{};
+        std::memcpy(static_cast<void*>(&value), words.data(), sizeof(T));
+
+        return value;
+    }
+
+    template <typename T>
+    std::uint64_t SeqLock<T>::get_version() const noexcept
+    {
+        return sequence_.load(std::memory_order_acquire) / 2;
+    }
+}
@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <condition_variable>
 #include <mutex>
 #include <queue>
@@ -29,8 +30,9 @@ namespace Util {
     /**
      * @brief A thread-safe implementation of a queue.
      *
-     * Provides a thread-safe implementation of a queue using a mutex and condition variable.
+     * Provides a thread-safe implementation of a queue using a mutex and condition variables.
      * Supports all the operations of a \c std::queue, but with added thread-safety.
+     * The queue can be bounded, pushing to a full queue then waits until an element is removed.
      *
      * @tparam T The type of elements in the queue.
      */
@@ -165,6 +167,22 @@ namespace Util {
          */
         ThreadSafeQueue& operator=(ThreadSafeQueue&&) = delete;
 
+        /**
+         * @brief Sets the maximum number of elements in the queue.
+         *
+         * Pushing to a full queue waits until an element is removed. The elements already in the queue are kept.
+         *
+         * @param capacity The maximum number of elements in the queue, 0 for an unbounded queue.
+         */
+        void set_capacity(SizeType capacity);
+
+        /**
+         * @brief Returns the maximum number of elements in the queue.
+         *
+         * @return The maximum number of elements in the queue, 0 for an unbounded queue.
+         */
+        [[nodiscard]] SizeType get_capacity() const;
+
         /**
          * @brief Pushes a new element to the back of the queue.
          *
@@ -199,6 +217,15 @@ namespace Util {
         template <typename... Args>
         decltype(auto) emplace(Args&&... args);
 
+        /**
+         * @brief Pushes a new element to the back of the queue unless it is full.
+         *
+         * @param item The value of the element to push to the back of the queue (rvalue).
+         *
+         * @return \c true if the element was pushed, \c false if the queue is full and the element was not moved.
+         */
+        bool try_push(T&& item);
+
         /**
          * @brief Removes and returns an element from the front of the queue.
          *
@@ -209,6 +236,40 @@ namespace Util {
          */
         T pop();
 
+        /**
+         * @brief Removes an element from the front of the queue if there is one.
+         *
+         * @param item Receives the removed element, left untouched if the queue is empty.
+         *
+         * @return \c true if an element was removed, \c false if the queue is empty.
+         */
+        [[nodiscard]] bool try_pop(T& item);
+
+        /**
+         * @brief Removes an element from the front of the queue, waiting until one becomes available.
+         *
+         * @param item Receives the removed element, left untouched if the wait timed out.
+         * @param timeout The maximum time to wait for an element.
+         *
+         * @return \c true if an element was removed, \c false if the wait timed out.
+         */
+        template <typename Rep, typename Period>
+        [[nodiscard]] bool pop_for(T& item, const std::chrono::duration<Rep, Period>& timeout);
+
+        /**
+         * @brief Removes all elements from the queue and appends them to a container.
+         *
+         * The elements are taken out under a single lock and moved to the container after it is released.
+         *
+         * @tparam Container The type of the container, it must support \c push_back.
+         *
+         * @param container The container to append the elements to.
+         *
+         * @return The number of elements appended.
+         */
+        template <typename Container>
+        SizeType drain_into(Container& container);
+
         /**
          * @brief Clears the queue.
          *
@@ -278,11 +339,23 @@ namespace Util {
         /// Mutex to protect access to the queue.
         mutable std::mutex mutex_{};
 
+        /// Waits until a bounded queue has room for an element, the lock must be held.
+        void wait_for_room(std::unique_lock<std::mutex>& lock);
+
+        /// Notifies a waiting producer that there is room in the queue after elements were removed.
+        void notify_room(SizeType removed);
+
         /// Condition variable to wait for elements in the queue.
-        std::condition_variable cond_var_{};
+        mutable std::condition_variable cond_var_{};
+
+        /// Condition variable to wait for room in a bounded queue.
+        std::condition_variable room_cond_var_{};
 
         /// The underlying queue of elements.
         std::queue<T> queue_{};
+
+        /// The maximum number of elements in the queue, 0 for an unbounded queue.
+        SizeType capacity_{};
     };
 
     template <typename T>
@@ -300,6 +373,7 @@ namespace Util {
     {
         const std::scoped_lock lock{other.mutex_};
         queue_ = other.queue_; // cppcheck-suppress useInitializationList
+        capacity_ = other.capacity_;
     }
 
     template <typename T>
@@ -307,6 +381,7 @@ namespace Util {
     {
         const std::scoped_lock lock{other.mutex_};
         queue_ = std::move(other.queue_); // cppcheck-suppress useInitializationList
+        capacity_ = other.capacity_;
     }
 
     template <typename T>
@@ -334,6 +409,7 @@ namespace Util {
     {
         const std::scoped_lock lock{other.mutex_};
         queue_ = std::queue<T, ContainerType>(other.queue_, alloc); // cppcheck-suppress useInitializationList
+        capacity_ = other.capacity_;
     }
 
     template <typename T>
@@ -344,28 +420,79 @@ namespace Util {
 
         // cppcheck-suppress useInitializationList
         queue_ = std::queue<T, ContainerType>(std::move(other.queue_), alloc);
+        capacity_ = other.capacity_;
     }
 
     template <typename T>
-    void ThreadSafeQueue<T>::push(const T& item)
+    void ThreadSafeQueue<T>::set_capacity(const SizeType capacity)
+    {
+        {
+            const std::scoped_lock lock{mutex_};
+            capacity_ = capacity;
+        }
+
+        room_cond_var_.notify_all();
+    }
+
+    template <typename T>
+    typename ThreadSafeQueue<T>::SizeType ThreadSafeQueue<T>::get_capacity() const
     {
         const std::scoped_lock lock{mutex_};
-        queue_.push(item);
+        return capacity_;
+    }
+
+    template <typename T>
+    void ThreadSafeQueue<T>::push(const T& item)
+    {
+        {
+            std::unique_lock lock{mutex_};
+            wait_for_room(lock);
+            queue_.push(item);
+        }
+
+        cond_var_.notify_one();
     }
 
     template <typename T>
     void ThreadSafeQueue<T>::push(T&& item)
     {
-        const std::scoped_lock lock{mutex_};
-        queue_.push(std::move(item));
+        {
+            std::unique_lock lock{mutex_};
+            wait_for_room(lock);
+            queue_.push(std::move(item));
+        }
+
+        cond_var_.notify_one();
     }
 
     template <typename T>
     template <typename... Args>
     decltype(auto) ThreadSafeQueue<T>::emplace(Args&&... args)
     {
-        const std::scoped_lock lock{mutex_};
-        return queue_.emplace(std::forward<Args>(args)...);
+        std::unique_lock lock{mutex_};
+        wait_for_room(lock);
+        decltype(auto) element = queue_.emplace(std::forward<Args>(args)...);
+        cond_var_.notify_one();
+
+        return element;
+    }
+
+    template <typename T>
+    bool ThreadSafeQueue<T>::try_push(T&& item)
+    {
+        {
+            const std::scoped_lock lock{mutex_};
+
+            if ((capacity_ != 0) && (queue_.size() >= capacity_)) {
+                return false;
+            }
+
+            queue_.push(std::move(item));
+        }
+
+        cond_var_.notify_one();
+
+        return true;
     }
 
     template <typename T>
@@ -377,19 +504,86 @@ namespace Util {
             return !queue_.empty();
         });
 
-        auto element = queue_.front();
+        auto element = std::move(queue_.front());
         queue_.pop();
+        lock.unlock();
+        notify_room(1);
 
         return element;
     }
 
     template <typename T>
-    void ThreadSafeQueue<T>::clear()
+    bool ThreadSafeQueue<T>::try_pop(T& item)
     {
-        const std::scoped_lock lock{mutex_};
+        std::unique_lock lock{mutex_};
+
+        if (queue_.empty()) {
+            return false;
+        }
+
+        item = std::move(queue_.front());
+        queue_.pop();
+        lock.unlock();
+        notify_room(1);
+
+        return true;
+    }
+
+    template <typename T>
+    template <typename Rep, typename Period>
+    bool ThreadSafeQueue<T>::pop_for(T& item, const std::chrono::duration<Rep, Period>& timeout)
+    {
+        std::unique_lock lock{mutex_};
+
+        const auto available = cond_var_.wait_for(lock, timeout, [this]() {
+            return !queue_.empty();
+        });
+
+        if (!available) {
+            return false;
+        }
 
+        item = std::move(queue_.front());
+        queue_.pop();
+        lock.unlock();
+        notify_room(1);
+
+        return true;
+    }
+
+    template <typename T>
+    template <typename Container>
+    typename ThreadSafeQueue<T>::SizeType ThreadSafeQueue<T>::drain_into(Container& container)
+    {
+        std::queue<T> drained{};
+
+        {
+            const std::scoped_lock lock{mutex_};
+            queue_.swap(drained);
+        }
+
+        const auto count = drained.size();
+        notify_room(count);
+
+        while (!drained.empty()) {
+            container.push_back(std::move(drained.front()));
+            drained.pop();
+        }
+
+        return count;
+    }
+
+    template <typename T>
+    void ThreadSafeQueue<T>::clear()
+    {
         std::queue<T> empty_queue{};
-        queue_.swap(empty_queue);
+
+        {
+            const std::scoped_lock lock{mutex_};
+            queue_.swap(empty_queue);
+        }
+
+        notify_room(empty_queue.size());
     }
 
     template <typename T>
@@ -453,4 +647,23 @@ namespace Util {
         const std::scoped_lock lock{mutex_};
         return queue_.empty();
     }
+
+    template <typename T>
+    void ThreadSafeQueue<T>::wait_for_room(std::unique_lock<std::mutex>& lock)
+    {
+        room_cond_var_.wait(lock, [this]() {
+            return (capacity_ == 0) || (queue_.size() < capacity_);
+        });
+    }
+
+    template <typename T>
+    void ThreadSafeQueue<T>::notify_room(const SizeType removed)
+    {
+        if (removed > 1) {
+            room_cond_var_.notify_all();
+        }
+        else if (removed == 1) {
+            room_cond_var_.notify_one();
+        }
+    }
 }
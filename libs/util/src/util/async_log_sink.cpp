@@ -0,0 +1,305 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+
+#include "util/async_log_sink.hpp"
+#include "util/string.hpp"
+#include <spdlog/pattern_formatter.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <utility>
+
+namespace {
+    /// The maximum number of messages written with a single call.
+    constexpr std::size_t MAX_BATCH_SIZE = 256;
+
+    /// The time a blocked logging thread waits before retrying.
+    constexpr std::chrono::microseconds BLOCKED_RETRY_INTERVAL{50};
+}
+
+namespace Util {
+    AsyncLogSink::Record::Record(const spdlog::details::log_msg& msg) noexcept
+      : time(msg.time), level(msg.level), size(std::min(msg.payload.size(), MAX_MESSAGE_SIZE))
+    {
+        std::memcpy(payload, msg.payload.data(), size);
+    }
+
+    AsyncLogSink::Record::Record(const Record& other) noexcept
+      : time(other.time), level(other.level), size(other.size)
+    {
+        std::memcpy(payload, other.payload, size);
+    }
+
+    AsyncLogSink::Record& AsyncLogSink::Record::operator=(const Record& other) noexcept
+    {
+        if (this != &other) {
+            time = other.time;
+            level = other.level;
+            size = other.size;
+            std::memcpy(payload, other.payload, size);
+        }
+
+        return *this;
+    }
+
+    AsyncLogSink::AsyncLogSink(const LogAsyncSettings& settings, std::shared_ptr<LogOutput> log_output,
+                               const std::string& logfile, const LogRotationSettings& rotation)
+      : settings_(settings), log_output_(std::move(log_output)), ring_(std::max<std::size_t>(settings.queue_size, 2))
+    {
+        if (!logfile.empty()) {
+            file_ = std::make_unique<RotatingLogFile>(logfile, rotation);
+            file_->open();
+        }
+
+        thread_ = std::thread{&AsyncLogSink::run, this};
+    }
+
+    AsyncLogSink::~AsyncLogSink()
+    {
+        stop();
+    }
+
+    void AsyncLogSink::log(const spdlog::details::log_msg& msg)
+    {
+        if (stopped_.load(std::memory_order_acquire)) {
+            const std::vector<Record> records{Record{msg}};
+            write_records(records);
+
+            if (msg.level == spdlog::level::critical) {
+                flush_outputs();
+            }
+
+            return;
+        }
+
+        Record record{msg};
+
+        // Critical messages precede an abort, so they are never dropped and are written before returning
+        const auto policy =
+          (msg.level == spdlog::level::critical) ? LogOverflowPolicy::block : settings_.overflow_policy;
+
+        while (!ring_.try_push(record)) {
+            if (LogOverflowPolicy::drop == policy) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            if (LogOverflowPolicy::drop_oldest == policy) {
+                if (Record oldest; ring_.try_pop(oldest)) {
+                    dropped_.fetch_add(1, std::memory_order_relaxed);
+                }
+
+                continue;
+            }
+
+            wake_writer();
+            std::this_thread::sleep_for(BLOCKED_RETRY_INTERVAL);
+        }
+
+        if (msg.level == spdlog::level::critical) {
+            flush_and_wait();
+        }
+        else {
+            wake_writer();
+        }
+    }
+
+    void AsyncLogSink::flush()
+    {
+        flush_requested_.fetch_add(1, std::memory_order_acq_rel);
+        wake_writer();
+    }
+
+    void AsyncLogSink::set_pattern(const std::string& pattern)
+    {
+        set_formatter(std::make_unique<spdlog::pattern_formatter>(pattern));
+    }
+
+    void AsyncLogSink::set_formatter(std::unique_ptr<spdlog::formatter> sink_formatter)
+    {
+        const std::lock_guard lock{output_mutex_};
+        formatter_ = std::move(sink_formatter);
+    }
+
+    void AsyncLogSink::stop()
+    {
+        {
+            const std::lock_guard lock{mutex_};
+
+            if (stopped_.exchange(true, std::memory_order_acq_rel)) {
+                return;
+            }
+        }
+
+        work_condition_.notify_one();
+
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+
+        // Messages pushed while the writer was exiting
+        std::vector<Record> records{};
+
+        for (Record record; ring_.try_pop(record);) {
+            records.push_back(record);
+        }
+
+        write_records(records);
+        flush_outputs();
+
+        const std::lock_guard lock{mutex_};
+        flush_completed_ = flush_requested_.load(std::memory_order_acquire);
+        flush_condition_.notify_all();
+    }
+
+    LogAsyncStats AsyncLogSink::get_stats() const noexcept
+    {
+        return {written_.load(std::memory_order_relaxed), dropped_.load(std::memory_order_relaxed)};
+    }
+
+    void AsyncLogSink::run()
+    {
+        std::vector<Record> records{};
+        records.reserve(MAX_BATCH_SIZE);
+        auto last_flush = std::chrono::steady_clock::now();
+
+        while (true) {
+            const auto flush_request = flush_requested_.load(std::memory_order_acquire);
+            const auto stopping = stopped_.load(std::memory_order_acquire);
+
+            for (Record record; records.size() < MAX_BATCH_SIZE && ring_.try_pop(record);) {
+                records.push_back(record);
+            }
+
+            const auto drained = records.size() < MAX_BATCH_SIZE;
+            write_records(records);
+            records.clear();
+
+            if (const auto now = std::chrono::steady_clock::now(); now - last_flush >= settings_.flush_interval) {
+                flush_outputs();
+                last_flush = now;
+            }
+
+            if (!drained) {
+                continue;
+            }
+
+            if (std::unique_lock lock{mutex_}; flush_completed_ != flush_request) {
+                lock.unlock();
+                flush_outputs();
+                last_flush = std::chrono::steady_clock::now();
+                lock.lock();
+                flush_completed_ = flush_request;
+                flush_condition_.notify_all();
+            }
+
+            if (stopping) {
+                break;
+            }
+
+            std::unique_lock lock{mutex_};
+            sleeping_.store(true, std::memory_order_seq_cst);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            const auto timeout = std::max(settings_.flush_interval, std::chrono::milliseconds{1});
+
+            work_condition_.wait_for(lock, timeout, [this, flush_request] {
+                return !ring_.empty() || stopped_.load(std::memory_order_acquire) ||
+                       flush_requested_.load(std::memory_order_acquire) != flush_request;
+            });
+
+            sleeping_.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    void AsyncLogSink::write_records(const std::vector<Record>& records)
+    {
+        const std::lock_guard lock{output_mutex_};
+        const auto dropped = dropped_.load(std::memory_order_relaxed);
+
+        if ((records.empty() && dropped == dropped_reported_) || !formatter_) {
+            return;
+        }
+
+        spdlog::memory_buf_t buffer{};
+
+        for (const auto& record : records) {
+            spdlog::details::log_msg msg{record.time, spdlog::source_loc{}, {}, record.level, record.get_payload()};
+            formatter_->format(msg, buffer);
+        }
+
+        if (dropped != dropped_reported_) {
+            const auto& text =
+              str::format("{} log messages were dropped because the log queue was full", dropped - dropped_reported_);
+            spdlog::details::log_msg msg{spdlog::source_loc{}, {}, spdlog::level::warn, text};
+            formatter_->format(msg, buffer);
+            dropped_reported_ = dropped;
+        }
+
+        if (log_output_) {
+            log_output_->write_log({buffer.data(), buffer.size()});
+
+            // Critical messages precede an abort, the output must not keep them back
+            if (std::any_of(records.cbegin(), records.cend(), [](const Record& record) {
+                    return record.level == spdlog::level::critical;
+                })) {
+                log_output_->flush();
+            }
+        }
+
+        if (file_) {
+            file_->write({buffer.data(), buffer.size()});
+        }
+
+        written_.fetch_add(records.size(), std::memory_order_relaxed);
+    }
+
+    void AsyncLogSink::flush_outputs()
+    {
+        const std::lock_guard lock{output_mutex_};
+
+        if (file_) {
+            file_->flush();
+        }
+    }
+
+    void AsyncLogSink::wake_writer()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (sleeping_.load(std::memory_order_seq_cst)) {
+            const std::lock_guard lock{mutex_};
+            work_condition_.notify_one();
+        }
+    }
+
+    void AsyncLogSink::flush_and_wait()
+    {
+        const auto flush_request = flush_requested_.fetch_add(1, std::memory_order_acq_rel) + 1;
+
+        std::unique_lock lock{mutex_};
+        work_condition_.notify_one();
+
+        flush_condition_.wait(lock, [this, flush_request] {
+            return flush_completed_ >= flush_request;
+        });
+    }
+}
@@ -0,0 +1,427 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+
+#include "util/binary_log.hpp"
+#include "util/logger.hpp"
+#include <fmt/args.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+
+namespace {
+    /// The size of the write buffer of the file.
+    constexpr std::size_t WRITE_BUFFER_SIZE = 64 * 1024;
+
+    /// Appends a value to a record.
+    template <typename T>
+    void append(spdlog::memory_buf_t& record, const T& value)
+    {
+        const auto* const bytes = reinterpret_cast<const char*>(&value);
+        record.append(bytes, bytes + sizeof(value));
+    }
+
+    /// Appends a length-prefixed string to a record.
+    void append_string(spdlog::memory_buf_t& record, const std::string_view text)
+    {
+        append(record, static_cast<std::uint32_t>(text.size()));
+        record.append(text.data(), text.data() + text.size());
+    }
+
+    /// Checks if a file starts with the header of the current format.
+    bool has_current_format(const std::string& path)
+    {
+        auto* const file = std::fopen(path.c_str(), "rb");
+
+        if (nullptr == file) {
+            return false;
+        }
+
+        std::uint32_t header[2]{};
+        const auto read = std::fread(header, sizeof(header), 1, file);
+        std::fclose(file);
+
+        return (1 == read) && (Util::BinaryLogWriter::MAGIC == header[0]) &&
+               (Util::BinaryLogWriter::VERSION == header[1]);
+    }
+
+    /// Gets the current time in nanoseconds since the epoch.
+    std::int64_t get_time() noexcept
+    {
+        const auto now = std::chrono::system_clock::now().time_since_epoch();
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+    }
+}
+
+namespace Util {
+    BinaryLogWriter::~BinaryLogWriter()
+    {
+        if (file_ != nullptr) {
+            std::fclose(file_);
+        }
+    }
+
+    bool BinaryLogWriter::open(const std::string& path)
+    {
+        const std::lock_guard lock{mutex_};
+
+        if (file_ != nullptr) {
+            return true;
+        }
+
+        std::error_code error_code{};
+        const auto size = std::filesystem::file_size(path, error_code);
+
+        // Appending to a file of another format would make it unreadable
+        if (!error_code && size > 0 && !has_current_format(path)) {
+            log_error("Binary log file '{}' has another format or version.", path);
+            return false;
+        }
+
+        file_ = std::fopen(path.c_str(), "ab");
+
+        if (nullptr == file_) {
+            log_error("Failed to open binary log file '{}'.", path);
+            return false;
+        }
+
+        std::setvbuf(file_, nullptr, _IOFBF, WRITE_BUFFER_SIZE);
+        spdlog::memory_buf_t record{};
+
+        if (error_code || 0 == size) {
+            append(record, MAGIC);
+            append(record, VERSION);
+        }
+
+        append(record, BinaryLogRecordType::session);
+        append(record, SESSION_MARKER);
+        append(record, get_time());
+        std::fwrite(record.data(), 1, record.size(), file_);
+
+        return true;
+    }
+
+    void BinaryLogWriter::write_event(const int level, const std::string_view format,
+                                      const spdlog::memory_buf_t& args, const std::size_t arg_count)
+    {
+        spdlog::memory_buf_t record{};
+        const std::lock_guard lock{mutex_};
+
+        if (nullptr == file_) {
+            return;
+        }
+
+        append(record, BinaryLogRecordType::event);
+        append(record, get_time());
+        append(record, static_cast<std::uint8_t>(level));
+        append(record, intern_format(format));
+        append(record, static_cast<std::uint8_t>(arg_count));
+        record.append(args.data(), args.data() + args.size());
+
+        commit(record, level);
+    }
+
+    void BinaryLogWriter::write_text(const int level, const std::string_view text)
+    {
+        spdlog::memory_buf_t record{};
+        const std::lock_guard lock{mutex_};
+
+        if (nullptr == file_) {
+            return;
+        }
+
+        append(record, BinaryLogRecordType::text);
+        append(record, get_time());
+        append(record, static_cast<std::uint8_t>(level));
+        append_string(record, text);
+
+        commit(record, level);
+    }
+
+    void BinaryLogWriter::flush()
+    {
+        const std::lock_guard lock{mutex_};
+
+        if (file_ != nullptr) {
+            std::fflush(file_);
+        }
+    }
+
+    std::uint32_t BinaryLogWriter::intern_format(const std::string_view format)
+    {
+        if (const auto it = format_ids_.find(format); it != format_ids_.end()) {
+            return it->second;
+        }
+
+        const auto id = static_cast<std::uint32_t>(formats_.size());
+        const std::string_view key = formats_.emplace_back(format);
+        format_ids_.emplace(key, id);
+
+        spdlog::memory_buf_t record{};
+        append(record, BinaryLogRecordType::format);
+        append(record, id);
+        append_string(record, key);
+        std::fwrite(record.data(), 1, record.size(), file_);
+
+        return id;
+    }
+
+    void BinaryLogWriter::commit(const spdlog::memory_buf_t& record, const int level)
+    {
+        std::fwrite(record.data(), 1, record.size(), file_);
+
+        // Errors usually precede a crash or an abort, they must not stay in the buffer
+        if (level >= static_cast<int>(LogLevel::error)) {
+            std::fflush(file_);
+        }
+    }
+
+    std::string BinaryLogMessage::format_message() const
+    {
+        if (is_text) {
+            return std::string{format};
+        }
+
+        fmt::dynamic_format_arg_store<fmt::format_context> store{};
+
+        for (const auto& arg : args) {
+            std::visit(
+              [&store](const auto& value) {
+                  store.push_back(value);
+              },
+              arg);
+        }
+
+        return fmt::vformat(format, store);
+    }
+
+    bool BinaryLogReader::open(const std::string& path)
+    {
+        std::uint32_t magic{};
+        std::uint32_t version{};
+
+        if (!file_.open(path) || !read(magic) || !read(version)) {
+            return false;
+        }
+
+        return BinaryLogWriter::MAGIC == magic && BinaryLogWriter::VERSION == version;
+    }
+
+    bool BinaryLogReader::next(BinaryLogMessage& message)
+    {
+        while (position_ < file_.size()) {
+            const auto start = position_;
+            const auto result = read_record(message);
+
+            // A crash leaves a torn record behind, the session appended after it starts with a marker.
+            // The torn record either cannot be read, or it is completed by the bytes of that session.
+            const auto end = (RecordResult::damaged == result) ? file_.size() : position_;
+            const auto session = find_session(start + 1, end);
+
+            if (RecordResult::damaged == result || session < end) {
+                damaged_ = true;
+                position_ = std::min(session, file_.size());
+
+                continue;
+            }
+
+            if (RecordResult::message == result) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    BinaryLogReader::RecordResult BinaryLogReader::read_record(BinaryLogMessage& message)
+    {
+        BinaryLogRecordType type{};
+        std::int64_t time{};
+        std::uint8_t level{};
+
+        if (!read(type)) {
+            return RecordResult::damaged;
+        }
+
+        switch (type) {
+            case BinaryLogRecordType::session: {
+                formats_.clear();
+                std::uint64_t marker{};
+
+                if (!read(marker) || BinaryLogWriter::SESSION_MARKER != marker || !read(time)) {
+                    return RecordResult::damaged;
+                }
+
+                return RecordResult::skipped;
+            }
+
+            case BinaryLogRecordType::format: {
+                std::uint32_t id{};
+                std::string_view format{};
+
+                if (!read(id) || !read_string(format)) {
+                    return RecordResult::damaged;
+                }
+
+                formats_[id] = format;
+                return RecordResult::skipped;
+            }
+
+            case BinaryLogRecordType::text: {
+                if (!read(time) || !read(level) || !read_string(message.format)) {
+                    return RecordResult::damaged;
+                }
+
+                message.time = time;
+                message.level = level;
+                message.args.clear();
+                message.is_text = true;
+
+                return RecordResult::message;
+            }
+
+            case BinaryLogRecordType::event: {
+                std::uint32_t id{};
+                std::uint8_t arg_count{};
+
+                if (!read(time) || !read(level) || !read(id) || !read(arg_count)) {
+                    return RecordResult::damaged;
+                }
+
+                const auto format = formats_.find(id);
+
+                if (format == formats_.end()) {
+                    return RecordResult::damaged;
+                }
+
+                message.time = time;
+                message.level = level;
+                message.format = format->second;
+                message.args.clear();
+                message.is_text = false;
+
+                for (std::uint8_t i = 0; i < arg_count; ++i) {
+                    if (BinaryLogArgType arg_type{}; !read(arg_type) || !read_arg(arg_type, message.args)) {
+                        return RecordResult::damaged;
+                    }
+                }
+
+                return RecordResult::message;
+            }
+        }
+
+        return RecordResult::damaged;
+    }
+
+    std::size_t BinaryLogReader::find_session(const std::size_t from, const std::size_t end) const
+    {
+        char pattern[sizeof(BinaryLogRecordType) + sizeof(BinaryLogWriter::SESSION_MARKER)]{};
+        pattern[0] = static_cast<char>(BinaryLogRecordType::session);
+        std::memcpy(pattern + 1, &BinaryLogWriter::SESSION_MARKER, sizeof(BinaryLogWriter::SESSION_MARKER));
+
+        // A session starting before the end may reach past it
+        const auto size = std::min(end + sizeof(pattern) - 1, file_.size());
+
+        if (from >= size) {
+            return std::string_view::npos;
+        }
+
+        const std::string_view data{file_.data() + from, size - from};
+        const auto found = data.find(std::string_view{pattern, sizeof(pattern)});
+
+        return std::string_view::npos == found ? found : from + found;
+    }
+
+    bool BinaryLogReader::read_arg(const BinaryLogArgType type, std::vector<BinaryLogArg>& args)
+    {
+        switch (type) {
+            case BinaryLogArgType::signed_integer: return read_value<std::int64_t>(args);
+            case BinaryLogArgType::unsigned_integer: return read_value<std::uint64_t>(args);
+            case BinaryLogArgType::floating_point: return read_value<double>(args);
+            case BinaryLogArgType::character: return read_value<char>(args);
+            case BinaryLogArgType::boolean: {
+                std::uint8_t value{};
+
+                if (!read(value)) {
+                    return false;
+                }
+
+                args.emplace_back(0 != value);
+                return true;
+            }
+            case BinaryLogArgType::string: {
+                std::string_view value{};
+
+                if (!read_string(value)) {
+                    return false;
+                }
+
+                args.emplace_back(value);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    template <typename T>
+    bool BinaryLogReader::read_value(std::vector<BinaryLogArg>& args)
+    {
+        T value{};
+
+        if (!read(value)) {
+            return false;
+        }
+
+        args.emplace_back(value);
+        return true;
+    }
+
+    template <typename T>
+    bool BinaryLogReader::read(T& value)
+    {
+        if (file_.size() - position_ < sizeof(T)) {
+            position_ = file_.size();
+            return false;
+        }
+
+        std::memcpy(&value, file_.data() + position_, sizeof(T));
+        position_ += sizeof(T);
+
+        return true;
+    }
+
+    bool BinaryLogReader::read_string(std::string_view& value)
+    {
+        std::uint32_t size{};
+
+        if (!read(size) || file_.size() - position_ < size) {
+            position_ = file_.size();
+            return false;
+        }
+
+        value = {file_.data() + position_, size};
+        position_ += size;
+
+        return true;
+    }
+}
@@ -21,6 +21,7 @@
 #include "util/file.hpp"
 #include "util/logger.hpp"
 #include <algorithm>
+#include <chrono>
 #include <fstream>
 #include <iterator>
 
@@ -144,6 +145,24 @@ namespace Util {
         return error_code;
     }
 
+    long file_mtime(const std::string& path) noexcept
+    {
+        using namespace std::chrono;
+
+        std::error_code error_code{};
+        const auto write_time = std::filesystem::last_write_time(path, error_code);
+
+        if (error_code) {
+            return 0;
+        }
+
+        // Moves the time point to the system clock, the clocks only differ by a constant offset
+        const auto system_time = time_point_cast<system_clock::duration>(
+          write_time - std::filesystem::file_time_type::clock::now() + system_clock::now());
+
+        return static_cast<long>(system_clock::to_time_t(system_time));
+    }
+
     bool try_file_read(const std::string& path, std::string& content) noexcept
     {
         switch (file_read(path, content)) {
@@ -0,0 +1,74 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+
+#include "util/line_splitter.hpp"
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #define LINE_SPLITTER_SSE2
+  #include <emmintrin.h>
+#endif
+
+namespace Util {
+    LineSplitter::LineSplitter(const std::size_t max_line_size) : max_line_size_(max_line_size)
+    {
+    }
+
+    const char* LineSplitter::find_newline(const char* first, const char* const last) noexcept
+    {
+#ifdef LINE_SPLITTER_SSE2
+        const auto newlines = _mm_set1_epi8('\n');
+
+        for (; last - first >= 16; first += 16) {
+            const auto data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(data, newlines)) != 0) {
+                return static_cast<const char*>(std::memchr(first, '\n', 16));
+            }
+        }
+#endif
+        const auto size = static_cast<std::size_t>(last - first);
+        const auto* const newline = static_cast<const char*>(std::memchr(first, '\n', size));
+
+        return nullptr == newline ? last : newline;
+    }
+
+    bool LineSplitter::append_partial(const std::string_view part)
+    {
+        if (overflow_) {
+            return false;
+        }
+
+        // One byte more for a carriage return that is removed later
+        if (partial_.size() + part.size() > max_line_size_ + 1) {
+            overflow_ = true;
+            ++dropped_;
+            partial_.clear();
+            partial_.shrink_to_fit();
+
+            return false;
+        }
+
+        partial_.append(part);
+
+        return true;
+    }
+}
@@ -27,8 +27,11 @@
 namespace Util {
     std::size_t get_console_width()
     {
-        if (winsize win_size{}; 0 == ::ioctl(STDOUT_FILENO, TIOCGWINSZ, &win_size)) {
-            return win_size.ws_col;
+        // The standard output may be redirected to the output capture pipe
+        for (const auto fd : {STDOUT_FILENO, STDIN_FILENO}) {
+            if (winsize win_size{}; 0 == ::ioctl(fd, TIOCGWINSZ, &win_size)) {
+                return win_size.ws_col;
+            }
         }
 
         if (const auto* const columns = ::getenv("COLUMNS"); (columns != nullptr) && (*columns != '\0')) {
@@ -37,4 +40,15 @@ namespace Util {
 
         return 0;
     }
+
+    std::size_t get_console_height()
+    {
+        for (const auto fd : {STDOUT_FILENO, STDIN_FILENO}) {
+            if (winsize win_size{}; 0 == ::ioctl(fd, TIOCGWINSZ, &win_size)) {
+                return win_size.ws_row;
+            }
+        }
+
+        return 0;
+    }
 }
@@ -0,0 +1,341 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+
+#include "util/linux/log_tail.hpp"
+#include "util/linux/reactor.hpp"
+#include "util/linux/system/error.hpp"
+#include "util/logger.hpp"
+#include <fmt/format.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unistd.h>
+#include <unordered_map>
+
+namespace {
+    /// The number of bytes buffered for a client before the ring stops being read for it.
+    constexpr std::size_t MAX_CLIENT_PENDING_SIZE = 64 * 1024;
+
+    /// The maximum number of connected clients.
+    constexpr std::size_t MAX_CLIENTS = 16;
+
+    /// A connected client.
+    struct Client {
+        /// The cursor of the client in the ring.
+        Util::LogRing::Reader reader;
+
+        /// The data read from the ring and not sent yet.
+        std::string pending{};
+    };
+
+    class LogTail final {
+      public:
+        LogTail() = default;
+
+        ~LogTail()
+        {
+            stop();
+        }
+
+        /// Move constructor.
+        LogTail(LogTail&&) = delete;
+
+        /// Copy constructor.
+        LogTail(const LogTail&) = delete;
+
+        /// Move assignment operator.
+        LogTail& operator=(LogTail&&) = delete;
+
+        /// Copy assignment operator.
+        LogTail& operator=(const LogTail&) = delete;
+
+        bool start(const std::string& socket_path)
+        {
+            const std::lock_guard lock{mutex_};
+
+            if (listen_fd_ >= 0) {
+                return true;
+            }
+
+            ring_ = Util::log_ring();
+
+            if (!ring_) {
+                return false;
+            }
+
+            ::sockaddr_un address{};
+            address.sun_family = AF_UNIX;
+
+            if (socket_path.empty() || socket_path.size() >= sizeof(address.sun_path)) {
+                Util::log_error("Invalid log tail socket path '{}'", socket_path);
+                return false;
+            }
+
+            event_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+            if (event_fd_ < 0) {
+                Util::log_error("Failed to create the log tail event: {}", Util::get_last_error_string());
+                return false;
+            }
+
+            std::memcpy(address.sun_path, socket_path.c_str(), socket_path.size() + 1);
+            listen_fd_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+            if (listen_fd_ < 0) {
+                Util::log_error("Failed to create the log tail socket: {}", Util::get_last_error_string());
+                close_descriptors();
+                return false;
+            }
+
+            // A socket left behind by a previous run would make the bind fail
+            ::unlink(socket_path.c_str());
+
+            if (::bind(listen_fd_, reinterpret_cast<const ::sockaddr*>(&address), sizeof(address)) < 0 ||
+                ::chmod(socket_path.c_str(), S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP) < 0 ||
+                ::listen(listen_fd_, SOMAXCONN) < 0) {
+                Util::log_error("Failed to listen on '{}': {}", socket_path, Util::get_last_error_string());
+                close_descriptors();
+                return false;
+            }
+
+            auto& reactor = Util::get_reactor();
+
+            if (!reactor.add(listen_fd_, EPOLLIN, [this](std::uint32_t) { accept_clients(); }) ||
+                !reactor.add(event_fd_, EPOLLIN, [this](std::uint32_t) { on_messages(); })) {
+                Util::log_error("Failed to serve the log tail socket, the launcher reactor is not running");
+                reactor.remove(listen_fd_);
+                close_descriptors();
+                return false;
+            }
+
+            // The writer signals the reactor, it never waits for the clients
+            ring_->set_wakeup([event_fd = event_fd_] {
+                constexpr std::uint64_t signal = 1;
+                [[maybe_unused]] const auto written = ::write(event_fd, &signal, sizeof(signal));
+            });
+
+            socket_path_ = socket_path;
+
+            return true;
+        }
+
+        void stop()
+        {
+            const std::lock_guard lock{mutex_};
+
+            if (listen_fd_ < 0) {
+                return;
+            }
+
+            ring_->set_wakeup({});
+
+            // The clients are only used on the reactor thread, a handler may be running
+            Util::get_reactor().run_and_wait([this] {
+                auto& reactor = Util::get_reactor();
+                reactor.remove(listen_fd_);
+                reactor.remove(event_fd_);
+
+                for (const auto& [fd, client] : clients_) {
+                    reactor.remove(fd);
+                    ::close(fd);
+                }
+
+                clients_.clear();
+            });
+
+            close_descriptors();
+            ::unlink(socket_path_.c_str());
+            ring_.reset();
+        }
+
+      private:
+        /// Closes the listening socket and the event.
+        void close_descriptors()
+        {
+            if (listen_fd_ >= 0) {
+                ::close(listen_fd_);
+                listen_fd_ = -1;
+            }
+
+            if (event_fd_ >= 0) {
+                ::close(event_fd_);
+                event_fd_ = -1;
+            }
+        }
+
+        /// Accepts the pending connections.
+        void accept_clients()
+        {
+            while (true) {
+                const auto fd = ::accept4(listen_fd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+                if (fd < 0) {
+                    break;
+                }
+
+                if (clients_.size() >= MAX_CLIENTS ||
+                    !Util::get_reactor().add(fd, EPOLLIN, [this, fd](const std::uint32_t events) {
+                        on_client_event(fd, events);
+                    })) {
+                    ::close(fd);
+                    continue;
+                }
+
+                clients_.emplace(fd, Client{Util::LogRing::Reader{*ring_}});
+            }
+
+            // The backlog of the new clients
+            on_messages();
+        }
+
+        /// Sends the new messages to the clients and arms the wakeup of the ring once all have been read.
+        void on_messages()
+        {
+            std::uint64_t signal = 0;
+            [[maybe_unused]] const auto bytes_read = ::read(event_fd_, &signal, sizeof(signal));
+
+            ring_->arm_wakeup();
+
+            for (auto it = clients_.begin(); it != clients_.end();) {
+                if (serve_client(it->first, it->second)) {
+                    ++it;
+                }
+                else {
+                    disconnect(it->first);
+                    it = clients_.erase(it);
+                }
+            }
+        }
+
+        /// Handles a readiness change of a client socket.
+        void on_client_event(const int fd, const std::uint32_t events)
+        {
+            const auto it = clients_.find(fd);
+
+            if (it == clients_.end()) {
+                return;
+            }
+
+            auto connected = (events & (EPOLLERR | EPOLLHUP)) == 0;
+
+            // Whatever the client sends is discarded, reading only detects that it has disconnected
+            if (connected && (events & EPOLLIN) != 0) {
+                char buffer[256];
+                const auto received = ::recv(fd, buffer, sizeof(buffer), 0);
+                connected = received > 0 || (received < 0 && (EAGAIN == errno || EINTR == errno));
+            }
+
+            if (!connected || !serve_client(fd, it->second)) {
+                disconnect(fd);
+                clients_.erase(it);
+            }
+        }
+
+        /// Reads the new messages for a client and sends them, returns \c false if the client is gone.
+        bool serve_client(const int fd, Client& client)
+        {
+            const auto was_blocked = !client.pending.empty();
+
+            while (client.pending.size() < MAX_CLIENT_PENDING_SIZE && client.reader.read(message_)) {
+                if (const auto lost = client.reader.take_lost(); lost > 0) {
+                    fmt::format_to(std::back_inserter(client.pending), "[{} log messages lost]\n", lost);
+                }
+
+                client.pending.append(message_);
+            }
+
+            if (!client.pending.empty()) {
+                const auto sent = ::send(fd, client.pending.data(), client.pending.size(), MSG_NOSIGNAL);
+
+                if (sent < 0 && errno != EAGAIN && errno != EINTR) {
+                    return false;
+                }
+
+                client.pending.erase(0, sent < 0 ? 0 : static_cast<std::size_t>(sent));
+            }
+
+            // Waits for the socket to drain only while there is something left to send
+            if (const auto blocked = !client.pending.empty(); blocked != was_blocked) {
+                Util::get_reactor().modify(fd, blocked ? EPOLLIN | EPOLLOUT : EPOLLIN);
+            }
+
+            return true;
+        }
+
+        /// Stops watching a client and closes its socket.
+        static void disconnect(const int fd)
+        {
+            Util::get_reactor().remove(fd);
+            ::close(fd);
+        }
+
+        /// Guards starting and stopping.
+        std::mutex mutex_{};
+
+        /// The ring of recent messages.
+        std::shared_ptr<Util::LogRing> ring_{};
+
+        /// The path to the socket.
+        std::string socket_path_{};
+
+        /// The listening socket.
+        int listen_fd_{-1};
+
+        /// Signaled by the ring when a message is logged.
+        int event_fd_{-1};
+
+        /// The connected clients by socket, only used by the reactor thread.
+        std::unordered_map<int, Client> clients_{};
+
+        /// The buffer a message is read into.
+        std::string message_{};
+    };
+
+    /// Created on first use and never destroyed, like the output capture.
+    LogTail& get_log_tail()
+    {
+        static auto* const log_tail = new LogTail{};
+
+        return *log_tail;
+    }
+}
+
+namespace Util {
+    bool start_log_tail(const std::string& socket_path)
+    {
+        return get_log_tail().start(socket_path);
+    }
+
+    void stop_log_tail()
+    {
+        get_log_tail().stop();
+    }
+}
@@ -0,0 +1,71 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#include "util/mapped_file.hpp"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <limits>
+
+namespace Util {
+    bool MappedFile::open(const std::string& path) noexcept
+    {
+        close();
+
+        const auto file = ::open(path.c_str(), O_RDONLY | O_CLOEXEC); // NOLINT(cppcoreguidelines-pro-type-vararg)
+
+        if (-1 == file) {
+            return false;
+        }
+
+        struct ::stat file_stat{};
+
+        if ((-1 == ::fstat(file, &file_stat)) || (file_stat.st_size <= 0) ||
+            (static_cast<unsigned long long>(file_stat.st_size) > std::numeric_limits<std::size_t>::max())) {
+            ::close(file);
+            return false;
+        }
+
+        const auto size = static_cast<std::size_t>(file_stat.st_size);
+        auto* const data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+
+        // The mapping stays valid after the descriptor is closed
+        ::close(file);
+
+        if (MAP_FAILED == data) {
+            return false;
+        }
+
+        data_ = static_cast<const char*>(data);
+        size_ = size;
+
+        return true;
+    }
+
+    void MappedFile::close() noexcept
+    {
+        if (data_ != nullptr) {
+            ::munmap(const_cast<char*>(data_), size_);
+            data_ = nullptr;
+            size_ = 0;
+        }
+    }
+}
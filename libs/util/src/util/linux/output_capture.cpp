@@ -0,0 +1,624 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+
+#include "util/linux/output_capture.hpp"
+#include "util/linux/system/error.hpp"
+#include "util/logger.hpp"
+#include "util/string.hpp"
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <time.h>
+#include <unistd.h>
+#include <utility>
+
+namespace {
+    /// The size of the pipe requested from the kernel, a larger pipe absorbs bursts.
+    constexpr int PIPE_SIZE = 1024 * 1024;
+
+    /// The size of a single read from the pipe.
+    constexpr std::size_t READ_SIZE = 64 * 1024;
+
+    /// The longest incomplete line kept back while waiting for its end.
+    constexpr std::size_t MAX_PARTIAL_LINE_SIZE = 8 * 1024;
+
+    /// The time an incomplete line is kept back before it is written as is.
+    constexpr int PARTIAL_LINE_TIMEOUT_MS = 100;
+
+    /// The signals that terminate the process, the output still in the pipe is written before they take effect.
+    constexpr std::array<int, 5> FATAL_SIGNALS{SIGABRT, SIGBUS, SIGFPE, SIGILL, SIGSEGV};
+
+    /// The time the fatal signal handler waits for the drain and writer threads to write the output they hold.
+    constexpr int SIGNAL_FLUSH_TIMEOUT_MS = 1000;
+
+    /// Handles the fatal signals while the output is captured.
+    void handle_fatal_signal(int signal) noexcept;
+
+    /// Writes the whole buffer to a file descriptor, retrying interrupted and partial writes.
+    bool write_all(const int fd, std::string_view data) noexcept
+    {
+        while (!data.empty()) {
+            const auto written = ::write(fd, data.data(), data.size());
+
+            if (written < 0) {
+                if (EINTR == errno) {
+                    continue;
+                }
+
+                return false;
+            }
+
+            data.remove_prefix(static_cast<std::size_t>(written));
+        }
+
+        return true;
+    }
+
+    class OutputCapture final {
+      public:
+        OutputCapture() = default;
+
+        ~OutputCapture()
+        {
+            stop();
+        }
+
+        /// Move constructor.
+        OutputCapture(OutputCapture&&) = delete;
+
+        /// Copy constructor.
+        OutputCapture(const OutputCapture&) = delete;
+
+        /// Move assignment operator.
+        OutputCapture& operator=(OutputCapture&&) = delete;
+
+        /// Copy assignment operator.
+        OutputCapture& operator=(const OutputCapture&) = delete;
+
+        bool start(const std::string& logfile, const std::size_t max_buffered_bytes)
+        {
+            // Not locked while logging, the view writes through the capture
+            if (const std::lock_guard lock{mutex_}; running_) {
+                return true;
+            }
+
+            if (int fds[2]{}; 0 == ::pipe2(fds, O_CLOEXEC)) {
+                read_fd_ = fds[0];
+                write_fd_ = fds[1];
+            }
+            else {
+                Util::log_error("Failed to create the output pipe: {}", Util::get_last_error_string());
+                return false;
+            }
+
+            // The write end stays blocking, the writers only wait when the drain thread falls behind
+            // by a whole pipe, and it never waits for the terminal; the read end is also read by the
+            // fatal signal handler, which must not block
+            ::fcntl(write_fd_, F_SETPIPE_SZ, PIPE_SIZE);
+            ::fcntl(read_fd_, F_SETFL, ::fcntl(read_fd_, F_GETFL) | O_NONBLOCK);
+
+            terminal_fd_ = ::fcntl(STDOUT_FILENO, F_DUPFD_CLOEXEC, 0);
+            error_fd_ = ::fcntl(STDERR_FILENO, F_DUPFD_CLOEXEC, 0);
+
+            if (terminal_fd_ < 0 || error_fd_ < 0) {
+                Util::log_error("Failed to duplicate the standard output: {}", Util::get_last_error_string());
+                close_descriptors();
+                return false;
+            }
+
+            if (!logfile.empty()) {
+                logfile_ = logfile;
+                log_fd_ = open_logfile();
+
+                if (log_fd_ < 0) {
+                    Util::log_error("Failed to open '{}' for the captured output: {}", logfile,
+                                    Util::get_last_error_string());
+                }
+            }
+
+            std::fflush(stdout);
+            std::fflush(stderr);
+
+            if (::dup2(write_fd_, STDOUT_FILENO) < 0 || ::dup2(write_fd_, STDERR_FILENO) < 0) {
+                Util::log_error("Failed to redirect the standard output: {}", Util::get_last_error_string());
+                restore_descriptors();
+                close_descriptors();
+                return false;
+            }
+
+            install_signal_handlers();
+
+            const std::lock_guard lock{mutex_};
+            ring_ = Util::log_ring();
+            max_buffered_bytes_ = max_buffered_bytes;
+            running_ = true;
+            stopping_ = false;
+            drain_thread_ = std::thread{&OutputCapture::drain, this};
+            writer_thread_ = std::thread{&OutputCapture::write_pending, this};
+
+            return true;
+        }
+
+        void stop()
+        {
+            {
+                const std::lock_guard lock{mutex_};
+
+                if (!running_) {
+                    return;
+                }
+
+                std::fflush(stdout);
+                std::fflush(stderr);
+                restore_signal_handlers();
+                restore_descriptors();
+                stopping_ = true;
+            }
+
+            // The drain thread reads what is left in the pipe before it exits
+            drain_thread_.join();
+
+            {
+                const std::lock_guard lock{mutex_};
+                running_ = false;
+            }
+
+            condition_.notify_one();
+            writer_thread_.join();
+            close_descriptors();
+        }
+
+        bool write(const std::string_view text)
+        {
+            const std::lock_guard lock{mutex_};
+
+            if (!running_) {
+                return false;
+            }
+
+            enqueue(text, false);
+
+            return true;
+        }
+
+        void flush()
+        {
+            // Taken first, so that the output the writer thread has already taken is written before
+            const std::lock_guard output_lock{output_mutex_};
+            std::deque<Chunk> chunks{};
+
+            {
+                const std::lock_guard lock{mutex_};
+
+                if (!running_) {
+                    return;
+                }
+
+                chunks.swap(pending_);
+                pending_bytes_ = 0;
+            }
+
+            write_chunks(chunks);
+        }
+
+        /// Writes the output still in the pipe to the terminal and the log file, then raises the signal again.
+        void flush_on_signal(const int signal) noexcept
+        {
+            // Only async-signal-safe calls here: the threads are given a moment to write the output they hold,
+            // in case the signal interrupted one of them the rest of the pipe is written directly
+            for (int i = 0; (i < SIGNAL_FLUSH_TIMEOUT_MS) && has_unwritten_output(); ++i) {
+                const ::timespec interval{0, 1000 * 1000};
+                ::nanosleep(&interval, nullptr);
+            }
+
+            if (read_fd_ >= 0) {
+                char buffer[4096];
+
+                for (ssize_t bytes_read{}; (bytes_read = ::read(read_fd_, buffer, sizeof(buffer))) > 0;) {
+                    const std::string_view text{buffer, static_cast<std::size_t>(bytes_read)};
+                    write_all(terminal_fd_, text);
+
+                    if (log_fd_ >= 0) {
+                        write_all(log_fd_, text);
+                    }
+                }
+            }
+
+            restore_descriptors();
+
+            for (std::size_t i = 0; i < FATAL_SIGNALS.size(); ++i) {
+                if (FATAL_SIGNALS[i] == signal) {
+                    ::sigaction(signal, &previous_actions_[i], nullptr);
+                }
+            }
+
+            // Delivered once the handler returns, with the previous action
+            ::raise(signal);
+        }
+
+        /// Checks if some output has not been written yet, async-signal-safe.
+        [[nodiscard]] bool has_unwritten_output() const noexcept
+        {
+            int available{};
+
+            if ((read_fd_ >= 0) && (0 == ::ioctl(read_fd_, FIONREAD, &available)) && (available > 0)) {
+                return true;
+            }
+
+            return unwritten_bytes_.load(std::memory_order_acquire) > 0;
+        }
+
+        [[nodiscard]] Util::OutputCaptureStats get_stats() const noexcept
+        {
+            return {captured_bytes_.load(std::memory_order_relaxed), dropped_bytes_.load(std::memory_order_relaxed)};
+        }
+
+      private:
+        /// A piece of output waiting for the terminal.
+        struct Chunk {
+            std::string text{};
+            bool captured{};
+        };
+
+        /// Reads the pipe and queues the output line by line.
+        void drain()
+        {
+            std::string partial_line{};
+            std::string buffer(READ_SIZE, '\0');
+            ::pollfd pfd{read_fd_, POLLIN, 0};
+
+            while (true) {
+                auto ready = ::poll(&pfd, 1, PARTIAL_LINE_TIMEOUT_MS);
+
+                if (ready < 0 && EINTR == errno) {
+                    continue;
+                }
+
+                ssize_t bytes_read = 0;
+
+                if (ready > 0) {
+                    bytes_read = ::read(read_fd_, buffer.data(), buffer.size());
+
+                    // The read end is non-blocking, the fatal signal handler may have read the data first
+                    if (bytes_read < 0 && (EAGAIN == errno || EINTR == errno)) {
+                        bytes_read = 0;
+                        ready = 0;
+                    }
+                }
+
+                if (bytes_read > 0) {
+                    captured_bytes_.fetch_add(static_cast<std::uint64_t>(bytes_read), std::memory_order_relaxed);
+                    unwritten_bytes_.fetch_add(static_cast<std::size_t>(bytes_read), std::memory_order_release);
+                    partial_line.append(buffer.data(), static_cast<std::size_t>(bytes_read));
+
+                    // Complete lines are queued together, the rest waits for its end
+                    const auto end_of_lines = partial_line.rfind('\n');
+
+                    if (end_of_lines != std::string::npos) {
+                        queue_captured(std::string_view{partial_line}.substr(0, end_of_lines + 1));
+                        partial_line.erase(0, end_of_lines + 1);
+                    }
+
+                    if (partial_line.size() > MAX_PARTIAL_LINE_SIZE) {
+                        queue_captured(partial_line);
+                        partial_line.clear();
+                    }
+
+                    continue;
+                }
+
+                if (!partial_line.empty()) {
+                    queue_captured(partial_line);
+                    partial_line.clear();
+                }
+
+                if (stopping_.load(std::memory_order_acquire) || bytes_read < 0 || (ready > 0 && 0 == bytes_read)) {
+                    break;
+                }
+            }
+        }
+
+        /// Queues output read from the pipe and appends its lines to the ring of recent messages.
+        void queue_captured(const std::string_view text)
+        {
+            if (ring_) {
+                for (std::size_t start = 0; start < text.size();) {
+                    const auto end = std::min(text.find('\n', start), text.size() - 1) + 1;
+                    ring_->write(text.substr(start, end - start));
+                    start = end;
+                }
+            }
+
+            const std::lock_guard lock{mutex_};
+            enqueue(text, true);
+        }
+
+        /// Queues a chunk for the writer thread or drops it if too much output is pending, \c mutex_ must be held.
+        void enqueue(const std::string_view text, const bool captured)
+        {
+            if (pending_bytes_ + text.size() > max_buffered_bytes_) {
+                dropped_bytes_.fetch_add(text.size(), std::memory_order_relaxed);
+
+                if (captured) {
+                    unwritten_bytes_.fetch_sub(text.size(), std::memory_order_release);
+                }
+
+                return;
+            }
+
+            // The captured output is counted as unwritten as soon as it is read from the pipe
+            if (!captured) {
+                unwritten_bytes_.fetch_add(text.size(), std::memory_order_release);
+            }
+
+            pending_bytes_ += text.size();
+            pending_.push_back({std::string{text}, captured});
+            condition_.notify_one();
+        }
+
+        /// Writes the queued output to the terminal and the log file.
+        void write_pending()
+        {
+            std::deque<Chunk> chunks{};
+            std::uint64_t dropped_reported{};
+
+            while (true) {
+                {
+                    std::unique_lock lock{mutex_};
+
+                    condition_.wait(lock, [this] {
+                        return !pending_.empty() || !running_;
+                    });
+
+                    if (pending_.empty() && !running_) {
+                        break;
+                    }
+                }
+
+                // Taken before the output, so that flush() cannot write newer output ahead of it
+                const std::lock_guard output_lock{output_mutex_};
+
+                {
+                    const std::lock_guard lock{mutex_};
+                    chunks.swap(pending_);
+                    pending_bytes_ = 0;
+                }
+
+                write_chunks(chunks);
+                chunks.clear();
+
+                if (const auto dropped = dropped_bytes_.load(std::memory_order_relaxed); dropped != dropped_reported) {
+                    const auto& notice = Util::str::format(
+                      "[WARNING] {} bytes of console output were dropped because the terminal was too slow\n",
+                      dropped - dropped_reported);
+                    write_all(terminal_fd_, notice);
+                    dropped_reported = dropped;
+                }
+            }
+        }
+
+        /// Writes chunks to the terminal and the captured ones to the log file, \c output_mutex_ must be held.
+        void write_chunks(const std::deque<Chunk>& chunks)
+        {
+            if (chunks.empty()) {
+                return;
+            }
+
+            reopen_rotated_logfile();
+
+            for (const auto& chunk : chunks) {
+                write_all(terminal_fd_, chunk.text);
+
+                if (chunk.captured && log_fd_ >= 0) {
+                    write_all(log_fd_, chunk.text);
+                }
+
+                unwritten_bytes_.fetch_sub(chunk.text.size(), std::memory_order_release);
+            }
+        }
+
+        /// Installs the fatal signal handlers, keeping the previous actions.
+        void install_signal_handlers() noexcept
+        {
+            struct sigaction action {};
+            action.sa_handler = &handle_fatal_signal;
+            ::sigemptyset(&action.sa_mask);
+
+            for (std::size_t i = 0; i < FATAL_SIGNALS.size(); ++i) {
+                ::sigaction(FATAL_SIGNALS[i], &action, &previous_actions_[i]);
+            }
+        }
+
+        /// Restores the actions of the fatal signals.
+        void restore_signal_handlers() noexcept
+        {
+            for (std::size_t i = 0; i < FATAL_SIGNALS.size(); ++i) {
+                ::sigaction(FATAL_SIGNALS[i], &previous_actions_[i], nullptr);
+            }
+        }
+
+        /// Opens the log file for appending.
+        [[nodiscard]] int open_logfile() const noexcept
+        {
+            return ::open(logfile_.c_str(), O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0644);
+        }
+
+        /// Reopens the log file if the logger rotated it away.
+        void reopen_rotated_logfile() noexcept
+        {
+            if (log_fd_ < 0) {
+                return;
+            }
+
+            struct stat path_stat {};
+            struct stat file_stat {};
+
+            if (0 == ::stat(logfile_.c_str(), &path_stat) && 0 == ::fstat(log_fd_, &file_stat) &&
+                path_stat.st_dev == file_stat.st_dev && path_stat.st_ino == file_stat.st_ino) {
+                return;
+            }
+
+            if (const auto fd = open_logfile(); fd >= 0) {
+                ::close(log_fd_);
+                log_fd_ = fd;
+            }
+        }
+
+        /// Points the standard output and error back to the original descriptors.
+        void restore_descriptors() noexcept
+        {
+            if (terminal_fd_ >= 0) {
+                ::dup2(terminal_fd_, STDOUT_FILENO);
+            }
+
+            if (error_fd_ >= 0) {
+                ::dup2(error_fd_, STDERR_FILENO);
+            }
+        }
+
+        /// Closes the descriptors owned by the capture.
+        void close_descriptors() noexcept
+        {
+            for (auto* const fd : {&read_fd_, &write_fd_, &terminal_fd_, &error_fd_, &log_fd_}) {
+                if (*fd >= 0) {
+                    ::close(*fd);
+                    *fd = -1;
+                }
+            }
+        }
+
+        /// The read end of the pipe.
+        int read_fd_{-1};
+
+        /// The write end of the pipe.
+        int write_fd_{-1};
+
+        /// The original standard output.
+        int terminal_fd_{-1};
+
+        /// The original standard error.
+        int error_fd_{-1};
+
+        /// The log file the captured output is appended to.
+        int log_fd_{-1};
+
+        /// The path to the log file.
+        std::string logfile_{};
+
+        /// Guards the state and the pending output.
+        std::mutex mutex_{};
+
+        /// Serializes writing to the terminal and the log file, taken before \c mutex_.
+        std::mutex output_mutex_{};
+
+        /// The actions of the fatal signals before the output was captured.
+        std::array<struct sigaction, FATAL_SIGNALS.size()> previous_actions_{};
+
+        /// Signals the writer thread about pending output.
+        std::condition_variable condition_{};
+
+        /// The output waiting for the terminal.
+        std::deque<Chunk> pending_{};
+
+        /// The number of bytes waiting for the terminal.
+        std::size_t pending_bytes_{};
+
+        /// The maximum number of bytes waiting for the terminal.
+        std::size_t max_buffered_bytes_{};
+
+        /// Whether the output is captured.
+        bool running_{};
+
+        /// Whether the drain thread should exit once the pipe is empty.
+        std::atomic<bool> stopping_{};
+
+        /// The number of bytes read from the pipe.
+        std::atomic<std::uint64_t> captured_bytes_{};
+
+        /// The number of bytes dropped.
+        std::atomic<std::uint64_t> dropped_bytes_{};
+
+        /// The number of bytes read from the pipe or queued, and neither written nor dropped yet.
+        std::atomic<std::size_t> unwritten_bytes_{};
+
+        /// The ring of recent messages the captured lines are appended to.
+        std::shared_ptr<Util::LogRing> ring_{};
+
+        /// Reads the pipe.
+        std::thread drain_thread_{};
+
+        /// Writes the output to the terminal.
+        std::thread writer_thread_{};
+    };
+
+    /// Created on first use and never destroyed, the logger may still write through it at exit.
+    OutputCapture& get_output_capture()
+    {
+        static auto* const output_capture = new OutputCapture{};
+
+        return *output_capture;
+    }
+
+    void handle_fatal_signal(const int signal) noexcept
+    {
+        get_output_capture().flush_on_signal(signal);
+    }
+}
+
+namespace Util {
+    bool start_output_capture(const std::string& logfile, const std::size_t max_buffered_bytes)
+    {
+        return get_output_capture().start(logfile, max_buffered_bytes);
+    }
+
+    void stop_output_capture()
+    {
+        get_output_capture().stop();
+    }
+
+    bool write_captured_output(const std::string_view text)
+    {
+        return get_output_capture().write(text);
+    }
+
+    void flush_captured_output()
+    {
+        get_output_capture().flush();
+    }
+
+    OutputCaptureStats output_capture_stats() noexcept
+    {
+        return get_output_capture().get_stats();
+    }
+}
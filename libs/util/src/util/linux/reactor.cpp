@@ -0,0 +1,390 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+
+#include "util/linux/reactor.hpp"
+#include "util/linux/system/error.hpp"
+#include "util/logger.hpp"
+#include <pthread.h>
+#include <sched.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+#include <sys/timerfd.h>
+#include <array>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <future>
+#include <unistd.h>
+#include <utility>
+
+namespace {
+    /// The maximum number of events dispatched per wakeup.
+    constexpr int MAX_EVENTS = 64;
+
+    /// Reads the counter of an \c eventfd or \c timerfd to rearm it.
+    void drain_counter(const int fd) noexcept
+    {
+        std::uint64_t counter = 0;
+        [[maybe_unused]] const auto bytes_read = ::read(fd, &counter, sizeof(counter));
+    }
+}
+
+namespace Util {
+    Reactor::~Reactor()
+    {
+        stop();
+    }
+
+    bool Reactor::start(const int cpu)
+    {
+        const std::lock_guard start_lock{start_mutex_};
+
+        if (thread_.joinable()) {
+            return true;
+        }
+
+        const auto epoll_fd = ::epoll_create1(EPOLL_CLOEXEC);
+        const auto event_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        ::epoll_event event{EPOLLIN, {}};
+        event.data.fd = event_fd;
+
+        if (epoll_fd < 0 || event_fd < 0 || ::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, event_fd, &event) < 0) {
+            Util::log_error("Failed to create the reactor: {}", Util::get_last_error_string());
+
+            if (epoll_fd >= 0) {
+                ::close(epoll_fd);
+            }
+
+            if (event_fd >= 0) {
+                ::close(event_fd);
+            }
+
+            return false;
+        }
+
+        {
+            const std::lock_guard lock{mutex_};
+            epoll_fd_ = epoll_fd;
+            event_fd_ = event_fd;
+        }
+
+        // The thread inherits a mask with all signals blocked, they are only received through the signalfd
+        ::sigset_t mask{};
+        ::sigset_t old_mask{};
+        ::sigfillset(&mask);
+        ::pthread_sigmask(SIG_BLOCK, &mask, &old_mask);
+
+        stopping_ = false;
+        thread_ = std::thread{&Reactor::run, this};
+        ::pthread_sigmask(SIG_SETMASK, &old_mask, nullptr);
+
+        if (cpu >= 0) {
+            ::cpu_set_t cpu_set{};
+            CPU_ZERO(&cpu_set);
+            CPU_SET(static_cast<std::size_t>(cpu), &cpu_set);
+
+            if (const auto error = ::pthread_setaffinity_np(thread_.native_handle(), sizeof(cpu_set), &cpu_set);
+                error != 0) {
+                Util::log_warn("Failed to pin the reactor thread to CPU {}: {}", cpu, std::strerror(error));
+            }
+        }
+
+        return true;
+    }
+
+    void Reactor::stop()
+    {
+        const std::lock_guard start_lock{start_mutex_};
+
+        if (!thread_.joinable()) {
+            return;
+        }
+
+        stopping_ = true;
+        constexpr std::uint64_t signal = 1;
+        [[maybe_unused]] const auto written = ::write(event_fd_, &signal, sizeof(signal));
+        thread_.join();
+        thread_id_ = std::thread::id{};
+
+        const std::lock_guard lock{mutex_};
+
+        for (const auto timer : timers_) {
+            ::close(timer);
+        }
+
+        if (signal_fd_ >= 0) {
+            ::close(signal_fd_);
+        }
+
+        handlers_.clear();
+        timers_.clear();
+        signals_.clear();
+        posted_.clear();
+        ::close(epoll_fd_);
+        ::close(event_fd_);
+        epoll_fd_ = event_fd_ = signal_fd_ = -1;
+    }
+
+    bool Reactor::is_reactor_thread() const noexcept
+    {
+        return thread_id_.load(std::memory_order_relaxed) == std::this_thread::get_id();
+    }
+
+    bool Reactor::add(const int fd, const std::uint32_t events, Handler handler)
+    {
+        const std::lock_guard lock{mutex_};
+
+        if (epoll_fd_ < 0) {
+            return false;
+        }
+
+        ::epoll_event event{events, {}};
+        event.data.fd = fd;
+
+        if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) < 0) {
+            return false;
+        }
+
+        handlers_.insert_or_assign(fd, std::make_shared<Handler>(std::move(handler)));
+
+        return true;
+    }
+
+    bool Reactor::modify(const int fd, const std::uint32_t events)
+    {
+        ::epoll_event event{events, {}};
+        event.data.fd = fd;
+
+        return ::epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, fd, &event) == 0;
+    }
+
+    void Reactor::remove(const int fd)
+    {
+        {
+            const std::lock_guard lock{mutex_};
+
+            if (handlers_.erase(fd) != 0) {
+                ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+            }
+        }
+
+        // A handler or a posted callback that is already running may still use the descriptor
+        run_and_wait({});
+    }
+
+    int Reactor::add_timer(const std::chrono::milliseconds interval, Callback callback)
+    {
+        const auto timer = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+
+        if (timer < 0) {
+            Util::log_error("Failed to create a timer: {}", Util::get_last_error_string());
+            return -1;
+        }
+
+        const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(interval);
+        const auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(interval - seconds);
+        const ::timespec period{static_cast<::time_t>(seconds.count()), static_cast<long>(nanoseconds.count())};
+        const ::itimerspec value{period, period};
+
+        if (::timerfd_settime(timer, 0, &value, nullptr) < 0 ||
+            !add(timer, EPOLLIN, [timer, callback = std::move(callback)](std::uint32_t) {
+                drain_counter(timer);
+                callback();
+            })) {
+            Util::log_error("Failed to start a timer: {}", Util::get_last_error_string());
+            ::close(timer);
+            return -1;
+        }
+
+        const std::lock_guard lock{mutex_};
+        timers_.insert(timer);
+
+        return timer;
+    }
+
+    void Reactor::remove_timer(const int timer)
+    {
+        remove(timer);
+
+        const std::lock_guard lock{mutex_};
+
+        if (timers_.erase(timer) != 0) {
+            ::close(timer);
+        }
+    }
+
+    bool Reactor::add_signal(const int signal, Callback callback)
+    {
+        ::sigset_t mask{};
+        ::sigemptyset(&mask);
+        ::sigaddset(&mask, signal);
+
+        if (::pthread_sigmask(SIG_BLOCK, &mask, nullptr) != 0) {
+            return false;
+        }
+
+        std::unique_lock lock{mutex_};
+
+        if (epoll_fd_ < 0) {
+            return false;
+        }
+
+        for (const auto& [number, handler] : signals_) {
+            ::sigaddset(&mask, number);
+        }
+
+        const auto created = signal_fd_ < 0;
+        const auto fd = ::signalfd(signal_fd_, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+
+        if (fd < 0) {
+            Util::log_error("Failed to handle signal {}: {}", signal, Util::get_last_error_string());
+            return false;
+        }
+
+        signals_.insert_or_assign(signal, std::move(callback));
+        signal_fd_ = fd;
+        lock.unlock();
+
+        return !created || add(fd, EPOLLIN, [this](std::uint32_t) {
+            dispatch_signals();
+        });
+    }
+
+    void Reactor::post(Callback callback)
+    {
+        {
+            const std::lock_guard lock{mutex_};
+            posted_.emplace_back(std::move(callback));
+        }
+
+        constexpr std::uint64_t signal = 1;
+        [[maybe_unused]] const auto written = ::write(event_fd_, &signal, sizeof(signal));
+    }
+
+    void Reactor::run()
+    {
+        std::array<::epoll_event, MAX_EVENTS> events{};
+        thread_id_ = std::this_thread::get_id();
+
+        while (!stopping_.load(std::memory_order_relaxed)) {
+            const auto count = ::epoll_wait(epoll_fd_, events.data(), MAX_EVENTS, -1);
+
+            if (count < 0) {
+                if (EINTR == errno) {
+                    continue;
+                }
+
+                Util::log_error("Failed to wait for reactor events: {}", Util::get_last_error_string());
+                break;
+            }
+
+            for (auto i = 0; i < count; ++i) {
+                const auto fd = events[static_cast<std::size_t>(i)].data.fd;
+
+                if (fd == event_fd_) {
+                    drain_counter(event_fd_);
+                    run_posted();
+                    continue;
+                }
+
+                std::shared_ptr<Handler> handler{};
+                {
+                    // A handler removed by a previous one in this batch is skipped
+                    const std::lock_guard lock{mutex_};
+
+                    if (const auto it = handlers_.find(fd); it != handlers_.end()) {
+                        handler = it->second;
+                    }
+                }
+
+                if (handler) {
+                    (*handler)(events[static_cast<std::size_t>(i)].events);
+                }
+            }
+        }
+    }
+
+    void Reactor::run_posted()
+    {
+        std::vector<Callback> callbacks{};
+        {
+            const std::lock_guard lock{mutex_};
+            callbacks.swap(posted_);
+        }
+
+        for (const auto& callback : callbacks) {
+            if (callback) {
+                callback();
+            }
+        }
+    }
+
+    void Reactor::dispatch_signals()
+    {
+        ::signalfd_siginfo info{};
+
+        while (::read(signal_fd_, &info, sizeof(info)) == static_cast<::ssize_t>(sizeof(info))) {
+            Callback callback{};
+            {
+                const std::lock_guard lock{mutex_};
+
+                if (const auto it = signals_.find(static_cast<int>(info.ssi_signo)); it != signals_.end()) {
+                    callback = it->second;
+                }
+            }
+
+            if (callback) {
+                callback();
+            }
+        }
+    }
+
+    void Reactor::run_and_wait(const Callback& callback)
+    {
+        // Not running, or called from a handler: no other handler can be running
+        if (thread_id_.load() == std::thread::id{} || is_reactor_thread()) {
+            if (callback) {
+                callback();
+            }
+
+            return;
+        }
+
+        std::promise<void> done{};
+        post([&callback, &done] {
+            if (callback) {
+                callback();
+            }
+
+            done.set_value();
+        });
+
+        done.get_future().wait();
+    }
+
+    Reactor& get_reactor()
+    {
+        static auto* const reactor = new Reactor{};
+
+        return *reactor;
+    }
+}
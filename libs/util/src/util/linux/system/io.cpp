@@ -0,0 +1,67 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#include "util/linux/system/io.hpp"
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+    /// Scheduling class used by the I/O scheduler for idle priority (see ioprio_set(2)).
+    constexpr int IOPRIO_CLASS_IDLE = 3;
+
+    /// Number of bits the scheduling class is shifted by within the priority value.
+    constexpr int IOPRIO_CLASS_SHIFT = 13;
+
+    /// Applies the priority to a single thread (or process) identified by its ID.
+    constexpr int IOPRIO_WHO_PROCESS = 1;
+}
+
+namespace Util {
+    bool set_thread_background_io_priority() noexcept
+    {
+        // A zero ID refers to the calling thread
+        constexpr int priority = IOPRIO_CLASS_IDLE << IOPRIO_CLASS_SHIFT;
+        return 0 == ::syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, 0, priority);
+    }
+
+    bool file_prefetch(const std::string& path) noexcept
+    {
+        const auto file = ::open(path.c_str(), O_RDONLY | O_CLOEXEC); // NOLINT(cppcoreguidelines-pro-type-vararg)
+
+        if (-1 == file) {
+            return false;
+        }
+
+        struct ::stat file_stat{};
+        auto result = 0 == ::fstat(file, &file_stat);
+
+        if (result && file_stat.st_size > 0) {
+            // posix_fadvise only queues the request, readahead blocks until the pages are read,
+            // which is what a background thread with idle I/O priority wants
+            result = 0 == ::posix_fadvise(file, 0, 0, POSIX_FADV_WILLNEED);
+            result = (0 == ::readahead(file, 0, static_cast<std::size_t>(file_stat.st_size))) || result;
+        }
+
+        ::close(file);
+        return result;
+    }
+}
@@ -0,0 +1,194 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+
+#include "util/log_limiter.hpp"
+#include <fmt/format.h>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <utility>
+
+namespace {
+    /// The maximum number of tracked format strings, messages with other format strings are not limited.
+    constexpr std::size_t max_groups = 1024;
+
+    /// Removes the trailing line breaks from a format string for use in a report.
+    [[nodiscard]] std::string_view trim_newlines(std::string_view text) noexcept
+    {
+        while (!text.empty() && ('\n' == text.back() || '\r' == text.back())) {
+            text.remove_suffix(1);
+        }
+
+        return text;
+    }
+}
+
+namespace Util {
+    LogLimiter::LogLimiter(const LogRateLimitSettings& settings, Report report, const Clock::time_point now)
+      : settings_(settings), report_(std::move(report)), report_time_(now)
+    {
+    }
+
+    bool LogLimiter::allow(const LogLevel level, const std::string_view format, const std::string_view args,
+                           const Clock::time_point now)
+    {
+        Reports reports{};
+        auto allowed = true;
+
+        {
+            std::lock_guard lock{mutex_};
+
+            if (is_repeat(level, format, args)) {
+                ++repeats_;
+                allowed = false;
+            }
+            else {
+                collect_repeats(reports);
+
+                last_message_.assign(format);
+                last_message_.push_back('\0');
+                last_message_.append(args);
+                last_level_ = level;
+
+                if (auto* const group = get_group(format, now); group != nullptr) {
+                    const auto elapsed = std::chrono::duration<double>(now - group->refill_time).count();
+                    group->tokens = std::min(group->tokens + (elapsed * settings_.rate),
+                                             static_cast<double>(settings_.burst));
+                    group->refill_time = now;
+                    group->level = level;
+
+                    if (group->tokens >= 1.0) {
+                        group->tokens -= 1.0;
+                    }
+                    else {
+                        ++group->suppressed;
+                        allowed = false;
+                    }
+                }
+            }
+
+            if (!allowed) {
+                suppressed_.fetch_add(1, std::memory_order_relaxed);
+                has_pending_.store(true, std::memory_order_relaxed);
+            }
+
+            if (now - report_time_ >= settings_.report_interval) {
+                report_time_ = now;
+                collect_reports(reports);
+            }
+        }
+
+        write_reports(reports);
+
+        return allowed;
+    }
+
+    void LogLimiter::report(const bool force, const Clock::time_point now)
+    {
+        if (!has_pending_.load(std::memory_order_relaxed)) {
+            return;
+        }
+
+        Reports reports{};
+
+        {
+            std::lock_guard lock{mutex_};
+
+            if (!force && now - report_time_ < settings_.report_interval) {
+                return;
+            }
+
+            report_time_ = now;
+            collect_reports(reports);
+        }
+
+        write_reports(reports);
+    }
+
+    void LogLimiter::collect_reports(Reports& reports)
+    {
+        collect_repeats(reports);
+
+        for (auto& [hash, group] : groups_) {
+            if (group.suppressed > 0) {
+                reports.emplace_back(group.level, fmt::format("Suppressed {} messages: {}", group.suppressed,
+                                                              trim_newlines(group.format)));
+                group.suppressed = 0;
+            }
+        }
+
+        has_pending_.store(false, std::memory_order_relaxed);
+    }
+
+    void LogLimiter::collect_repeats(Reports& reports)
+    {
+        if (repeats_ > 0) {
+            const auto format = std::string_view{last_message_}.substr(0, last_message_.find('\0'));
+            reports.emplace_back(last_level_,
+                                 fmt::format("Message repeated {} times: {}", repeats_, trim_newlines(format)));
+            repeats_ = 0;
+        }
+    }
+
+    void LogLimiter::write_reports(const Reports& reports) const
+    {
+        for (const auto& [level, message] : reports) {
+            report_(level, message);
+        }
+    }
+
+    bool LogLimiter::is_repeat(const LogLevel level, const std::string_view format,
+                               const std::string_view args) const noexcept
+    {
+        const std::string_view last{last_message_};
+
+        return level == last_level_ && last.size() == format.size() + 1 + args.size() &&
+               last.substr(0, format.size()) == format && '\0' == last[format.size()] &&
+               last.substr(format.size() + 1) == args;
+    }
+
+    LogLimiter::Group* LogLimiter::get_group(const std::string_view format, const Clock::time_point now)
+    {
+        const auto hash = std::hash<std::string_view>{}(format);
+
+        if (const auto it = groups_.find(hash); it != groups_.end()) {
+            return &it->second;
+        }
+
+        if (groups_.size() >= max_groups) {
+            // Forget the groups that have nothing to report
+            for (auto it = groups_.begin(); it != groups_.end();) {
+                it = 0 == it->second.suppressed ? groups_.erase(it) : std::next(it);
+            }
+
+            if (groups_.size() >= max_groups) {
+                return nullptr;
+            }
+        }
+
+        auto& group = groups_[hash];
+        group.format.assign(format);
+        group.tokens = static_cast<double>(settings_.burst);
+        group.refill_time = now;
+
+        return &group;
+    }
+}
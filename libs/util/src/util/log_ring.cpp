@@ -0,0 +1,156 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+
+#include "util/log_ring.hpp"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <utility>
+
+namespace {
+    /// Rounds a number up to a power of two, at least two.
+    [[nodiscard]] std::size_t round_up_to_power_of_two(const std::size_t value) noexcept
+    {
+        std::size_t result = 2;
+
+        while (result < value) {
+            result <<= 1U;
+        }
+
+        return result;
+    }
+
+    /// Gets the index of the message a reader starts from.
+    [[nodiscard]] std::uint64_t get_start_index(const Util::LogRing& ring, const bool from_oldest) noexcept
+    {
+        const auto head = ring.get_head();
+        const auto capacity = static_cast<std::uint64_t>(ring.get_capacity());
+
+        if (!from_oldest) {
+            return head;
+        }
+
+        return head > capacity ? head - capacity : 0;
+    }
+}
+
+namespace Util {
+    LogRing::LogRing(const std::size_t capacity)
+      : mask_(round_up_to_power_of_two(capacity) - 1), slots_(std::make_unique<Slot[]>(mask_ + 1))
+    {
+    }
+
+    void LogRing::write(std::string_view message)
+    {
+        // Truncated messages keep their line break
+        const auto has_newline = !message.empty() && '\n' == message.back();
+        message = message.substr(0, has_newline ? MAX_MESSAGE_SIZE - 1 : MAX_MESSAGE_SIZE);
+
+        std::array<Word, WORD_COUNT> words{};
+        auto size = message.size();
+        std::memcpy(words.data(), message.data(), size);
+
+        if (has_newline && '\n' != message.back()) {
+            reinterpret_cast<char*>(words.data())[size++] = '\n';
+        }
+
+        const std::lock_guard lock{mutex_};
+        const auto index = head_.load(std::memory_order_relaxed);
+        auto& slot = slots_[index & mask_];
+
+        slot.sequence.store((index * 2) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for (std::size_t i = 0; i < (size + sizeof(Word) - 1) / sizeof(Word); ++i) {
+            slot.words[i].store(words[i], std::memory_order_relaxed);
+        }
+
+        slot.size.store(size, std::memory_order_relaxed);
+        slot.sequence.store((index * 2) + 2, std::memory_order_release);
+        head_.store(index + 1, std::memory_order_seq_cst);
+
+        if (wakeup_armed_.load(std::memory_order_seq_cst) && wakeup_armed_.exchange(false) && wakeup_) {
+            wakeup_();
+        }
+    }
+
+    void LogRing::set_wakeup(std::function<void()> wakeup)
+    {
+        const std::lock_guard lock{mutex_};
+        wakeup_ = std::move(wakeup);
+    }
+
+    LogRing::Reader::Reader(const LogRing& ring, const bool from_oldest) noexcept
+      : ring_(&ring), cursor_(get_start_index(ring, from_oldest))
+    {
+    }
+
+    bool LogRing::Reader::read(std::string& message)
+    {
+        const auto capacity = static_cast<std::uint64_t>(ring_->get_capacity());
+
+        while (true) {
+            const auto head = ring_->get_head();
+
+            if (cursor_ >= head) {
+                return false;
+            }
+
+            // Skip what the writers have overwritten already
+            if (head - cursor_ > capacity) {
+                lost_ += head - capacity - cursor_;
+                cursor_ = head - capacity;
+            }
+
+            const auto& slot = ring_->slots_[cursor_ & ring_->mask_];
+            const auto expected = (cursor_ * 2) + 2;
+
+            if (slot.sequence.load(std::memory_order_acquire) != expected) {
+                continue;
+            }
+
+            // The copy may be torn by a writer, in which case the sequence check below discards it
+            std::array<Word, WORD_COUNT> words{};
+            const auto size = std::min(slot.size.load(std::memory_order_relaxed), MAX_MESSAGE_SIZE);
+
+            for (std::size_t i = 0; i < (size + sizeof(Word) - 1) / sizeof(Word); ++i) {
+                words[i] = slot.words[i].load(std::memory_order_relaxed);
+            }
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (slot.sequence.load(std::memory_order_relaxed) != expected) {
+                continue;
+            }
+
+            message.assign(reinterpret_cast<const char*>(words.data()), size);
+
+            ++cursor_;
+
+            return true;
+        }
+    }
+
+    std::uint64_t LogRing::Reader::take_lost() noexcept
+    {
+        return std::exchange(lost_, 0);
+    }
+}
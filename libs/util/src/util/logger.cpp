@@ -19,15 +19,21 @@
  */
 
 #include "util/logger.hpp"
-#include "util/string.hpp"
+#include "util/async_log_sink.hpp"
+#include "util/log_limiter.hpp"
+#include "util/rotating_log_file.hpp"
 #include <spdlog/common.h>
 #include <spdlog/formatter.h>
 #include <spdlog/logger.h>
+#include <spdlog/details/null_mutex.h>
 #include <spdlog/sinks/base_sink.h>
-#include <spdlog/sinks/basic_file_sink.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
 #include <memory>
 #include <mutex>
-#include <unordered_map>
+#include <string_view>
 #include <vector>
 
 namespace spdlog::sinks {
@@ -39,26 +45,58 @@ namespace {
     std::shared_ptr<spdlog::logger> logger{};
     std::shared_ptr<spdlog::sinks::sink> log_sink{};
     std::shared_ptr<spdlog::sinks::sink> file_sink{};
+    std::shared_ptr<Util::AsyncLogSink> async_sink{};
+    std::unique_ptr<Util::BinaryLogWriter> binary_log{};
+    std::atomic<Util::BinaryLogWriter*> binary_log_writer{};
+    std::atomic<int> binary_log_level{static_cast<int>(Util::LogLevel::off)};
+    std::shared_ptr<Util::LogRing> message_ring{};
+    std::unique_ptr<Util::LogLimiter> log_limiter{};
+    std::atomic<Util::LogLimiter*> log_limiter_ptr{};
+    std::atomic<int> log_limiter_level{static_cast<int>(Util::LogLevel::off)};
 
+    /// The message prefixes, indexed by the log level.
+    constexpr std::array<std::string_view, spdlog::level::n_levels> level_prefixes = {
+      "",               // trace
+      "[DEBUG] ",       // debug
+      "",               // info
+      "[WARNING] ",     // warn
+      "[ERROR] ",       // err
+      "[FATAL ERROR] ", // critical
+      ""                // off
+    };
+
+    /**
+     * @brief Writes a report of the rate limiter past the limiter itself.
+     */
+    void write_limiter_report(const Util::LogLevel level, const std::string_view message)
+    {
+        if (Util::LogLevel::info == level) {
+            Util::detail::log_binary(level, "{}\n", message);
+            spdlog::info("{}\n", message);
+        }
+        else {
+            Util::detail::log_binary(level, "{}", message);
+            spdlog::log(static_cast<spdlog::level::level_enum>(level), "{}", message);
+        }
+    }
+
+    /**
+     * @brief Writes the level prefix and the payload of a message straight into the destination buffer.
+     *
+     * The buffer has inline storage, so formatting a line of a usual length does not allocate.
+     */
     class Formatter final : public spdlog::formatter {
       public:
         void format(const spdlog::details::log_msg& msg, spdlog::memory_buf_t& dest) override
         {
-            static const std::unordered_map<spdlog::level::level_enum, const char*> prefixes = {
-              {spdlog::level::debug,    "DEBUG"      },
-              {spdlog::level::warn,     "WARNING"    },
-              {spdlog::level::err,      "ERROR"      },
-              {spdlog::level::critical, "FATAL ERROR"}
-            };
-
-            const auto& it = prefixes.find(msg.level);
-            const auto& prefix = (it == prefixes.end()) ? "" : Util::str::format("[{}] ", it->second);
-            const auto& formatted_msg = Util::str::format("{}{}", prefix, msg.payload);
-            dest.append(formatted_msg.data(), formatted_msg.data() + formatted_msg.size());
+            const auto level = static_cast<std::size_t>(msg.level);
+            const auto prefix = level < level_prefixes.size() ? level_prefixes[level] : std::string_view{};
+
+            dest.append(prefix.data(), prefix.data() + prefix.size());
+            dest.append(msg.payload.data(), msg.payload.data() + msg.payload.size());
 
             if (msg.level != spdlog::level::info) {
-                constexpr auto* newline = "\n";
-                dest.append(newline, newline + 1);
+                dest.push_back('\n');
             }
 
 #ifdef _WIN32
@@ -103,7 +141,12 @@ namespace {
         {
             spdlog::memory_buf_t formatted;
             spdlog::sinks::base_sink<Mutex>::formatter_->format(msg, formatted);
-            log_output_->write_log(fmt::to_string(formatted));
+            log_output_->write_log({formatted.data(), formatted.size()});
+
+            // Critical messages precede an abort, the output must not keep them back
+            if (msg.level == spdlog::level::critical) {
+                log_output_->flush();
+            }
         }
 
         /**
@@ -120,28 +163,166 @@ namespace {
         ///< The LogOutput instance handling the actual logging.
         std::shared_ptr<Util::LogOutput> log_output_;
     };
+
+    /**
+     * @brief Custom sink for spdlog that appends the messages to a log file rotated by size or by time.
+     */
+    template <typename Mutex>
+    class RotatingFileSink final : public spdlog::sinks::base_sink<Mutex> {
+      public:
+        /**
+         * @brief Construct a new RotatingFileSink object and open the log file.
+         *
+         * @param path The path to the log file.
+         * @param settings The settings for the rotation.
+         */
+        RotatingFileSink(std::string path, const Util::LogRotationSettings& settings)
+          : file_(std::move(path), settings)
+        {
+            file_.open();
+        }
+
+      protected:
+        void sink_it_(const spdlog::details::log_msg& msg) override
+        {
+            spdlog::memory_buf_t formatted;
+            spdlog::sinks::base_sink<Mutex>::formatter_->format(msg, formatted);
+            file_.write({formatted.data(), formatted.size()});
+        }
+
+        void flush_() override
+        {
+            file_.flush();
+        }
+
+      private:
+        ///< The log file.
+        Util::RotatingLogFile file_;
+    };
+
+    /**
+     * @brief Custom sink for spdlog that appends the messages to the ring of recent messages.
+     *
+     * The ring serializes the writers itself.
+     */
+    class LogRingSink final : public spdlog::sinks::base_sink<spdlog::details::null_mutex> {
+      public:
+        /**
+         * @brief Construct a new LogRingSink object.
+         *
+         * @param ring The ring to append the messages to.
+         */
+        explicit LogRingSink(std::shared_ptr<Util::LogRing> ring) : ring_(std::move(ring))
+        {
+        }
+
+      protected:
+        void sink_it_(const spdlog::details::log_msg& msg) override
+        {
+            spdlog::memory_buf_t formatted;
+            formatter_->format(msg, formatted);
+            ring_->write({formatted.data(), formatted.size()});
+        }
+
+        void flush_() override
+        {
+        }
+
+      private:
+        ///< The ring of recent messages.
+        std::shared_ptr<Util::LogRing> ring_;
+    };
 }
 
 namespace Util {
     void log_init(const LogSettings& settings)
     {
+        log_shutdown();
+        binary_log_writer.store(nullptr, std::memory_order_release);
+        binary_log.reset();
+        log_limiter_ptr.store(nullptr, std::memory_order_release);
+        log_limiter.reset();
+        async_sink.reset();
+        log_sink.reset();
+        file_sink.reset();
         logger_settings = settings;
         spdlog::drop_all();
 
+        // Kept across reinitializations of the same size, the readers hold on to it
+        if (0 == settings.ring_size) {
+            std::atomic_store(&message_ring, std::shared_ptr<LogRing>{});
+        }
+        else if (!message_ring || message_ring->get_capacity() < settings.ring_size) {
+            std::atomic_store(&message_ring, std::make_shared<LogRing>(settings.ring_size));
+        }
+
+        const auto ring_sink = message_ring ? std::make_shared<LogRingSink>(message_ring) : nullptr;
+
+        if (settings.rate_limit.enabled) {
+            const auto level = std::max(settings.level, settings.rate_limit.min_level);
+            log_limiter = std::make_unique<LogLimiter>(settings.rate_limit, &write_limiter_report);
+            log_limiter_level.store(static_cast<int>(level), std::memory_order_relaxed);
+            log_limiter_ptr.store(log_limiter.get(), std::memory_order_release);
+        }
+
+        const auto to_view = (settings.output & LogDestination::view) == LogDestination::view;
+        auto to_file = (settings.output & LogDestination::file) == LogDestination::file;
+
+        // The binary log replaces the text log file
+        if (to_file && !settings.binary_logfile.empty()) {
+            binary_log = std::make_unique<BinaryLogWriter>();
+
+            if (binary_log->open(settings.binary_logfile)) {
+                to_file = false;
+                binary_log_level.store(static_cast<int>(settings.level), std::memory_order_relaxed);
+                binary_log_writer.store(binary_log.get(), std::memory_order_release);
+            }
+            else {
+                // Falls back to the text log file rather than writing no log file at all
+                binary_log.reset();
+            }
+        }
+
+        if (settings.async.enabled) {
+            async_sink = std::make_shared<AsyncLogSink>(settings.async, to_view ? settings.log_output : nullptr,
+                                                        to_file ? settings.logfile : std::string{}, settings.rotation);
+
+            // The writer thread flushes the file periodically and after critical messages
+            std::vector<spdlog::sink_ptr> sinks{async_sink};
+
+            if (ring_sink) {
+                sinks.emplace_back(ring_sink);
+            }
+
+            logger = std::make_shared<spdlog::logger>("main", sinks.cbegin(), sinks.cend());
+            logger->flush_on(spdlog::level::off);
+            logger->set_level(static_cast<spdlog::level::level_enum>(settings.level));
+            logger->set_formatter(std::make_unique<Formatter>());
+
+            register_logger(logger);
+            set_default_logger(logger);
+
+            return;
+        }
+
         std::vector<spdlog::sink_ptr> sinks{};
-        constexpr std::size_t max_sinks = 2;
+        constexpr std::size_t max_sinks = 3;
         sinks.reserve(max_sinks);
 
-        if ((settings.output & LogDestination::view) == LogDestination::view) {
+        if (to_view) {
             log_sink = std::make_shared<LogOutputSink<std::mutex>>(settings.log_output);
             sinks.emplace_back(log_sink);
         }
 
-        if ((settings.output & LogDestination::file) == LogDestination::file) {
-            file_sink = std::make_shared<spdlog::sinks::basic_file_sink_mt>(settings.logfile);
+        if (to_file) {
+            file_sink = std::make_shared<RotatingFileSink<std::mutex>>(settings.logfile, settings.rotation);
             sinks.emplace_back(file_sink);
         }
 
+        if (ring_sink) {
+            sinks.emplace_back(ring_sink);
+        }
+
         logger = std::make_shared<spdlog::logger>("main", sinks.cbegin(), sinks.cend());
         logger->flush_on(static_cast<spdlog::level::level_enum>(settings.flush_on));
         logger->set_level(static_cast<spdlog::level::level_enum>(settings.level));
@@ -164,6 +345,62 @@ namespace Util {
         log_init(settings);
     }
 
+    void log_shutdown()
+    {
+        if (log_limiter) {
+            log_limiter->report(true);
+        }
+
+        if (async_sink) {
+            async_sink->stop();
+        }
+
+        if (binary_log) {
+            binary_log->flush();
+        }
+    }
+
+    LogAsyncStats log_async_stats() noexcept
+    {
+        return async_sink ? async_sink->get_stats() : LogAsyncStats{};
+    }
+
+    std::shared_ptr<LogRing> log_ring() noexcept
+    {
+        return std::atomic_load(&message_ring);
+    }
+
+    void log_report_suppressed()
+    {
+        if (auto* const limiter = log_limiter_ptr.load(std::memory_order_acquire); limiter != nullptr) {
+            limiter->report();
+        }
+    }
+
+    bool detail::is_log_limited(const LogLevel level) noexcept
+    {
+        return level < LogLevel::critical &&
+               static_cast<int>(level) >= log_limiter_level.load(std::memory_order_relaxed) &&
+               log_limiter_ptr.load(std::memory_order_relaxed) != nullptr;
+    }
+
+    bool detail::is_log_allowed(const LogLevel level, const std::string_view format, const std::string_view args)
+    {
+        auto* const limiter = log_limiter_ptr.load(std::memory_order_acquire);
+        return nullptr == limiter || limiter->allow(level, format, args);
+    }
+
+    BinaryLogWriter* detail::get_binary_log(const LogLevel level) noexcept
+    {
+        auto* const writer = binary_log_writer.load(std::memory_order_acquire);
+
+        if (writer != nullptr && static_cast<int>(level) >= binary_log_level.load(std::memory_order_relaxed)) {
+            return writer;
+        }
+
+        return nullptr;
+    }
+
     const LogSettings& log_settings()
     {
         return logger_settings;
@@ -0,0 +1,401 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+
+#include "util/rotating_log_file.hpp"
+#include "util/system.hpp"
+#include <fmt/chrono.h>
+#include <fmt/format.h>
+#include <zlib.h>
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <system_error>
+#include <vector>
+
+#ifndef _WIN32
+  #include <sys/resource.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+#endif
+
+namespace {
+    /// The size of the chunks the rotated segments are compressed in.
+    constexpr std::size_t COMPRESS_CHUNK_SIZE = 64 * 1024;
+
+    /// The extension of the compressed segments.
+    constexpr std::string_view COMPRESSED_EXTENSION = ".gz";
+
+    /// Lowers the CPU and I/O priority of the calling thread.
+    void lower_thread_priority() noexcept
+    {
+#ifndef _WIN32
+        // The nice value is per thread on Linux
+        constexpr int lowest_priority = 19;
+        ::setpriority(PRIO_PROCESS, static_cast<::id_t>(::syscall(SYS_gettid)), lowest_priority);
+#endif
+        Util::set_thread_background_io_priority();
+    }
+
+    /// Compresses a file with gzip.
+    bool compress_file(const std::string& source, const std::string& target)
+    {
+        auto* const input = std::fopen(source.c_str(), "rb");
+
+        if (nullptr == input) {
+            return false;
+        }
+
+        auto* const output = ::gzopen(target.c_str(), "wb6");
+
+        if (nullptr == output) {
+            std::fclose(input);
+            return false;
+        }
+
+        std::array<char, COMPRESS_CHUNK_SIZE> buffer{};
+        auto result = true;
+
+        while (result) {
+            const auto bytes_read = std::fread(buffer.data(), 1, buffer.size(), input);
+
+            if (0 == bytes_read) {
+                result = 0 == std::ferror(input);
+                break;
+            }
+
+            result = ::gzwrite(output, buffer.data(), static_cast<unsigned>(bytes_read)) > 0;
+        }
+
+        std::fclose(input);
+        result = (Z_OK == ::gzclose(output)) && result;
+
+        return result;
+    }
+
+    /// Checks if a file name is a rotated segment of a log file.
+    bool is_segment_name(const std::string_view name, const std::string_view stem, const std::string_view extension)
+    {
+        if (name.size() <= stem.size() + 1 || name.substr(0, stem.size()) != stem || name[stem.size()] != '.') {
+            return false;
+        }
+
+        const auto rest = name.substr(stem.size() + 1);
+        const auto ends_with = [rest](const std::string_view suffix) {
+            return rest.size() > suffix.size() && rest.substr(rest.size() - suffix.size()) == suffix;
+        };
+
+        return ends_with(extension) || ends_with(fmt::format("{}{}", extension, COMPRESSED_EXTENSION));
+    }
+}
+
+namespace Util {
+    RotatingLogFile::RotatingLogFile(std::string path, const LogRotationSettings& settings)
+      : path_(std::move(path)), settings_(settings)
+    {
+    }
+
+    RotatingLogFile::~RotatingLogFile()
+    {
+        // A requested rotation is completed, so that the segment is archived like the others
+        if (rotation_pending_) {
+            {
+                std::unique_lock lock{mutex_};
+
+                condition_.wait(lock, [this] {
+                    return next_file_ready_.load(std::memory_order_relaxed);
+                });
+            }
+
+            switch_file();
+        }
+
+        if (thread_.joinable()) {
+            {
+                const std::lock_guard lock{mutex_};
+                stopping_ = true;
+            }
+
+            condition_.notify_one();
+            thread_.join();
+        }
+
+        if (file_ != nullptr) {
+            std::fclose(file_);
+        }
+
+        // A file opened for a rotation the writes have not switched to yet
+        if (next_file_ != nullptr) {
+            std::fclose(next_file_);
+        }
+    }
+
+    bool RotatingLogFile::open()
+    {
+        if (file_ != nullptr) {
+            return true;
+        }
+
+        const auto parent = std::filesystem::path{path_}.parent_path();
+
+        if (std::error_code error_code{}; !parent.empty()) {
+            std::filesystem::create_directories(parent, error_code);
+        }
+
+        file_ = std::fopen(path_.c_str(), "ab");
+
+        if (nullptr == file_) {
+            log_error("Failed to open log file '{}'.", path_);
+            return false;
+        }
+
+        std::error_code error_code{};
+        const auto size = std::filesystem::file_size(path_, error_code);
+        size_ = error_code ? 0 : size;
+        rotation_time_ = std::chrono::system_clock::now() + settings_.interval;
+
+        return true;
+    }
+
+    void RotatingLogFile::write(const std::string_view data)
+    {
+        if (nullptr == file_) {
+            return;
+        }
+
+        if (next_file_ready_.load(std::memory_order_acquire)) {
+            switch_file();
+        }
+
+        std::fwrite(data.data(), 1, data.size(), file_);
+        size_ += data.size();
+
+        if (!rotation_pending_ && ((settings_.max_size > 0 && size_ >= settings_.max_size) ||
+                                   (settings_.interval.count() > 0 &&
+                                    std::chrono::system_clock::now() >= rotation_time_))) {
+            rotate();
+        }
+    }
+
+    void RotatingLogFile::flush()
+    {
+        if (file_ != nullptr) {
+            std::fflush(file_);
+        }
+    }
+
+    void RotatingLogFile::rotate()
+    {
+#ifdef _WIN32
+        // Open files cannot be renamed on Windows, the file is closed and reopened in place
+        const auto segment_path = get_segment_path();
+        std::fclose(file_);
+        const auto renamed = 0 == std::rename(path_.c_str(), segment_path.c_str());
+
+        {
+            const std::lock_guard lock{mutex_};
+            next_file_ = std::fopen(path_.c_str(), "ab");
+            next_segment_ = renamed ? segment_path : std::string{};
+            next_file_ready_.store(true, std::memory_order_release);
+        }
+
+        // Nothing is left to close, the writes continue in the new file or not at all
+        file_ = nullptr;
+        switch_file();
+#else
+        // The background thread renames the file and opens a new one, the writes go on to the old file
+        // in the meantime and land in the segment
+        rotation_pending_ = true;
+
+        {
+            const std::lock_guard lock{mutex_};
+            rotation_requested_ = true;
+        }
+
+        if (!thread_.joinable()) {
+            thread_ = std::thread{&RotatingLogFile::archive, this};
+        }
+
+        condition_.notify_one();
+#endif
+    }
+
+    void RotatingLogFile::switch_file()
+    {
+        std::FILE* new_file = nullptr;
+        std::string segment_path{};
+
+        {
+            const std::lock_guard lock{mutex_};
+            new_file = std::exchange(next_file_, nullptr);
+            segment_path = std::move(next_segment_);
+            next_file_ready_.store(false, std::memory_order_relaxed);
+        }
+
+        rotation_pending_ = false;
+        rotation_time_ = std::chrono::system_clock::now() + settings_.interval;
+
+        if (nullptr == new_file) {
+            // Keep writing to the old file rather than losing the messages
+            return;
+        }
+
+        auto* const old_file = std::exchange(file_, new_file);
+        size_ = segment_path.empty() ? size_ : 0;
+
+        {
+            const std::lock_guard lock{mutex_};
+            segments_.emplace_back(std::move(segment_path), old_file);
+        }
+
+        if (!thread_.joinable()) {
+            thread_ = std::thread{&RotatingLogFile::archive, this};
+        }
+
+        condition_.notify_one();
+    }
+
+    void RotatingLogFile::open_next_file()
+    {
+        const auto segment_path = get_segment_path();
+        const auto renamed = 0 == std::rename(path_.c_str(), segment_path.c_str());
+        auto* const new_file = std::fopen(path_.c_str(), "ab");
+
+        {
+            const std::lock_guard lock{mutex_};
+            next_file_ = new_file;
+            next_segment_ = renamed ? segment_path : std::string{};
+            next_file_ready_.store(true, std::memory_order_release);
+        }
+
+        // The destructor may be waiting for the rotation as well
+        condition_.notify_all();
+    }
+
+    std::string RotatingLogFile::get_segment_path() const
+    {
+        const std::filesystem::path path{path_};
+        const auto& parent = path.parent_path();
+        const auto& stem = path.stem().string();
+        const auto& extension = path.extension().string();
+        const auto& timestamp = fmt::format("{:%Y%m%d-%H%M%S}", fmt::localtime(std::time(nullptr)));
+
+        const auto& prefix = fmt::format("{}.{}", stem, timestamp);
+
+        // Suffixed after the newest segment of the same second, a name freed by pruning is not reused
+        // for a newer segment, which would then be pruned first
+        int suffix = 0;
+        std::error_code error_code{};
+
+        for (const auto& entry : std::filesystem::directory_iterator{parent.empty() ? "." : parent, error_code}) {
+            const auto& name = entry.path().filename().string();
+
+            if (!is_segment_name(name, stem, extension) || name.compare(0, prefix.size(), prefix) != 0) {
+                continue;
+            }
+
+            // Either the extension follows the timestamp, or an underscore and the suffix
+            suffix = std::max(suffix, '_' == name[prefix.size()] ? std::atoi(name.c_str() + prefix.size() + 1) + 1 : 1);
+        }
+
+        const auto& name = (0 == suffix) ? fmt::format("{}{}", prefix, extension)
+                                         : fmt::format("{}_{}{}", prefix, suffix, extension);
+
+        return (parent / name).string();
+    }
+
+    void RotatingLogFile::archive()
+    {
+        lower_thread_priority();
+
+        const std::filesystem::path path{path_};
+        const auto& directory = path.has_parent_path() ? path.parent_path() : std::filesystem::path{"."};
+        const auto& stem = path.stem().string();
+        const auto& extension = path.extension().string();
+
+        while (true) {
+            std::pair<std::string, std::FILE*> segment{};
+
+            {
+                std::unique_lock lock{mutex_};
+
+                condition_.wait(lock, [this] {
+                    return stopping_ || rotation_requested_ || !segments_.empty();
+                });
+
+                if (rotation_requested_ && !stopping_) {
+                    rotation_requested_ = false;
+                    lock.unlock();
+                    open_next_file();
+                    continue;
+                }
+
+                if (segments_.empty()) {
+                    break;
+                }
+
+                segment = std::move(segments_.front());
+                segments_.pop_front();
+            }
+
+            if (segment.second != nullptr) {
+                std::fclose(segment.second);
+            }
+
+            if (segment.first.empty()) {
+                continue;
+            }
+
+            if (settings_.compress) {
+                const auto& compressed = segment.first + std::string{COMPRESSED_EXTENSION};
+                std::error_code error_code{};
+
+                if (compress_file(segment.first, compressed)) {
+                    std::filesystem::remove(segment.first, error_code);
+                }
+                else {
+                    std::filesystem::remove(compressed, error_code);
+                }
+            }
+
+            if (0 == settings_.max_files) {
+                continue;
+            }
+
+            // The timestamps in the names sort the segments from the oldest to the newest
+            std::vector<std::filesystem::path> segments{};
+            std::error_code error_code{};
+
+            for (const auto& entry : std::filesystem::directory_iterator{directory, error_code}) {
+                if (is_segment_name(entry.path().filename().string(), stem, extension)) {
+                    segments.push_back(entry.path());
+                }
+            }
+
+            std::sort(segments.begin(), segments.end());
+
+            for (std::size_t i = 0; i + settings_.max_files < segments.size(); ++i) {
+                std::filesystem::remove(segments[i], error_code);
+            }
+        }
+    }
+}
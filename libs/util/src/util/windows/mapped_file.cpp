@@ -0,0 +1,76 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#define WIN32_LEAN_AND_MEAN // NOLINT(clang-diagnostic-unused-macros)
+
+#include "util/mapped_file.hpp"
+#include <limits>
+#include <Windows.h>
+
+namespace Util {
+    bool MappedFile::open(const std::string& path) noexcept
+    {
+        close();
+
+        auto* const file = ::CreateFile(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                        FILE_ATTRIBUTE_NORMAL, nullptr);
+
+        if (INVALID_HANDLE_VALUE == file) {
+            return false;
+        }
+
+        ::LARGE_INTEGER file_size{};
+
+        if ((FALSE == ::GetFileSizeEx(file, &file_size)) || (file_size.QuadPart <= 0) ||
+            (static_cast<unsigned long long>(file_size.QuadPart) > std::numeric_limits<std::size_t>::max())) {
+            ::CloseHandle(file);
+            return false;
+        }
+
+        auto* const mapping = ::CreateFileMapping(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        ::CloseHandle(file);
+
+        if (nullptr == mapping) {
+            return false;
+        }
+
+        // The view keeps the mapping object alive after its handle is closed
+        const auto* const data = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        ::CloseHandle(mapping);
+
+        if (nullptr == data) {
+            return false;
+        }
+
+        data_ = static_cast<const char*>(data);
+        size_ = static_cast<std::size_t>(file_size.QuadPart);
+
+        return true;
+    }
+
+    void MappedFile::close() noexcept
+    {
+        if (data_ != nullptr) {
+            ::UnmapViewOfFile(data_);
+            data_ = nullptr;
+            size_ = 0;
+        }
+    }
+}
@@ -0,0 +1,55 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#include "util/windows/system/io.hpp"
+#include <array>
+
+namespace Util {
+    bool set_thread_background_io_priority() noexcept
+    {
+        // Background mode lowers both the CPU and the I/O priority of the thread
+        return FALSE != ::SetThreadPriority(::GetCurrentThread(), THREAD_MODE_BACKGROUND_BEGIN);
+    }
+
+    bool file_prefetch(const std::string& path) noexcept
+    {
+        auto* const file = ::CreateFile(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                                        OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+        if (INVALID_HANDLE_VALUE == file) {
+            return false;
+        }
+
+        // There is no readahead counterpart, so the file is read through the system cache and discarded
+        constexpr ::DWORD chunk_size = 64 * 1024;
+        static thread_local std::array<char, chunk_size> buffer{};
+
+        ::DWORD bytes_read{};
+        auto result = true;
+
+        do {
+            result = FALSE != ::ReadFile(file, buffer.data(), chunk_size, &bytes_read, nullptr);
+        }
+        while (result && bytes_read > 0);
+
+        ::CloseHandle(file);
+        return result;
+    }
+}
@@ -0,0 +1,151 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#include "util/atomic_observable.hpp"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+    class TestObservable : public Util::AtomicObservable<int, int> {
+      public:
+        using AtomicObservable::notify;
+    };
+
+    TEST(AtomicObservableTest, AppendAndRemoveListener)
+    {
+        TestObservable observable{};
+        auto sum1 = 0;
+        auto sum2 = 0;
+
+        // Notifying without listeners does nothing
+        observable.notify(1, 1);
+
+        const auto handle1 = observable.append_listener([&sum1](const int event, const int arg) {
+            sum1 += event * arg;
+        });
+
+        const auto handle2 = observable.append_listener([&sum2](const int event, const int arg) {
+            sum2 += event * arg;
+        });
+
+        ASSERT_NE(handle1, handle2);
+
+        observable.notify(2, 3);
+        EXPECT_EQ(sum1, 6);
+        EXPECT_EQ(sum2, 6);
+
+        observable.remove_listener(handle1);
+        observable.notify(2, 5);
+        EXPECT_EQ(sum1, 6);
+        EXPECT_EQ(sum2, 16);
+
+        // Removing an unknown listener does nothing
+        observable.remove_listener(handle1);
+        observable.notify(1, 1);
+        EXPECT_EQ(sum2, 17);
+    }
+
+    TEST(AtomicObservableTest, ManyListenersInOrder)
+    {
+        TestObservable observable{};
+        std::vector<int> calls{};
+        std::vector<TestObservable::Handle> handles{};
+
+        for (auto i = 0; i < static_cast<int>(TestObservable::INLINE_LISTENERS * 2); ++i) {
+            handles.push_back(observable.append_listener([&calls, i](int, int) {
+                calls.push_back(i);
+            }));
+        }
+
+        observable.remove_listener(handles[1]);
+        observable.remove_listener(handles[TestObservable::INLINE_LISTENERS + 1]);
+        observable.notify(0, 0);
+
+        std::vector<int> expected{};
+
+        for (auto i = 0; i < static_cast<int>(TestObservable::INLINE_LISTENERS * 2); ++i) {
+            if ((i != 1) && (i != static_cast<int>(TestObservable::INLINE_LISTENERS + 1))) {
+                expected.push_back(i);
+            }
+        }
+
+        EXPECT_EQ(calls, expected);
+    }
+
+    TEST(AtomicObservableTest, ChangeListenersWhileNotifying)
+    {
+        TestObservable observable{};
+        auto calls = 0;
+        auto appended_calls = 0;
+        TestObservable::Handle handle{};
+
+        handle = observable.append_listener([&](int, int) {
+            ++calls;
+
+            // The notification in progress keeps calling the listeners it started with
+            observable.remove_listener(handle);
+            observable.append_listener([&appended_calls](int, int) {
+                ++appended_calls;
+            });
+        });
+
+        observable.notify(0, 0);
+        EXPECT_EQ(calls, 1);
+        EXPECT_EQ(appended_calls, 0);
+
+        observable.notify(0, 0);
+        EXPECT_EQ(calls, 1);
+        EXPECT_EQ(appended_calls, 1);
+    }
+
+    TEST(AtomicObservableTest, ConcurrentNotifyAndChanges)
+    {
+        TestObservable observable{};
+        std::atomic<int> calls{};
+        std::atomic<bool> stop{};
+
+        observable.append_listener([&calls](int, int) {
+            calls.fetch_add(1, std::memory_order_relaxed);
+        });
+
+        std::thread notifier{[&] {
+            while (!stop.load(std::memory_order_relaxed)) {
+                observable.notify(0, 0);
+            }
+        }};
+
+        for (auto i = 0; i < 1000; ++i) {
+            const auto handle = observable.append_listener([&calls](int, int) {
+                calls.fetch_add(1, std::memory_order_relaxed);
+            });
+
+            observable.remove_listener(handle);
+        }
+
+        stop.store(true, std::memory_order_relaxed);
+        notifier.join();
+
+        const auto calls_before = calls.load();
+        observable.notify(0, 0);
+        EXPECT_EQ(calls.load(), calls_before + 1);
+    }
+}
@@ -0,0 +1,165 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+
+#include "util/binary_log.hpp"
+#include "util/logger.hpp"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <variant>
+
+namespace {
+    class BinaryLogTest : public ::testing::Test {
+      protected:
+        void SetUp() override
+        {
+            std::filesystem::remove(path);
+        }
+
+        void TearDown() override
+        {
+            std::filesystem::remove(path);
+        }
+
+        template <typename... Args>
+        void write_event(Util::BinaryLogWriter& writer, const Util::LogLevel level, const std::string_view format,
+                         const Args&... args)
+        {
+            spdlog::memory_buf_t encoded_args{};
+            (Util::encode_binary_log_arg(encoded_args, args), ...);
+            writer.write_event(static_cast<int>(level), format, encoded_args, sizeof...(Args));
+        }
+
+        const std::string path{(std::filesystem::temp_directory_path() / "binary_log_test.hlbl").string()};
+    };
+
+    TEST_F(BinaryLogTest, RoundTrip)
+    {
+        {
+            Util::BinaryLogWriter writer{};
+            ASSERT_TRUE(writer.open(path));
+
+            write_event(writer, Util::LogLevel::info, "{} joined with {} ping\n", "Player", 42);
+            writer.write_text(static_cast<int>(Util::LogLevel::info), "engine text\n");
+            write_event(writer, Util::LogLevel::warn, "{:.1f} {} {} {}", 1.25, true, 'x', std::uint16_t{7});
+            write_event(writer, Util::LogLevel::info, "{} joined with {} ping\n", std::string{"Other"}, -1);
+        }
+
+        Util::BinaryLogReader reader{};
+        ASSERT_TRUE(reader.open(path));
+
+        Util::BinaryLogMessage message{};
+        ASSERT_TRUE(reader.next(message));
+        ASSERT_FALSE(message.is_text);
+        ASSERT_EQ(message.level, static_cast<int>(Util::LogLevel::info));
+        ASSERT_EQ(message.format, "{} joined with {} ping\n");
+        ASSERT_EQ(message.args.size(), 2);
+        ASSERT_EQ(std::get<std::string_view>(message.args[0]), "Player");
+        ASSERT_EQ(std::get<std::int64_t>(message.args[1]), 42);
+        ASSERT_EQ(message.format_message(), "Player joined with 42 ping\n");
+
+        ASSERT_TRUE(reader.next(message));
+        ASSERT_TRUE(message.is_text);
+        ASSERT_EQ(message.format_message(), "engine text\n");
+
+        ASSERT_TRUE(reader.next(message));
+        ASSERT_EQ(message.level, static_cast<int>(Util::LogLevel::warn));
+        ASSERT_EQ(message.format_message(), "1.2 true x 7");
+
+        // The format string is defined once and referenced by its ID afterwards
+        ASSERT_TRUE(reader.next(message));
+        ASSERT_EQ(message.format_message(), "Other joined with -1 ping\n");
+
+        ASSERT_FALSE(reader.next(message));
+        ASSERT_FALSE(reader.is_damaged());
+    }
+
+    TEST_F(BinaryLogTest, SessionsAreAppended)
+    {
+        for (int session = 0; session < 2; ++session) {
+            Util::BinaryLogWriter writer{};
+            ASSERT_TRUE(writer.open(path));
+            write_event(writer, Util::LogLevel::info, "session {}", session);
+        }
+
+        Util::BinaryLogReader reader{};
+        ASSERT_TRUE(reader.open(path));
+
+        Util::BinaryLogMessage message{};
+        ASSERT_TRUE(reader.next(message));
+        ASSERT_EQ(message.format_message(), "session 0");
+        ASSERT_TRUE(reader.next(message));
+        ASSERT_EQ(message.format_message(), "session 1");
+        ASSERT_FALSE(reader.next(message));
+    }
+
+    TEST_F(BinaryLogTest, TruncatedRecordIsReported)
+    {
+        {
+            Util::BinaryLogWriter writer{};
+            ASSERT_TRUE(writer.open(path));
+            write_event(writer, Util::LogLevel::info, "value {}", 1);
+            write_event(writer, Util::LogLevel::info, "value {}", 2);
+        }
+
+        std::filesystem::resize_file(path, std::filesystem::file_size(path) - 3);
+
+        Util::BinaryLogReader reader{};
+        ASSERT_TRUE(reader.open(path));
+
+        Util::BinaryLogMessage message{};
+        ASSERT_TRUE(reader.next(message));
+        ASSERT_EQ(message.format_message(), "value 1");
+        ASSERT_FALSE(reader.next(message));
+        ASSERT_TRUE(reader.is_damaged());
+    }
+
+    TEST_F(BinaryLogTest, TornRecordIsSkippedToNextSession)
+    {
+        {
+            Util::BinaryLogWriter writer{};
+            ASSERT_TRUE(writer.open(path));
+            write_event(writer, Util::LogLevel::info, "value {}", 1);
+            write_event(writer, Util::LogLevel::info, "value {}", 2);
+        }
+
+        // A crash while the last record was written, then a new session appended after it
+        std::filesystem::resize_file(path, std::filesystem::file_size(path) - 3);
+
+        {
+            Util::BinaryLogWriter writer{};
+            ASSERT_TRUE(writer.open(path));
+            write_event(writer, Util::LogLevel::info, "value {}", 3);
+        }
+
+        Util::BinaryLogReader reader{};
+        ASSERT_TRUE(reader.open(path));
+
+        Util::BinaryLogMessage message{};
+        ASSERT_TRUE(reader.next(message));
+        ASSERT_EQ(message.format_message(), "value 1");
+        ASSERT_TRUE(reader.next(message));
+        ASSERT_EQ(message.format_message(), "value 3");
+        ASSERT_FALSE(reader.next(message));
+        ASSERT_TRUE(reader.is_damaged());
+    }
+}
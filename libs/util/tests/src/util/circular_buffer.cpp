@@ -20,6 +20,9 @@
 
 #include "util/circular_buffer.hpp"
 #include <gtest/gtest.h>
+#include <array>
+#include <string>
+#include <vector>
 
 namespace {
     class CircularBufferTest : public ::testing::Test {
@@ -378,4 +381,146 @@ namespace {
         buffer.pop_back();
         ASSERT_EQ(const_buffer[0], 2);
     }
+
+    TEST(CircularBufferPowerOfTwoTest, Wraparound)
+    {
+        Util::CircularBuffer<int, 4> buffer{};
+        static_assert(Util::CircularBuffer<int, 4>::IS_POWER_OF_TWO);
+        static_assert(!Util::CircularBuffer<int, 3>::IS_POWER_OF_TWO);
+
+        for (auto i = 1; i <= 6; ++i) {
+            buffer.push_back(i);
+        }
+
+        ASSERT_TRUE(buffer.full());
+        ASSERT_EQ(buffer.front(), 3);
+        ASSERT_EQ(buffer.back(), 6);
+        ASSERT_EQ(buffer[3], 6);
+
+        buffer.push_front(2);
+        ASSERT_EQ(buffer.front(), 2);
+        ASSERT_EQ(buffer.back(), 5);
+
+        buffer.pop_back();
+        buffer.pop_front();
+        ASSERT_EQ(buffer.size(), 2);
+        ASSERT_EQ(buffer.front(), 3);
+        ASSERT_EQ(buffer.back(), 4);
+    }
+
+    TEST_F(CircularBufferTest, Segments)
+    {
+        // Test segments of an empty buffer
+        auto segments = buffer.get_segments();
+        ASSERT_EQ(segments[0].size + segments[1].size, 0);
+
+        buffer.push_back(1);
+        buffer.push_back(2);
+        segments = buffer.get_segments();
+        ASSERT_EQ(segments[0].size, 2);
+        ASSERT_EQ(segments[1].size, 0);
+        ASSERT_EQ(segments[0].data[1], 2);
+
+        // Test segments of a buffer wrapping around the end of the storage
+        buffer.push_back(3);
+        buffer.push_back(4);
+        const auto& const_buffer = buffer;
+        const auto const_segments = const_buffer.get_segments();
+        ASSERT_EQ(const_segments[0].size, 2);
+        ASSERT_EQ(const_segments[0].data[0], 2);
+        ASSERT_EQ(const_segments[0].data[1], 3);
+        ASSERT_EQ(const_segments[1].size, 1);
+        ASSERT_EQ(const_segments[1].data[0], 4);
+    }
+
+    TEST_F(CircularBufferTest, BulkPushBack)
+    {
+        const std::array<int, 5> items{1, 2, 3, 4, 5};
+
+        buffer.push_back(items.data(), 2);
+        ASSERT_EQ(buffer.size(), 2);
+        ASSERT_EQ(buffer.back(), 2);
+
+        // Test overwriting the front of the buffer
+        buffer.push_back(items.data() + 2, 2);
+        ASSERT_TRUE(buffer.full());
+        ASSERT_EQ(buffer[0], 2);
+        ASSERT_EQ(buffer[1], 3);
+        ASSERT_EQ(buffer[2], 4);
+
+        // Test inserting more elements than the buffer holds
+        buffer.push_back(items.data(), items.size());
+        ASSERT_TRUE(buffer.full());
+        ASSERT_EQ(buffer[0], 3);
+        ASSERT_EQ(buffer[1], 4);
+        ASSERT_EQ(buffer[2], 5);
+    }
+
+    TEST_F(CircularBufferTest, CopyTo)
+    {
+        std::array<int, 3> output{};
+
+        // Test copying from an empty buffer
+        ASSERT_EQ(buffer.copy_to(output.data(), output.size()), 0);
+
+        buffer.push_back(1);
+        buffer.push_back(2);
+        buffer.push_back(3);
+        buffer.push_back(4);
+
+        ASSERT_EQ(buffer.copy_to(output.data(), 2), 2);
+        ASSERT_EQ(output[0], 2);
+        ASSERT_EQ(output[1], 3);
+
+        ASSERT_EQ(buffer.copy_to(output.data(), output.size()), 3);
+        ASSERT_EQ(output[2], 4);
+    }
+
+    TEST_F(CircularBufferTest, Iterators)
+    {
+        // Test iterators of an empty buffer
+        ASSERT_EQ(buffer.begin(), buffer.end());
+        ASSERT_EQ(buffer.crbegin(), buffer.crend());
+
+        buffer.push_back(1);
+        buffer.push_back(2);
+        buffer.push_back(3);
+        buffer.push_back(4);
+
+        ASSERT_EQ(std::vector<int>(buffer.cbegin(), buffer.cend()), (std::vector<int>{2, 3, 4}));
+        ASSERT_EQ(std::vector<int>(buffer.crbegin(), buffer.crend()), (std::vector<int>{4, 3, 2}));
+
+        for (auto& item : buffer) {
+            item *= 10;
+        }
+
+        ASSERT_EQ(std::vector<int>(buffer.rbegin(), buffer.rend()), (std::vector<int>{40, 30, 20}));
+
+        const auto& const_buffer = buffer;
+        ASSERT_EQ(std::vector<int>(const_buffer.rbegin(), const_buffer.rend()), (std::vector<int>{40, 30, 20}));
+    }
+
+    TEST_F(CircularBufferTestString, EmplaceInPlace)
+    {
+        buffer.emplace_back(3, 'a');
+        buffer.emplace_back("bb");
+        buffer.emplace_front(std::string{"c"});
+        buffer.emplace_back(2, 'd');
+
+        ASSERT_EQ(std::vector<std::string>(buffer.cbegin(), buffer.cend()),
+          (std::vector<std::string>{"aaa", "bb", "dd"}));
+    }
+
+    TEST_F(CircularBufferTestString, EmplaceFromOverwrittenElement)
+    {
+        buffer.push_back("first element");
+        buffer.push_back("b");
+        buffer.push_back("c");
+
+        // The new element replaces the front one it is constructed from
+        buffer.emplace_back(buffer.front(), 6);
+
+        ASSERT_EQ(std::vector<std::string>(buffer.cbegin(), buffer.cend()),
+          (std::vector<std::string>{"b", "c", "element"}));
+    }
 }
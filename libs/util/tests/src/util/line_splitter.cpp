@@ -0,0 +1,79 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+
+#include "util/line_splitter.hpp"
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+namespace {
+    std::vector<std::string> split(Util::LineSplitter& splitter, const std::vector<std::string>& chunks)
+    {
+        std::vector<std::string> lines{};
+        const auto on_line = [&lines](const std::string_view line) { lines.emplace_back(line); };
+
+        for (const auto& chunk : chunks) {
+            splitter.feed(chunk, on_line);
+        }
+
+        splitter.finish(on_line);
+
+        return lines;
+    }
+
+    TEST(LineSplitterTest, FindNewline)
+    {
+        std::string data(100, 'x');
+
+        for (std::size_t i = 0; i < data.size(); ++i) {
+            data[i] = '\n';
+            ASSERT_EQ(Util::LineSplitter::find_newline(data.data(), data.data() + data.size()), data.data() + i);
+            data[i] = 'x';
+        }
+
+        ASSERT_EQ(Util::LineSplitter::find_newline(data.data(), data.data() + data.size()), data.data() + data.size());
+    }
+
+    TEST(LineSplitterTest, SplitLines)
+    {
+        Util::LineSplitter splitter{};
+        const auto lines = split(splitter, {"status\nsay hello\r\n\nmap de_dust2\n"});
+
+        ASSERT_EQ(lines, (std::vector<std::string>{"status", "say hello", "map de_dust2"}));
+    }
+
+    TEST(LineSplitterTest, LinesAcrossChunks)
+    {
+        Util::LineSplitter splitter{};
+        const auto lines = split(splitter, {"sta", "tus\nsay hel", "lo", "\r", "\nquit"});
+
+        ASSERT_EQ(lines, (std::vector<std::string>{"status", "say hello", "quit"}));
+    }
+
+    TEST(LineSplitterTest, LongLinesAreDropped)
+    {
+        Util::LineSplitter splitter{8};
+        const auto lines = split(splitter, {"12345678\n123456789\nshort\n1234", "56789", "0\nlast\r\n"});
+
+        ASSERT_EQ(lines, (std::vector<std::string>{"12345678", "short", "last"}));
+        ASSERT_EQ(splitter.get_dropped(), 2);
+    }
+}
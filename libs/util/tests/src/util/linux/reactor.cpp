@@ -0,0 +1,138 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+
+#include "util/linux/reactor.hpp"
+#include <gtest/gtest.h>
+#include <sys/epoll.h>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <future>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+    using namespace std::chrono_literals;
+
+    class ReactorTest : public ::testing::Test {
+      protected:
+        void SetUp() override
+        {
+            ASSERT_TRUE(reactor.start());
+        }
+
+        Util::Reactor reactor{};
+    };
+
+    TEST_F(ReactorTest, DispatchesDescriptorEvents)
+    {
+        int fds[2];
+        ASSERT_EQ(::pipe(fds), 0);
+
+        std::promise<char> received{};
+        ASSERT_TRUE(reactor.add(fds[0], EPOLLIN, [&](const std::uint32_t events) {
+            char data = 0;
+            ASSERT_NE(events & EPOLLIN, 0U);
+            ASSERT_EQ(::read(fds[0], &data, 1), 1);
+            received.set_value(data);
+        }));
+
+        ASSERT_EQ(::write(fds[1], "x", 1), 1);
+        auto future = received.get_future();
+        ASSERT_EQ(future.wait_for(5s), std::future_status::ready);
+        ASSERT_EQ(future.get(), 'x');
+
+        reactor.remove(fds[0]);
+        ::close(fds[0]);
+        ::close(fds[1]);
+    }
+
+    TEST_F(ReactorTest, RunsPostedCallbacksOnReactorThread)
+    {
+        std::promise<bool> on_reactor{};
+        reactor.post([&] {
+            on_reactor.set_value(reactor.is_reactor_thread());
+        });
+
+        auto future = on_reactor.get_future();
+        ASSERT_EQ(future.wait_for(5s), std::future_status::ready);
+        ASSERT_TRUE(future.get());
+        ASSERT_FALSE(reactor.is_reactor_thread());
+    }
+
+    TEST_F(ReactorTest, TimerFiresUntilRemoved)
+    {
+        std::atomic<int> expirations{};
+        const auto timer = reactor.add_timer(1ms, [&] {
+            ++expirations;
+        });
+
+        ASSERT_GE(timer, 0);
+
+        for (auto i = 0; i < 500 && expirations < 3; ++i) {
+            std::this_thread::sleep_for(10ms);
+        }
+
+        reactor.remove_timer(timer);
+        const auto count = expirations.load();
+        std::this_thread::sleep_for(20ms);
+
+        ASSERT_GE(count, 3);
+        ASSERT_EQ(expirations, count);
+    }
+
+    TEST_F(ReactorTest, RemoveWaitsForRunningHandler)
+    {
+        int fds[2];
+        ASSERT_EQ(::pipe(fds), 0);
+
+        std::atomic<bool> entered{};
+        std::atomic<bool> finished{};
+        ASSERT_TRUE(reactor.add(fds[0], EPOLLIN, [&](std::uint32_t) {
+            entered = true;
+            std::this_thread::sleep_for(50ms);
+            finished = true;
+        }));
+
+        ASSERT_EQ(::write(fds[1], "x", 1), 1);
+
+        while (!entered) {
+            std::this_thread::yield();
+        }
+
+        reactor.remove(fds[0]);
+        ASSERT_TRUE(finished);
+
+        ::close(fds[0]);
+        ::close(fds[1]);
+    }
+
+    TEST_F(ReactorTest, HandlesSignals)
+    {
+        std::promise<void> received{};
+        ASSERT_TRUE(reactor.add_signal(SIGUSR1, [&] {
+            received.set_value();
+        }));
+
+        ASSERT_EQ(::kill(::getpid(), SIGUSR1), 0);
+        ASSERT_EQ(received.get_future().wait_for(5s), std::future_status::ready);
+    }
+}
@@ -0,0 +1,106 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+
+#include "util/log_limiter.hpp"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+    class LogLimiterTest : public ::testing::Test {
+      protected:
+        [[nodiscard]] Util::LogLimiter create_limiter(const std::size_t burst, const double rate)
+        {
+            Util::LogRateLimitSettings settings{};
+            settings.burst = burst;
+            settings.rate = rate;
+            settings.report_interval = std::chrono::seconds{10};
+
+            return Util::LogLimiter{settings, [this](Util::LogLevel, const std::string_view message) {
+                                        reports.emplace_back(message);
+                                    },
+                                    start};
+        }
+
+        std::vector<std::string> reports{};
+        const Util::LogLimiter::Clock::time_point start{Util::LogLimiter::Clock::now()};
+    };
+
+    TEST_F(LogLimiterTest, BurstThenRate)
+    {
+        auto limiter = create_limiter(3, 1.0);
+        auto allowed = 0;
+
+        for (auto i = 0; i < 10; ++i) {
+            const std::string args(1, static_cast<char>('0' + i));
+            allowed += limiter.allow(Util::LogLevel::warn, "value {}", args, start) ? 1 : 0;
+        }
+
+        ASSERT_EQ(allowed, 3);
+        ASSERT_EQ(limiter.get_suppressed(), 7);
+
+        // One token is refilled per second
+        ASSERT_TRUE(limiter.allow(Util::LogLevel::warn, "value {}", "a", start + std::chrono::seconds{1}));
+        ASSERT_FALSE(limiter.allow(Util::LogLevel::warn, "value {}", "b", start + std::chrono::seconds{1}));
+
+        // Other format strings have their own buckets
+        ASSERT_TRUE(limiter.allow(Util::LogLevel::warn, "other {}", "a", start + std::chrono::seconds{1}));
+
+        ASSERT_TRUE(reports.empty());
+        limiter.report(false, start + std::chrono::seconds{10});
+        ASSERT_EQ(reports, std::vector<std::string>{"Suppressed 8 messages: value {}"});
+    }
+
+    TEST_F(LogLimiterTest, RepeatsAreCollapsed)
+    {
+        auto limiter = create_limiter(100, 10.0);
+
+        ASSERT_TRUE(limiter.allow(Util::LogLevel::warn, "value {}", "1", start));
+
+        for (auto i = 0; i < 5; ++i) {
+            ASSERT_FALSE(limiter.allow(Util::LogLevel::warn, "value {}", "1", start));
+        }
+
+        ASSERT_TRUE(reports.empty());
+        ASSERT_TRUE(limiter.allow(Util::LogLevel::warn, "value {}", "2", start));
+        ASSERT_EQ(reports, std::vector<std::string>{"Message repeated 5 times: value {}"});
+    }
+
+    TEST_F(LogLimiterTest, ReportAfterInterval)
+    {
+        auto limiter = create_limiter(100, 10.0);
+
+        ASSERT_TRUE(limiter.allow(Util::LogLevel::warn, "value {}", "1", start));
+        ASSERT_FALSE(limiter.allow(Util::LogLevel::warn, "value {}", "1", start));
+
+        limiter.report(false, start + std::chrono::seconds{1});
+        ASSERT_TRUE(reports.empty());
+
+        limiter.report(false, start + std::chrono::seconds{10});
+        ASSERT_EQ(reports, std::vector<std::string>{"Message repeated 1 times: value {}"});
+
+        // Nothing is reported twice
+        limiter.report(true, start + std::chrono::seconds{20});
+        ASSERT_EQ(reports.size(), 1);
+    }
+}
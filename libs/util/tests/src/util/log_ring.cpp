@@ -0,0 +1,139 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+
+#include "util/log_ring.hpp"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    TEST(LogRingTest, ReadInOrder)
+    {
+        Util::LogRing ring{4};
+        Util::LogRing::Reader reader{ring};
+        std::string message{};
+
+        ASSERT_FALSE(reader.read(message));
+
+        ring.write("first\n");
+        ring.write("second\n");
+
+        ASSERT_TRUE(reader.read(message));
+        ASSERT_EQ(message, "first\n");
+        ASSERT_TRUE(reader.read(message));
+        ASSERT_EQ(message, "second\n");
+        ASSERT_FALSE(reader.read(message));
+        ASSERT_EQ(reader.take_lost(), 0);
+    }
+
+    TEST(LogRingTest, ReadersHaveOwnCursors)
+    {
+        Util::LogRing ring{4};
+        ring.write("old");
+
+        Util::LogRing::Reader backlog_reader{ring};
+        Util::LogRing::Reader live_reader{ring, false};
+        ring.write("new");
+
+        std::string message{};
+        ASSERT_TRUE(backlog_reader.read(message));
+        ASSERT_EQ(message, "old");
+        ASSERT_TRUE(live_reader.read(message));
+        ASSERT_EQ(message, "new");
+        ASSERT_TRUE(backlog_reader.read(message));
+        ASSERT_EQ(message, "new");
+    }
+
+    TEST(LogRingTest, OverrunIsCounted)
+    {
+        Util::LogRing ring{4};
+        Util::LogRing::Reader reader{ring};
+
+        for (auto i = 0; i < 10; ++i) {
+            ring.write(std::to_string(i));
+        }
+
+        std::string message{};
+        ASSERT_TRUE(reader.read(message));
+        ASSERT_EQ(message, "6");
+        ASSERT_EQ(reader.take_lost(), 6);
+        ASSERT_EQ(reader.take_lost(), 0);
+    }
+
+    TEST(LogRingTest, LongMessageIsTruncated)
+    {
+        Util::LogRing ring{2};
+        Util::LogRing::Reader reader{ring};
+        ring.write(std::string(1000, 'x') + "\n");
+
+        std::string message{};
+        ASSERT_TRUE(reader.read(message));
+        ASSERT_EQ(message.size(), Util::LogRing::MAX_MESSAGE_SIZE);
+        ASSERT_EQ(message.back(), '\n');
+    }
+
+    TEST(LogRingTest, ConcurrentReadersSeeOrderedMessages)
+    {
+        constexpr std::uint64_t message_count = 100'000;
+        Util::LogRing ring{64};
+        std::atomic_bool done{};
+        std::vector<std::thread> readers{};
+
+        for (auto i = 0; i < 3; ++i) {
+            readers.emplace_back([&ring, &done, message_count] {
+                Util::LogRing::Reader reader{ring};
+                std::string message{};
+                std::uint64_t last{};
+                auto has_last = false;
+
+                auto finished = false;
+
+                while (!finished) {
+                    finished = done.load();
+
+                    while (reader.read(message)) {
+                        const auto value = std::stoull(message);
+                        EXPECT_TRUE(!has_last || value > last);
+                        last = value;
+                        has_last = true;
+                    }
+                }
+
+                EXPECT_EQ(last, message_count - 1);
+            });
+        }
+
+        for (std::uint64_t i = 0; i < message_count; ++i) {
+            ring.write(std::to_string(i));
+        }
+
+        done.store(true);
+
+        for (auto& reader : readers) {
+            reader.join();
+        }
+
+        ASSERT_EQ(ring.get_head(), message_count);
+    }
+}
@@ -0,0 +1,118 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+
+#include "util/mpmc_ring.hpp"
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    TEST(MpmcRingTest, Capacity)
+    {
+        ASSERT_EQ(Util::MpmcRing<int>{1}.capacity(), 2);
+        ASSERT_EQ(Util::MpmcRing<int>{5}.capacity(), 8);
+        ASSERT_EQ(Util::MpmcRing<int>{8}.capacity(), 8);
+    }
+
+    TEST(MpmcRingTest, PushPop)
+    {
+        Util::MpmcRing<std::string> ring{4};
+        ASSERT_TRUE(ring.empty());
+
+        for (int i = 0; i < 4; ++i) {
+            auto value = std::to_string(i);
+            ASSERT_TRUE(ring.try_push(value));
+        }
+
+        // The element is left untouched when the queue is full
+        std::string value{"full"};
+        ASSERT_FALSE(ring.try_push(value));
+        ASSERT_EQ(value, "full");
+
+        for (int i = 0; i < 4; ++i) {
+            ASSERT_TRUE(ring.try_pop(value));
+            ASSERT_EQ(value, std::to_string(i));
+        }
+
+        ASSERT_TRUE(ring.empty());
+        ASSERT_FALSE(ring.try_pop(value));
+    }
+
+    TEST(MpmcRingTest, WrapAround)
+    {
+        Util::MpmcRing<int> ring{2};
+
+        for (int i = 0; i < 10; ++i) {
+            auto value = i;
+            ASSERT_TRUE(ring.try_push(value));
+            ASSERT_TRUE(ring.try_pop(value));
+            ASSERT_EQ(value, i);
+        }
+    }
+
+    TEST(MpmcRingTest, ConcurrentProducersAndConsumers)
+    {
+        constexpr int thread_count = 4;
+        constexpr int values_per_thread = 10000;
+
+        Util::MpmcRing<int> ring{64};
+        std::vector<std::thread> threads{};
+        std::vector<long long> sums(thread_count);
+
+        for (int i = 0; i < thread_count; ++i) {
+            threads.emplace_back([&ring, i] {
+                for (int j = 1; j <= values_per_thread; ++j) {
+                    for (auto value = j; !ring.try_push(value);) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+
+            threads.emplace_back([&ring, &sums, i] {
+                for (int j = 0; j < values_per_thread; ++j) {
+                    int value{};
+
+                    while (!ring.try_pop(value)) {
+                        std::this_thread::yield();
+                    }
+
+                    sums[static_cast<std::size_t>(i)] += value;
+                }
+            });
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        long long total{};
+
+        for (const auto sum : sums) {
+            total += sum;
+        }
+
+        constexpr long long expected = static_cast<long long>(values_per_thread) * (values_per_thread + 1) / 2;
+        ASSERT_EQ(total, expected * thread_count);
+        ASSERT_TRUE(ring.empty());
+    }
+}
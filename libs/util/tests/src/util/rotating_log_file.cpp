@@ -0,0 +1,129 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+
+#include "util/rotating_log_file.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+    class RotatingLogFileTest : public ::testing::Test {
+      protected:
+        void SetUp() override
+        {
+            std::filesystem::remove_all(directory);
+        }
+
+        void TearDown() override
+        {
+            std::filesystem::remove_all(directory);
+        }
+
+        [[nodiscard]] std::vector<std::string> get_segments() const
+        {
+            std::vector<std::string> segments{};
+
+            for (const auto& entry : std::filesystem::directory_iterator{directory}) {
+                if (entry.path().filename() != "qconsole.log") {
+                    segments.push_back(entry.path().filename().string());
+                }
+            }
+
+            return segments;
+        }
+
+        const std::filesystem::path directory{std::filesystem::temp_directory_path() / "rotating_log_file_test"};
+        const std::string path{(directory / "qconsole.log").string()};
+    };
+
+    TEST_F(RotatingLogFileTest, AppendsWithoutRotation)
+    {
+        {
+            Util::RotatingLogFile file{path, Util::LogRotationSettings{}};
+            ASSERT_TRUE(file.open());
+            file.write("first\n");
+        }
+
+        {
+            Util::RotatingLogFile file{path, Util::LogRotationSettings{}};
+            ASSERT_TRUE(file.open());
+            file.write("second\n");
+        }
+
+        std::ifstream stream{path};
+        const std::string content{std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{}};
+
+        ASSERT_EQ(content, "first\nsecond\n");
+        ASSERT_TRUE(get_segments().empty());
+    }
+
+    TEST_F(RotatingLogFileTest, RotatesBySizeAndKeepsNewestSegments)
+    {
+        Util::LogRotationSettings settings{};
+        settings.max_size = 64;
+        settings.max_files = 2;
+        settings.compress = false;
+
+        // The file is rotated in the background, the writes only switch to the new file once it is open
+        for (int i = 0; i < 5; ++i) {
+            Util::RotatingLogFile file{path, settings};
+            ASSERT_TRUE(file.open());
+            file.write(std::string(64, static_cast<char>('a' + i)) + "\n");
+        }
+
+        const auto segments = get_segments();
+        ASSERT_EQ(segments.size(), 2);
+        ASSERT_TRUE(std::filesystem::exists(path));
+        ASSERT_EQ(std::filesystem::file_size(path), 0);
+
+        // Only the last two rotated segments are kept
+        std::vector<std::string> contents{};
+
+        for (const auto& segment : segments) {
+            std::ifstream stream{directory / segment};
+            contents.emplace_back(std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{});
+        }
+
+        std::sort(contents.begin(), contents.end());
+        ASSERT_EQ(contents[0], std::string(64, 'd') + "\n");
+        ASSERT_EQ(contents[1], std::string(64, 'e') + "\n");
+    }
+
+    TEST_F(RotatingLogFileTest, CompressesRotatedSegments)
+    {
+        Util::LogRotationSettings settings{};
+        settings.max_size = 16;
+
+        {
+            Util::RotatingLogFile file{path, settings};
+            ASSERT_TRUE(file.open());
+            file.write("a line long enough to rotate\n");
+        }
+
+        const auto segments = get_segments();
+        ASSERT_EQ(segments.size(), 1);
+        ASSERT_EQ(std::filesystem::path{segments.front()}.extension(), ".gz");
+    }
+}
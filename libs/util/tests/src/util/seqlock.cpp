@@ -0,0 +1,88 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+
+#include "util/seqlock.hpp"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+namespace {
+    struct Sample {
+        std::uint32_t first{};
+        double second{};
+        char text[13]{};
+        std::uint32_t last{};
+    };
+
+    TEST(SeqLockTest, InitialValue)
+    {
+        const Util::SeqLock<Sample> lock{};
+        const auto value = lock.load();
+
+        ASSERT_EQ(value.first, 0);
+        ASSERT_EQ(value.last, 0);
+        ASSERT_EQ(lock.get_version(), 0);
+    }
+
+    TEST(SeqLockTest, StoreLoad)
+    {
+        Util::SeqLock<Sample> lock{};
+        lock.store({1, 2.5, "hello world!", 3});
+
+        const auto value = lock.load();
+        ASSERT_EQ(value.first, 1);
+        ASSERT_DOUBLE_EQ(value.second, 2.5);
+        ASSERT_STREQ(value.text, "hello world!");
+        ASSERT_EQ(value.last, 3);
+        ASSERT_EQ(lock.get_version(), 1);
+    }
+
+    TEST(SeqLockTest, ReadsAreNeverTorn)
+    {
+        constexpr std::uint32_t num_stores = 200'000;
+        Util::SeqLock<Sample> lock{};
+        std::atomic<bool> done{};
+
+        std::thread writer{[&lock, &done] {
+            for (std::uint32_t i = 1; i <= num_stores; ++i) {
+                lock.store({i, static_cast<double>(i), {}, i});
+            }
+
+            done = true;
+        }};
+
+        std::uint32_t previous = 0;
+
+        while (!done.load()) {
+            const auto value = lock.load();
+
+            // Every field is written with the same number, and the numbers only grow
+            ASSERT_EQ(value.first, value.last);
+            ASSERT_EQ(static_cast<double>(value.first), value.second);
+            ASSERT_GE(value.first, previous);
+            previous = value.first;
+        }
+
+        writer.join();
+        ASSERT_EQ(lock.load().last, num_stores);
+    }
+}
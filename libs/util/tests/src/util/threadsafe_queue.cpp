@@ -0,0 +1,185 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+#include "util/threadsafe_queue.hpp"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    TEST(ThreadSafeQueueTest, PopMovesElement)
+    {
+        Util::ThreadSafeQueue<std::unique_ptr<int>> queue{};
+        queue.push(std::make_unique<int>(1));
+        queue.emplace(std::make_unique<int>(2));
+
+        ASSERT_EQ(*queue.pop(), 1);
+
+        std::unique_ptr<int> item{};
+        ASSERT_TRUE(queue.try_pop(item));
+        ASSERT_EQ(*item, 2);
+
+        // The element is left untouched when the queue is empty
+        ASSERT_FALSE(queue.try_pop(item));
+        ASSERT_EQ(*item, 2);
+    }
+
+    TEST(ThreadSafeQueueTest, PopWaitsForPush)
+    {
+        Util::ThreadSafeQueue<int> queue{};
+
+        std::thread producer{[&queue] {
+            std::this_thread::sleep_for(std::chrono::milliseconds{20});
+            queue.push(42);
+        }};
+
+        ASSERT_EQ(queue.pop(), 42);
+        producer.join();
+    }
+
+    TEST(ThreadSafeQueueTest, PopFor)
+    {
+        Util::ThreadSafeQueue<std::string> queue{};
+        std::string item{"untouched"};
+
+        ASSERT_FALSE(queue.pop_for(item, std::chrono::milliseconds{10}));
+        ASSERT_EQ(item, "untouched");
+
+        std::thread producer{[&queue] {
+            std::this_thread::sleep_for(std::chrono::milliseconds{20});
+            queue.emplace("pushed");
+        }};
+
+        ASSERT_TRUE(queue.pop_for(item, std::chrono::seconds{10}));
+        ASSERT_EQ(item, "pushed");
+        producer.join();
+    }
+
+    TEST(ThreadSafeQueueTest, DrainInto)
+    {
+        Util::ThreadSafeQueue<int> queue{};
+        std::vector<int> items{0};
+
+        ASSERT_EQ(queue.drain_into(items), 0);
+
+        for (int i = 1; i <= 3; ++i) {
+            queue.push(i);
+        }
+
+        ASSERT_EQ(queue.drain_into(items), 3);
+        ASSERT_EQ(items, (std::vector<int>{0, 1, 2, 3}));
+        ASSERT_TRUE(queue.empty());
+    }
+
+    TEST(ThreadSafeQueueTest, BoundedCapacity)
+    {
+        Util::ThreadSafeQueue<int> queue{};
+        queue.set_capacity(2);
+        ASSERT_EQ(queue.get_capacity(), 2);
+
+        ASSERT_TRUE(queue.try_push(1));
+        ASSERT_TRUE(queue.try_push(2));
+        ASSERT_FALSE(queue.try_push(3));
+
+        // The producer waits until the consumer makes room
+        std::thread producer{[&queue] {
+            queue.push(3);
+            queue.push(4);
+        }};
+
+        std::vector<int> items{};
+
+        while (items.size() < 4) {
+            int item{};
+
+            if (queue.pop_for(item, std::chrono::seconds{10})) {
+                items.push_back(item);
+            }
+
+            ASSERT_LE(queue.size(), 2);
+        }
+
+        producer.join();
+        ASSERT_EQ(items, (std::vector<int>{1, 2, 3, 4}));
+    }
+
+    TEST(ThreadSafeQueueTest, CopyAndMoveKeepCapacity)
+    {
+        Util::ThreadSafeQueue<int> queue{};
+        queue.set_capacity(1);
+        ASSERT_TRUE(queue.try_push(1));
+
+        Util::ThreadSafeQueue<int> copy{queue};
+        ASSERT_EQ(copy.get_capacity(), 1);
+        ASSERT_FALSE(copy.try_push(2));
+
+        Util::ThreadSafeQueue<int> moved{std::move(copy)};
+        ASSERT_EQ(moved.get_capacity(), 1);
+        ASSERT_FALSE(moved.try_push(2));
+
+        Util::ThreadSafeQueue<int> allocated{queue, std::allocator<int>{}};
+        ASSERT_EQ(allocated.get_capacity(), 1);
+    }
+
+    TEST(ThreadSafeQueueTest, ConcurrentProducers)
+    {
+        constexpr int thread_count = 4;
+        constexpr int values_per_thread = 10000;
+
+        Util::ThreadSafeQueue<int> queue{};
+        queue.set_capacity(64);
+        std::vector<std::thread> producers{};
+
+        for (int thread = 0; thread < thread_count; ++thread) {
+            producers.emplace_back([&queue] {
+                for (int i = 1; i <= values_per_thread; ++i) {
+                    queue.push(i);
+                }
+            });
+        }
+
+        long long sum = 0;
+        std::vector<int> items{};
+
+        for (int received = 0; received < thread_count * values_per_thread;) {
+            items.clear();
+
+            if (queue.drain_into(items) == 0) {
+                sum += queue.pop();
+                ++received;
+            }
+
+            for (const auto item : items) {
+                sum += item;
+            }
+
+            received += static_cast<int>(items.size());
+        }
+
+        for (auto& producer : producers) {
+            producer.join();
+        }
+
+        ASSERT_EQ(sum, static_cast<long long>(thread_count) * values_per_thread * (values_per_thread + 1) / 2);
+    }
+}
@@ -77,5 +77,17 @@ namespace View {
          * @param map The name of the current map on the server.
          */
         virtual void display_server_status(float fps, int num_players, int max_players, const std::string& map) = 0;
+
+        /**
+         * @brief Displays the frame rate and frame times of the server loop.
+         *
+         * Called before \c display_server_status with the figures of the same status update.
+         *
+         * @param fps The number of frames per second achieved by the server loop.
+         * @param median_ms The median frame time, in milliseconds.
+         * @param p99_ms The 99th percentile of the frame times, in milliseconds.
+         * @param max_ms The longest frame time, in milliseconds.
+         */
+        virtual void display_frame_times(float fps, float median_ms, float p99_ms, float max_ms) = 0;
     };
 }
@@ -20,11 +20,22 @@
 
 #pragma once
 
+#include "view/line_renderer.hpp"
 #include <atomic>
 #include <memory>
 #include <optional>
 #include <string>
-#include <thread>
+#include <string_view>
+
+#ifdef _WIN32
+  #include <thread>
+#else
+  #include "util/line_splitter.hpp"
+  #include "view/linux/terminal_settings.hpp"
+  #include "view/linux/tty_redirect.hpp"
+  #include <cstdint>
+  #include <vector>
+#endif
 
 namespace Presenter {
     class InputPresenter;
@@ -66,12 +77,14 @@ namespace View {
         ~ConsoleInput();
 
         /**
-         * @brief Starts the input worker thread.
+         * @brief Starts reading the console input.
+         *
+         * On Linux the input is read by the launcher reactor, on Windows by a worker thread.
          */
         void start();
 
         /**
-         * @brief Stops the input worker thread.
+         * @brief Stops reading the console input.
          */
         void stop();
 
@@ -79,11 +92,34 @@ namespace View {
         /// A shared pointer to an \c Presenter::InputPresenter
         InputPresenterPtr input_presenter_;
 
-        /// Indicates whether the input worker thread is running.
+        /// Indicates whether the console input is running.
         std::atomic<bool> running_{};
 
+#ifdef _WIN32
         /// The input worker thread.
         std::thread input_thread_{};
+#else
+        /// The state of an escape sequence being received from the terminal.
+        enum class EscapeState { none, escape, control, delete_key };
+
+        /// Disables the canonical mode and the echo while the input is read from a terminal.
+        std::optional<ScopedTerminalSettings> terminal_settings_{};
+
+        /// Redirects \c std::cout to the terminal while the input is read from it.
+        std::optional<ScopedTtyRedirect> tty_redirect_{};
+
+        /// Splits the input into lines when the standard input is not a terminal.
+        Util::LineSplitter splitter_{};
+
+        /// The number of lines dropped by the splitter that have been reported.
+        std::uint64_t dropped_lines_{};
+
+        /// The buffer the input is read into.
+        std::vector<char> read_buffer_{};
+
+        /// The state of the escape sequence being received.
+        EscapeState escape_state_{};
+#endif
 
         /// The current input line.
         std::string input_line_{};
@@ -94,9 +130,18 @@ namespace View {
         /// The current cursor position in the input line.
         std::string::size_type cursor_position_{};
 
+        /// Computes the terminal output for the edits of the input line.
+        LineRenderer renderer_;
+
 #ifndef _WIN32
-        /// Handles ANSI escape codes.
-        void handle_escape();
+        /// Reads the available input, returns \c false once the input has ended (runs on the reactor thread).
+        bool read_available_input();
+
+        /// Handles a character received from the terminal, including the ANSI escape codes.
+        void handle_terminal_char(char ch);
+
+        /// Enqueues the complete lines of a standard input that is not a terminal, without line editing.
+        void handle_piped_input(std::string_view input, bool finished);
 #endif
         /// Handles the up arrow key.
         void handle_up_arrow();
@@ -131,10 +176,15 @@ namespace View {
         /// Handles a character input.
         void handle_char(std::string::value_type ch);
 
+#ifdef _WIN32
         /// Reads input from the console (runs in a separate thread).
         void read_input();
+#endif
+
+        /// Displays the current input line and cursor position with a single write.
+        void refresh_line();
 
-        /// Clears the current input line from the console.
-        void clear_input();
+        /// Writes the output to the console with a single write.
+        static void write_output(std::string_view output);
     };
 }
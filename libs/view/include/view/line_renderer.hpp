@@ -0,0 +1,85 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace View {
+    /**
+     * @brief Computes the terminal output that turns the displayed input line into a new one.
+     *
+     * The renderer remembers what is on the screen and produces, for each edit, the shortest sequence it
+     * knows of: the cursor is moved to the first changed character, the changed tail is rewritten and the
+     * leftover characters are erased. The caller writes the sequence with a single write, so a keystroke
+     * costs one system call however long the line is. Without ANSI support, the cursor is moved with
+     * backspaces and the leftover characters are overwritten with spaces.
+     */
+    class LineRenderer final {
+      public:
+        /**
+         * @brief Constructs a new LineRenderer object.
+         *
+         * @param use_ansi Whether the terminal understands the ANSI cursor movement and erase sequences.
+         */
+        explicit LineRenderer(bool use_ansi) noexcept;
+
+        /**
+         * @brief Computes the output that displays the line with the cursor at the given position.
+         *
+         * @param line The new input line.
+         * @param cursor The new cursor position in the line.
+         *
+         * @return The output to write, valid until the next call.
+         */
+        [[nodiscard]] std::string_view update(std::string_view line, std::size_t cursor);
+
+        /**
+         * @brief Computes the output that erases the displayed line and leaves the cursor at its start.
+         *
+         * @return The output to write, valid until the next call.
+         */
+        [[nodiscard]] std::string_view clear();
+
+        /**
+         * @brief Forgets the displayed line, after the cursor was moved to a new line by other output.
+         */
+        void reset() noexcept;
+
+      private:
+        /// Appends the movement of the cursor from its current position to the given one.
+        void move_cursor(std::size_t position);
+
+        /// Whether the terminal understands the ANSI sequences.
+        const bool use_ansi_;
+
+        /// The line on the screen.
+        std::string displayed_{};
+
+        /// The cursor position on the screen.
+        std::size_t cursor_{};
+
+        /// The output of the last update.
+        std::string output_{};
+    };
+}
@@ -20,9 +20,14 @@
 
 #pragma once
 
+#include "util/linux/output_capture.hpp"
 #include "util/log_output.hpp"
 #include "view/base_view.hpp"
+#include "view/linux/status_line.hpp"
 #include <fmt/core.h>
+#include <algorithm>
+#include <cstring>
+#include <string>
 
 namespace View {
     class ConsoleView final : public BaseView, public Util::LogOutput {
@@ -46,22 +51,78 @@ namespace View {
          */
         void display_server_status(float fps, int num_players, int max_players, const std::string& map) override;
 
+        /**
+         * @brief Displays the frame rate and frame times of the server loop.
+         *
+         * @param fps The number of frames per second achieved by the server loop.
+         * @param median_ms The median frame time, in milliseconds.
+         * @param p99_ms The 99th percentile of the frame times, in milliseconds.
+         * @param max_ms The longest frame time, in milliseconds.
+         */
+        void display_frame_times(float fps, float median_ms, float p99_ms, float max_ms) override;
+
         /**
          * @brief Write a log message to the console.
          *
          * @param message The formatted log message to be written.
          */
         void write_log(std::string_view message) override;
+
+        /**
+         * @brief Writes the captured output still waiting for the terminal.
+         */
+        void flush() override;
+
+        /**
+         * @brief Starts drawing the server status on the top row of the terminal.
+         *
+         * @return \c true if the status is drawn, \c false if the output is not a terminal.
+         */
+        bool start_status_line();
+
+        /**
+         * @brief Stops drawing the server status.
+         */
+        void stop_status_line();
+
+      private:
+        /// The figures of the status update being received, only used by the server thread.
+        StatusLine::Snapshot status_{};
+
+        /// Draws the server status.
+        StatusLine status_line_{*this};
     };
 
     inline void ConsoleView::display_server_status(
-      const float /* fps */, const int /* num_players */, const int /* max_players */, const std::string& /* map */)
+      const float /* fps */, const int num_players, const int max_players, const std::string& map)
     {
-        // No implementation on Linux
+        // The frame rate measured by the launcher is shown rather than the one of the engine
+        status_.num_players = num_players;
+        status_.max_players = max_players;
+
+        const auto map_length = std::min(::strnlen(map.c_str(), map.size()), sizeof(status_.map) - 1);
+        map.copy(status_.map, map_length);
+        status_.map[map_length] = '\0';
+
+        status_line_.publish(status_);
+    }
+
+    inline void ConsoleView::display_frame_times(
+      const float fps, const float median_ms, const float p99_ms, const float max_ms)
+    {
+        status_.fps = fps;
+        status_.median_ms = median_ms;
+        status_.p99_ms = p99_ms;
+        status_.max_ms = max_ms;
     }
 
     inline int ConsoleView::print(const std::string_view text)
     {
+        // Handed to the writer thread while the output is captured, a slow terminal does not block the caller
+        if (Util::write_captured_output(text)) {
+            return 0;
+        }
+
         fmt::print(text);
 
         return std::fflush(stdout);
@@ -71,4 +132,19 @@ namespace View {
     {
         print(message);
     }
+
+    inline void ConsoleView::flush()
+    {
+        Util::flush_captured_output();
+    }
+
+    inline bool ConsoleView::start_status_line()
+    {
+        return status_line_.start();
+    }
+
+    inline void ConsoleView::stop_status_line()
+    {
+        status_line_.stop();
+    }
 }
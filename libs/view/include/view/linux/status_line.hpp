@@ -0,0 +1,164 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+
+#pragma once
+
+#include "util/seqlock.hpp"
+#include "view/base_view.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace View {
+    /**
+     * @brief A status line kept on the top row of the terminal, above the scrolling output.
+     *
+     * The server thread only publishes the figures to a lock-free snapshot. The line is formatted and
+     * written by a timer of the launcher reactor, which also measures the CPU usage of the process and
+     * reads the log drop counters, so rendering never happens on the server thread. The output scrolls
+     * below the line in an ANSI scroll region.
+     */
+    class StatusLine final {
+      public:
+        /**
+         * @brief The figures published by the server thread.
+         */
+        struct Snapshot {
+            /**
+             * @brief The number of frames per second achieved by the server loop.
+             */
+            float fps{};
+
+            /**
+             * @brief The median frame time, in milliseconds.
+             */
+            float median_ms{};
+
+            /**
+             * @brief The 99th percentile of the frame times, in milliseconds.
+             */
+            float p99_ms{};
+
+            /**
+             * @brief The longest frame time, in milliseconds.
+             */
+            float max_ms{};
+
+            /**
+             * @brief The number of active players on the server.
+             */
+            int num_players{};
+
+            /**
+             * @brief The maximum number of players allowed on the server.
+             */
+            int max_players{};
+
+            /**
+             * @brief The name of the current map, null-terminated.
+             */
+            char map[32]{};
+        };
+
+        /**
+         * @brief Constructs a new StatusLine object.
+         *
+         * @param view The view the line is written through, so it is ordered with the other output.
+         */
+        explicit StatusLine(BaseView& view);
+
+        /// Move constructor.
+        StatusLine(StatusLine&&) = delete;
+
+        /// Copy constructor.
+        StatusLine(const StatusLine&) = delete;
+
+        /// Move assignment operator.
+        StatusLine& operator=(StatusLine&&) = delete;
+
+        /// Copy assignment operator.
+        StatusLine& operator=(const StatusLine&) = delete;
+
+        /**
+         * @brief Destructor, removes the line.
+         */
+        ~StatusLine();
+
+        /**
+         * @brief Starts drawing the line, the launcher reactor has to be running.
+         *
+         * @return \c true if the line is drawn, \c false if the output is not a terminal.
+         */
+        bool start();
+
+        /**
+         * @brief Stops drawing the line and gives the top row back to the output.
+         */
+        void stop();
+
+        /**
+         * @brief Publishes new figures, must only be called by one thread at a time.
+         *
+         * @param snapshot The figures.
+         */
+        void publish(const Snapshot& snapshot) noexcept;
+
+      private:
+        /// Measures the CPU usage and writes the line (runs on the reactor thread).
+        void redraw();
+
+        /// Formats the text of the line, returns \c true if the server looks like it is struggling.
+        bool format_status(const Snapshot& snapshot, double cpu_percent, std::uint64_t log_drops,
+                           std::uint64_t output_drops);
+
+        /// The view the line is written through.
+        BaseView& view_;
+
+        /// The last published figures.
+        Util::SeqLock<Snapshot> snapshot_{};
+
+        /// Guards starting and stopping.
+        std::mutex mutex_{};
+
+        /// The reactor timer that redraws the line, or -1 if it is not drawn.
+        int timer_{-1};
+
+        /// The number of rows of the terminal the scroll region was set for.
+        std::size_t rows_{};
+
+        /// The CPU time of the process at the previous redraw.
+        std::chrono::nanoseconds cpu_time_{};
+
+        /// The time of the previous redraw.
+        std::chrono::steady_clock::time_point redraw_time_{};
+
+        /// The number of dropped log messages at the previous redraw.
+        std::uint64_t log_drops_{};
+
+        /// The text of the line.
+        std::string text_{};
+
+        /// The escape sequences and the text written to the terminal.
+        std::string output_{};
+    };
+}
@@ -84,6 +84,16 @@ namespace View {
          */
         void display_server_status(float fps, int num_players, int max_players, const std::string& map) override;
 
+        /**
+         * @brief Displays the frame rate and frame times of the server loop.
+         *
+         * @param fps The number of frames per second achieved by the server loop.
+         * @param median_ms The median frame time, in milliseconds.
+         * @param p99_ms The 99th percentile of the frame times, in milliseconds.
+         * @param max_ms The longest frame time, in milliseconds.
+         */
+        void display_frame_times(float fps, float median_ms, float p99_ms, float max_ms) override;
+
         /**
          * @brief Write a log message to the console.
          *
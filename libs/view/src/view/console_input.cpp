@@ -22,10 +22,12 @@
 #include "presenter/input_presenter.hpp"
 #include "util/console.hpp"
 #include "util/string.hpp"
+#include <fmt/format.h>
 #include <algorithm>
 #include <cassert>
-#include <chrono>
 #include <iostream>
+#include <iterator>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -60,8 +62,8 @@ namespace {
         return std::string{first1, first_mismatch};
     }
 
-    /// Prints a list of matching commands to the console.
-    void print_command_matches(const std::vector<std::string>& commands)
+    /// Formats a list of matching commands in columns that fit the console.
+    void format_command_matches(std::string& output, const std::vector<std::string>& commands)
     {
         constexpr std::size_t default_console_width = 80;
         constexpr std::size_t min_console_width = 10;
@@ -80,16 +82,22 @@ namespace {
 
             if (current_column > total_columns) {
                 current_column = 1;
-                std::cout << '\n';
+                output.push_back('\n');
             }
 
-            std::cout << Util::str::format("{:<{}}  ", command, longest_command_length);
+            fmt::format_to(std::back_inserter(output), "{:<{}}  ", command, longest_command_length);
         }
     }
 }
 
 namespace View {
-    ConsoleInput::ConsoleInput(InputPresenterPtr input_presenter) : input_presenter_(std::move(input_presenter))
+    ConsoleInput::ConsoleInput(InputPresenterPtr input_presenter) :
+      input_presenter_(std::move(input_presenter)),
+#ifdef _WIN32
+      renderer_(false)
+#else
+      renderer_(true)
+#endif
     {
         assert(input_presenter_ != nullptr);
         start();
@@ -100,27 +108,6 @@ namespace View {
         stop();
     }
 
-    void ConsoleInput::start()
-    {
-        if (running_) {
-            return;
-        }
-
-        running_ = true;
-        input_thread_ = std::thread{&ConsoleInput::read_input, this};
-
-        using namespace std::chrono_literals;
-        std::this_thread::sleep_for(10ms);
-    }
-
-    void ConsoleInput::stop()
-    {
-        if (running_) {
-            running_ = false;
-            input_thread_.join();
-        }
-    }
-
     void ConsoleInput::handle_up_arrow()
     {
         if (const auto& previous_input = input_presenter_->history_previous(); previous_input) {
@@ -128,17 +115,16 @@ namespace View {
                 saved_input_ = input_line_;
             }
 
-            clear_input();
             input_line_ = *previous_input;
-            std::cout << input_line_;
             cursor_position_ = input_line_.length();
+            refresh_line();
         }
     }
 
     void ConsoleInput::handle_down_arrow()
     {
         if (const auto& next_input = input_presenter_->history_next(); next_input || saved_input_) {
-            if (clear_input(); next_input) {
+            if (next_input) {
                 input_line_ = *next_input;
             }
             else {
@@ -146,8 +132,8 @@ namespace View {
                 saved_input_ = std::nullopt;
             }
 
-            std::cout << input_line_;
             cursor_position_ = input_line_.length();
+            refresh_line();
         }
     }
 
@@ -157,8 +143,8 @@ namespace View {
             return;
         }
 
-        std::cout << '\b';
         --cursor_position_;
+        refresh_line();
     }
 
     void ConsoleInput::handle_right_arrow()
@@ -167,8 +153,8 @@ namespace View {
             return;
         }
 
-        std::cout << input_line_[cursor_position_];
         ++cursor_position_;
+        refresh_line();
     }
 
     void ConsoleInput::handle_backspace()
@@ -179,14 +165,7 @@ namespace View {
 
         --cursor_position_;
         input_line_.erase(cursor_position_, 1);
-
-        std::cout << '\b';
-        std::cout << (input_line_.c_str() + cursor_position_);
-        std::cout << ' ';
-
-        for (auto i = input_line_.length() + 1; i > cursor_position_; --i) {
-            std::cout << '\b';
-        }
+        refresh_line();
     }
 
     void ConsoleInput::handle_delete()
@@ -196,26 +175,22 @@ namespace View {
         }
 
         input_line_.erase(cursor_position_, 1);
-        std::cout << (input_line_.c_str() + cursor_position_);
-        std::cout << ' ';
-
-        for (auto i = input_line_.length() + 1; i > cursor_position_; --i) {
-            std::cout << '\b';
-        }
+        refresh_line();
     }
 
     void ConsoleInput::handle_home()
     {
         if (cursor_position_ != 0) {
             cursor_position_ = 0;
-            std::cout << '\r';
+            refresh_line();
         }
     }
 
     void ConsoleInput::handle_end()
     {
-        while (cursor_position_ < input_line_.length()) {
-            handle_right_arrow();
+        if (cursor_position_ != input_line_.length()) {
+            cursor_position_ = input_line_.length();
+            refresh_line();
         }
     }
 
@@ -228,27 +203,31 @@ namespace View {
         }
 
         if (1U == commands.size()) {
-            const auto completion = commands.front().substr(input_line_.length()) + " ";
-            input_line_.append(completion);
-            std::cout << completion;
-        }
-        else {
-            clear_input();
-
-            std::cout << '\n';
-            print_command_matches(commands);
-            std::cout << '\n';
+            input_line_.append(commands.front().substr(std::min(input_line_.length(), commands.front().length())));
+            input_line_.push_back(' ');
+            cursor_position_ = input_line_.length();
+            refresh_line();
 
-            input_line_ = find_common_command_prefix(commands);
-            std::cout << input_line_;
+            return;
         }
 
+        // The matches are printed below the line, which is then displayed again with the common prefix
+        std::string output{renderer_.clear()};
+        output.push_back('\n');
+        format_command_matches(output, commands);
+        output.push_back('\n');
+
+        input_line_ = find_common_command_prefix(commands);
         cursor_position_ = input_line_.length();
+        output.append(renderer_.update(input_line_, cursor_position_));
+
+        write_output(output);
     }
 
     void ConsoleInput::handle_newline()
     {
-        std::cout << '\n';
+        renderer_.reset();
+        write_output("\n");
         input_presenter_->enqueue_input(input_line_);
         input_line_.clear();
         cursor_position_ = 0;
@@ -261,22 +240,20 @@ namespace View {
         }
 
         input_line_.insert(cursor_position_, 1, ch);
-        std::cout << (input_line_.c_str() + cursor_position_);
         ++cursor_position_;
-
-        for (auto i = input_line_.length(); i > cursor_position_; --i) {
-            std::cout << '\b';
-        }
+        refresh_line();
     }
 
-    void ConsoleInput::clear_input()
+    void ConsoleInput::refresh_line()
     {
-        if (!input_line_.empty()) {
-            handle_end();
+        write_output(renderer_.update(input_line_, cursor_position_));
+    }
 
-            for (auto i = input_line_.length(); i > 0; --i) {
-                std::cout << "\b \b";
-            }
+    void ConsoleInput::write_output(const std::string_view output)
+    {
+        if (!output.empty()) {
+            std::cout.write(output.data(), static_cast<std::streamsize>(output.size()));
+            std::cout.flush();
         }
     }
 }
@@ -0,0 +1,113 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+
+#include "view/line_renderer.hpp"
+#include <fmt/format.h>
+#include <algorithm>
+#include <iterator>
+
+namespace {
+    /// The longest cursor movement written as plain characters, a CSI sequence is shorter beyond it.
+    constexpr std::size_t MAX_PLAIN_MOVE = 4;
+}
+
+namespace View {
+    LineRenderer::LineRenderer(const bool use_ansi) noexcept : use_ansi_(use_ansi)
+    {
+    }
+
+    std::string_view LineRenderer::update(const std::string_view line, std::size_t cursor)
+    {
+        output_.clear();
+        cursor = std::min(cursor, line.size());
+
+        const auto first_change = std::mismatch(displayed_.cbegin(), displayed_.cend(), line.cbegin(), line.cend());
+        const auto unchanged = static_cast<std::size_t>(first_change.first - displayed_.cbegin());
+
+        if (unchanged < displayed_.size() || unchanged < line.size()) {
+            move_cursor(unchanged);
+            output_.append(line.substr(unchanged));
+            cursor_ = line.size();
+
+            if (displayed_.size() > line.size()) {
+                const auto leftover = displayed_.size() - line.size();
+
+                if (use_ansi_) {
+                    output_.append("\x1B[K");
+                }
+                else {
+                    output_.append(leftover, ' ');
+                    cursor_ += leftover;
+                }
+            }
+
+            displayed_.assign(line);
+        }
+
+        move_cursor(cursor);
+
+        return output_;
+    }
+
+    std::string_view LineRenderer::clear()
+    {
+        const auto output = update({}, 0);
+        reset();
+
+        return output;
+    }
+
+    void LineRenderer::reset() noexcept
+    {
+        displayed_.clear();
+        cursor_ = 0;
+    }
+
+    void LineRenderer::move_cursor(const std::size_t position)
+    {
+        if (position < cursor_) {
+            const auto distance = cursor_ - position;
+
+            if (0 == position) {
+                output_.push_back('\r');
+            }
+            else if (!use_ansi_ || distance <= MAX_PLAIN_MOVE) {
+                output_.append(distance, '\b');
+            }
+            else {
+                fmt::format_to(std::back_inserter(output_), "\x1B[{}D", distance);
+            }
+        }
+        else if (position > cursor_) {
+            const auto distance = position - cursor_;
+
+            // Rewriting a few characters moves the cursor right without an escape sequence
+            if (!use_ansi_ || distance <= MAX_PLAIN_MOVE) {
+                output_.append(std::string_view{displayed_}.substr(cursor_, distance));
+            }
+            else {
+                fmt::format_to(std::back_inserter(output_), "\x1B[{}C", distance);
+            }
+        }
+
+        cursor_ = position;
+    }
+}
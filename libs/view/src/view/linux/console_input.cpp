@@ -18,83 +18,168 @@
  * For commercial use, contact: sourceengine@valvesoftware.com
  */
 
+
 #include "view/console_input.hpp"
+#include "presenter/input_presenter.hpp"
+#include "util/linux/reactor.hpp"
 #include "util/linux/system/error.hpp"
 #include "util/logger.hpp"
-#include "view/linux/terminal_settings.hpp"
-#include "view/linux/tty_redirect.hpp"
-#include <array>
-#include <poll.h>
+#include <sys/epoll.h>
+#include <cerrno>
 #include <string>
 #include <unistd.h>
 
 namespace {
-    /// Reads a character from the standard input.
-    int read_char_from_stdin()
-    {
-        int input_char = '\0';
-        const auto bytes_read = ::read(STDIN_FILENO, &input_char, 1);
+    /// The size of the chunks read from a standard input that is not a terminal.
+    constexpr std::size_t PIPED_INPUT_CHUNK_SIZE = 64 * 1024;
+
+    /// The size of the chunks read from a terminal.
+    constexpr std::size_t TERMINAL_INPUT_CHUNK_SIZE = 256;
+}
 
-        if ((0 == bytes_read) || ('\0' == input_char)) {
-            return 0;
+namespace View {
+    void ConsoleInput::start()
+    {
+        if (running_) {
+            return;
         }
 
-        if (-1 == bytes_read) {
-            Util::log_error("Failed to read from terminal: {}", Util::get_last_error_string());
-            return 0;
+        const auto is_terminal = ::isatty(STDIN_FILENO) != 0;
+
+        if (is_terminal) {
+            terminal_settings_.emplace();
+            tty_redirect_.emplace();
         }
 
-        return input_char;
+        read_buffer_.resize(is_terminal ? TERMINAL_INPUT_CHUNK_SIZE : PIPED_INPUT_CHUNK_SIZE);
+        escape_state_ = EscapeState::none;
+        running_ = true;
+
+        auto& reactor = Util::get_reactor();
+
+        if (!reactor.add(STDIN_FILENO, EPOLLIN, [this](std::uint32_t) {
+                read_available_input();
+            })) {
+            // Regular files and /dev/null cannot be watched, reading them never blocks
+            reactor.post([this] {
+                while (running_ && read_available_input()) {
+                }
+            });
+        }
     }
-}
 
-namespace View {
-    void ConsoleInput::handle_escape()
+    void ConsoleInput::stop()
     {
-        if (read_char_from_stdin() != '[') {
+        if (!running_) {
             return;
         }
 
-        switch (read_char_from_stdin()) {
-            case 'A': handle_up_arrow(); break;
-            case 'B': handle_down_arrow(); break;
-            case 'C': handle_right_arrow(); break;
-            case 'D': handle_left_arrow(); break;
-            case 'F': handle_end(); break;
-            case 'H': handle_home(); break;
-            case '3': {
-                if ('~' == read_char_from_stdin()) {
-                    handle_delete();
-                }
+        running_ = false;
+        Util::get_reactor().remove(STDIN_FILENO);
+        tty_redirect_.reset();
+        terminal_settings_.reset();
+    }
+
+    bool ConsoleInput::read_available_input()
+    {
+        const auto bytes_read = ::read(STDIN_FILENO, read_buffer_.data(), read_buffer_.size());
 
-                break;
+        if (bytes_read > 0) {
+            const std::string_view input{read_buffer_.data(), static_cast<std::size_t>(bytes_read)};
+
+            if (terminal_settings_) {
+                for (const auto ch : input) {
+                    handle_terminal_char(ch);
+                }
+            }
+            else {
+                handle_piped_input(input, false);
             }
+
+            return true;
+        }
+
+        if ((-1 == bytes_read) && ((EINTR == errno) || (EAGAIN == errno))) {
+            return true;
         }
+
+        if (-1 == bytes_read) {
+            Util::log_error("Failed to read from standard input: {}", Util::get_last_error_string());
+        }
+
+        // The input has ended, nothing more will arrive
+        if (!terminal_settings_) {
+            handle_piped_input({}, true);
+        }
+
+        Util::get_reactor().remove(STDIN_FILENO);
+
+        return false;
     }
 
-    void ConsoleInput::read_input()
+    void ConsoleInput::handle_terminal_char(const char ch)
     {
-        const ScopedTerminalSettings terminal_settings{};
-        const ScopedTtyRedirect tty_redirect{};
+        switch (escape_state_) {
+            case EscapeState::escape: {
+                escape_state_ = '[' == ch ? EscapeState::control : EscapeState::none;
+                return;
+            }
+
+            case EscapeState::control: {
+                escape_state_ = EscapeState::none;
 
-        std::array<::pollfd, 1> pfd{{{STDIN_FILENO, POLLIN, 0}}};
-        constexpr ::nfds_t pfd_size = 1;
-        constexpr auto timeout_msec = 100;
+                switch (ch) {
+                    case 'A': handle_up_arrow(); break;
+                    case 'B': handle_down_arrow(); break;
+                    case 'C': handle_right_arrow(); break;
+                    case 'D': handle_left_arrow(); break;
+                    case 'F': handle_end(); break;
+                    case 'H': handle_home(); break;
+                    case '3': escape_state_ = EscapeState::delete_key; break;
+                }
 
-        while (running_) {
-            if (::poll(pfd.data(), pfd_size, timeout_msec) <= 0) {
-                continue;
+                return;
             }
 
-            switch (const auto input_char = read_char_from_stdin(); input_char) {
-                case '\0': continue;
-                case '\n': handle_newline(); break;
-                case '\x1B': handle_escape(); break;
-                case '\x7F':
-                case '\b': handle_backspace(); break;
-                case '\t': handle_tab(); break;
-                default: handle_char(static_cast<std::string::value_type>(input_char)); break;
+            case EscapeState::delete_key: {
+                escape_state_ = EscapeState::none;
+
+                if ('~' == ch) {
+                    handle_delete();
+                }
+
+                return;
             }
+
+            case EscapeState::none: break;
+        }
+
+        switch (ch) {
+            case '\0': break;
+            case '\n': handle_newline(); break;
+            case '\x1B': escape_state_ = EscapeState::escape; break;
+            case '\x7F':
+            case '\b': handle_backspace(); break;
+            case '\t': handle_tab(); break;
+            default: handle_char(ch); break;
+        }
+    }
+
+    void ConsoleInput::handle_piped_input(const std::string_view input, const bool finished)
+    {
+        const auto enqueue = [this](const std::string_view line) { input_presenter_->enqueue_piped_input(line); };
+
+        if (finished) {
+            splitter_.finish(enqueue);
+        }
+        else {
+            splitter_.feed(input, enqueue);
+        }
+
+        if (const auto dropped = splitter_.get_dropped(); dropped != dropped_lines_) {
+            Util::log_warn("Dropped {} input lines longer than {} bytes.", dropped - dropped_lines_,
+                           Util::LineSplitter::DEFAULT_MAX_LINE_SIZE);
+            dropped_lines_ = dropped;
         }
     }
 }
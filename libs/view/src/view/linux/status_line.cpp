@@ -0,0 +1,188 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+
+#include "view/linux/status_line.hpp"
+#include "util/console.hpp"
+#include "util/linux/output_capture.hpp"
+#include "util/linux/reactor.hpp"
+#include "util/logger.hpp"
+#include <fmt/format.h>
+#include <cstring>
+#include <ctime>
+#include <iterator>
+#include <string_view>
+
+namespace {
+    /// The interval at which the line is redrawn.
+    constexpr std::chrono::milliseconds REDRAW_INTERVAL{500};
+
+    /// The number of rows the terminal needs for the line to be drawn.
+    constexpr std::size_t MIN_ROWS = 3;
+
+    /// A frame time that players notice as a hitch, in milliseconds.
+    constexpr float HITCH_FRAME_TIME_MS = 50.0F;
+
+    /// The CPU usage at which the server thread is considered saturated, in percent of one core.
+    constexpr double BUSY_CPU_PERCENT = 95.0;
+
+    /// The style of the line: reverse video.
+    constexpr std::string_view NORMAL_STYLE = "\x1B[0;7m";
+
+    /// The style of the line when the server is struggling: bold white on red.
+    constexpr std::string_view STRUGGLING_STYLE = "\x1B[0;1;37;41m";
+
+    /// Saves the cursor position and attributes.
+    constexpr std::string_view SAVE_CURSOR = "\x1B"
+                                             "7";
+
+    /// Restores the cursor position and attributes.
+    constexpr std::string_view RESTORE_CURSOR = "\x1B"
+                                                "8";
+
+    /// Gets the CPU time used by all the threads of the process.
+    std::chrono::nanoseconds get_process_cpu_time() noexcept
+    {
+        ::timespec time{};
+        ::clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time);
+
+        return std::chrono::seconds{time.tv_sec} + std::chrono::nanoseconds{time.tv_nsec};
+    }
+}
+
+namespace View {
+    StatusLine::StatusLine(BaseView& view) :
+      view_(view)
+    {
+    }
+
+    StatusLine::~StatusLine()
+    {
+        stop();
+    }
+
+    bool StatusLine::start()
+    {
+        const std::lock_guard lock{mutex_};
+
+        if (timer_ >= 0) {
+            return true;
+        }
+
+        if (Util::get_console_height() < MIN_ROWS) {
+            return false;
+        }
+
+        rows_ = 0;
+        cpu_time_ = get_process_cpu_time();
+        redraw_time_ = std::chrono::steady_clock::now();
+        log_drops_ = Util::log_async_stats().dropped;
+        timer_ = Util::get_reactor().add_timer(REDRAW_INTERVAL, [this] {
+            redraw();
+        });
+
+        return timer_ >= 0;
+    }
+
+    void StatusLine::stop()
+    {
+        const std::lock_guard lock{mutex_};
+
+        if (timer_ < 0) {
+            return;
+        }
+
+        // Waits for a redraw in progress
+        Util::get_reactor().remove_timer(timer_);
+        timer_ = -1;
+
+        if (rows_ != 0) {
+            output_.clear();
+            output_.append(SAVE_CURSOR).append("\x1B[r\x1B[1;1H\x1B[2K").append(RESTORE_CURSOR);
+            view_.print(output_);
+            rows_ = 0;
+        }
+    }
+
+    void StatusLine::publish(const Snapshot& snapshot) noexcept
+    {
+        snapshot_.store(snapshot);
+    }
+
+    void StatusLine::redraw()
+    {
+        const auto now = std::chrono::steady_clock::now();
+        const auto cpu_time = get_process_cpu_time();
+        const auto elapsed = std::chrono::duration<double>{now - redraw_time_}.count();
+        const auto cpu_percent =
+          elapsed > 0.0 ? 100.0 * std::chrono::duration<double>{cpu_time - cpu_time_}.count() / elapsed : 0.0;
+
+        cpu_time_ = cpu_time;
+        redraw_time_ = now;
+
+        const auto rows = Util::get_console_height();
+        const auto columns = Util::get_console_width();
+
+        if (rows < MIN_ROWS || columns < 2) {
+            return;
+        }
+
+        const auto log_drops = Util::log_async_stats().dropped;
+        const auto output_drops = Util::output_capture_stats().dropped_bytes;
+        const auto struggling = format_status(snapshot_.load(), cpu_percent, log_drops, output_drops);
+        log_drops_ = log_drops;
+
+        // The last column is left blank, writing it would wrap the cursor on some terminals
+        text_.resize(columns - 1, ' ');
+
+        output_.clear();
+        output_.append(SAVE_CURSOR);
+
+        // Setting the scroll region moves the cursor, it is restored below
+        if (rows != rows_) {
+            fmt::format_to(std::back_inserter(output_), "\x1B[2;{}r", rows);
+            rows_ = rows;
+        }
+
+        output_.append("\x1B[1;1H").append(struggling ? STRUGGLING_STYLE : NORMAL_STYLE);
+        output_.append(text_).append("\x1B[K\x1B[0m").append(RESTORE_CURSOR);
+        view_.print(output_);
+    }
+
+    bool StatusLine::format_status(const Snapshot& snapshot, const double cpu_percent, const std::uint64_t log_drops,
+                                   const std::uint64_t output_drops)
+    {
+        constexpr std::uint64_t bytes_per_kilobyte = 1024;
+        const std::string_view map{snapshot.map, ::strnlen(snapshot.map, sizeof(snapshot.map))};
+
+        text_.clear();
+        fmt::format_to(std::back_inserter(text_),
+                       " FPS {:.1f} | Frame p50 {:.2f} p99 {:.2f} max {:.2f} ms | Players {}/{} | Map {} | "
+                       "CPU {:.0f}% | Log drops {}",
+                       snapshot.fps, snapshot.median_ms, snapshot.p99_ms, snapshot.max_ms, snapshot.num_players,
+                       snapshot.max_players, map.empty() ? "-" : map, cpu_percent, log_drops);
+
+        if (output_drops > 0) {
+            fmt::format_to(std::back_inserter(text_), " | Output drops {} KiB", output_drops / bytes_per_kilobyte);
+        }
+
+        return snapshot.max_ms >= HITCH_FRAME_TIME_MS || cpu_percent >= BUSY_CPU_PERCENT || log_drops > log_drops_;
+    }
+}
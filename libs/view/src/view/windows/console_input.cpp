@@ -24,6 +24,7 @@
 #include "util/logger.hpp"
 #include "util/system.hpp"
 #include <chrono>
+#include <thread>
 #include <Windows.h>
 
 namespace {
@@ -57,6 +58,27 @@ namespace {
 }
 
 namespace View {
+    void ConsoleInput::start()
+    {
+        if (running_) {
+            return;
+        }
+
+        running_ = true;
+        input_thread_ = std::thread{&ConsoleInput::read_input, this};
+
+        using namespace std::chrono_literals;
+        std::this_thread::sleep_for(10ms);
+    }
+
+    void ConsoleInput::stop()
+    {
+        if (running_) {
+            running_ = false;
+            input_thread_.join();
+        }
+    }
+
     void ConsoleInput::read_input()
     {
         ::INPUT_RECORD input_record{};
@@ -78,4 +78,10 @@ namespace View {
             ::TextOut(console_device_context_, 1, 2, status.c_str(), static_cast<int>(status.length()));
         }
     }
+
+    void ConsoleView::display_frame_times(
+      const float /* fps */, const float /* median_ms */, const float /* p99_ms */, const float /* max_ms */)
+    {
+        // The status area of the console window only shows the engine figures
+    }
 }
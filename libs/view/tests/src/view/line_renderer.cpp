@@ -0,0 +1,115 @@
+/*
+ * Half Life 1 SDK License
+ * Copyright(c) Valve Corp
+ *
+ * DISCLAIMER OF WARRANTIES. THE HALF LIFE 1 SDK AND ANY OTHER MATERIAL
+ * DOWNLOADED BY LICENSEE IS PROVIDED "AS IS". VALVE AND ITS SUPPLIERS
+ * DISCLAIM ALL WARRANTIES WITH RESPECT TO THE SDK, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NON-INFRINGEMENT, TITLE AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * LIMITATION OF LIABILITY. IN NO EVENT SHALL VALVE OR ITS SUPPLIERS BE LIABLE
+ * FOR ANY SPECIAL, INCIDENTAL, INDIRECT, OR CONSEQUENTIAL DAMAGES WHATSOEVER
+ * (INCLUDING, WITHOUT LIMITATION, DAMAGES FOR LOSS OF BUSINESS PROFITS,
+ * BUSINESS INTERRUPTION, LOSS OF BUSINESS INFORMATION, OR ANY OTHER PECUNIARY
+ * LOSS) ARISING OUT OF THE USE OF OR INABILITY TO USE THE ENGINE AND/OR THE
+ * SDK, EVEN IF VALVE HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * For commercial use, contact: sourceengine@valvesoftware.com
+ */
+
+
+#include "view/line_renderer.hpp"
+#include <gtest/gtest.h>
+#include <string>
+
+namespace {
+    TEST(LineRendererTest, InsertAtEnd)
+    {
+        View::LineRenderer renderer{true};
+
+        ASSERT_EQ(renderer.update("abc", 3), "abc");
+
+        // Only the new character is written
+        ASSERT_EQ(renderer.update("abcd", 4), "d");
+    }
+
+    TEST(LineRendererTest, InsertInMiddle)
+    {
+        View::LineRenderer renderer{true};
+        ASSERT_EQ(renderer.update("abcd", 4), "abcd");
+
+        // The changed tail is rewritten and the cursor is moved back behind the inserted character
+        ASSERT_EQ(renderer.update("abXcd", 3), "\b\bXcd\b\b");
+    }
+
+    TEST(LineRendererTest, DeleteAtEnd)
+    {
+        View::LineRenderer renderer{true};
+        ASSERT_EQ(renderer.update("abcd", 4), "abcd");
+
+        ASSERT_EQ(renderer.update("abc", 3), "\b\x1B[K");
+    }
+
+    TEST(LineRendererTest, DeleteInMiddle)
+    {
+        View::LineRenderer renderer{true};
+        ASSERT_EQ(renderer.update("abcd", 1), "abcd\b\b\b");
+
+        ASSERT_EQ(renderer.update("acd", 1), "cd\x1B[K\b\b");
+    }
+
+    TEST(LineRendererTest, HomeAndEnd)
+    {
+        View::LineRenderer renderer{true};
+        ASSERT_EQ(renderer.update("hello world", 11), "hello world");
+
+        ASSERT_EQ(renderer.update("hello world", 0), "\r");
+        ASSERT_EQ(renderer.update("hello world", 11), "\x1B[11C");
+        ASSERT_EQ(renderer.update("hello world", 2), "\x1B[9D");
+
+        // Short movements are cheaper as plain characters
+        ASSERT_EQ(renderer.update("hello world", 5), "llo");
+        ASSERT_EQ(renderer.update("hello world", 3), "\b\b");
+        ASSERT_EQ(renderer.update("hello world", 3), "");
+    }
+
+    TEST(LineRendererTest, ShrinkingLine)
+    {
+        View::LineRenderer renderer{true};
+        ASSERT_EQ(renderer.update("long line", 9), "long line");
+
+        ASSERT_EQ(renderer.update("ab", 2), "\rab\x1B[K");
+        ASSERT_EQ(renderer.update("abc", 3), "c");
+    }
+
+    TEST(LineRendererTest, ClearAndReset)
+    {
+        View::LineRenderer renderer{true};
+        ASSERT_EQ(renderer.update("abc", 3), "abc");
+
+        ASSERT_EQ(renderer.clear(), "\r\x1B[K");
+        ASSERT_EQ(renderer.update("x", 1), "x");
+
+        // Other output moved the cursor to a new line, the whole line is written again
+        renderer.reset();
+        ASSERT_EQ(renderer.update("x", 1), "x");
+    }
+
+    TEST(LineRendererTest, WithoutAnsi)
+    {
+        View::LineRenderer renderer{false};
+        ASSERT_EQ(renderer.update("long line", 9), "long line");
+
+        // The leftover characters are overwritten with spaces and the cursor is moved back with backspaces
+        ASSERT_EQ(renderer.update("ab", 2), "\rab" + std::string(7, ' ') + std::string(7, '\b'));
+
+        // Long movements still use plain characters
+        ASSERT_EQ(renderer.update("abcdefgh", 0), "cdefgh\r");
+        ASSERT_EQ(renderer.update("abcdefgh", 6), "abcdef");
+        ASSERT_EQ(renderer.update("abcdefgh", 0), "\r");
+        ASSERT_EQ(renderer.update("abcdefgh", 8), "abcdefgh");
+        ASSERT_EQ(renderer.update("abcdefgh", 1), std::string(7, '\b'));
+        ASSERT_EQ(renderer.clear(), "\r" + std::string(8, ' ') + "\r");
+    }
+}